@@ -15,9 +15,9 @@
  * • Core 1
  *   ─ Bloqueia na FIFO aguardando um novo estado.
  *   ─ Ajusta a cor do LED RGB e o buzzer conforme a tabela:
- *      1 – VERDE   – Atividade Baixa
- *      2 – AZUL    – Atividade Moderada
- *      3 – VERMELHO + BUZZER – Atividade Alta/Critica
+ *      1 – VERDE   + acorde curto (arpejo)  – Atividade Baixa
+ *      2 – AZUL    + duas notas            – Atividade Moderada
+ *      3 – VERMELHO + sirene em laço       – Atividade Alta/Critica
  * 
  * • Requisitos atendidos
  *   ─ Uso de variável `volatile` para partilha de estado.
@@ -42,16 +42,14 @@
  *  
  * PWM no Buzzer
  * ───────────────────────────
- * O acionamento ON/OFF do buzzer pelo
- * periférico PWM do RP2040, permite gerar tons audíveis em qualquer
- * frequência (≈ 20 Hz – 20 kHz), limitada apenas pela resolução do PWM
- * e pela resposta do piezo/alto‑falante empregado.
- * 
- * Como escolher a frequência?
- * (1) Compilação: altere o valor de `DEFAULT_BUZZER_FREQ_HZ` abaixo.
- * (2) Execução: chame `set_buzzer_frequency(novafreq)` a qualquer momento
- *     (por exemplo, dentro do `core1_main()` antes de ligar o buzzer,
- *      ou em um comando vindo da UART, etc.).
+ * O buzzer toca sequências de notas (buzzer_melodia.h): a tabela de notas
+ * é calculada em tempo de compilação e o DMA reescreve o PWM a cada nota,
+ * então o Core 1 só entrega a sequência e volta a esperar na FIFO.
+ * A sirene do estado ALTO é um alarme prioritário: interrompe o som em
+ * andamento e, ao ser parada, o som interrompido continua de onde estava.
+ *
+ * Como mudar os sons?
+ *  Edite as listas de eventos em `config_buzzer()` (nota, duração, volume).
  *
  * Histórico
  * ─────────
@@ -67,8 +65,7 @@
 #include "pico/util/queue.h"
 #include "hardware/adc.h"
 #include "hardware/gpio.h"
-#include "hardware/pwm.h"     // PWM
-#include "hardware/clocks.h"  // clock_get_hz()
+#include "buzzer_melodia.h"   // Notas e sequências por PWM + DMA
 
 /* ╔══════════════════════════════════╗
  * ║  DEFINIÇÕES DE HARDWARE          ║
@@ -84,10 +81,9 @@
 #define JOYSTICK_Y_PIN  26      // ADC‑0 – eixo Y (debug)
 
 /* ╔══════════════════════════════════╗
- * ║  PARÂMETROS DO PWM DO BUZZER     ║
+ * ║  SONS DO BUZZER                  ║
  * ╚══════════════════════════════════╝*/
-#define DEFAULT_BUZZER_FREQ_HZ  2000u   // 2 kHz inicial – altere à vontade
-#define BUZZER_PWM_DUTY         0.50f   // 50 % duty‑cycle (onda quadrada)
+#define BUZZER_VOLUME   100u    // % do duty máximo (100 → onda quadrada 50 %)
 
 /* ╔══════════════════════════════════╗
  * ║  SISTEMA DE ESTADOS              ║
@@ -108,6 +104,10 @@ typedef enum {
 volatile uint8_t system_state = STATE_LOW;   // Flag de estado (visível a ambos os cores)
 queue_t state_fifo;                          // FIFO com 1 byte (uint8_t)
 
+static buzzer_seq_t som_baixo;               // Acorde C–E–G arpejado
+static buzzer_seq_t som_moderado;            // Duas notas
+static buzzer_seq_t som_alto;                // Sirene 1 kHz / 2 kHz (alarme em laço)
+
 /* ╔══════════════════════════════════╗
  * ║  PROTÓTIPOS DE FUNÇÃO            ║
  * ╚══════════════════════════════════╝*/
@@ -117,8 +117,7 @@ static void  config_joystick(void);     // Configura os Joystick
 static void  set_leds(uint8_t state);   // Seta os LEDs
 static void  read_joystick(void);       // Lê e processa o Joystick
 static void  core1_main(void);          // Uso do Core 1
-static void  activate_buzzer(bool on);  // Ativação do Buzzer
-static void  set_buzzer_frequency(uint32_t freq_hz);
+static void  play_buzzer(uint8_t state); // Sons de cada estado
 static int64_t alarm_cb(alarm_id_t id, void *user_data);
 
 /* ╔══════════════════════════════════╗
@@ -162,6 +161,7 @@ static int64_t alarm_cb(__unused alarm_id_t id, __unused void* user_data)
 static void core1_main(void)
 {
     uint8_t incoming;
+    uint8_t last = 0;
     printf("Core 1 ativo - aguardando estados…\n");
 
     while (true)
@@ -172,16 +172,11 @@ static void core1_main(void)
         /* Atuação sobre LEDs */
         set_leds(incoming);
 
-        /* Exemplo: alterar tom aqui, se desejar */
-        /* if (incoming == STATE_HIGH)  set_buzzer_frequency(1000); */
-
-        if (incoming == STATE_HIGH) {
-            set_buzzer_frequency(1000);  // 1 KHz
-            activate_buzzer(true);
-        } else {
-            activate_buzzer(false);
+        /* Atuação sobre o buzzer (só nas mudanças de estado) */
+        if (incoming != last) {
+            play_buzzer(incoming);
+            last = incoming;
         }
-        //activate_buzzer(incoming == STATE_HIGH);
     }
 }
 
@@ -265,72 +260,60 @@ static void set_leds(uint8_t state)
 }
 
 /* ╔══════════════════════════════════╗
- * ║  BUZZER – PWM                    ║
+ * ║  BUZZER – PWM + DMA              ║
  * ╚══════════════════════════════════╝*/
 /**
- * @brief Configura o pino do buzzer como saída PWM (desabilitado).
+ * @brief Configura o PWM/DMA do buzzer e compila os sons de cada estado.
  */
 static void config_buzzer(void)
 {
-    /* ➌ Configura pino A como função PWM */
-    gpio_set_function(BUZZER_PIN_A, GPIO_FUNC_PWM);
-    uint slice = pwm_gpio_to_slice_num(BUZZER_PIN_A);
+    buzzer_init(BUZZER_PIN_A);
 
-    /* Pino B continua como GPIO ON/OFF (fase oposta ou reforço) */
+    /* Pino B continua como GPIO (fase oposta ou reforço) – mantido em 0 */
     gpio_init(BUZZER_PIN_B);
     gpio_set_dir(BUZZER_PIN_B, GPIO_OUT);
     gpio_put(BUZZER_PIN_B, 0);
 
-    /* Define frequência padrão e duty‑cycle */
-    set_buzzer_frequency(DEFAULT_BUZZER_FREQ_HZ);
-
-    pwm_set_enabled(slice, false);  // começa em silêncio
+    /* BAIXO: acorde de Dó maior arpejado (notas alternadas a cada 30 ms) */
+    static const buzzer_nota_t acorde_c[] = { NOTA_C5, NOTA_E5, NOTA_G5 };
+    buzzer_seq_compilar(&som_baixo, NULL, 0, false);
+    buzzer_seq_arpejo(&som_baixo, acorde_c, 3, 30, 360, BUZZER_VOLUME / 2);
 
-    printf("Buzzer PWM configurado (pino %d • freq. inicial %u Hz)\n",
-           BUZZER_PIN_A, DEFAULT_BUZZER_FREQ_HZ);
-}
+    /* MODERADO: duas notas curtas */
+    static const buzzer_evento_t duas_notas[] = {
+        { NOTA_A5, 120, BUZZER_VOLUME }, { NOTA_PAUSA, 60, 0 }, { NOTA_E5, 180, BUZZER_VOLUME },
+    };
+    buzzer_seq_compilar(&som_moderado, duas_notas, 3, false);
 
-/**
- * @brief Ajusta a frequência do buzzer em tempo de execução.
- * @param freq_hz Frequência desejada (Hz). Máx. ≈ 20 kHz
- *
- * Fórmula: `freq = clk_sys / (div * (TOP + 1))`,
- * onde `div` é o divisor (1 – 255, fracionário) e `TOP` (wrap) é o valor
- * máximo do contador PWM.
- */
-static void set_buzzer_frequency(uint32_t freq_hz)
-{
-    uint slice = pwm_gpio_to_slice_num(BUZZER_PIN_A);
+    /* ALTO: sirene 1 kHz / 2 kHz repetida até sair do estado */
+    static const buzzer_evento_t sirene[] = {
+        { NOTA_BIP_1K, 250, BUZZER_VOLUME }, { NOTA_BIP_2K, 250, BUZZER_VOLUME },
+    };
+    buzzer_seq_compilar(&som_alto, sirene, 2, true);
 
-    /* Escolha de TOP – valor intermediário para boa resolução */
-    const uint32_t top = 2499;           // TOP = 2499 → 2500 passos
-    pwm_set_wrap(slice, top);            // define período
-
-    /* Calcula divisor fracionário (float) */
-    uint32_t clk = clock_get_hz(clk_sys);   // 125 MHz padrão
-    float div = (float)clk / (freq_hz * (top + 1));
-
-    /* Limita faixa aceita (SDK: 1 ≤ div ≤ 255) */
-    if (div < 1.0f)   div = 1.0f;
-    if (div > 255.0f) div = 255.0f;
-
-    pwm_set_clkdiv(slice, div);
-
-    /* Duty‑cycle (50 %) */
-    uint32_t level = (uint32_t)((top + 1) * BUZZER_PWM_DUTY);
-    pwm_set_gpio_level(BUZZER_PIN_A, level);
+    printf("Buzzer PWM+DMA configurado (pino %d)\n", BUZZER_PIN_A);
 }
 
 /**
- * @brief Liga ou desliga o buzzer.
- *        Ao ligar, apenas habilita o slice (freq. já configurada).
+ * @brief Toca o som do estado. A sirene é alarme; os demais são melodias.
  */
-static void activate_buzzer(bool on)
+static void play_buzzer(uint8_t state)
 {
-    uint slice = pwm_gpio_to_slice_num(BUZZER_PIN_A);
-    pwm_set_enabled(slice, on);
-
-    /* Opcional: espelha nível no pino B */
-    gpio_put(BUZZER_PIN_B, on ? 1 : 0);
+    switch (state)
+    {
+        case STATE_HIGH:
+            buzzer_tocar_alarme(&som_alto);
+            break;
+        case STATE_MODERATE:
+            buzzer_parar_alarme();
+            buzzer_tocar_melodia(&som_moderado);
+            break;
+        case STATE_LOW:
+            buzzer_parar_alarme();
+            buzzer_tocar_melodia(&som_baixo);
+            break;
+        default:
+            buzzer_parar();
+            break;
+    }
 }
-
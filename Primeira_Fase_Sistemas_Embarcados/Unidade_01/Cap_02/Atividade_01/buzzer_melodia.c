@@ -0,0 +1,331 @@
+/**
+ * @file   buzzer_melodia.c
+ * @brief  Tabela de notas em tempo de compilação e reprodução das sequências por DMA.
+ *
+ * Histórico
+ * ─────────
+ *  29-abr-2025 – Manoel F. C. Furtado
+ */
+#include "buzzer_melodia.h"
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+#include "pico/critical_section.h"
+
+/* ╔══════════════════════════════════╗
+ * ║  TABELA DE NOTAS (compilação)    ║
+ * ╚══════════════════════════════════╝*/
+#ifndef SYS_CLK_HZ
+#define SYS_CLK_HZ 125000000u
+#endif
+
+/*
+ * Período da nota em 1/16 de ciclo de clk_sys (o divisor do PWM é 8.4 bits).
+ * DIV (em 1/16) é o menor que deixa TOP ≤ 65535; TOP é arredondado.
+ * Ex.: C4 a 125 MHz → DIV = 117/16 = 7,31; TOP = 65336; erro < 0,001 %.
+ */
+#define NOTA_T16(fc)  ((uint64_t)SYS_CLK_HZ * 1600u / (fc))
+#define NOTA_DIV(fc)  (NOTA_T16(fc) / 65536u + 1u < 16u ? 16u : NOTA_T16(fc) / 65536u + 1u)
+#define NOTA_TOP(fc)  ((NOTA_T16(fc) + NOTA_DIV(fc) / 2u) / NOTA_DIV(fc) - 1u)
+
+typedef struct {
+    uint16_t div;   /* Valor do registrador DIV (INT << 4 | FRAC). */
+    uint16_t top;
+} nota_pwm_t;
+
+#define BUZZER_ITEM_NOTA(nome, fc) { (uint16_t)NOTA_DIV(fc), (uint16_t)NOTA_TOP(fc) },
+static const nota_pwm_t tabela_notas[] = {
+    BUZZER_NOTAS(BUZZER_ITEM_NOTA)
+};
+#undef BUZZER_ITEM_NOTA
+
+/* ╔══════════════════════════════════╗
+ * ║  ESTADO DO MOTOR                 ║
+ * ╚══════════════════════════════════╝*/
+#define TICK_HZ 4000u   /* Resolução das durações: 0,25 ms. */
+
+static uint  fatia;
+static uint  shift_cc;              /* 0 (canal A) ou 16 (canal B) no registrador CC. */
+static int   canal_ctrl, canal_dados;
+static uint32_t ctrl_pwm, ctrl_espera, ctrl_fim;
+static uint32_t lixo_origem, lixo_destino;  /* Alvo das transferências de espera. */
+static const uint32_t regs_silencio[4] = { 16u, 0u, 0u, 0xFFFFu };
+
+typedef enum { PARADO, TOCANDO_MELODIA, TOCANDO_ALARME } modo_t;
+static volatile modo_t modo = PARADO;
+static const buzzer_seq_t *melodia;         /* Melodia atual (tocando ou suspensa). */
+static const buzzer_seq_t *alarme;
+static int32_t melodia_bloco = -1;          /* Bloco onde a melodia retoma; -1 = nenhuma. */
+
+/*
+ * A API pode ser chamada de um núcleo e a IRQ do DMA estar habilitada no outro
+ * (no exemplo: buzzer_init() no core 0, buzzer_tocar_*() no core 1). Mascarar só
+ * as interrupções locais não basta: modo/sequência e o reinício dos canais ficam
+ * sob um spin lock, tomado também pela IRQ.
+ */
+static critical_section_t cs;
+
+/**
+ * @brief Para os dois canais sem disparar o encadeamento e silencia o PWM.
+ */
+static void parar_canais(void)
+{
+    dma_channel_set_irq0_enabled(canal_dados, false);
+    dma_channel_abort(canal_ctrl);
+    dma_channel_abort(canal_dados);
+    dma_channel_abort(canal_ctrl);
+    dma_channel_acknowledge_irq0(canal_dados);
+    dma_channel_set_irq0_enabled(canal_dados, true);
+    pwm_hw->slice[fatia].cc = 0;
+}
+
+/**
+ * @brief Dispara a lista de blocos a partir do bloco `bloco`.
+ */
+static void iniciar(const buzzer_seq_t *seq, uint32_t bloco)
+{
+    dma_channel_set_write_addr(canal_ctrl, &dma_hw->ch[canal_dados].read_addr, false);
+    dma_channel_set_read_addr(canal_ctrl, seq->blocos[bloco], true);
+}
+
+/**
+ * @brief Bloco da melodia que está em execução (para retomar depois do alarme).
+ * @return Bloco de escrita da nota atual ou -1 se a melodia já terminou.
+ */
+static int32_t bloco_atual(const buzzer_seq_t *seq)
+{
+    uint32_t lido = dma_hw->ch[canal_ctrl].read_addr;
+    int32_t proximo = (int32_t)((lido - (uint32_t)(uintptr_t)seq->blocos) / sizeof(seq->blocos[0]));
+    int32_t evento = (proximo - 1) / 2;     /* Blocos 2e (nota) e 2e+1 (espera). */
+    return (evento >= 0 && (uint32_t)evento < seq->n) ? 2 * evento : -1;
+}
+
+/**
+ * @brief Fim de uma sequência (bloco de silêncio final, o único sem IRQ_QUIET).
+ */
+static void buzzer_dma_irq(void)
+{
+    critical_section_enter_blocking(&cs);
+    /* Testado já com o lock: o outro núcleo pode ter parado os canais e reconhecido a IRQ. */
+    if (!dma_channel_get_irq0_status(canal_dados)) {
+        critical_section_exit(&cs);
+        return;
+    }
+    dma_channel_acknowledge_irq0(canal_dados);
+    /* O canal de controle ainda carrega o gatilho nulo: espera (4 palavras) antes de reusá-lo. */
+    while (dma_channel_is_busy(canal_ctrl)) {
+        tight_loop_contents();
+    }
+
+    if (modo == TOCANDO_ALARME) {
+        if (alarme->repetir) {
+            iniciar(alarme, 0);
+        } else if (melodia_bloco >= 0) {
+            modo = TOCANDO_MELODIA;
+            iniciar(melodia, (uint32_t)melodia_bloco);
+            melodia_bloco = -1;
+        } else {
+            modo = PARADO;
+        }
+    } else if (modo == TOCANDO_MELODIA) {
+        if (melodia->repetir) {
+            iniciar(melodia, 0);
+        } else {
+            modo = PARADO;
+        }
+    }
+    critical_section_exit(&cs);
+}
+
+void buzzer_init(uint32_t pino)
+{
+    critical_section_init(&cs);
+    gpio_set_function(pino, GPIO_FUNC_PWM);
+    fatia = pwm_gpio_to_slice_num(pino);
+    shift_cc = (pwm_gpio_to_channel(pino) == PWM_CHAN_B) ? 16u : 0u;
+    pwm_config cfg = pwm_get_default_config();
+    pwm_init(fatia, &cfg, true);
+    pwm_hw->slice[fatia].cc = 0;            /* Começa em silêncio. */
+
+    if (clock_get_hz(clk_sys) != SYS_CLK_HZ) {
+        printf("Buzzer: clk_sys = %lu Hz, tabela de notas feita para %lu Hz (afinação deslocada)\n",
+               (unsigned long)clock_get_hz(clk_sys), (unsigned long)SYS_CLK_HZ);
+    }
+
+    /* Timer de DMA: um DREQ a cada 0,25 ms. */
+    int timer = dma_claim_unused_timer(true);
+    dma_timer_set_fraction((uint)timer, 1, (uint16_t)(clock_get_hz(clk_sys) / TICK_HZ));
+
+    canal_ctrl  = dma_claim_unused_channel(true);
+    canal_dados = dma_claim_unused_channel(true);
+
+    /* Canal de controle: copia 4 palavras (um bloco) para READ/WRITE/COUNT/CTRL_TRIG do canal de dados. */
+    dma_channel_config c = dma_channel_get_default_config(canal_ctrl);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, 4);   /* Escrita volta ao início a cada 16 bytes. */
+    dma_channel_configure(canal_ctrl, &c, &dma_hw->ch[canal_dados].read_addr, NULL, 4, false);
+
+    /* Palavras CTRL dos blocos do canal de dados (todas encadeiam no canal de controle). */
+    dma_channel_config d = dma_channel_get_default_config(canal_dados);
+    channel_config_set_transfer_data_size(&d, DMA_SIZE_32);
+    channel_config_set_chain_to(&d, canal_ctrl);
+    channel_config_set_irq_quiet(&d, true);
+    channel_config_set_read_increment(&d, true);
+    channel_config_set_write_increment(&d, true);
+    channel_config_set_dreq(&d, DREQ_FORCE);
+    ctrl_pwm = channel_config_get_ctrl_value(&d);
+
+    channel_config_set_read_increment(&d, false);
+    channel_config_set_write_increment(&d, false);
+    channel_config_set_dreq(&d, dma_get_timer_dreq((uint)timer));
+    ctrl_espera = channel_config_get_ctrl_value(&d);
+
+    channel_config_set_read_increment(&d, true);
+    channel_config_set_write_increment(&d, true);
+    channel_config_set_dreq(&d, DREQ_FORCE);
+    channel_config_set_irq_quiet(&d, false);
+    ctrl_fim = channel_config_get_ctrl_value(&d);
+
+    dma_channel_set_irq0_enabled(canal_dados, true);
+    irq_add_shared_handler(DMA_IRQ_0, buzzer_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+/**
+ * @brief Grava os registradores e os dois blocos de um evento.
+ */
+static void montar_evento(buzzer_seq_t *seq, uint32_t i, buzzer_nota_t nota, uint16_t dur_ms, uint8_t volume)
+{
+    uint32_t *r = seq->regs[i];
+    if (nota >= NOTA_PAUSA || volume == 0) {
+        for (int k = 0; k < 4; k++) r[k] = regs_silencio[k];
+    } else {
+        const nota_pwm_t *n = &tabela_notas[nota];
+        if (volume > 100) volume = 100;
+        uint32_t nivel = ((uint32_t)n->top + 1u) * volume / 200u;   /* 100 % = duty de 50 %. */
+        r[0] = n->div;
+        r[1] = 0;                           /* CTR: reinicia o período na troca de nota. */
+        r[2] = nivel << shift_cc;
+        r[3] = n->top;
+    }
+
+    uint32_t *b = seq->blocos[2 * i];
+    b[0] = (uint32_t)(uintptr_t)r;
+    b[1] = (uint32_t)(uintptr_t)&pwm_hw->slice[fatia].div;   /* DIV, CTR, CC, TOP são contíguos. */
+    b[2] = 4;
+    b[3] = ctrl_pwm;
+
+    uint32_t ticks = (uint32_t)dur_ms * (TICK_HZ / 1000u);
+    b = seq->blocos[2 * i + 1];
+    b[0] = (uint32_t)(uintptr_t)&lixo_origem;
+    b[1] = (uint32_t)(uintptr_t)&lixo_destino;
+    b[2] = ticks ? ticks : 1u;
+    b[3] = ctrl_espera;
+}
+
+/**
+ * @brief Fecha a lista: bloco de silêncio (gera a IRQ de fim) e gatilho nulo.
+ */
+static void fechar_seq(buzzer_seq_t *seq)
+{
+    uint32_t *b = seq->blocos[2 * seq->n];
+    b[0] = (uint32_t)(uintptr_t)regs_silencio;
+    b[1] = (uint32_t)(uintptr_t)&pwm_hw->slice[fatia].div;
+    b[2] = 4;
+    b[3] = ctrl_fim;
+
+    b = seq->blocos[2 * seq->n + 1];
+    b[0] = b[1] = b[2] = b[3] = 0;          /* CTRL_TRIG = 0: gatilho nulo, a cadeia para. */
+}
+
+bool buzzer_seq_compilar(buzzer_seq_t *seq, const buzzer_evento_t *eventos, uint32_t n, bool repetir)
+{
+    if (n > BUZZER_MAX_EVENTOS) {
+        return false;
+    }
+    seq->n = n;
+    seq->repetir = repetir;
+    for (uint32_t i = 0; i < n; i++) {
+        montar_evento(seq, i, eventos[i].nota, eventos[i].dur_ms, eventos[i].volume);
+    }
+    fechar_seq(seq);
+    return true;
+}
+
+bool buzzer_seq_arpejo(buzzer_seq_t *seq, const buzzer_nota_t *acorde, uint32_t n_notas,
+                       uint16_t passo_ms, uint16_t dur_ms, uint8_t volume)
+{
+    uint32_t passos = (dur_ms + passo_ms - 1u) / passo_ms;
+    if (n_notas == 0 || passo_ms == 0 || seq->n + passos > BUZZER_MAX_EVENTOS) {
+        return false;
+    }
+    for (uint32_t k = 0; k < passos; k++) {
+        montar_evento(seq, seq->n++, acorde[k % n_notas], passo_ms, volume);
+    }
+    fechar_seq(seq);
+    return true;
+}
+
+void buzzer_tocar_melodia(const buzzer_seq_t *seq)
+{
+    critical_section_enter_blocking(&cs);
+    if (modo == TOCANDO_ALARME) {
+        melodia = seq;
+        melodia_bloco = 0;                  /* Começa quando o alarme terminar. */
+    } else {
+        parar_canais();
+        melodia = seq;
+        modo = TOCANDO_MELODIA;
+        iniciar(seq, 0);
+    }
+    critical_section_exit(&cs);
+}
+
+void buzzer_tocar_alarme(const buzzer_seq_t *seq)
+{
+    critical_section_enter_blocking(&cs);
+    if (modo == TOCANDO_MELODIA) {
+        dma_channel_abort(canal_ctrl);      /* Congela o ponteiro antes de ler a posição. */
+        melodia_bloco = bloco_atual(melodia);
+    }
+    parar_canais();
+    alarme = seq;
+    modo = TOCANDO_ALARME;
+    iniciar(seq, 0);
+    critical_section_exit(&cs);
+}
+
+void buzzer_parar_alarme(void)
+{
+    critical_section_enter_blocking(&cs);
+    if (modo == TOCANDO_ALARME) {
+        parar_canais();
+        if (melodia_bloco >= 0) {
+            modo = TOCANDO_MELODIA;
+            iniciar(melodia, (uint32_t)melodia_bloco);
+            melodia_bloco = -1;
+        } else {
+            modo = PARADO;
+        }
+    }
+    critical_section_exit(&cs);
+}
+
+void buzzer_parar(void)
+{
+    critical_section_enter_blocking(&cs);
+    parar_canais();
+    melodia_bloco = -1;
+    modo = PARADO;
+    critical_section_exit(&cs);
+}
+
+bool buzzer_tocando(void)
+{
+    return modo != PARADO;
+}
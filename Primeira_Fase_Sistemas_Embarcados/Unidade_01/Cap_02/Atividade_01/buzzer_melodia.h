@@ -0,0 +1,128 @@
+/**
+ * @file   buzzer_melodia.h
+ * @brief  Motor de melodias do buzzer: PWM + DMA, sem CPU durante a reprodução.
+ *
+ * ──────────────────────────────────────────────────────────────────────────
+ * • Tabela de notas em tempo de compilação
+ *   ─ Cada nota da tabela (X-macro `BUZZER_NOTAS`) vira um par divisor/TOP do PWM
+ *     calculado por expressões constantes a partir de `SYS_CLK_HZ`. Nada de
+ *     float em tempo de execução: tocar uma nota é copiar 4 registradores.
+ *
+ * • Reprodução por DMA ("blocos de controle")
+ *   ─ Uma sequência (nota, duração, volume) é compilada uma vez numa lista de
+ *     blocos. O canal de controle copia cada bloco para os registradores do
+ *     canal de dados, que executa:
+ *        1) escrita de DIV/CTR/CC/TOP na fatia do PWM (muda nota e volume);
+ *        2) N transferências "vazias" cadenciadas por um timer de DMA a 4 kHz
+ *           (a duração da nota, em passos de 0,25 ms).
+ *     O canal de dados encadeia de volta no de controle. No fim da lista, um
+ *     bloco silencia o buzzer (a única interrupção da sequência) e um gatilho
+ *     nulo encerra a cadeia.
+ *
+ *       blocos ──canal ctrl──▶ regs do canal dados ──▶ PWM (nota) / espera (timer)
+ *                   ▲                                           │
+ *                   └───────────────── chain ───────────────────┘
+ *
+ * • Arpejos: acordes soam "polifônicos" alternando as notas em passos curtos
+ *   (`buzzer_seq_arpejo`).
+ *
+ * • Alarmes prioritários: `buzzer_tocar_alarme` interrompe a melodia na nota
+ *   em que está; ao fim do alarme (ou em `buzzer_parar_alarme`) a melodia
+ *   continua daquela nota. Um alarme com `repetir` toca em laço até ser parado.
+ *
+ * Histórico
+ * ─────────
+ *  29-abr-2025 – Manoel F. C. Furtado
+ */
+#ifndef BUZZER_MELODIA_H
+#define BUZZER_MELODIA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Frequência de cada nota em centésimos de Hz (temperamento igual, A4 = 440 Hz). */
+#define BUZZER_NOTAS(X) \
+    X(C4, 26163)   X(CS4, 27718)  X(D4, 29366)   X(DS4, 31113)  \
+    X(E4, 32963)   X(F4, 34923)   X(FS4, 36999)  X(G4, 39200)   \
+    X(GS4, 41530)  X(A4, 44000)   X(AS4, 46616)  X(B4, 49388)   \
+    X(C5, 52325)   X(CS5, 55437)  X(D5, 58733)   X(DS5, 62225)  \
+    X(E5, 65926)   X(F5, 69846)   X(FS5, 73999)  X(G5, 78399)   \
+    X(GS5, 83061)  X(A5, 88000)   X(AS5, 93233)  X(B5, 98777)   \
+    X(C6, 104650)  X(CS6, 110873) X(D6, 117466)  X(DS6, 124451) \
+    X(E6, 131851)  X(F6, 139691)  X(FS6, 147998) X(G6, 156798)  \
+    X(GS6, 166122) X(A6, 176000)  X(AS6, 186466) X(B6, 197553)  \
+    X(C7, 209300)  X(BIP_1K, 100000) X(BIP_2K, 200000)
+
+#define BUZZER_ENUM_NOTA(nome, fc) NOTA_##nome,
+/** Índice na tabela de notas; `NOTA_PAUSA` é silêncio. */
+typedef enum {
+    BUZZER_NOTAS(BUZZER_ENUM_NOTA)
+    NOTA_PAUSA
+} buzzer_nota_t;
+#undef BUZZER_ENUM_NOTA
+
+#define BUZZER_MAX_EVENTOS 96   /**< Notas por sequência (arpejos consomem várias). */
+
+/** Uma nota da sequência. */
+typedef struct {
+    buzzer_nota_t nota;
+    uint16_t dur_ms;            /**< Duração (até 16 s). */
+    uint8_t  volume;            /**< 0 a 100 (% do duty máximo de 50 %). */
+} buzzer_evento_t;
+
+/** Sequência já compilada em registradores e blocos de controle do DMA. */
+typedef struct {
+    uint32_t regs[BUZZER_MAX_EVENTOS][4];             /**< DIV, CTR, CC, TOP de cada nota. */
+    uint32_t blocos[2 * BUZZER_MAX_EVENTOS + 2][4];   /**< Blocos para o canal de dados. */
+    uint32_t n;                                       /**< Notas na sequência. */
+    bool repetir;                                     /**< Reinicia ao terminar (alarmes). */
+} buzzer_seq_t;
+
+/**
+ * @brief Configura o PWM do pino, o timer de DMA e os dois canais de DMA.
+ * @note  A IRQ do DMA fica no núcleo que chama esta função; as demais podem ser
+ *        chamadas de qualquer núcleo.
+ * @param pino Pino do buzzer (função PWM).
+ */
+void buzzer_init(uint32_t pino);
+
+/**
+ * @brief Compila uma lista de eventos numa sequência (zera a anterior).
+ * @note  Requer `buzzer_init()` antes: os blocos embutem os canais de DMA e a fatia do PWM.
+ * @return `false` se não couber em BUZZER_MAX_EVENTOS.
+ */
+bool buzzer_seq_compilar(buzzer_seq_t *seq, const buzzer_evento_t *eventos, uint32_t n, bool repetir);
+
+/**
+ * @brief Acrescenta à sequência um arpejo: as notas do acorde alternadas a cada
+ *        `passo_ms` até completar `dur_ms`.
+ * @return `false` se não couber.
+ */
+bool buzzer_seq_arpejo(buzzer_seq_t *seq, const buzzer_nota_t *acorde, uint32_t n_notas,
+                       uint16_t passo_ms, uint16_t dur_ms, uint8_t volume);
+
+/**
+ * @brief Toca uma melodia (substitui a atual). Se houver alarme tocando, ela começa
+ *        quando o alarme terminar.
+ */
+void buzzer_tocar_melodia(const buzzer_seq_t *seq);
+
+/**
+ * @brief Interrompe a melodia (se houver) e toca o alarme imediatamente.
+ */
+void buzzer_tocar_alarme(const buzzer_seq_t *seq);
+
+/**
+ * @brief Para o alarme; a melodia interrompida continua da nota em que parou.
+ */
+void buzzer_parar_alarme(void);
+
+/**
+ * @brief Para tudo e silencia o buzzer.
+ */
+void buzzer_parar(void);
+
+/** @brief Indica se alguma sequência está tocando. */
+bool buzzer_tocando(void);
+
+#endif /* BUZZER_MELODIA_H */
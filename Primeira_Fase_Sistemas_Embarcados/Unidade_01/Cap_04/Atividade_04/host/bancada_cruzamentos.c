@@ -0,0 +1,143 @@
+/**
+ * @file bancada_cruzamentos.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Bancada no Linux do controlador de cruzamentos (src/cruzamento.c sobre src/roda_tempo.c).
+ *
+ * @details
+ * Para N = 1 .. 4096 cruzamentos numa avenida (onda verde a 50 km/h, 250 m entre eles),
+ * simula uma hora de ticks com pedidos de pedestre aleatórios e mede o tempo de CPU por
+ * tick e por troca de fase. Para comparar, roda também a abordagem de varredura (um
+ * contador por cruzamento decrementado a cada tick, como o timer_cb de Atividade_04).
+ *
+ * Também confere a coordenação: toda entrada na fase 0 tem de cair em t ≡ defasagem
+ * (mod ciclo). O código de saída é 1 se alguma não cair.
+ *
+ * @code
+ *   cmake -S host -B build_host && cmake --build build_host && ./build_host/bancada_cruzamentos
+ * @endcode
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cruzamento.h"
+
+#define N_MAX          4096u
+#define DISTANCIA_M    250u
+#define VELOCIDADE_KMH 50u
+#define HORA           CRUZAMENTO_S(3600u)
+#define PEDIDOS_POR_MIN 1u     ///< Por cruzamento, em média.
+
+static const fase_t fases[] = {
+    { { COR_VERDE,    COR_VERMELHO, COR_VERMELHO }, 0, CRUZAMENTO_S(30) },
+    { { COR_AMARELO,  COR_VERMELHO, COR_VERMELHO }, 0, CRUZAMENTO_S(3) },
+    { { COR_VERMELHO, COR_VERMELHO, COR_VERMELHO }, 0, CRUZAMENTO_S(1) },
+    { { COR_VERMELHO, COR_VERMELHO, COR_VERDE },    1, CRUZAMENTO_S(7) },
+    { { COR_VERMELHO, COR_VERMELHO, COR_AMARELO },  1, CRUZAMENTO_S(5) },
+    { { COR_VERMELHO, COR_VERDE,    COR_VERMELHO }, 0, CRUZAMENTO_S(15) },
+    { { COR_VERMELHO, COR_AMARELO,  COR_VERMELHO }, 0, CRUZAMENTO_S(3) },
+    { { COR_VERMELHO, COR_VERMELHO, COR_VERMELHO }, 0, CRUZAMENTO_S(1) },
+};
+static plano_t plano = { fases, sizeof(fases) / sizeof(fases[0]), 0 };
+
+static cruzamento_t cruz[N_MAX];
+static roda_t roda;
+static uint32_t fora_de_sincronia;
+static uint32_t sumidouro;
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void conferir(uint16_t id, const uint8_t cor[GRUPOS]) {
+    const cruzamento_t *c = &cruz[id];
+    sumidouro += cor[GRUPO_PRINCIPAL];
+    // Chamado ao entrar numa fase: se for a 0, ela começou agora (= roda.agora).
+    if (c->fase == 0 && c->trocas > 0 &&
+        (roda.agora % plano.ciclo + plano.ciclo - c->defasagem) % plano.ciclo != 0) {
+        fora_de_sincronia++;
+    }
+}
+
+/** @brief Roda N cruzamentos por uma hora na roda; devolve ns por tick. */
+static double com_roda(uint32_t n, uint32_t *trocas, uint32_t *espera_max) {
+    srand(1);
+    roda_iniciar(&roda, 12345u);   // Começa fora do zero para exercitar a sincronização.
+    for (uint32_t i = 0; i < n; i++) {
+        cruzamento_iniciar(&cruz[i], (uint16_t)i, &roda, &plano,
+                           cruzamento_onda_verde(i * DISTANCIA_M, VELOCIDADE_KMH));
+    }
+    uint32_t limiar = (uint32_t)((uint64_t)RAND_MAX * PEDIDOS_POR_MIN / CRUZAMENTO_S(60u));
+
+    double t0 = agora_ns();
+    for (uint32_t t = 0; t < HORA; t++) {
+        // Um sorteio por tick para toda a avenida: o custo não cresce com N.
+        if ((uint32_t)rand() < limiar * n) {
+            cruzamento_pedir(&cruz[rand() % n], roda.agora);
+        }
+        roda_avancar(&roda, roda.agora + 1u);
+    }
+    double ns = (agora_ns() - t0) / HORA;
+
+    *trocas = 0;
+    *espera_max = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        *trocas += cruz[i].trocas;
+        if (cruz[i].espera_max > *espera_max) *espera_max = cruz[i].espera_max;
+        roda_cancelar(&roda, &cruz[i].no);
+    }
+    return ns;
+}
+
+/** @brief Mesma carga com um contador por cruzamento varrido a cada tick. */
+static double com_varredura(uint32_t n) {
+    static uint32_t restante[N_MAX];
+    static uint8_t fase[N_MAX];
+    for (uint32_t i = 0; i < n; i++) {
+        restante[i] = fases[0].duracao;
+        fase[i] = 0;
+    }
+    double t0 = agora_ns();
+    for (uint32_t t = 0; t < HORA; t++) {
+        for (uint32_t i = 0; i < n; i++) {
+            if (--restante[i] == 0) {
+                fase[i] = (uint8_t)((fase[i] + 1u) % plano.n_fases);
+                restante[i] = fases[fase[i]].duracao;
+                sumidouro += fases[fase[i]].cor[GRUPO_PRINCIPAL];
+            }
+        }
+    }
+    return (agora_ns() - t0) / HORA;
+}
+
+int main(void) {
+    if (!cruzamento_plano_validar(&plano)) {
+        fprintf(stderr, "plano inválido\n");
+        return 1;
+    }
+    cruzamento_definir_saida(conferir);
+
+    printf("ciclo %lu ticks (%lu s), 1 h = %lu ticks de %u ms\n\n", (unsigned long)plano.ciclo,
+           (unsigned long)(plano.ciclo * CRUZAMENTO_TICK_MS / 1000u), (unsigned long)HORA,
+           CRUZAMENTO_TICK_MS);
+    printf("%6s %12s %14s %12s %14s %12s %14s\n", "N", "trocas", "ns/troca", "ns/tick",
+           "cascatas/troca", "espera máx", "varredura/tick");
+
+    for (uint32_t n = 1; n <= N_MAX; n *= 4) {
+        uint32_t trocas, espera;
+        double ns_tick = com_roda(n, &trocas, &espera);   // roda_iniciar() zera os contadores
+        uint32_t vencidos = roda.vencidos;
+        uint32_t cascatas = roda.cascateados;
+        double ns_varre = com_varredura(n);
+        printf("%6lu %12lu %14.1f %12.1f %14.2f %10lu s %11.1f ns\n", (unsigned long)n,
+               (unsigned long)trocas, ns_tick * HORA / (vencidos ? vencidos : 1), ns_tick,
+               (double)cascatas / (vencidos ? vencidos : 1),
+               (unsigned long)(espera * CRUZAMENTO_TICK_MS / 1000u), ns_varre);
+    }
+
+    printf("\nentradas na fase 0 fora da defasagem: %lu\n", (unsigned long)fora_de_sincronia);
+    return fora_de_sincronia ? 1 : 0;
+}
@@ -0,0 +1,266 @@
+/**
+ * ************* Unidade 01 - cap.04 - Atividade 04 (vários cruzamentos) *************
+ * @file    Atividade_04_multi.c
+ * @brief   Controlador de N cruzamentos coordenados (onda verde) numa única Pico.
+ * @details Cada cruzamento segue a tabela de fases `fases_avenida` (cruzamento.h) e é
+ *          escalonado pela roda de temporização (roda_tempo.h): um único timer de 10 ms
+ *          avança a roda, e só os cruzamentos que trocam de fase naquele tick custam algo.
+ *
+ *        • Avenida com N_CRUZAMENTOS a DISTANCIA_M metros entre si; defasagens para uma
+ *          onda verde a VELOCIDADE_KMH na via principal. Ciclo comum de 65 s.
+ *        • Pedestres: fase exclusiva sob demanda (verde 7 s + piscante 5 s). Sem pedido,
+ *          o tempo vai para a transversal e o ciclo não muda (a coordenação se mantém).
+ *        • Botão A (GP5): pedido no cruzamento 0. Botão B (GP6): pedido no próximo
+ *          cruzamento da avenida, em rodízio.
+ *        • Cruzamento 0 na placa: LED RGB mostra a via principal (como Atividade_04) e o
+ *          buzzer bipa a 2 Hz durante o verde dos pedestres; OLED com fase e pedidos.
+ *        • A cada 5 s, pela USB: trocas de fase, travessias e o custo do tick (médio e
+ *          máximo), que deve ficar estável ao aumentar N_CRUZAMENTOS.
+ *
+ *       Hardware (igual a Atividade_04):
+ *            - LED RGB: GP11 (Verde), GP13 (Vermelho)
+ *            - Buzzer: GP10, GP21
+ *            - Botões: GP5, GP6 (INPUT_PULLUP)
+ *            - OLED: I2C1 SDA GP14, SCL GP15
+ *
+ * @author  Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "hardware/i2c.h"
+#include "ssd1306_i2c.h"
+#include "ssd1306.h"
+#include "ssd1306_font.h"
+#include "cruzamento.h"
+
+/*──────────────────────────── Avenida ────────────────────────────*/
+#ifndef N_CRUZAMENTOS
+#define N_CRUZAMENTOS      64     ///< -DN_CRUZAMENTOS=... no CMake para medir outros N.
+#endif
+#define DISTANCIA_M        250
+#define VELOCIDADE_KMH     50
+
+#define RELATORIO_MS       5000
+#define DEBOUNCE_US        200000
+#define BIP_TICKS          (CRUZAMENTO_S(1) / 4)  ///< Meio período do bip de 2 Hz.
+
+/*──────────────────────────── GPIO (igual a Atividade_04) ────────────────────────────*/
+#define LED_RED_PIN        13
+#define LED_GREEN_PIN      11
+#define BUZZER_PIN1        10
+#define BUZZER_PIN2        21
+#define BUTTON_PIN1         5
+#define BUTTON_PIN2         6
+#define I2C_SDA_PIN        14
+#define I2C_SCL_PIN        15
+
+/*──────────────────────────── Plano ────────────────────────────*/
+/** @brief Fases de cada cruzamento: principal, transversal, pedestres. */
+static const fase_t fases_avenida[] = {
+    { { COR_VERDE,    COR_VERMELHO, COR_VERMELHO }, 0, CRUZAMENTO_S(30) },  // coordenada
+    { { COR_AMARELO,  COR_VERMELHO, COR_VERMELHO }, 0, CRUZAMENTO_S(3) },
+    { { COR_VERMELHO, COR_VERMELHO, COR_VERMELHO }, 0, CRUZAMENTO_S(1) },
+    { { COR_VERMELHO, COR_VERMELHO, COR_VERDE },    1, CRUZAMENTO_S(7) },   // travessia
+    { { COR_VERMELHO, COR_VERMELHO, COR_AMARELO },  1, CRUZAMENTO_S(5) },   // piscante
+    { { COR_VERMELHO, COR_VERDE,    COR_VERMELHO }, 0, CRUZAMENTO_S(15) },
+    { { COR_VERMELHO, COR_AMARELO,  COR_VERMELHO }, 0, CRUZAMENTO_S(3) },
+    { { COR_VERMELHO, COR_VERMELHO, COR_VERMELHO }, 0, CRUZAMENTO_S(1) },
+};
+
+static plano_t plano_avenida = {
+    fases_avenida, sizeof(fases_avenida) / sizeof(fases_avenida[0]), 0
+};
+
+/*──────────────────────────── Estado ────────────────────────────*/
+static roda_t roda;
+static cruzamento_t cruz[N_CRUZAMENTOS];
+static roda_no_t bip;                      ///< Buzzer do cruzamento 0.
+static struct repeating_timer timer_tick;
+
+static volatile bool oled_sujo = true;
+static volatile uint32_t tick_max_us, tick_soma_us, tick_n;
+static uint32_t proximo_b = 1;             ///< Rodízio do botão B.
+
+static uint8_t           oled_buf[ssd1306_buffer_length];
+static struct render_area full_area;
+
+/*──────────────────────────── Saídas ────────────────────────────*/
+
+/** @brief Bip de 2 Hz enquanto os pedestres do cruzamento 0 estão no verde. */
+static void bip_cb(roda_no_t *no, void *ctx) {
+    (void)ctx;
+    bool nivel = !gpio_get(BUZZER_PIN1);
+    gpio_put(BUZZER_PIN1, nivel);
+    gpio_put(BUZZER_PIN2, nivel);
+    roda_agendar_em(&roda, no, BIP_TICKS);
+}
+
+/**
+ * @brief Callback de saída dos cruzamentos (roda no contexto do tick).
+ * @details Só o cruzamento 0 tem LEDs; os demais existem apenas na contagem.
+ */
+static void saida(uint16_t id, const uint8_t cor[GRUPOS]) {
+    if (id != 0) {
+        return;
+    }
+    uint8_t p = cor[GRUPO_PRINCIPAL];
+    gpio_put(LED_RED_PIN,   p == COR_VERMELHO || p == COR_AMARELO);
+    gpio_put(LED_GREEN_PIN, p == COR_VERDE || p == COR_AMARELO);
+
+    if (cor[GRUPO_PEDESTRE] == COR_VERDE) {
+        if (!roda_pendente(&bip)) {
+            roda_agendar_em(&roda, &bip, 1);
+        }
+    } else {
+        roda_cancelar(&roda, &bip);
+        gpio_put(BUZZER_PIN1, 0);
+        gpio_put(BUZZER_PIN2, 0);
+    }
+    oled_sujo = true;
+}
+
+static void oled_mostrar(void) {
+    static const char *const nomes[] = { "VERMELHO", "AMARELO", "VERDE" };
+    const cruzamento_t *c = &cruz[0];
+    const uint8_t *cor = plano_avenida.fases[c->fase].cor;
+    char linha[24];
+
+    memset(oled_buf, 0, sizeof(oled_buf));
+    snprintf(linha, sizeof(linha), "Cruz 0 de %u", N_CRUZAMENTOS);
+    ssd1306_draw_string(oled_buf, 0, 0, linha);
+    snprintf(linha, sizeof(linha), "Princ: %s", nomes[cor[GRUPO_PRINCIPAL]]);
+    ssd1306_draw_string(oled_buf, 0, 16, linha);
+    snprintf(linha, sizeof(linha), "Transv: %s", nomes[cor[GRUPO_TRANSVERSAL]]);
+    ssd1306_draw_string(oled_buf, 0, 28, linha);
+    snprintf(linha, sizeof(linha), "Pedestre: %s",
+             cor[GRUPO_PEDESTRE] == COR_VERDE ? "SIGA" :
+             cor[GRUPO_PEDESTRE] == COR_AMARELO ? "ACABANDO" : c->pedido ? "PEDIDO" : "PARE");
+    ssd1306_draw_string(oled_buf, 0, 40, linha);
+    render_on_display(oled_buf, &full_area);
+}
+
+/*──────────────────────────── Tick e botões ────────────────────────────*/
+
+/** @brief Tick de 10 ms: avança a roda até o tick atual (recupera ticks atrasados). */
+static bool tick_cb(struct repeating_timer *t) {
+    (void)t;
+    uint32_t ini = time_us_32();
+    roda_avancar(&roda, (uint32_t)(time_us_64() / (CRUZAMENTO_TICK_MS * 1000u)));
+    uint32_t dur = time_us_32() - ini;
+    if (dur > tick_max_us) tick_max_us = dur;
+    tick_soma_us += dur;
+    tick_n++;
+    return true;
+}
+
+/** @brief Botões de travessia: só marcam o pedido (cruzamento_pedir é seguro em IRQ). */
+static void button_irq(uint gpio, uint32_t events) {
+    (void)events;
+    static uint64_t ultimo[2];
+    int b = gpio == BUTTON_PIN1 ? 0 : 1;
+    uint64_t agora = time_us_64();
+    if (agora - ultimo[b] < DEBOUNCE_US) {
+        return;
+    }
+    ultimo[b] = agora;
+
+    if (b == 0) {
+        cruzamento_pedir(&cruz[0], roda.agora);
+    } else {
+        cruzamento_pedir(&cruz[proximo_b], roda.agora);
+        proximo_b = (proximo_b + 1u) % N_CRUZAMENTOS;
+    }
+    oled_sujo = true;
+}
+
+/*──────────────────────────── Inicialização ────────────────────────────*/
+
+static void hw_init(void) {
+    stdio_init_all();
+
+    gpio_init(LED_RED_PIN);   gpio_set_dir(LED_RED_PIN,   GPIO_OUT);
+    gpio_init(LED_GREEN_PIN); gpio_set_dir(LED_GREEN_PIN, GPIO_OUT);
+    gpio_init(BUZZER_PIN1);   gpio_set_dir(BUZZER_PIN1,  GPIO_OUT);
+    gpio_init(BUZZER_PIN2);   gpio_set_dir(BUZZER_PIN2,  GPIO_OUT);
+    gpio_put(BUZZER_PIN1, 0);
+    gpio_put(BUZZER_PIN2, 0);
+
+    gpio_init(BUTTON_PIN1);   gpio_set_dir(BUTTON_PIN1, GPIO_IN);
+    gpio_pull_up(BUTTON_PIN1);
+    gpio_init(BUTTON_PIN2);   gpio_set_dir(BUTTON_PIN2, GPIO_IN);
+    gpio_pull_up(BUTTON_PIN2);
+
+    i2c_init(i2c1, ssd1306_i2c_clock * 1000);
+    gpio_set_function(I2C_SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(I2C_SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(I2C_SDA_PIN);
+    gpio_pull_up(I2C_SCL_PIN);
+
+    full_area.start_column = 0;
+    full_area.end_column   = ssd1306_width - 1;
+    full_area.start_page   = 0;
+    full_area.end_page     = ssd1306_n_pages - 1;
+    calculate_render_area_buffer_length(&full_area);
+    ssd1306_init();
+}
+
+int main(void) {
+    hw_init();
+
+    if (!cruzamento_plano_validar(&plano_avenida)) {
+        panic("plano da avenida inválido");
+    }
+
+    // Roda e cruzamentos montados antes de ligar o tick e os botões.
+    roda_iniciar(&roda, (uint32_t)(time_us_64() / (CRUZAMENTO_TICK_MS * 1000u)));
+    roda_no_iniciar(&bip, bip_cb, NULL);
+    cruzamento_definir_saida(saida);
+    for (uint32_t i = 0; i < N_CRUZAMENTOS; i++) {
+        cruzamento_iniciar(&cruz[i], (uint16_t)i, &roda, &plano_avenida,
+                           cruzamento_onda_verde(i * DISTANCIA_M, VELOCIDADE_KMH));
+    }
+
+    add_repeating_timer_ms(-(int32_t)CRUZAMENTO_TICK_MS, tick_cb, NULL, &timer_tick);
+    gpio_set_irq_enabled_with_callback(BUTTON_PIN1, GPIO_IRQ_EDGE_FALL, true, &button_irq);
+    gpio_set_irq_enabled(BUTTON_PIN2, GPIO_IRQ_EDGE_FALL, true);
+
+    uint32_t ultimo_relatorio = to_ms_since_boot(get_absolute_time());
+    while (true) {
+        // OLED fora das IRQs: uma tela leva ~25 ms no I2C.
+        if (oled_sujo) {
+            oled_sujo = false;
+            oled_mostrar();
+        }
+
+        uint32_t agora = to_ms_since_boot(get_absolute_time());
+        if (agora - ultimo_relatorio >= RELATORIO_MS) {
+            ultimo_relatorio = agora;
+
+            // Snapshot consistente das estatísticas escritas pelo tick.
+            uint32_t estado = save_and_disable_interrupts();
+            uint32_t max_us = tick_max_us, soma = tick_soma_us, n = tick_n;
+            uint32_t trocas = roda.vencidos, pendentes = roda.pendentes;
+            tick_max_us = tick_soma_us = tick_n = 0;
+            restore_interrupts(estado);
+
+            uint32_t travessias = 0, espera_max = 0;
+            for (uint32_t i = 0; i < N_CRUZAMENTOS; i++) {
+                travessias += cruz[i].travessias;
+                if (cruz[i].espera_max > espera_max) espera_max = cruz[i].espera_max;
+            }
+            printf("N=%u | vencidos %lu | pendentes %lu | travessias %lu (espera máx %lu s) | "
+                   "tick médio %lu us, máx %lu us\n",
+                   N_CRUZAMENTOS, (unsigned long)trocas, (unsigned long)pendentes,
+                   (unsigned long)travessias,
+                   (unsigned long)(espera_max * CRUZAMENTO_TICK_MS / 1000u),
+                   (unsigned long)(n ? soma / n : 0), (unsigned long)max_us);
+        }
+        __wfi();
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * @file cruzamento.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Cruzamentos semafóricos dirigidos por tabela de fases (cruzamento.h).
+ */
+
+#include "cruzamento.h"
+#include <stddef.h>
+
+static cruzamento_saida_t saida;
+
+static void publicar(const cruzamento_t *c) {
+    if (saida) {
+        saida(c->id, c->plano->fases[c->fase].cor);
+    }
+}
+
+/** A fase `k` pode acontecer agora? Numa travessia, as fases sob demanda seguidas valem juntas. */
+static bool servida(const cruzamento_t *c, uint8_t k) {
+    return !c->plano->fases[k].sob_demanda || c->pedido || c->atendendo;
+}
+
+/** Fim de fase: passa para a próxima servida; as puladas cedem o tempo a ela. */
+static void fim_de_fase(roda_no_t *no, void *ctx) {
+    (void)no;
+    cruzamento_t *c = ctx;
+    const plano_t *p = c->plano;
+    uint8_t k = c->fase;
+    uint32_t duracao = 0;
+
+    // No máximo n_fases passos: a fase 0 nunca é pulada.
+    do {
+        k = (uint8_t)((k + 1u) % p->n_fases);
+        duracao += p->fases[k].duracao;
+    } while (!servida(c, k));
+
+    if (!p->fases[k].sob_demanda) {
+        c->atendendo = 0;
+    } else if (!c->atendendo) {
+        int32_t espera = (int32_t)(c->fim - c->pedido_tick);
+        if (espera > 0 && (uint32_t)espera > c->espera_max) {
+            c->espera_max = (uint32_t)espera;
+        }
+        c->atendendo = 1;
+        c->pedido = 0;
+        c->travessias++;
+    }
+
+    c->fase = k;
+    c->fim += duracao;
+    c->trocas++;
+    roda_agendar(c->roda, &c->no, c->fim);
+    publicar(c);
+}
+
+bool cruzamento_plano_validar(plano_t *plano) {
+    if (plano->fases == NULL || plano->n_fases == 0 || plano->fases[0].sob_demanda) {
+        return false;
+    }
+    uint32_t ciclo = 0;
+    for (uint8_t i = 0; i < plano->n_fases; i++) {
+        if (plano->fases[i].duracao == 0) {
+            return false;
+        }
+        ciclo += plano->fases[i].duracao;
+    }
+    plano->ciclo = ciclo;
+    return true;
+}
+
+void cruzamento_definir_saida(cruzamento_saida_t s) {
+    saida = s;
+}
+
+void cruzamento_iniciar(cruzamento_t *c, uint16_t id, roda_t *roda, const plano_t *plano,
+                        uint32_t defasagem) {
+    uint32_t agora = roda->agora;
+    uint32_t ciclo = plano->ciclo;
+
+    c->roda = roda;
+    c->plano = plano;
+    c->defasagem = defasagem % ciclo;
+    c->id = id;
+    c->pedido = 0;
+    c->atendendo = 0;
+    c->trocas = c->travessias = c->espera_max = 0;
+    roda_no_iniciar(&c->no, fim_de_fase, c);
+
+    // Posição no ciclo comum e fase correspondente.
+    uint32_t pos = (agora % ciclo + ciclo - c->defasagem) % ciclo;
+    uint32_t inicio = 0;
+    uint8_t k = 0;
+    while (pos >= inicio + plano->fases[k].duracao) {
+        inicio += plano->fases[k].duracao;
+        k++;
+    }
+    c->fase = k;
+    c->fim = agora - pos + inicio + plano->fases[k].duracao;
+
+    // Sem pedido, uma fase sob demanda cede o tempo à seguinte.
+    while (plano->fases[c->fase].sob_demanda) {
+        c->fase = (uint8_t)((c->fase + 1u) % plano->n_fases);
+        c->fim += plano->fases[c->fase].duracao;
+    }
+
+    roda_agendar(roda, &c->no, c->fim);
+    publicar(c);
+}
+
+void cruzamento_pedir(cruzamento_t *c, uint32_t agora) {
+    if (!c->pedido) {
+        c->pedido_tick = agora;
+        c->pedido = 1;
+    }
+}
+
+uint32_t cruzamento_onda_verde(uint32_t distancia_m, uint32_t velocidade_kmh) {
+    // t = d / v; v em m/ms = km/h / 3600.
+    return (uint32_t)((uint64_t)distancia_m * 3600u / (velocidade_kmh * CRUZAMENTO_TICK_MS));
+}
@@ -0,0 +1,119 @@
+/**
+ * @file cruzamento.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief N cruzamentos semafóricos descritos por tabelas de fases e escalonados pela
+ *        roda de temporização (roda_tempo.h).
+ *
+ * @details
+ * Cada cruzamento tem três grupos focais (via principal, via transversal e pedestres) e
+ * segue um plano: a lista de fases, com as cores de cada grupo e a duração. Todos os
+ * cruzamentos de um plano têm o mesmo ciclo; a defasagem de cada um diz em que instante
+ * do ciclo comum começa a sua fase 0 (verde da principal). Com defasagem = distância /
+ * velocidade, quem sai no verde de um cruzamento chega no verde do seguinte (onda verde).
+ *
+ * Fases marcadas `sob_demanda` (travessia de pedestres) só acontecem se houve pedido
+ * desde a última vez; senão são puladas e o tempo delas vai para a fase seguinte, de modo
+ * que o ciclo, e portanto a coordenação, não muda. A fase 0 não pode ser sob demanda.
+ *
+ * Cada cruzamento usa um único nó da roda, reagendado no fim de cada fase: o custo por
+ * troca de fase é O(1) e não cresce com o número de cruzamentos.
+ *
+ * O módulo não usa o pico-sdk: as cores saem por um callback (cruzamento_saida_t).
+ */
+
+#ifndef CRUZAMENTO_H
+#define CRUZAMENTO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "roda_tempo.h"
+
+#define CRUZAMENTO_TICK_MS      10u                            ///< Período do tick da roda.
+#define CRUZAMENTO_S(seg)       ((seg) * 1000u / CRUZAMENTO_TICK_MS)   ///< Segundos -> ticks.
+
+/** @brief Cor de um grupo focal (pedestre: vermelho, verde ou vermelho piscante). */
+typedef enum {
+    COR_VERMELHO = 0,
+    COR_AMARELO,          ///< Pedestres: vermelho piscante (fim da travessia).
+    COR_VERDE,
+} cor_t;
+
+/** @brief Grupos focais de um cruzamento. */
+typedef enum {
+    GRUPO_PRINCIPAL = 0,
+    GRUPO_TRANSVERSAL,
+    GRUPO_PEDESTRE,
+    GRUPOS
+} grupo_t;
+
+/** @brief Uma linha da tabela de fases. */
+typedef struct {
+    uint8_t cor[GRUPOS];     ///< cor_t de cada grupo.
+    uint8_t sob_demanda;     ///< 1: só com pedido de pedestre.
+    uint32_t duracao;        ///< Ticks.
+} fase_t;
+
+/** @brief Plano semafórico (tabela de fases). */
+typedef struct {
+    const fase_t *fases;
+    uint8_t n_fases;
+    uint32_t ciclo;          ///< Soma das durações; preenchido por cruzamento_plano_validar().
+} plano_t;
+
+/**
+ * @brief Recebe as cores sempre que um cruzamento troca de fase.
+ * @param id Identificador do cruzamento.
+ * @param cor Cores dos GRUPOS.
+ */
+typedef void (*cruzamento_saida_t)(uint16_t id, const uint8_t cor[GRUPOS]);
+
+/** @brief Estado de um cruzamento. */
+typedef struct {
+    roda_no_t no;            ///< Fim da fase atual.
+    roda_t *roda;
+    const plano_t *plano;
+    uint32_t defasagem;      ///< A fase 0 começa nos ticks t com t ≡ defasagem (mod ciclo).
+    uint32_t fim;            ///< Tick em que a fase atual termina.
+    uint32_t pedido_tick;    ///< Quando chegou o pedido pendente.
+    uint32_t trocas;         ///< Fases executadas.
+    uint32_t travessias;     ///< Fases sob demanda atendidas.
+    uint32_t espera_max;     ///< Maior espera pedido -> travessia (ticks).
+    uint16_t id;
+    uint8_t fase;
+    uint8_t atendendo;       ///< Dentro de um bloco de fases sob demanda.
+    volatile uint8_t pedido; ///< Pedido de pedestre ainda não atendido.
+} cruzamento_t;
+
+/**
+ * @brief Calcula o ciclo do plano e confere a tabela.
+ * @return false se o plano estiver vazio, tiver duração zero ou a fase 0 for sob demanda.
+ */
+bool cruzamento_plano_validar(plano_t *plano);
+
+/** @brief Define o callback de saída (comum a todos os cruzamentos). */
+void cruzamento_definir_saida(cruzamento_saida_t saida);
+
+/**
+ * @brief Põe o cruzamento em funcionamento já sincronizado com o ciclo comum.
+ * @details A fase inicial é a que corresponde a (agora - defasagem) mod ciclo, com o
+ *          tempo que falta dela; assim todos entram coordenados desde o primeiro tick.
+ */
+void cruzamento_iniciar(cruzamento_t *c, uint16_t id, roda_t *roda, const plano_t *plano,
+                        uint32_t defasagem);
+
+/**
+ * @brief Registra um pedido de travessia; atendido na próxima fase sob demanda.
+ * @details Só grava dois campos: pode ser chamada de uma IRQ de botão.
+ */
+void cruzamento_pedir(cruzamento_t *c, uint32_t agora);
+
+/**
+ * @brief Defasagem de uma onda verde.
+ * @param distancia_m Distância do cruzamento de referência.
+ * @param velocidade_kmh Velocidade de progressão da onda.
+ * @return Ticks.
+ */
+uint32_t cruzamento_onda_verde(uint32_t distancia_m, uint32_t velocidade_kmh);
+
+#endif // CRUZAMENTO_H
@@ -0,0 +1,128 @@
+/**
+ * @file roda_tempo.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Implementação da roda de temporização hierárquica (roda_tempo.h).
+ */
+
+#include "roda_tempo.h"
+#include <stddef.h>
+#include <string.h>
+
+#define MASCARA (RODA_SLOTS - 1u)
+
+static void ligar(roda_no_t **cabeca, roda_no_t *no) {
+    no->prox = *cabeca;
+    if (no->prox) {
+        no->prox->pprev = &no->prox;
+    }
+    no->pprev = cabeca;
+    *cabeca = no;
+}
+
+static void desligar(roda_no_t *no) {
+    *no->pprev = no->prox;
+    if (no->prox) {
+        no->prox->pprev = no->pprev;
+    }
+    no->prox = NULL;
+    no->pprev = NULL;
+}
+
+/** Coloca o nó no nível/posição de acordo com a distância até o vencimento (>= 0). */
+static void inserir(roda_t *r, roda_no_t *no) {
+    uint32_t falta = no->expira - r->agora;
+    uint32_t alvo = no->expira;
+    unsigned nivel;
+
+    if (falta < RODA_SLOTS) {
+        nivel = 0;
+    } else if (falta < RODA_SLOTS * RODA_SLOTS) {
+        nivel = 1;
+    } else {
+        nivel = 2;
+        if (falta >= RODA_ALCANCE) {
+            alvo = r->agora + RODA_ALCANCE - 1u;   // Volta a ser redistribuído depois.
+        }
+    }
+    ligar(&r->slots[nivel][(alvo >> (nivel * RODA_BITS)) & MASCARA], no);
+}
+
+/** Esvazia uma posição para uma lista local, mantendo `pprev` válido para cancelamentos. */
+static void soltar(roda_no_t **slot, roda_no_t **lista) {
+    *lista = *slot;
+    *slot = NULL;
+    if (*lista) {
+        (*lista)->pprev = lista;
+    }
+}
+
+static void cascatear(roda_t *r, unsigned nivel) {
+    roda_no_t *lista, *no;
+    soltar(&r->slots[nivel][(r->agora >> (nivel * RODA_BITS)) & MASCARA], &lista);
+    while ((no = lista) != NULL) {
+        desligar(no);
+        inserir(r, no);
+        r->cascateados++;
+    }
+}
+
+void roda_iniciar(roda_t *r, uint32_t agora) {
+    memset(r, 0, sizeof(*r));
+    r->agora = agora;
+}
+
+void roda_no_iniciar(roda_no_t *no, roda_cb_t cb, void *ctx) {
+    no->prox = NULL;
+    no->pprev = NULL;
+    no->expira = 0;
+    no->cb = cb;
+    no->ctx = ctx;
+}
+
+void roda_agendar(roda_t *r, roda_no_t *no, uint32_t expira) {
+    if (roda_pendente(no)) {
+        desligar(no);
+    } else {
+        r->pendentes++;
+    }
+    if ((int32_t)(expira - r->agora) <= 0) {
+        expira = r->agora + 1u;
+    }
+    no->expira = expira;
+    inserir(r, no);
+}
+
+void roda_cancelar(roda_t *r, roda_no_t *no) {
+    if (roda_pendente(no)) {
+        desligar(no);
+        r->pendentes--;
+    }
+}
+
+uint32_t roda_avancar(roda_t *r, uint32_t ate) {
+    uint32_t executados = 0;
+
+    while ((int32_t)(ate - r->agora) > 0) {
+        uint32_t t = ++r->agora;
+
+        // Começo de volta do nível 0: traz a próxima posição do 1 (e do 2, se ele também virou).
+        if ((t & MASCARA) == 0) {
+            if (((t >> RODA_BITS) & MASCARA) == 0) {
+                cascatear(r, 2);
+            }
+            cascatear(r, 1);
+        }
+
+        roda_no_t *lista, *no;
+        soltar(&r->slots[0][t & MASCARA], &lista);
+        while ((no = lista) != NULL) {
+            desligar(no);
+            r->pendentes--;
+            r->vencidos++;
+            executados++;
+            no->cb(no, no->ctx);
+        }
+    }
+    return executados;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file roda_tempo.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Roda de temporização hierárquica: milhares de temporizadores sobre um único tick.
+ *
+ * @details
+ * Três níveis de RODA_SLOTS posições. O nível 0 guarda o que vence nos próximos 64 ticks,
+ * uma lista por tick; o nível 1, o que vence nos próximos 64² ticks, uma lista a cada 64;
+ * o nível 2, até 64³ (262 144 ticks, ~43 min com tick de 10 ms). Quando o nível 0 dá uma
+ * volta, a posição seguinte do nível 1 é redistribuída ("cascata"); idem do 2 para o 1.
+ *
+ * - Agendar e cancelar: O(1), só mexem em ponteiros (lista com `pprev`, como a hlist do Linux).
+ * - Cada tick: O(1) mais o custo dos temporizadores que vencem nele; cada temporizador
+ *   cascateia no máximo duas vezes. O custo não depende de quantos estão pendentes.
+ * - Prazos além do alcance ficam na última posição do nível 2 e voltam a ser
+ *   redistribuídos a cada volta, até caberem.
+ *
+ * O nó fica dentro do objeto dono (sem alocação). Os ticks são uint32_t e podem dar a volta:
+ * as comparações usam a diferença com sinal.
+ *
+ * Não é reentrante: agendar, cancelar e avançar devem rodar no mesmo contexto (ou com as
+ * interrupções desligadas). Os callbacks podem agendar e cancelar qualquer nó, inclusive o
+ * próprio.
+ */
+
+#ifndef RODA_TEMPO_H
+#define RODA_TEMPO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define RODA_BITS     6
+#define RODA_SLOTS    (1u << RODA_BITS)              ///< 64 posições por nível.
+#define RODA_NIVEIS   3
+#define RODA_ALCANCE  (1u << (RODA_BITS * RODA_NIVEIS))  ///< Ticks cobertos sem recascata.
+
+typedef struct roda_no roda_no_t;
+
+/** @brief Chamado quando o nó vence; o nó já saiu da roda. */
+typedef void (*roda_cb_t)(roda_no_t *no, void *ctx);
+
+/** @brief Temporizador; fica embutido no objeto que o usa. */
+struct roda_no {
+    roda_no_t *prox;
+    roda_no_t **pprev;   ///< Endereço do ponteiro que aponta para este nó; NULL = fora da roda.
+    uint32_t expira;     ///< Tick de vencimento.
+    roda_cb_t cb;
+    void *ctx;
+};
+
+/** @brief A roda. */
+typedef struct {
+    roda_no_t *slots[RODA_NIVEIS][RODA_SLOTS];
+    uint32_t agora;          ///< Último tick processado.
+    uint32_t pendentes;      ///< Nós na roda.
+    uint32_t vencidos;       ///< Callbacks executados (acumulado).
+    uint32_t cascateados;    ///< Redistribuições entre níveis (acumulado).
+} roda_t;
+
+/** @brief Esvazia a roda e define o tick atual. */
+void roda_iniciar(roda_t *r, uint32_t agora);
+
+/** @brief Prepara um nó (fora da roda). */
+void roda_no_iniciar(roda_no_t *no, roda_cb_t cb, void *ctx);
+
+/**
+ * @brief Agenda (ou reagenda) o nó para o tick absoluto `expira`.
+ * @details Prazo já vencido ou igual ao tick atual vira o próximo tick.
+ */
+void roda_agendar(roda_t *r, roda_no_t *no, uint32_t expira);
+
+/** @brief Agenda o nó para daqui a `ticks` (mínimo 1). */
+static inline void roda_agendar_em(roda_t *r, roda_no_t *no, uint32_t ticks) {
+    roda_agendar(r, no, r->agora + ticks);
+}
+
+/** @brief Tira o nó da roda, se estiver nela. */
+void roda_cancelar(roda_t *r, roda_no_t *no);
+
+/** @brief true se o nó está agendado. */
+static inline bool roda_pendente(const roda_no_t *no) {
+    return no->pprev != 0;
+}
+
+/**
+ * @brief Processa todos os ticks até `ate` (inclusive), executando os callbacks vencidos.
+ * @return Callbacks executados nesta chamada.
+ */
+uint32_t roda_avancar(roda_t *r, uint32_t ate);
+
+#endif // RODA_TEMPO_H
@@ -0,0 +1,104 @@
+/**
+ * @file    Atividade_05_stream.c
+ * @brief   Modo streaming: amostras cruas do ADC em quadros binários pela USB‑CDC.
+ *
+ *          Variante da Atividade_05 para tirar dados brutos da placa em alta taxa
+ *          (até 500 kS/s em 8 bits ou algumas centenas de kS/s em 12 bits). O
+ *          protocolo de quadros está descrito em adc_stream.h; o receptor para
+ *          Linux está em tools/adc_stream_rx.py.
+ *
+ *          Comandos de texto recebidos pela CDC (uma linha, fim em '\n'):
+ *             start <8|12> [taxa_hz] [entrada]   → responde "OK <bits> <taxa_real> <entrada>"
+ *             stop                               → para e responde "STOP <capt> <env> <perd>"
+ *          Entrada 0‑3 = GPIO 26‑29, 4 = sensor de temperatura (padrão).
+ *
+ *          O `tud_task()` é chamado aqui no laço (tarefa de fundo do stdio_usb
+ *          desligada no CMake): com a chamada em laço apertado, cada pacote de 64 bytes
+ *          completado já libera o próximo, sem esperar o tick de 1 ms do fundo.
+ *
+ * @author  Manoel Furtado
+ * @date    18 mai 2025
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "tusb.h"
+
+#include "adc_stream.h"
+
+/* --------------------------- Parâmetros do sistema ------------------------- */
+#define CMD_LINE_MAX        40          /**< Tamanho máximo de uma linha de comando */
+#define DEFAULT_RATE_HZ     500000u     /**< Taxa padrão do comando start */
+#define DEFAULT_INPUT       4u          /**< Sensor de temperatura */
+
+/* --------------------------- Buffers e variáveis --------------------------- */
+static char   cmd_line[CMD_LINE_MAX + 1];   /**< Linha de comando em montagem */
+static size_t cmd_len;
+
+/**
+ * @brief Envia uma linha de texto (só fora do streaming, para não partir quadros).
+ */
+static void reply(const char *text)
+{
+    tud_cdc_write_str(text);
+    tud_cdc_write_flush();
+}
+
+/**
+ * @brief Interpreta uma linha de comando completa.
+ */
+static void run_command(char *line)
+{
+    char out[64];
+    unsigned bits = 0, rate = DEFAULT_RATE_HZ, input = DEFAULT_INPUT;
+
+    if (sscanf(line, "start %u %u %u", &bits, &rate, &input) >= 1 && (bits == 8 || bits == 12) && input <= 4) {
+        adc_stream_stop();
+        uint32_t actual = adc_stream_start(input, bits == 8 ? ADC_STREAM_FMT_8BIT : ADC_STREAM_FMT_12BIT, rate);
+        snprintf(out, sizeof(out), "OK %u %lu %u\n", bits, (unsigned long)actual, input);
+        reply(out);
+    } else if (strncmp(line, "stop", 4) == 0) {
+        adc_stream_stop();
+        adc_stream_stats_t s = adc_stream_stats();
+        snprintf(out, sizeof(out), "STOP %lu %lu %lu\n",
+                 (unsigned long)s.captured, (unsigned long)s.sent, (unsigned long)s.dropped);
+        reply(out);
+    } else if (!adc_stream_running()) {
+        reply("ERR comandos: start <8|12> [taxa_hz] [entrada] | stop\n");
+    }
+}
+
+/**
+ * @brief Consome os bytes recebidos e executa cada linha completa.
+ */
+static void read_commands(void)
+{
+    while (tud_cdc_available()) {
+        char c = (char)tud_cdc_read_char();
+        if (c == '\r' || c == '\n') {
+            if (cmd_len > 0) {
+                cmd_line[cmd_len] = '\0';
+                run_command(cmd_line);
+            }
+            cmd_len = 0;
+        } else if (cmd_len < CMD_LINE_MAX) {
+            cmd_line[cmd_len++] = c;
+        }
+    }
+}
+
+/* ------------------------------ Função main ------------------------------- */
+int main(void)
+{
+    stdio_init_all();    // USB‑CDC (tud_task() chamado no laço abaixo)
+    adc_stream_init();   // ADC + canais DMA + IRQ de fim de bloco
+
+    while (true)
+    {
+        tud_task();          /* Pilha USB: completa pacotes e libera o FIFO */
+        read_commands();     /* start/stop vindos do host */
+        adc_stream_poll();   /* Blocos prontos → quadros → FIFO da CDC */
+    }
+}
@@ -0,0 +1,301 @@
+/**
+ * @file    adc_stream.c
+ * @brief   Captura do ADC em anel de blocos por DMA e envio em quadros binários pela CDC.
+ *
+ *          Dois canais de DMA se encadeiam (A termina → B começa → A ...), cada um
+ *          gravando um bloco inteiro. Na interrupção de fim de bloco o canal que
+ *          acabou é reapontado para o próximo bloco livre, enquanto o outro já
+ *          captura: não há amostra perdida entre blocos. Sem bloco livre (USB
+ *          atrasada), o canal grava num bloco de descarte e a perda fica visível
+ *          pelo salto em `seq`.
+ *
+ * @author  Manoel Furtado
+ * @date    18 mai 2025
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ */
+
+#include "adc_stream.h"
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "tusb.h"
+
+/* --------------------------- Parâmetros internos --------------------------- */
+#define ADC_CLK_HZ        48000000u  /**< clk_adc padrão */
+#define PAYLOAD_BYTES     (ADC_STREAM_FRAME_BYTES - ADC_STREAM_HDR_BYTES)  /**< 1008 */
+#define SAMPLES_8BIT      PAYLOAD_BYTES                /**< 1 byte por amostra */
+#define SAMPLES_12BIT     (PAYLOAD_BYTES * 2u / 3u)    /**< 2 amostras a cada 3 bytes: 672 */
+#define DISCARD           ADC_STREAM_N_BLOCKS          /**< Índice do bloco de descarte */
+#define USB_PACKET_BYTES  64u                          /**< Pacote bulk em full speed */
+
+/* ------------------------------- Buffers ----------------------------------- */
+/** Blocos crus como o DMA grava (8 bits: bytes; 12 bits: meias‑palavras). +1 = descarte. */
+static uint16_t raw[ADC_STREAM_N_BLOCKS + 1][SAMPLES_12BIT];
+static uint8_t  frame[ADC_STREAM_FRAME_BYTES];   /**< Quadro em envio */
+
+/* -------------------- Anel (produtor: IRQ; consumidor: poll) --------------- */
+static volatile uint8_t  ready_idx[ADC_STREAM_N_BLOCKS];   /**< Fila de blocos completos */
+static volatile uint32_t ready_seq[ADC_STREAM_N_BLOCKS];
+static volatile uint8_t  ready_flags[ADC_STREAM_N_BLOCKS];
+static volatile uint32_t ready_head, ready_count;
+static volatile uint8_t  free_idx[ADC_STREAM_N_BLOCKS];    /**< Pilha de blocos livres */
+static volatile uint32_t free_count;
+static volatile uint8_t  chan_block[2];                    /**< Bloco em gravação por canal */
+static volatile uint32_t seq_next;
+static volatile bool     lost_pending;                     /**< Perda a sinalizar no próximo quadro */
+
+/* ------------------------------- Estado ------------------------------------ */
+static int  dma_chan[2];
+static int  crc_chan;
+static uint8_t crc_sink;                  /**< Destino fixo do DMA de CRC */
+static adc_stream_fmt_t cur_fmt;
+static uint32_t block_samples, block_raw_bytes;
+static bool running;
+static uint32_t tx_pos = ADC_STREAM_FRAME_BYTES;   /**< Bytes do quadro já no FIFO (= tamanho: ocioso) */
+static volatile adc_stream_stats_t stats;
+
+/**
+ * @brief Reaponta um canal de captura para um bloco (sem disparar).
+ */
+static void arm_channel(uint32_t ch, uint8_t block)
+{
+    chan_block[ch] = block;
+    dma_channel_set_write_addr(dma_chan[ch], raw[block], false);
+    dma_channel_set_trans_count(dma_chan[ch], block_samples, false);
+}
+
+/**
+ * @brief Fim de bloco: enfileira o bloco gravado e prepara o canal para o próximo.
+ */
+static void adc_stream_dma_irq(void)
+{
+    for (uint32_t ch = 0; ch < 2; ch++) {
+        if (!dma_channel_get_irq0_status(dma_chan[ch])) continue;
+        dma_channel_acknowledge_irq0(dma_chan[ch]);
+
+        uint8_t done = chan_block[ch];
+        uint32_t seq = seq_next++;
+        stats.captured++;
+        if (done == DISCARD) {
+            stats.dropped++;
+            lost_pending = true;
+        } else {
+            uint32_t slot = (ready_head + ready_count) % ADC_STREAM_N_BLOCKS;
+            ready_idx[slot]   = done;
+            ready_seq[slot]   = seq;
+            ready_flags[slot] = lost_pending ? ADC_STREAM_FLAG_OVERFLOW : 0;
+            lost_pending = false;
+            ready_count++;
+        }
+        arm_channel(ch, free_count ? free_idx[--free_count] : DISCARD);
+    }
+}
+
+void adc_stream_init(void)
+{
+    adc_init();
+    adc_set_temp_sensor_enabled(true);
+
+    dma_chan[0] = dma_claim_unused_channel(true);
+    dma_chan[1] = dma_claim_unused_channel(true);
+    crc_chan    = dma_claim_unused_channel(true);
+
+    irq_add_shared_handler(DMA_IRQ_0, adc_stream_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+/**
+ * @brief Para o ADC e os canais, descartando o conteúdo do anel.
+ */
+static void stop_capture(void)
+{
+    adc_run(false);
+    for (uint32_t ch = 0; ch < 2; ch++) {
+        dma_channel_set_irq0_enabled(dma_chan[ch], false);
+    }
+    /* O abort de um canal pode disparar o encadeado: aborta os dois duas vezes */
+    for (int rep = 0; rep < 2; rep++) {
+        dma_channel_abort(dma_chan[0]);
+        dma_channel_abort(dma_chan[1]);
+    }
+    for (uint32_t ch = 0; ch < 2; ch++) {
+        dma_channel_acknowledge_irq0(dma_chan[ch]);
+    }
+    adc_fifo_drain();
+    running = false;
+}
+
+uint32_t adc_stream_start(uint32_t input, adc_stream_fmt_t fmt, uint32_t rate_hz)
+{
+    if (running) stop_capture();
+
+    cur_fmt = fmt;
+    block_samples   = (fmt == ADC_STREAM_FMT_8BIT) ? SAMPLES_8BIT : SAMPLES_12BIT;
+    block_raw_bytes = (fmt == ADC_STREAM_FMT_8BIT) ? block_samples : block_samples * 2u;
+
+    /* ADC: FIFO com DREQ a cada amostra; no modo 8 bits o FIFO já entrega o byte alto */
+    adc_select_input(input);
+    adc_fifo_setup(true, true, 1, false, fmt == ADC_STREAM_FMT_8BIT);
+
+    /* Divisor em 1/256: período = 1 + div ciclos de 48 MHz (mínimo 96 ciclos) */
+    if (rate_hz == 0 || rate_hz > ADC_STREAM_RATE_MAX) rate_hz = ADC_STREAM_RATE_MAX;
+    uint32_t div256 = (uint32_t)(((uint64_t)ADC_CLK_HZ * 256u + rate_hz / 2u) / rate_hz) - 256u;
+    if (div256 < 95u * 256u) div256 = 0;   /* Abaixo de 96 ciclos o ADC roda no máximo */
+    adc_set_clkdiv((float)div256 / 256.0f);
+    uint32_t actual = div256 ? (uint32_t)((uint64_t)ADC_CLK_HZ * 256u / (div256 + 256u)) : ADC_STREAM_RATE_MAX;
+
+    /* Anel: blocos 0 e 1 com os canais, demais livres */
+    ready_head = ready_count = 0;
+    free_count = 0;
+    for (uint8_t b = ADC_STREAM_N_BLOCKS; b-- > 2; ) {
+        free_idx[free_count++] = b;
+    }
+    seq_next = 0;
+    lost_pending = false;
+    memset((void *)&stats, 0, sizeof(stats));
+    tx_pos = ADC_STREAM_FRAME_BYTES;
+
+    /* Canais de captura: FIFO fixo → bloco, cada um encadeando no outro */
+    for (uint32_t ch = 0; ch < 2; ch++) {
+        dma_channel_config c = dma_channel_get_default_config(dma_chan[ch]);
+        channel_config_set_transfer_data_size(&c, fmt == ADC_STREAM_FMT_8BIT ? DMA_SIZE_8 : DMA_SIZE_16);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, true);
+        channel_config_set_dreq(&c, DREQ_ADC);
+        channel_config_set_chain_to(&c, dma_chan[ch ^ 1u]);
+        dma_channel_configure(dma_chan[ch], &c, raw[ch], &adc_hw->fifo, block_samples, false);
+        chan_block[ch] = (uint8_t)ch;
+        dma_channel_acknowledge_irq0(dma_chan[ch]);
+        dma_channel_set_irq0_enabled(dma_chan[ch], true);
+    }
+
+    running = true;
+    dma_channel_start(dma_chan[0]);
+    adc_run(true);
+    return actual;
+}
+
+void adc_stream_stop(void)
+{
+    if (running) stop_capture();
+    tx_pos = ADC_STREAM_FRAME_BYTES;
+}
+
+bool adc_stream_running(void)
+{
+    return running;
+}
+
+adc_stream_stats_t adc_stream_stats(void)
+{
+    uint32_t irq = save_and_disable_interrupts();
+    adc_stream_stats_t s = stats;
+    restore_interrupts(irq);
+    return s;
+}
+
+/**
+ * @brief CRC‑32 (zlib) de um bloco pelo sniffer do DMA: cópia memória → registrador fixo.
+ *
+ * CRC32R processa os bits de cada byte invertidos; com a saída também invertida
+ * (ordem dos bits e complemento) e semente 0xFFFFFFFF o resultado é o do zlib.
+ */
+static uint32_t block_crc32(const void *data, uint32_t len)
+{
+    dma_channel_config c = dma_channel_get_default_config(crc_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_sniff_enable(&c, true);
+
+    dma_sniffer_enable(crc_chan, DMA_SNIFF_CTRL_CALC_VALUE_CRC32R, true);
+    dma_sniffer_set_output_reverse_enabled(true);
+    dma_sniffer_set_output_invert_enabled(true);
+    dma_sniffer_set_data_accumulator(0xFFFFFFFFu);
+
+    dma_channel_configure(crc_chan, &c, &crc_sink, data, len, true);
+    dma_channel_wait_for_finish_blocking(crc_chan);   /* ~1 byte por ciclo: ~10 µs por bloco */
+    return dma_sniffer_get_data_accumulator();
+}
+
+/**
+ * @brief Monta o próximo quadro a partir do bloco mais antigo da fila.
+ * @return false se não houver bloco pronto.
+ */
+static bool build_frame(void)
+{
+    uint32_t irq = save_and_disable_interrupts();
+    if (ready_count == 0) {
+        restore_interrupts(irq);
+        return false;
+    }
+    uint8_t  b     = ready_idx[ready_head];
+    uint32_t seq   = ready_seq[ready_head];
+    uint8_t  flags = ready_flags[ready_head];
+    ready_head = (ready_head + 1) % ADC_STREAM_N_BLOCKS;
+    ready_count--;
+    restore_interrupts(irq);
+
+    uint32_t crc = block_crc32(raw[b], block_raw_bytes);
+
+    frame[0]  = (uint8_t)(ADC_STREAM_MAGIC & 0xFF);
+    frame[1]  = (uint8_t)(ADC_STREAM_MAGIC >> 8);
+    frame[2]  = (uint8_t)cur_fmt;
+    frame[3]  = flags;
+    frame[4]  = (uint8_t)seq;
+    frame[5]  = (uint8_t)(seq >> 8);
+    frame[6]  = (uint8_t)(seq >> 16);
+    frame[7]  = (uint8_t)(seq >> 24);
+    frame[8]  = (uint8_t)block_samples;
+    frame[9]  = (uint8_t)(block_samples >> 8);
+    frame[10] = (uint8_t)PAYLOAD_BYTES;
+    frame[11] = (uint8_t)(PAYLOAD_BYTES >> 8);
+    frame[12] = (uint8_t)crc;
+    frame[13] = (uint8_t)(crc >> 8);
+    frame[14] = (uint8_t)(crc >> 16);
+    frame[15] = (uint8_t)(crc >> 24);
+
+    uint8_t *out = &frame[ADC_STREAM_HDR_BYTES];
+    if (cur_fmt == ADC_STREAM_FMT_8BIT) {
+        memcpy(out, raw[b], PAYLOAD_BYTES);
+    } else {
+        const uint16_t *s = raw[b];
+        for (uint32_t i = 0; i < SAMPLES_12BIT; i += 2, out += 3) {
+            uint16_t a = s[i] & 0x0FFF, c = s[i + 1] & 0x0FFF;
+            out[0] = (uint8_t)a;
+            out[1] = (uint8_t)((a >> 8) | (c << 4));
+            out[2] = (uint8_t)(c >> 4);
+        }
+    }
+
+    /* Bloco copiado: devolve à pilha de livres */
+    irq = save_and_disable_interrupts();
+    free_idx[free_count++] = b;
+    restore_interrupts(irq);
+
+    tx_pos = 0;
+    return true;
+}
+
+void adc_stream_poll(void)
+{
+    if (!running || !tud_cdc_connected()) return;
+
+    for (;;) {
+        if (tx_pos >= ADC_STREAM_FRAME_BYTES && !build_frame()) return;
+
+        /* Só pacotes inteiros entram no FIFO: o TinyUSB envia o que houver nele ao
+         * fim de cada transferência, então nunca pode sobrar um pedaço de pacote. */
+        uint32_t room = tud_cdc_write_available() & ~(USB_PACKET_BYTES - 1u);
+        if (room == 0) return;   /* FIFO cheio: tud_task() esvazia e voltamos depois */
+
+        uint32_t len = ADC_STREAM_FRAME_BYTES - tx_pos;
+        if (len > room) len = room;
+        tx_pos += tud_cdc_write(&frame[tx_pos], len);
+        if (tx_pos >= ADC_STREAM_FRAME_BYTES) stats.sent++;
+    }
+}
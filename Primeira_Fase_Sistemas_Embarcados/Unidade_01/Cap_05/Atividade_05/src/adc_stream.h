@@ -0,0 +1,97 @@
+/**
+ * @file    adc_stream.h
+ * @brief   Streaming binário de blocos do ADC (capturados por DMA) pela USB‑CDC.
+ *
+ *          Em vez de `printf` de floats (limitado a poucos kHz e caro na newlib),
+ *          as amostras saem em quadros binários escritos direto no FIFO de TX do
+ *          TinyUSB:
+ *
+ *          @code
+ *            ADC (free‑running) ─DREQ─▶ 2 canais DMA em pingue‑pongue ─▶ anel de blocos
+ *                 ─▶ CRC‑32 pelo "sniffer" do DMA ─▶ quadro (cabeçalho + amostras)
+ *                 ─▶ tud_cdc_write() em pacotes cheios de 64 bytes
+ *          @endcode
+ *
+ *          Formato do quadro (little‑endian), sempre 1024 bytes = 16 pacotes USB cheios:
+ *          | offset | tamanho | campo                                                 |
+ *          |--------|---------|-------------------------------------------------------|
+ *          | 0      | 2       | magic 0x5341 ("AS")                                   |
+ *          | 2      | 1       | formato: 1 = 8 bits, 2 = 12 bits empacotados          |
+ *          | 3      | 1       | flags: bit 0 = blocos perdidos antes deste            |
+ *          | 4      | 4       | seq: número do bloco capturado (conta também perdidos)|
+ *          | 8      | 2       | amostras no bloco                                     |
+ *          | 10     | 2       | bytes de carga                                        |
+ *          | 12     | 4       | CRC‑32 (zlib) das amostras como saíram do ADC         |
+ *          | 16     | carga   | 8 bits: 1 byte/amostra; 12 bits: 2 amostras em 3 bytes|
+ *
+ *          No formato de 12 bits o CRC cobre as amostras em 16 bits little‑endian (o
+ *          que o DMA gravou), então o receptor valida depois de desempacotar.
+ *
+ *          Vazão necessária: 500 kS/s × 8 bits ≈ 508 kB/s; 400 kS/s × 12 bits ≈ 610 kB/s.
+ *          Se a USB não acompanhar, blocos são descartados na captura (lacuna em `seq`
+ *          e flag de perda), nunca dentro de um bloco.
+ *
+ * @author  Manoel Furtado
+ * @date    18 mai 2025
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ */
+
+#ifndef ADC_STREAM_H
+#define ADC_STREAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ADC_STREAM_MAGIC        0x5341u  /**< "AS" em little‑endian */
+#define ADC_STREAM_HDR_BYTES    16u      /**< Bytes do cabeçalho */
+#define ADC_STREAM_FRAME_BYTES  1024u    /**< Quadro inteiro: múltiplo de 64 (pacote USB FS) */
+#define ADC_STREAM_N_BLOCKS     8u       /**< Blocos no anel de captura (absorve pausas da USB) */
+#define ADC_STREAM_RATE_MAX     500000u  /**< Taxa máxima do ADC (48 MHz / 96) */
+
+#define ADC_STREAM_FLAG_OVERFLOW 0x01u   /**< Blocos descartados antes deste quadro */
+
+/** Formato das amostras no quadro. */
+typedef enum {
+    ADC_STREAM_FMT_8BIT  = 1,  /**< 8 bits mais significativos, 1008 amostras por quadro */
+    ADC_STREAM_FMT_12BIT = 2,  /**< 12 bits, 2 amostras em 3 bytes, 672 amostras por quadro */
+} adc_stream_fmt_t;
+
+/** Contadores do streaming (desde o último start). */
+typedef struct {
+    uint32_t captured;  /**< Blocos completados pelo DMA */
+    uint32_t sent;      /**< Quadros entregues ao FIFO da CDC */
+    uint32_t dropped;   /**< Blocos descartados por falta de espaço no anel */
+} adc_stream_stats_t;
+
+/**
+ * @brief Reserva os canais de DMA e registra a interrupção de fim de bloco.
+ */
+void adc_stream_init(void);
+
+/**
+ * @brief Inicia a captura contínua.
+ * @param input   Entrada do ADC (0‑3 = GPIO 26‑29, 4 = sensor de temperatura).
+ * @param fmt     Formato das amostras.
+ * @param rate_hz Taxa de amostragem (até ADC_STREAM_RATE_MAX).
+ * @return Taxa efetivamente programada (o divisor do ADC é inteiro + 8 bits de fração).
+ */
+uint32_t adc_stream_start(uint32_t input, adc_stream_fmt_t fmt, uint32_t rate_hz);
+
+/**
+ * @brief Para a captura e descarta os blocos ainda não enviados.
+ */
+void adc_stream_stop(void);
+
+/** @brief Indica se a captura está ativa. */
+bool adc_stream_running(void);
+
+/**
+ * @brief Monta quadros dos blocos prontos e escreve no FIFO da CDC até ele encher.
+ * @note  Não bloqueia; chamar no laço principal junto com `tud_task()`.
+ */
+void adc_stream_poll(void);
+
+/** @brief Copia os contadores atuais. */
+adc_stream_stats_t adc_stream_stats(void);
+
+#endif /* ADC_STREAM_H */
@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""
+@file adc_stream_rx.py
+@author Manoel Felipe Costa Furtado
+@copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+@brief Receptor Linux do streaming binário do ADC (Atividade_05_stream).
+
+Envia "start", remonta os quadros (formato em src/adc_stream.h), confere o CRC-32,
+detecta lacunas pela sequência e mostra a vazão sustentada a cada segundo.
+
+Uso:
+    python3 adc_stream_rx.py /dev/ttyACM0 --bits 8 --taxa 500000 --segundos 10
+    python3 adc_stream_rx.py /dev/ttyACM0 --bits 12 --taxa 400000 -o amostras.u16
+
+Com -o as amostras são gravadas como uint16 little-endian (os quadros com CRC
+inválido não são gravados). Usa pyserial se instalado; senão, abre a porta
+com termios. numpy, se instalado, acelera o desempacotamento de 12 bits.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+import zlib
+
+try:
+    import numpy as np
+except ImportError:  # Sem numpy: desempacotamento em Python puro (mais lento)
+    np = None
+
+# Deve ser igual a adc_stream.h
+MAGIC = b"AS"                 # 0x5341 little-endian
+HDR = struct.Struct("<HBBIHHI")
+HDR_BYTES = HDR.size          # 16
+FRAME_BYTES = 1024
+FMT_8BIT, FMT_12BIT = 1, 2
+AMOSTRAS = {FMT_8BIT: 1008, FMT_12BIT: 672}
+FLAG_OVERFLOW = 0x01
+
+
+def abrir_porta(caminho):
+    """Retorna (ler(n), escrever(dados), fechar())."""
+    try:
+        import serial
+        porta = serial.Serial(caminho, timeout=0.1)
+        return porta.read, porta.write, porta.close
+    except ImportError:
+        import termios
+        import tty
+        fd = os.open(caminho, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(fd)
+        atributos = termios.tcgetattr(fd)
+        atributos[6][termios.VMIN] = 0
+        atributos[6][termios.VTIME] = 1   # read() retorna após 100 ms sem dados
+        termios.tcsetattr(fd, termios.TCSANOW, atributos)
+        return (lambda n: os.read(fd, n)), (lambda d: os.write(fd, d)), (lambda: os.close(fd))
+
+
+def desempacotar_12(carga):
+    """3 bytes -> 2 amostras de 12 bits; retorna os bytes uint16 little-endian."""
+    if np is not None:
+        b = np.frombuffer(carga, dtype=np.uint8).reshape(-1, 3).astype(np.uint16)
+        saida = np.empty((b.shape[0], 2), dtype="<u2")
+        saida[:, 0] = b[:, 0] | ((b[:, 1] & 0x0F) << 8)
+        saida[:, 1] = (b[:, 1] >> 4) | (b[:, 2] << 4)
+        return saida.tobytes()
+    saida = bytearray()
+    for i in range(0, len(carga), 3):
+        b0, b1, b2 = carga[i], carga[i + 1], carga[i + 2]
+        saida += struct.pack("<HH", b0 | ((b1 & 0x0F) << 8), (b1 >> 4) | (b2 << 4))
+    return bytes(saida)
+
+
+class Estatisticas:
+    def __init__(self):
+        self.quadros = self.amostras = self.bytes = 0
+        self.lacunas = self.blocos_perdidos = self.erros_crc = self.descartados = 0
+        self.flags_perda = 0
+
+    def linha(self, dt):
+        return ("{:7.1f} kS/s  {:7.1f} kB/s  quadros={}  lacunas={} (blocos perdidos={})  "
+                "crc_inv={}  bytes_lixo={}").format(
+                    self.amostras / dt / 1e3, self.bytes / dt / 1e3, self.quadros, self.lacunas,
+                    self.blocos_perdidos, self.erros_crc, self.descartados)
+
+
+def processar(buf, est, estado, saida):
+    """Consome quadros completos de `buf` (bytearray). Retorna o buf restante."""
+    pos = 0
+    while True:
+        ini = buf.find(MAGIC, pos)
+        if ini < 0:
+            # Guarda o último byte: pode ser o começo do magic.
+            est.descartados += max(0, len(buf) - pos - 1)
+            return buf[max(pos, len(buf) - 1):]
+        est.descartados += ini - pos
+        if len(buf) - ini < FRAME_BYTES:
+            return buf[ini:]
+
+        _, fmt, flags, seq, n, carga_len, crc = HDR.unpack_from(buf, ini)
+        if fmt not in AMOSTRAS or n != AMOSTRAS[fmt] or carga_len != FRAME_BYTES - HDR_BYTES:
+            pos = ini + 1     # Falso magic (texto ou dado): ressincroniza
+            continue
+
+        carga = bytes(buf[ini + HDR_BYTES: ini + FRAME_BYTES])
+        amostras = carga if fmt == FMT_8BIT else desempacotar_12(carga)
+        if zlib.crc32(amostras) & 0xFFFFFFFF != crc:
+            est.erros_crc += 1
+            pos = ini + 1
+            continue
+
+        ultimo = estado.get("seq")
+        if ultimo is not None and seq != (ultimo + 1) & 0xFFFFFFFF:
+            est.lacunas += 1
+            est.blocos_perdidos += (seq - ultimo - 1) & 0xFFFFFFFF
+        estado["seq"] = seq
+        if flags & FLAG_OVERFLOW:
+            est.flags_perda += 1
+
+        est.quadros += 1
+        est.amostras += n
+        est.bytes += FRAME_BYTES
+        if saida is not None:
+            if fmt == FMT_8BIT:
+                amostras = b"".join(struct.pack("<H", v << 4) for v in amostras) if np is None \
+                    else (np.frombuffer(amostras, dtype=np.uint8).astype("<u2") << 4).tobytes()
+            saida.write(amostras)
+        pos = ini + FRAME_BYTES
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Receptor do streaming binário do ADC")
+    ap.add_argument("porta", help="ex.: /dev/ttyACM0")
+    ap.add_argument("--bits", type=int, choices=(8, 12), default=8)
+    ap.add_argument("--taxa", type=int, default=500000, help="amostras/s (máx. 500000)")
+    ap.add_argument("--entrada", type=int, default=4, help="0-3 = GPIO26-29, 4 = temperatura")
+    ap.add_argument("--segundos", type=float, default=10.0)
+    ap.add_argument("-o", "--saida", help="grava amostras (uint16 LE, 8 bits vão para a escala de 12)")
+    args = ap.parse_args()
+
+    ler, escrever, fechar = abrir_porta(args.porta)
+    saida = open(args.saida, "wb") if args.saida else None
+    escrever(b"stop\n")
+    time.sleep(0.2)
+    while ler(4096):      # Descarta resposta do stop e restos de uma execução anterior
+        pass
+    escrever("start {} {} {}\n".format(args.bits, args.taxa, args.entrada).encode())
+
+    total, janela = Estatisticas(), Estatisticas()
+    estado = {}
+    buf = bytearray()
+    t0 = t_janela = time.monotonic()
+    try:
+        while time.monotonic() - t0 < args.segundos:
+            dados = ler(65536)
+            if dados:
+                if not total.quadros and b"OK " in dados:
+                    fim = dados.index(b"OK ")
+                    print("Placa:", dados[fim:dados.find(b"\n", fim)].decode(errors="replace"))
+                buf += dados
+                antes = (total.quadros, total.amostras, total.bytes, total.lacunas,
+                         total.blocos_perdidos, total.erros_crc, total.descartados)
+                buf = processar(buf, total, estado, saida)
+                for campo, valor in zip(("quadros", "amostras", "bytes", "lacunas",
+                                         "blocos_perdidos", "erros_crc", "descartados"), antes):
+                    setattr(janela, campo, getattr(janela, campo) + getattr(total, campo) - valor)
+            agora = time.monotonic()
+            if agora - t_janela >= 1.0:
+                print(janela.linha(agora - t_janela))
+                janela, t_janela = Estatisticas(), agora
+    except KeyboardInterrupt:
+        pass
+    finally:
+        escrever(b"stop\n")
+        fechar()
+        if saida:
+            saida.close()
+
+    dt = time.monotonic() - t0
+    print("\nSustentado em {:.1f} s:".format(dt))
+    print(total.linha(dt))
+    if total.flags_perda:
+        print("Quadros com flag de perda na placa:", total.flags_perda)
+    return 0 if total.quadros and not total.lacunas and not total.erros_crc else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -12,12 +12,18 @@
  *          3. Aciona buzzer (GPIO 10) com o comando "som".
  *          4. Exibe comandos no display OLED SSD1306 via I2C (GPIO 14-SDA, 15-SCL).
  *
- *          Comandos reconhecidos (case‑insensitive):
- *          └─ "vermelho"  → acende LED vermelho  (GPIO‑13)
- *          └─ "verde"     → acende LED verde     (GPIO‑11)
- *          └─ "azul"      → acende LED azul      (GPIO‑12)
- *          └─ "som"       → aciona buzzer        (GPIO‑10)
- *          Cada indicação visual/sonora permanece ativa por 1 s.
+ *          Comandos reconhecidos (case‑insensitive, um por linha, fim em Enter):
+ *          └─ "vermelho [ms]"  → acende LED vermelho  (GPIO‑13)
+ *          └─ "verde [ms]"     → acende LED verde     (GPIO‑11)
+ *          └─ "azul [ms]"      → acende LED azul      (GPIO‑12)
+ *          └─ "som [ms]"       → aciona buzzer        (GPIO‑10)
+ *          └─ "pisca <cor|som> <vezes> [periodo_ms]"
+ *          └─ "parar [cor|som]", "status", "ajuda"
+ *          Sem [ms], cada indicação visual/sonora permanece ativa por 1 s.
+ *
+ *          As linhas são montadas através de vários pacotes USB (cdc_shell.c) e
+ *          as ações rodam como jobs temporizados (pin_jobs.c): o laço principal
+ *          nunca dorme e o TinyUSB continua sendo servido durante as ações.
  *
  * @note    Hardware‑alvo  : Raspberry Pi Pico W (RP2040) + placa BitDogLab
  *          Bibliotecas    : - TinyUSB (via pico_stdio_usb)
@@ -36,7 +42,6 @@
  *---------------------------------------------------------------------*/
 #include <stdio.h>
 #include <string.h>
-#include <ctype.h>
 
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
@@ -48,6 +53,10 @@
 #include "ssd1306.h"
 #include "ssd1306_i2c.h"
 
+/* Shell de comandos e ações não bloqueantes */
+#include "cdc_shell.h"
+#include "pin_jobs.h"
+
 /*==========================================================================
  *                             DEFINES & CONSTANTS
  *=========================================================================*/
@@ -56,8 +65,8 @@
 #define LED_RED_PIN     13    /**< GPIO do LED VERMELHO */
 #define BUZZER_PIN      10    /**< GPIO do BUZZER       */
 
-#define ONE_SECOND_MS   1000u /**< Duração fixa de 1 s  */
-#define CMD_BUF_MAX     32    /**< Tamanho máximo do buffer de comando */
+#define ONE_SECOND_MS   1000u  /**< Duração padrão de 1 s  */
+#define PULSE_MAX_MS    60000u /**< Maior duração aceita num comando */
 
 /*==========================================================================
  *                              PROTÓTIPOS
@@ -79,15 +88,19 @@ static void cdc_wait_connect(void);
 static void oled_print(const char *str);
 
 /**
- * @brief Gera pulso de 1 s em um pino GPIO (LED ou buzzer).
- * @param gpio Número do pino GPIO já configurado como saída.
+ * @brief Pino associado a um nome de cor ("som" = buzzer).
+ * @param name Nome em minúsculas.
+ * @param gpio Pino encontrado.
+ * @return false se o nome não for de cor/buzzer.
  */
-static void pulse_pin(uint gpio);
+static bool pin_by_name(const char *name, uint *gpio);
 
-/**
- * @brief Lê dados da CDC, ecoa, converte, exibe no OLED e dispara ação.
- */
-static void process_cdc(void);
+/** @brief Handlers dos comandos do shell (ver tabela `commands`). */
+static bool cmd_pulse(int argc, char **argv);
+static bool cmd_blink(int argc, char **argv);
+static bool cmd_stop(int argc, char **argv);
+static bool cmd_status(int argc, char **argv);
+static bool cmd_help(int argc, char **argv);
 
 /*==========================================================================
  *                             VARIÁVEIS GLOBAIS
@@ -95,11 +108,25 @@ static void process_cdc(void);
 /** Buffer local de RAM para o OLED (tamanho definido na lib SSD1306) */
 static uint8_t oled_buf[ssd1306_buffer_length] = { 0 };
 
-/* Buffer temporário para receber dados da CDC */
-static char cmd_buf[CMD_BUF_MAX] = { 0 };
-
-/* Comprimento atual do comando armazenado em cmd_buf */
-static size_t cmd_len = 0;
+/** Nomes de cor aceitos e seus pinos */
+static const struct { const char *name; uint gpio; } pin_names[] = {
+    { "vermelho", LED_RED_PIN   },
+    { "verde",    LED_GREEN_PIN },
+    { "azul",     LED_BLUE_PIN  },
+    { "som",      BUZZER_PIN    },
+};
+
+/** Tabela de comandos do shell (indexada por hash em shell_init) */
+static const shell_cmd_t commands[] = {
+    { "vermelho", 0, 1, "vermelho [ms]                 acende LED vermelho", cmd_pulse  },
+    { "verde",    0, 1, "verde [ms]                    acende LED verde",    cmd_pulse  },
+    { "azul",     0, 1, "azul [ms]                     acende LED azul",     cmd_pulse  },
+    { "som",      0, 1, "som [ms]                      aciona buzzer",       cmd_pulse  },
+    { "pisca",    2, 3, "pisca <cor|som> <vezes> [ms]  pisca com periodo ms", cmd_blink  },
+    { "parar",    0, 1, "parar [cor|som]               cancela acoes",       cmd_stop   },
+    { "status",   0, 0, "status                        acoes em andamento",  cmd_status },
+    { "ajuda",    0, 0, "ajuda                         lista os comandos",   cmd_help   },
+};
 
 /*==========================================================================
  *                           IMPLEMENTAÇÃO
@@ -145,7 +172,7 @@ static void cdc_wait_connect(void)
     }
     /* Conectado: exibe status */
     oled_print("CDC conectado!");
-    printf("CDC conectado!\r\nComandos: vermelho | verde | azul | som\r\n");
+    printf("CDC conectado!\r\nComandos: vermelho | verde | azul | som | pisca | parar | status | ajuda\r\n");
 }
 
 /**
@@ -180,55 +207,83 @@ static void oled_print(const char *str)
 }
 
 /**
- * @brief Acende um GPIO (LED ou buzzer) por EXACTAMENTE 1 s.
- * @param gpio Pino configurado como saída.
+ * @brief Procura o pino pelo nome na tabela `pin_names`.
  */
-static void pulse_pin(uint gpio)
+static bool pin_by_name(const char *name, uint *gpio)
 {
-    gpio_put(gpio, true);
-    sleep_ms(ONE_SECOND_MS);
-    gpio_put(gpio, false);
+    for (size_t i = 0; i < sizeof(pin_names)/sizeof(pin_names[0]); i++) {
+        if (strcmp(pin_names[i].name, name) == 0) {
+            *gpio = pin_names[i].gpio;
+            return true;
+        }
+    }
+    return false;
 }
 
 /**
- * @brief Lê dados da CDC, ecoa, converte para minúsculas, exibe e aciona periféricos.
+ * @brief "vermelho|verde|azul|som [ms]": liga o pino por ms (padrão 1 s) sem bloquear.
  */
-static void process_cdc(void)
+static bool cmd_pulse(int argc, char **argv)
 {
-    /* Enquanto houver dados disponíveis na CDC */
-    while (tud_cdc_available()) {
-        uint8_t buf[64];
-        /* Leitura não-bloqueante em bloco */
-        uint32_t count = tud_cdc_read(buf, sizeof(buf));
-        if (count == 0) return;
-
-        /* Garante string C-zero-terminated */
-        if (count < sizeof(buf)) buf[count] = '\0';
-        else buf[sizeof(buf)-1] = '\0';
-
-        /* Ecoa de volta ao host */
-        tud_cdc_write(buf, count);
-        tud_cdc_write_flush();
-
-        /* Converte buffer para minúsculas para simplificar comparações */
-        for (uint32_t i = 0; i < count; i++) {
-            buf[i] = (char)tolower((unsigned char)buf[i]);
-        }
+    uint gpio;
+    uint32_t ms = ONE_SECOND_MS;
+    if (!pin_by_name(argv[0], &gpio)) return false;
+    if (argc > 1 && !shell_arg_u32(argv[1], 1, PULSE_MAX_MS, &ms)) return false;
+    if (!jobs_start(gpio, ms, 0, 1)) {
+        shell_print("Sem job livre!\r\n");
+    }
+    return true;
+}
 
-        /* Exibe o comando no OLED */
-        oled_print((const char *)buf);
-
-        /* Despacha ação conforme comando */
-        if      (strcmp((char*)buf, "vermelho") == 0) pulse_pin(LED_RED_PIN);
-        else if (strcmp((char*)buf, "verde")    == 0) pulse_pin(LED_GREEN_PIN);
-        else if (strcmp((char*)buf, "azul")     == 0) pulse_pin(LED_BLUE_PIN);
-        else if (strcmp((char*)buf, "som")      == 0) pulse_pin(BUZZER_PIN);
-        else {
-            /* Comando não reconhecido */
-            tud_cdc_write_str("\r\nComando desconhecido!\r\n");
-            tud_cdc_write_flush();
-        }
+/**
+ * @brief "pisca <cor|som> <vezes> [periodo_ms]": pisca com ciclo de trabalho de 50 %.
+ */
+static bool cmd_blink(int argc, char **argv)
+{
+    uint gpio;
+    uint32_t times, period = 500;
+    if (!pin_by_name(argv[1], &gpio)) return false;
+    if (!shell_arg_u32(argv[2], 1, 1000, &times)) return false;
+    if (argc > 3 && !shell_arg_u32(argv[3], 20, 10000, &period)) return false;
+    if (!jobs_start(gpio, period / 2, period - period / 2, times)) {
+        shell_print("Sem job livre!\r\n");
     }
+    return true;
+}
+
+/**
+ * @brief "parar [cor|som]": cancela um job ou todos.
+ */
+static bool cmd_stop(int argc, char **argv)
+{
+    uint gpio;
+    if (argc == 1) {
+        jobs_cancel_all();
+        return true;
+    }
+    if (!pin_by_name(argv[1], &gpio)) return false;
+    jobs_cancel(gpio);
+    return true;
+}
+
+/**
+ * @brief "status": quantidade de ações em andamento.
+ */
+static bool cmd_status(int argc, char **argv)
+{
+    (void)argc; (void)argv;
+    shell_printf("Acoes em andamento: %lu\r\n", (unsigned long)jobs_active());
+    return true;
+}
+
+/**
+ * @brief "ajuda": lista os comandos.
+ */
+static bool cmd_help(int argc, char **argv)
+{
+    (void)argc; (void)argv;
+    shell_print_help();
+    return true;
 }
 
 /**
@@ -239,9 +294,13 @@ int main(void)
     board_init();          /* Configura LEDs, buzzer, I²C, OLED, USB-CDC */
     cdc_wait_connect();    /* Aguarda host e exibe status */
 
-    /* Loop infinito de serviço USB e CDC */
+    /* Tabela hash de comandos; cada linha recebida também vai ao OLED */
+    shell_init(commands, sizeof(commands)/sizeof(commands[0]), oled_print);
+
+    /* Loop infinito de serviço USB e CDC: nenhuma etapa bloqueia */
     while (1) {
-        process_cdc();     /* Trata leitura/escrita CDC */
+        shell_poll();      /* Monta linhas e despacha comandos */
+        jobs_poll();       /* Avança LEDs/buzzer temporizados */
         tud_task();        /* Mantém TinyUSB rodando */
     }
 
@@ -0,0 +1,217 @@
+/**
+ * @file    cdc_shell.c
+ * @brief   Montagem de linhas, tabela hash de comandos e despacho do shell USB‑CDC.
+ *
+ * @author  Manoel Furtado
+ * @date    19 mai 2025
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ */
+
+#include "cdc_shell.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "tusb.h"
+
+/*==========================================================================
+ *                             ESTADO DO SHELL
+ *=========================================================================*/
+static const shell_cmd_t *cmd_table;           /**< Tabela fornecida em shell_init() */
+static size_t cmd_count;
+static int8_t hash_slots[SHELL_HASH_SLOTS];    /**< Índice em cmd_table; -1 = vazio */
+static void (*line_cb)(const char *line);
+
+static char   line_buf[SHELL_LINE_MAX + 1];    /**< Linha em montagem */
+static size_t line_len;
+static bool   line_overflow;                   /**< Linha longa demais: descarta até o fim */
+static bool   last_was_cr;                     /**< Para tratar CRLF como um único fim de linha */
+
+/*==========================================================================
+ *                           TABELA HASH
+ *=========================================================================*/
+
+/**
+ * @brief FNV‑1a de 32 bits sobre a string.
+ */
+static uint32_t hash_str(const char *s)
+{
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= (uint8_t)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * @brief Procura o comando pelo nome (sondagem linear a partir do hash).
+ * @return Descritor ou NULL se não existir.
+ */
+static const shell_cmd_t *find_cmd(const char *name)
+{
+    uint32_t i = hash_str(name) & (SHELL_HASH_SLOTS - 1);
+    for (uint32_t n = 0; n < SHELL_HASH_SLOTS; n++) {
+        int8_t idx = hash_slots[i];
+        if (idx < 0) return NULL;
+        if (strcmp(cmd_table[idx].name, name) == 0) return &cmd_table[idx];
+        i = (i + 1) & (SHELL_HASH_SLOTS - 1);
+    }
+    return NULL;
+}
+
+void shell_init(const shell_cmd_t *cmds, size_t count, void (*on_line)(const char *line))
+{
+    cmd_table = cmds;
+    cmd_count = count < SHELL_HASH_SLOTS ? count : SHELL_HASH_SLOTS - 1;
+    line_cb = on_line;
+    memset(hash_slots, -1, sizeof(hash_slots));
+
+    for (size_t c = 0; c < cmd_count; c++) {
+        uint32_t i = hash_str(cmds[c].name) & (SHELL_HASH_SLOTS - 1);
+        while (hash_slots[i] >= 0) {
+            i = (i + 1) & (SHELL_HASH_SLOTS - 1);
+        }
+        hash_slots[i] = (int8_t)c;
+    }
+}
+
+/*==========================================================================
+ *                              SAÍDA
+ *=========================================================================*/
+
+void shell_print(const char *str)
+{
+    size_t len = strlen(str);
+    while (len > 0 && tud_cdc_connected()) {
+        uint32_t n = tud_cdc_write(str, len);
+        str += n;
+        len -= n;
+        if (len > 0) {
+            /* FIFO de TX cheio: envia e deixa a pilha USB andar */
+            tud_cdc_write_flush();
+            tud_task();
+        }
+    }
+    tud_cdc_write_flush();
+}
+
+void shell_printf(const char *fmt, ...)
+{
+    char out[128];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(out, sizeof(out), fmt, ap);
+    va_end(ap);
+    shell_print(out);
+}
+
+void shell_print_help(void)
+{
+    shell_print("Comandos:\r\n");
+    for (size_t c = 0; c < cmd_count; c++) {
+        shell_printf("  %s\r\n", cmd_table[c].usage);
+    }
+}
+
+/*==========================================================================
+ *                         ARGUMENTOS E DESPACHO
+ *=========================================================================*/
+
+bool shell_arg_u32(const char *str, uint32_t min, uint32_t max, uint32_t *out)
+{
+    char *end;
+    if (!isdigit((unsigned char)str[0])) return false;
+    unsigned long v = strtoul(str, &end, 10);
+    if (*end != '\0' || v < min || v > max) return false;
+    *out = (uint32_t)v;
+    return true;
+}
+
+/**
+ * @brief Separa a linha em argumentos e executa o comando.
+ */
+static void execute_line(char *line)
+{
+    char *argv[SHELL_ARGS_MAX];
+    int argc = 0;
+
+    for (char *p = line; *p; ) {
+        while (*p == ' ' || *p == '\t') *p++ = '\0';
+        if (!*p) break;
+        if (argc == SHELL_ARGS_MAX) {
+            shell_print("Argumentos demais!\r\n");
+            return;
+        }
+        argv[argc++] = p;
+        while (*p && *p != ' ' && *p != '\t') p++;
+    }
+    if (argc == 0) return;   /* Linha vazia */
+
+    const shell_cmd_t *cmd = find_cmd(argv[0]);
+    if (!cmd) {
+        shell_printf("Comando desconhecido: %s (digite 'ajuda')\r\n", argv[0]);
+        return;
+    }
+    int nargs = argc - 1;
+    if (nargs < cmd->min_args || nargs > cmd->max_args || !cmd->handler(argc, argv)) {
+        shell_printf("Uso: %s\r\n", cmd->usage);
+    }
+}
+
+/**
+ * @brief Trata um byte recebido: eco, edição e fim de linha.
+ */
+static void feed_byte(char c)
+{
+    if (c == '\r' || c == '\n') {
+        bool crlf = (c == '\n' && last_was_cr);
+        last_was_cr = (c == '\r');
+        if (crlf) return;                 /* LF de um CRLF já tratado */
+
+        shell_print("\r\n");
+        if (line_overflow) {
+            shell_printf("Linha longa demais (max %u)\r\n", SHELL_LINE_MAX);
+        } else {
+            line_buf[line_len] = '\0';
+            if (line_len > 0 && line_cb) line_cb(line_buf);
+            execute_line(line_buf);
+        }
+        line_len = 0;
+        line_overflow = false;
+        return;
+    }
+    last_was_cr = false;
+
+    if (c == '\b' || c == 0x7F) {         /* Backspace / DEL */
+        if (line_len > 0 && !line_overflow) {
+            line_len--;
+            shell_print("\b \b");
+        }
+        return;
+    }
+    if (!isprint((unsigned char)c)) return;
+
+    if (line_len >= SHELL_LINE_MAX) {
+        line_overflow = true;
+        return;
+    }
+    line_buf[line_len++] = (char)tolower((unsigned char)c);
+    char echo[2] = { c, '\0' };
+    shell_print(echo);
+}
+
+void shell_poll(void)
+{
+    while (tud_cdc_available()) {
+        char buf[64];
+        uint32_t count = tud_cdc_read(buf, sizeof(buf));
+        if (count == 0) return;
+        for (uint32_t i = 0; i < count; i++) {
+            feed_byte(buf[i]);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file    cdc_shell.h
+ * @brief   Interpretador de comandos por linha sobre USB‑CDC (TinyUSB).
+ * @details Os bytes chegam da CDC em pacotes de tamanho arbitrário: um comando
+ *          pode vir partido em vários `tud_cdc_read()` e um pacote pode trazer
+ *          mais de um comando. O shell:
+ *           • monta a linha byte a byte (eco local, Backspace, fim em CR, LF ou CRLF);
+ *           • separa a linha em argumentos (espaço/tab, máx. SHELL_ARGS_MAX);
+ *           • localiza o comando numa tabela hash (FNV‑1a, endereçamento aberto)
+ *             montada uma vez em `shell_init()`, sem percorrer `strcmp` a cada linha;
+ *           • valida a quantidade de argumentos e chama o handler.
+ *          Os handlers devem retornar rápido (ações longas viram jobs, ver pin_jobs.h).
+ *
+ * @author  Manoel Furtado
+ * @date    19 mai 2025
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ */
+
+#ifndef CDC_SHELL_H
+#define CDC_SHELL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SHELL_LINE_MAX   64   /**< Caracteres por linha (excedente descarta a linha) */
+#define SHELL_ARGS_MAX    6   /**< Argumentos por linha, incluindo o nome do comando */
+#define SHELL_HASH_SLOTS 32   /**< Entradas da tabela hash (potência de 2, > nº de comandos) */
+
+/**
+ * @brief Handler de comando.
+ * @param argc Quantidade de argumentos (argv[0] é o nome do comando).
+ * @param argv Argumentos já em minúsculas e zero‑terminados.
+ * @return true se executou; false imprime a linha de uso do comando.
+ */
+typedef bool (*shell_handler_t)(int argc, char **argv);
+
+/** Descritor de um comando da tabela. */
+typedef struct {
+    const char     *name;      /**< Nome (minúsculas) */
+    uint8_t         min_args;  /**< Mínimo de argumentos após o nome */
+    uint8_t         max_args;  /**< Máximo de argumentos após o nome */
+    const char     *usage;     /**< Texto de ajuda: "nome <arg> [opc]  descrição" */
+    shell_handler_t handler;
+} shell_cmd_t;
+
+/**
+ * @brief Monta a tabela hash dos comandos.
+ * @param cmds  Tabela de comandos (deve permanecer válida).
+ * @param count Quantidade de comandos (< SHELL_HASH_SLOTS).
+ * @param on_line Callback opcional chamado com cada linha recebida (ex.: mostrar no OLED).
+ */
+void shell_init(const shell_cmd_t *cmds, size_t count, void (*on_line)(const char *line));
+
+/**
+ * @brief Consome todos os bytes disponíveis na CDC e executa as linhas completas.
+ * @note  Não bloqueia: sem dados, retorna imediatamente.
+ */
+void shell_poll(void);
+
+/**
+ * @brief Escreve texto na CDC, servindo o TinyUSB enquanto o FIFO de TX estiver cheio.
+ * @param str Texto zero‑terminado.
+ */
+void shell_print(const char *str);
+
+/** @brief `printf` para a CDC (linha formatada de até 128 caracteres). */
+void shell_printf(const char *fmt, ...);
+
+/** @brief Imprime o uso de todos os comandos (comando "ajuda"). */
+void shell_print_help(void);
+
+/**
+ * @brief Converte um argumento decimal, com faixa.
+ * @param str Texto do argumento.
+ * @param min Valor mínimo aceito.
+ * @param max Valor máximo aceito.
+ * @param out Valor convertido.
+ * @return false se não for número inteiro ou estiver fora da faixa.
+ */
+bool shell_arg_u32(const char *str, uint32_t min, uint32_t max, uint32_t *out);
+
+#endif /* CDC_SHELL_H */
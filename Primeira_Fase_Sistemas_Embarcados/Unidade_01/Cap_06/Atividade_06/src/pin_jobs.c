@@ -0,0 +1,107 @@
+/**
+ * @file    pin_jobs.c
+ * @brief   Implementação dos jobs temporizados de GPIO.
+ *
+ * @author  Manoel Furtado
+ * @date    19 mai 2025
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ */
+
+#include "pin_jobs.h"
+
+#include "pico/stdlib.h"
+
+/** Estado de um job. */
+typedef struct {
+    bool     active;
+    uint32_t gpio;
+    uint32_t on_us;
+    uint32_t off_us;
+    uint32_t cycles_left;  /**< Ciclos restantes, incluindo o atual */
+    bool     level;        /**< Nível atual do pino */
+    uint64_t next_us;      /**< Instante absoluto da próxima troca */
+} pin_job_t;
+
+static pin_job_t jobs[JOBS_MAX];
+
+/**
+ * @brief Job do pino (ativo ou não) ou um slot livre; NULL se não houver.
+ */
+static pin_job_t *slot_for(uint32_t gpio)
+{
+    pin_job_t *free_slot = NULL;
+    for (int i = 0; i < JOBS_MAX; i++) {
+        if (jobs[i].active && jobs[i].gpio == gpio) return &jobs[i];
+        if (!jobs[i].active && !free_slot) free_slot = &jobs[i];
+    }
+    return free_slot;
+}
+
+bool jobs_start(uint32_t gpio, uint32_t on_ms, uint32_t off_ms, uint32_t cycles)
+{
+    pin_job_t *j = slot_for(gpio);
+    if (!j || on_ms == 0 || cycles == 0) return false;
+
+    j->active      = true;
+    j->gpio        = gpio;
+    j->on_us       = on_ms * 1000u;
+    j->off_us      = off_ms * 1000u;
+    j->cycles_left = cycles;
+    j->level       = true;
+    j->next_us     = time_us_64() + j->on_us;
+    gpio_put(gpio, true);
+    return true;
+}
+
+void jobs_cancel(uint32_t gpio)
+{
+    for (int i = 0; i < JOBS_MAX; i++) {
+        if (jobs[i].active && jobs[i].gpio == gpio) {
+            jobs[i].active = false;
+            gpio_put(gpio, false);
+        }
+    }
+}
+
+void jobs_cancel_all(void)
+{
+    for (int i = 0; i < JOBS_MAX; i++) {
+        if (jobs[i].active) {
+            jobs[i].active = false;
+            gpio_put(jobs[i].gpio, false);
+        }
+    }
+}
+
+uint32_t jobs_active(void)
+{
+    uint32_t n = 0;
+    for (int i = 0; i < JOBS_MAX; i++) {
+        n += jobs[i].active;
+    }
+    return n;
+}
+
+void jobs_poll(void)
+{
+    uint64_t now = time_us_64();
+    for (int i = 0; i < JOBS_MAX; i++) {
+        pin_job_t *j = &jobs[i];
+        if (!j->active || now < j->next_us) continue;
+
+        if (j->level) {
+            /* Fim do tempo ligado: desliga; encerra se era o último ciclo */
+            j->level = false;
+            gpio_put(j->gpio, false);
+            if (--j->cycles_left == 0) {
+                j->active = false;
+                continue;
+            }
+            j->next_us += j->off_us;
+        } else {
+            j->level = true;
+            gpio_put(j->gpio, true);
+            j->next_us += j->on_us;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * @file    pin_jobs.h
+ * @brief   Jobs temporizados e não bloqueantes sobre pinos GPIO (LEDs e buzzer).
+ * @details Um job liga o pino por `on_ms`, desliga por `off_ms` e repete por
+ *          `cycles` ciclos. Nada de `sleep_ms()`: `jobs_poll()` compara o tempo
+ *          atual com o próximo instante de troca e retorna na hora, de modo que o
+ *          laço principal continua servindo `tud_task()` durante ações longas.
+ *          Os instantes são absolutos (próximo = anterior + duração), então a
+ *          cadência não acumula o atraso do laço.
+ *          Cada pino tem no máximo um job: um novo comando substitui o anterior.
+ *
+ * @author  Manoel Furtado
+ * @date    19 mai 2025
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ */
+
+#ifndef PIN_JOBS_H
+#define PIN_JOBS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define JOBS_MAX 4   /**< Jobs simultâneos (um por pino) */
+
+/**
+ * @brief Inicia (ou substitui) o job de um pino.
+ * @param gpio   Pino já configurado como saída.
+ * @param on_ms  Tempo ligado em cada ciclo (> 0).
+ * @param off_ms Tempo desligado entre ciclos.
+ * @param cycles Quantidade de ciclos (>= 1).
+ * @return false se não houver job livre.
+ */
+bool jobs_start(uint32_t gpio, uint32_t on_ms, uint32_t off_ms, uint32_t cycles);
+
+/**
+ * @brief Cancela o job de um pino e o desliga.
+ * @param gpio Pino.
+ */
+void jobs_cancel(uint32_t gpio);
+
+/** @brief Cancela todos os jobs e desliga os pinos. */
+void jobs_cancel_all(void);
+
+/** @brief Quantidade de jobs em execução. */
+uint32_t jobs_active(void);
+
+/**
+ * @brief Avança os jobs cujo próximo instante já chegou. Chamar no laço principal.
+ */
+void jobs_poll(void);
+
+#endif /* PIN_JOBS_H */
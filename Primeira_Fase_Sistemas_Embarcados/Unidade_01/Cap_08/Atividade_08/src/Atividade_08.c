@@ -113,17 +113,16 @@ int main() {
         cyw43_arch_poll();
         #endif
 
-        // Processa a lógica do alarme (piscar LEDs/Buzzer se ativo)
-        alarm_control_process();
+        // O LED vermelho e o buzzer piscam por alarme de hardware (alarm_pattern.c):
+        // nada do alarme precisa ser processado aqui.
 
         // O PICO_CYW43_ARCH_POLL define se o driver Wi-Fi é baseado em polling ou interrupções.
         // Se baseado em polling, cyw43_arch_wait_for_work_until() pode ser usado para
         // economizar energia esperando por trabalho ou por um timeout.
         #if PICO_CYW43_ARCH_POLL
-        // Espera por trabalho do Wi-Fi/LwIP ou até 10ms.
-        // Um timeout menor permite que a lógica do alarme (piscar) seja mais responsiva
-        // se não houver muita atividade de rede.
-        cyw43_arch_wait_for_work_until(make_timeout_time_ms(10));
+        // Espera por trabalho do Wi-Fi/LwIP ou até 100ms (o timeout só limita
+        // a latência de detecção da tecla 'd'; a cadência do alarme não depende dele).
+        cyw43_arch_wait_for_work_until(make_timeout_time_ms(100));
         #else
         // Se não estiver usando polling, o trabalho Wi-Fi/LwIP ocorre em background (interrupções).
         // Um pequeno sleep_ms pode ser usado para ceder tempo a outras tarefas, se houver.
@@ -9,14 +9,33 @@
 #include <stdio.h>
 #include "alarm_control.h"
 #include "app_config.h"
+#include "alarm_pattern.h"   // Cadência do LED vermelho e do buzzer por alarme de hardware
 #include "oled_display.h"    // Para atualizar o display quando o estado do alarme muda
-#include "pico/stdlib.h"     // Para time_us_64()
+#include "pico/stdlib.h"
 #include "hardware/gpio.h"
 
 // Variáveis estáticas para encapsular o estado do alarme dentro deste módulo.
 static volatile bool s_alarm_active = false;            /**< Estado atual do alarme (ativo/inativo). */
-static bool s_alarm_output_toggle_state = false;    /**< Estado de toggle para piscar LED/Buzzer. */
-static uint64_t s_last_toggle_time_us = 0;          /**< Timestamp do último toggle do LED/Buzzer. */
+
+// --- Padrões de LED vermelho/buzzer ---
+/** Evacuação: LED e tom ligados/desligados a cada ALARM_BLINK_INTERVAL_MS, em laço. */
+static const alarm_step_t s_passos_evacuar[] = {
+    ALARM_PASSO(ALARM_BLINK_INTERVAL_MS, true, ALARM_TONE_HZ),
+    ALARM_PASSO(ALARM_BLINK_INTERVAL_MS, false, 0),
+};
+static const alarm_pattern_t s_padrao_evacuar = {
+    s_passos_evacuar, 2, ALARM_PRIORIDADE_EVACUAR, true
+};
+
+/** Desarme: dois bipes curtos, tocados uma vez. */
+static const alarm_step_t s_passos_desarme[] = {
+    ALARM_PASSO(80, false, ALARM_TONE_HZ),
+    ALARM_PASSO(80, false, 0),
+    ALARM_PASSO(80, false, ALARM_TONE_HZ),
+};
+static const alarm_pattern_t s_padrao_desarme = {
+    s_passos_desarme, 3, ALARM_PRIORIDADE_AVISO, false
+};
 
 /**
  * @brief Inicializa os GPIOs para os LEDs e o buzzer.
@@ -32,15 +51,8 @@ void alarm_control_init(void) {
     gpio_set_dir(LED_BLUE_GPIO, GPIO_OUT);
     gpio_put(LED_BLUE_GPIO, false); // Desligado inicialmente
 
-    // LED Vermelho (alarme ativo)
-    gpio_init(LED_RED_GPIO);
-    gpio_set_dir(LED_RED_GPIO, GPIO_OUT);
-    gpio_put(LED_RED_GPIO, false); // Desligado inicialmente
-
-    // Buzzer
-    gpio_init(BUZZER_GPIO);
-    gpio_set_dir(BUZZER_GPIO, GPIO_OUT);
-    gpio_put(BUZZER_GPIO, false); // Desligado inicialmente
+    // LED Vermelho (alarme ativo) e Buzzer (PWM): controlados pelos padrões
+    alarm_pattern_init(LED_RED_GPIO, BUZZER_GPIO);
 
     printf("GPIOs para LEDs e Buzzer inicializados.\n");
 }
@@ -57,15 +69,12 @@ void alarm_control_set_active(bool active) {
         if (s_alarm_active) {
             printf("Alarme ATIVADO.\n");
             gpio_put(LED_GREEN_GPIO, false); // Apaga LED verde
-            // LED vermelho e buzzer serão controlados por alarm_control_process()
-            s_last_toggle_time_us = time_us_64(); // Reseta o timer de blink para iniciar imediatamente
-            s_alarm_output_toggle_state = false; // Garante que o primeiro blink acenda
+            alarm_pattern_start(&s_padrao_evacuar); // Começa aceso, sem esperar o loop principal
         } else {
             printf("Alarme DESATIVADO.\n");
-            gpio_put(LED_RED_GPIO, false);    // Apaga LED vermelho
-            gpio_put(BUZZER_GPIO, false);  // Desliga buzzer
+            alarm_pattern_stop(&s_padrao_evacuar);  // Apaga LED vermelho e silencia o buzzer
+            alarm_pattern_start(&s_padrao_desarme); // Bipe de confirmação
             gpio_put(LED_GREEN_GPIO, true);   // Acende LED verde
-            s_alarm_output_toggle_state = false; // Reseta estado do toggle
         }
     }
 }
@@ -77,23 +86,6 @@ bool alarm_control_is_active(void) {
     return s_alarm_active;
 }
 
-/**
- * @brief Processa a lógica de temporização do alarme.
- */
-void alarm_control_process(void) {
-    if (s_alarm_active) {
-        uint64_t current_time_us = time_us_64();
-        // Verifica se passou o intervalo para alternar o estado do LED/Buzzer
-        if (current_time_us - s_last_toggle_time_us >= (ALARM_BLINK_INTERVAL_MS * 1000)) {
-            s_alarm_output_toggle_state = !s_alarm_output_toggle_state; // Alterna o estado
-            gpio_put(LED_RED_GPIO, s_alarm_output_toggle_state);      // Aplica ao LED vermelho
-            gpio_put(BUZZER_GPIO, s_alarm_output_toggle_state);       // Aplica ao buzzer
-            s_last_toggle_time_us = current_time_us;                  // Atualiza o timestamp
-        }
-    }
-    // Se o alarme não estiver ativo, os LEDs e buzzer já foram definidos por alarm_control_set_active()
-}
-
 /**
  * @brief Controla o LED de status do Access Point (AP).
  */
@@ -105,8 +97,7 @@ void alarm_control_set_ap_led(bool on) {
  * @brief Desliga todas as saídas controladas pelo sistema de alarme.
  */
 void alarm_control_shutdown_outputs(void) {
-    gpio_put(LED_RED_GPIO, false);
-    gpio_put(BUZZER_GPIO, false);
+    alarm_pattern_stop_all();         // LED vermelho e buzzer
     gpio_put(LED_GREEN_GPIO, false);
     // O LED azul (AP_LED) é controlado separadamente pela lógica de rede/main.
 }
\ No newline at end of file
@@ -3,7 +3,9 @@
  * @brief Interface para controle do sistema de alarme (LEDs e Buzzer).
  *
  * Este módulo gerencia o estado do alarme, controla os LEDs de status
- * (verde, vermelho, azul) e o buzzer.
+ * (verde, vermelho, azul) e o buzzer. O LED vermelho e o buzzer seguem
+ * padrões executados por alarme de hardware (alarm_pattern.h); não há
+ * função a ser chamada no loop principal.
  *
  * @author  Manoel Furtado
  * @date    25 maio 2025
@@ -38,14 +40,6 @@ void alarm_control_set_active(bool active);
  */
 bool alarm_control_is_active(void);
 
-/**
- * @brief Processa a lógica de temporização do alarme.
- *
- * Esta função deve ser chamada repetidamente no loop principal do programa.
- * Ela é responsável por piscar o LED vermelho e o buzzer se o alarme estiver ativo.
- */
-void alarm_control_process(void);
-
 /**
  * @brief Controla o LED de status do Access Point (AP).
  *
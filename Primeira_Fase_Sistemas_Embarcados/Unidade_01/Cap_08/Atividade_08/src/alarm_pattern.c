@@ -0,0 +1,192 @@
+/**
+ * @file alarm_pattern.c
+ * @brief Implementação do gerador de padrões de alarme (alarme de hardware + PWM).
+ *
+ * @author  Manoel Furtado
+ * @date    25 maio 2025
+ */
+
+#include "alarm_pattern.h"
+#include "pico/stdlib.h"           // Para add_alarm_in_us, cancel_alarm
+#include "pico/critical_section.h" // Estado compartilhado entre callbacks e loop/lwIP
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/clocks.h"       // Para clock_get_hz()
+
+#define PWM_CONTADOR_HZ 1000000u  /**< Contador do PWM a 1 MHz: TOP = 1e6 / tom - 1. */
+
+// Variáveis estáticas para encapsular o estado do gerador dentro deste módulo.
+static critical_section_t s_cs;                                 /**< Protege todo o estado abaixo. */
+static const alarm_pattern_t *s_ativos[ALARM_PATTERN_MAX_ATIVOS]; /**< Padrões ativos, em ordem de ativação. */
+static uint8_t s_n_ativos = 0;
+static const alarm_pattern_t *s_tocando = NULL;                 /**< Padrão em execução. */
+static uint8_t s_passo = 0;                                     /**< Passo em execução. */
+static alarm_id_t s_alarm_id = 0;                               /**< Alarme do próximo passo (0 = nenhum). */
+static unsigned s_led_gpio, s_buzzer_gpio, s_buzzer_slice;
+
+/**
+ * @brief Ajusta o tom do buzzer (0 = mudo) com aritmética inteira.
+ */
+static void aplicar_tom(uint16_t tom_hz) {
+    if (tom_hz == 0) {
+        pwm_set_gpio_level(s_buzzer_gpio, 0);
+        return;
+    }
+    uint32_t top = PWM_CONTADOR_HZ / tom_hz - 1u;
+    pwm_set_wrap(s_buzzer_slice, (uint16_t)top);
+    pwm_set_gpio_level(s_buzzer_gpio, (uint16_t)((top + 1u) / 2u)); // Duty de 50 %
+}
+
+/**
+ * @brief Aplica o passo atual às saídas. Chamada dentro de `s_cs`.
+ * @return Duração do passo em microssegundos.
+ */
+static int64_t aplicar_passo(void) {
+    const alarm_step_t *p = &s_tocando->passos[s_passo];
+    gpio_put(s_led_gpio, p->led);
+    aplicar_tom(p->tom_hz);
+    return (int64_t)p->dur_ms * 1000;
+}
+
+/**
+ * @brief Padrão ativo de maior prioridade (em empate, o mais recente).
+ */
+static const alarm_pattern_t *maior_prioridade(void) {
+    const alarm_pattern_t *melhor = NULL;
+    for (uint8_t i = 0; i < s_n_ativos; i++) {
+        if (!melhor || s_ativos[i]->prioridade >= melhor->prioridade) {
+            melhor = s_ativos[i];
+        }
+    }
+    return melhor;
+}
+
+/**
+ * @brief Remove um padrão da lista de ativos. Chamada dentro de `s_cs`.
+ */
+static void remover(const alarm_pattern_t *padrao) {
+    for (uint8_t i = 0; i < s_n_ativos; i++) {
+        if (s_ativos[i] == padrao) {
+            for (uint8_t j = i + 1; j < s_n_ativos; j++) {
+                s_ativos[j - 1] = s_ativos[j];
+            }
+            s_n_ativos--;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Callback do alarme de hardware: avança um passo.
+ *
+ * Retorna o negativo da duração do novo passo, o que reagenda o alarme a partir
+ * do instante em que ele deveria ter disparado (sem acúmulo de atraso).
+ */
+static int64_t passo_callback(alarm_id_t id, void *user_data) {
+    (void)user_data;
+    int64_t proximo_us = 0;
+
+    critical_section_enter_blocking(&s_cs);
+    if (id == s_alarm_id && s_tocando) {   // Ignora alarmes já substituídos
+        if (++s_passo >= s_tocando->n_passos) {
+            s_passo = 0;
+            if (!s_tocando->repetir) {
+                remover(s_tocando);        // Fim de um padrão único: passa ao próximo ativo
+                s_tocando = maior_prioridade();
+            }
+        }
+        if (s_tocando) {
+            proximo_us = -aplicar_passo();
+        } else {
+            gpio_put(s_led_gpio, false);
+            aplicar_tom(0);
+        }
+    }
+    if (proximo_us == 0 && id == s_alarm_id) {
+        s_alarm_id = 0;
+    }
+    critical_section_exit(&s_cs);
+    return proximo_us;
+}
+
+/**
+ * @brief Reavalia qual padrão deve tocar após um start/stop. Chamada dentro de `s_cs`.
+ */
+static void reavaliar(void) {
+    const alarm_pattern_t *novo = maior_prioridade();
+    if (novo == s_tocando) {
+        return;
+    }
+    if (s_alarm_id > 0) {
+        cancel_alarm(s_alarm_id);   // Se já estiver disparando, o callback vê o id trocado
+    }
+    s_alarm_id = 0;
+    s_tocando = novo;
+    s_passo = 0;
+    if (!s_tocando) {
+        gpio_put(s_led_gpio, false);
+        aplicar_tom(0);
+        return;
+    }
+    int64_t dur_us = aplicar_passo();
+    // dur_ms >= 1: o alarme nunca está no passado, e o callback não roda dentro de `s_cs`.
+    s_alarm_id = add_alarm_in_us((uint64_t)dur_us, passo_callback, NULL, false);
+}
+
+void alarm_pattern_init(unsigned led_gpio, unsigned buzzer_gpio) {
+    critical_section_init(&s_cs);
+
+    s_led_gpio = led_gpio;
+    gpio_init(led_gpio);
+    gpio_set_dir(led_gpio, GPIO_OUT);
+    gpio_put(led_gpio, false);
+
+    s_buzzer_gpio = buzzer_gpio;
+    gpio_set_function(buzzer_gpio, GPIO_FUNC_PWM);
+    s_buzzer_slice = pwm_gpio_to_slice_num(buzzer_gpio);
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_clkdiv_int(&config, clock_get_hz(clk_sys) / PWM_CONTADOR_HZ);
+    pwm_init(s_buzzer_slice, &config, true);
+    pwm_set_gpio_level(buzzer_gpio, 0); // Mudo
+}
+
+bool alarm_pattern_start(const alarm_pattern_t *padrao) {
+    bool ok = true;
+    critical_section_enter_blocking(&s_cs);
+    remover(padrao);   // Reativar um padrão o torna o mais recente
+    if (s_n_ativos < ALARM_PATTERN_MAX_ATIVOS) {
+        s_ativos[s_n_ativos++] = padrao;
+        if (padrao == s_tocando) {
+            s_tocando = NULL;   // Força recomeçar do primeiro passo
+        }
+        reavaliar();
+    } else {
+        ok = false;
+    }
+    critical_section_exit(&s_cs);
+    return ok;
+}
+
+void alarm_pattern_stop(const alarm_pattern_t *padrao) {
+    critical_section_enter_blocking(&s_cs);
+    remover(padrao);
+    reavaliar();
+    critical_section_exit(&s_cs);
+}
+
+void alarm_pattern_stop_all(void) {
+    critical_section_enter_blocking(&s_cs);
+    s_n_ativos = 0;
+    reavaliar();
+    critical_section_exit(&s_cs);
+}
+
+bool alarm_pattern_is_active(const alarm_pattern_t *padrao) {
+    bool ativo = false;
+    critical_section_enter_blocking(&s_cs);
+    for (uint8_t i = 0; i < s_n_ativos; i++) {
+        ativo |= (s_ativos[i] == padrao);
+    }
+    critical_section_exit(&s_cs);
+    return ativo;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file alarm_pattern.h
+ * @brief Gerador de padrões de alarme (LED + buzzer) temporizado por hardware.
+ *
+ * Um padrão é uma sequência compacta de passos (duração, LED aceso/apagado, tom
+ * do buzzer). Cada passo é aplicado no callback de um alarme de hardware do
+ * timer do RP2040, reagendado em relação ao instante em que *deveria* ter
+ * disparado: a cadência não acumula atraso e não depende do loop principal,
+ * do servidor HTTP ou da carga do Wi-Fi. O tom é gerado pelo PWM, sem CPU.
+ *
+ * Vários padrões podem estar ativos ao mesmo tempo; toca o de maior prioridade
+ * (em empate, o mais recente). Quando ele para ou termina, o próximo ativo
+ * recomeça do primeiro passo.
+ *
+ * @author  Manoel Furtado
+ * @date    25 maio 2025
+ */
+
+#ifndef ALARM_PATTERN_H
+#define ALARM_PATTERN_H
+
+#include <stdbool.h> // Para o tipo bool
+#include <stdint.h>  // Para tipos inteiros de largura fixa
+
+#define ALARM_PATTERN_MAX_ATIVOS 4  /**< Padrões ativos simultaneamente. */
+
+/** @brief Um passo do padrão. */
+typedef struct {
+    uint16_t dur_ms;    /**< Duração do passo (1 a 65535 ms). */
+    uint16_t tom_hz;    /**< Frequência do buzzer (20 Hz a 20 kHz); 0 = buzzer mudo. */
+    bool led;           /**< Estado do LED durante o passo. */
+} alarm_step_t;
+
+/** @brief Atalho para declarar passos: `ALARM_PASSO(500, true, 2000)`. */
+#define ALARM_PASSO(ms, led_on, hz) { .dur_ms = (ms), .tom_hz = (hz), .led = (led_on) }
+
+/** @brief Padrão completo (normalmente `static const`). */
+typedef struct {
+    const alarm_step_t *passos; /**< Sequência de passos. */
+    uint8_t n_passos;           /**< Quantidade de passos (> 0). */
+    uint8_t prioridade;         /**< Maior valor vence. */
+    bool repetir;               /**< Recomeça ao fim; se falso, sai da lista ao terminar. */
+} alarm_pattern_t;
+
+/**
+ * @brief Configura o LED como saída e o buzzer como PWM (mudo).
+ * @param led_gpio Pino do LED controlado pelos padrões.
+ * @param buzzer_gpio Pino do buzzer.
+ */
+void alarm_pattern_init(unsigned led_gpio, unsigned buzzer_gpio);
+
+/**
+ * @brief Ativa um padrão. Se ele tiver a maior prioridade, começa imediatamente.
+ * @param padrao Padrão (deve permanecer válido enquanto ativo).
+ * @return Falso se já houver ALARM_PATTERN_MAX_ATIVOS padrões ativos.
+ */
+bool alarm_pattern_start(const alarm_pattern_t *padrao);
+
+/**
+ * @brief Desativa um padrão (sem efeito se não estiver ativo).
+ * @param padrao Padrão.
+ */
+void alarm_pattern_stop(const alarm_pattern_t *padrao);
+
+/**
+ * @brief Desativa todos os padrões, apaga o LED e silencia o buzzer.
+ */
+void alarm_pattern_stop_all(void);
+
+/**
+ * @brief Verifica se um padrão está ativo (tocando ou aguardando prioridade).
+ * @param padrao Padrão.
+ * @return Verdadeiro se ativo.
+ */
+bool alarm_pattern_is_active(const alarm_pattern_t *padrao);
+
+#endif // ALARM_PATTERN_H
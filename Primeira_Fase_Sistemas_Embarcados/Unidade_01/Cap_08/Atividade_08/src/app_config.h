@@ -27,6 +27,9 @@
 
 // Configurações do Alarme
 #define ALARM_BLINK_INTERVAL_MS 500 /**< Intervalo em milissegundos para piscar o LED vermelho e o buzzer. */
+#define ALARM_TONE_HZ 2000           /**< Tom do buzzer (PWM) nos padrões de alarme. */
+#define ALARM_PRIORIDADE_EVACUAR 2   /**< Prioridade do padrão de evacuação. */
+#define ALARM_PRIORIDADE_AVISO 1     /**< Prioridade dos avisos curtos (ex.: desarme). */
 
 // Mensagens para o Display OLED
 #define MSG_EVACUAR "EVACUAR"           /**< Mensagem para estado de alarme ativo. */
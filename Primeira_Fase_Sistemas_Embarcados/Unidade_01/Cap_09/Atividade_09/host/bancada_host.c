@@ -0,0 +1,167 @@
+/**
+ * @file bancada_host.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Bancada dos drivers no Linux sobre a HAL simulada (lib/hal/hal_mock.c).
+ *
+ * @details
+ * Cada cenário roda um driver várias vezes e imprime, por chamada: transações e bytes no
+ * barramento, tempo que elas levariam na placa (relógio simulado), tempo de CPU no host e
+ * o hash do conteúdo enviado. Um hash diferente depois de uma mudança no driver indica
+ * que a saída no barramento mudou; contagens diferentes, que o custo mudou.
+ *
+ * Uso:
+ * @code
+ *   ./bancada_host             # tabela
+ *   ./bancada_host --csv       # uma linha por cenário, para comparar entre versões
+ *   ./bancada_host --registro  # também imprime as transações da inicialização do OLED
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hal_mock.h"
+#include "ssd1306.h"
+#include "neopixel_driver.h"
+#include "tarefa1_temp.h"
+#include "tarefa3_tendencia.h"
+
+/** @brief Um cenário de medição. */
+typedef struct {
+    const char *nome;
+    void (*executar)(void);
+    uint32_t repeticoes;
+} cenario_t;
+
+static uint8_t quadro[ssd1306_buffer_length];
+static struct render_area area_toda = {
+    .start_column = 0, .end_column = ssd1306_width - 1,
+    .start_page = 0, .end_page = ssd1306_n_pages - 1,
+};
+static uint32_t passo;   ///< Muda o conteúdo a cada repetição.
+static volatile float sumidouro;
+static float ultima_media;
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/** @brief Sensor interno com uma rampa lenta e ruído de ±2 contagens. */
+static uint16_t adc_temperatura(uint32_t canal, uint64_t tempo_us) {
+    (void)canal;
+    static uint32_t ruido = 12345;
+    ruido = ruido * 1103515245u + 12345u;
+    return (uint16_t)(876 + tempo_us / 100000u % 20u + (ruido >> 16) % 5u - 2);
+}
+
+// --- Cenários ---
+
+static void oled_init(void) {
+    ssd1306_init();
+}
+
+static void oled_quadro(void) {
+    char texto[16];
+    snprintf(texto, sizeof(texto), "TEMP %lu", (unsigned long)(passo++ % 100));
+    memset(quadro, 0, sizeof(quadro));
+    ssd1306_draw_string(quadro, 0, 0, texto);
+    render_on_display(quadro, &area_toda);
+}
+
+static void oled_limpar(void) {
+    ssd1306_clear_display(quadro);
+}
+
+static void neopixel_quadro(void) {
+    npSetAll((uint8_t)passo, (uint8_t)(passo >> 1), 64);
+    passo++;
+    npWrite();
+}
+
+static void neopixel_brilho(void) {
+    npSetAll(200, 100, 50);
+    npWriteComBrilho(0.5f);
+}
+
+static void temp_media(void) {
+    ultima_media = tarefa1_obter_media_temp(0);
+}
+
+static void tendencia(void) {
+    for (int i = 0; i < 1000; i++) {
+        sumidouro = (float)tarefa3_analisa_tendencia(25.0f + sinf(i * 0.01f));
+    }
+}
+
+static const cenario_t cenarios[] = {
+    { "oled_init",       oled_init,       100 },
+    { "oled_quadro",     oled_quadro,     1000 },
+    { "oled_limpar",     oled_limpar,     1000 },
+    { "neopixel_quadro", neopixel_quadro, 10000 },
+    { "neopixel_brilho", neopixel_brilho, 10000 },
+    { "temp_media",      temp_media,      4 },
+    { "tendencia_x1000", tendencia,       1000 },
+};
+
+int main(int argc, char **argv) {
+    bool csv = false, registro = false;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--csv")) csv = true;
+        else if (!strcmp(argv[i], "--registro")) registro = true;
+        else {
+            fprintf(stderr, "uso: %s [--csv] [--registro]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    hal_mock_adc_fonte(adc_temperatura);
+    npInit(LED_PIN);
+    calculate_render_area_buffer_length(&area_toda);   // Como em setup.c: tela inteira.
+
+    if (registro) {
+        hal_mock_zerar();
+        ssd1306_init();
+        hal_mock_despejar(stdout);
+        printf("\n");
+    }
+
+    if (csv) {
+        printf("cenario;repeticoes;i2c_transacoes;i2c_bytes;pio_palavras;dma_amostras;tempo_sim_us;cpu_ns;hash\n");
+    } else {
+        printf("%-16s %9s %9s %9s %9s %12s %10s  %s\n", "por chamada", "I2C tr.", "I2C B",
+               "PIO pal.", "DMA am.", "barramento", "CPU host", "hash");
+    }
+
+    for (size_t c = 0; c < sizeof(cenarios) / sizeof(cenarios[0]); c++) {
+        const cenario_t *ce = &cenarios[c];
+        hal_mock_contadores_t k;
+        passo = 0;
+        hal_mock_zerar();
+        double t0 = agora_ns();
+        for (uint32_t r = 0; r < ce->repeticoes; r++) {
+            ce->executar();
+        }
+        double cpu_ns = (agora_ns() - t0) / ce->repeticoes;
+        hal_mock_contadores(&k);
+        double n = ce->repeticoes;
+
+        if (csv) {
+            printf("%s;%lu;%.1f;%.1f;%.1f;%.1f;%.1f;%.0f;%08lx\n", ce->nome, (unsigned long)ce->repeticoes,
+                   k.i2c_transacoes / n, k.i2c_bytes / n, k.pio_palavras / n, k.dma_amostras / n,
+                   k.tempo_us / n, cpu_ns, (unsigned long)k.hash);
+        } else {
+            printf("%-16s %9.1f %9.1f %9.1f %9.0f %9.1f us %7.0f ns  %08lx\n", ce->nome,
+                   k.i2c_transacoes / n, k.i2c_bytes / n, k.pio_palavras / n, k.dma_amostras / n,
+                   k.tempo_us / n, cpu_ns, (unsigned long)k.hash);
+        }
+    }
+
+    if (!csv) {
+        printf("\ntemp_media: %.2f °C (fonte simulada: 876 contagens = 27 °C, mais rampa e ruído)\n", ultima_media);
+    }
+    return 0;
+}
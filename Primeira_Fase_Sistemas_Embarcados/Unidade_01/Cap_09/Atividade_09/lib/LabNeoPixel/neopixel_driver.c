@@ -8,11 +8,10 @@
  */
 
 #include "neopixel_driver.h"
-#include "ws2818b.pio.h"
+#include "ponto_fixo.h"
 
 npLED_t leds[LED_COUNT];
-PIO np_pio;
-int sm;
+hal_pio_sm_t np_sm;
 
 /**
  * @brief Descrição da função npInit.
@@ -21,12 +20,8 @@ int sm;
  * @param pin Descrição do parâmetro pin.
  */
 
-void npInit(uint pin) {
-    uint offset = pio_add_program(pio0, &ws2818b_program);
-    np_pio = pio0;
-    sm = 0; // Usar SM 0 fixamente
-    pio_sm_claim(np_pio, sm);
-    ws2818b_program_init(np_pio, sm, offset, pin, 800000.f);
+void npInit(uint32_t pin) {
+    np_sm = hal_pio_ws2818b_iniciar(pin, 800000.f);
     npClear();
 }
 
@@ -37,10 +32,10 @@ void npInit(uint pin) {
  */
 
 void npWrite(void) {
-    for (uint i = 0; i < LED_COUNT; ++i) {
-        pio_sm_put_blocking(np_pio, sm, leds[i].G);
-        pio_sm_put_blocking(np_pio, sm, leds[i].R);
-        pio_sm_put_blocking(np_pio, sm, leds[i].B);
+    for (unsigned i = 0; i < LED_COUNT; ++i) {
+        hal_pio_fifo_escrever(np_sm, leds[i].G);
+        hal_pio_fifo_escrever(np_sm, leds[i].R);
+        hal_pio_fifo_escrever(np_sm, leds[i].B);
     }
 }
 
@@ -52,13 +47,18 @@ void npWrite(void) {
  */
 
 void npWriteComBrilho(float brilho) {
-    for (uint i = 0; i < LED_COUNT; ++i) {
-        uint8_t r = leds[i].R * brilho;
-        uint8_t g = leds[i].G * brilho;
-        uint8_t b = leds[i].B * brilho;
-        pio_sm_put_blocking(np_pio, sm, g);
-        pio_sm_put_blocking(np_pio, sm, r);
-        pio_sm_put_blocking(np_pio, sm, b);
+    // Um float por chamada; por canal, multiplicação inteira (255 × 2^16 cabe em 32 bits)
+    // truncada. k = brilho·2^16 arredondado, então cada canal fica a no máximo 1 da
+    // conversão float -> uint8_t de antes; igual só quando brilho·2^16 é inteiro (0,5,
+    // 0,25...). Ex.: brilho = 1/3 e R = 3 davam 1 e agora dão 0.
+    uint32_t k = (uint32_t)pf_q16_de_float(brilho);
+    for (unsigned i = 0; i < LED_COUNT; ++i) {
+        uint8_t r = (uint8_t)((leds[i].R * k) >> 16);
+        uint8_t g = (uint8_t)((leds[i].G * k) >> 16);
+        uint8_t b = (uint8_t)((leds[i].B * k) >> 16);
+        hal_pio_fifo_escrever(np_sm, g);
+        hal_pio_fifo_escrever(np_sm, r);
+        hal_pio_fifo_escrever(np_sm, b);
     }
 }
 
@@ -90,7 +90,7 @@ void npSetLED(uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
  */
 
 void npSetAll(uint8_t r, uint8_t g, uint8_t b) {
-    for (uint i = 0; i < LED_COUNT; ++i) {
+    for (unsigned i = 0; i < LED_COUNT; ++i) {
         npSetLED(i, r, g, b);
     }
 }
@@ -109,14 +109,12 @@ void npClear(void) {
  * @brief Descrição da função liberar_maquina_pio.
  *
  * @details Explique aqui a lógica da função, parâmetros de entrada e o que ela retorna.
- * @param pio Descrição do parâmetro pio.
  * @param sm_id Descrição do parâmetro sm_id.
  */
 
-void liberar_maquina_pio(PIO pio, uint sm_id) {
-    if (sm_id < 4) {
-        pio_sm_set_enabled(pio, sm_id, false);
-        pio_sm_unclaim(pio, sm_id);
+void liberar_maquina_pio(hal_pio_sm_t sm_id) {
+    if (sm_id.sm < 4) {
+        hal_pio_liberar(sm_id);
     }
 }
 
@@ -129,9 +127,9 @@ void liberar_maquina_pio(PIO pio, uint sm_id) {
  * @return Valor de retorno descrevendo o significado.
  */
 
-uint getLEDIndex(uint x, uint y) {
+unsigned getLEDIndex(unsigned x, unsigned y) {
     if (x >= NUM_COLUNAS || y >= NUM_LINHAS) return 0;
-    uint linha_fisica = NUM_LINHAS - 1 - y;
-    uint base = linha_fisica * NUM_COLUNAS;
+    unsigned linha_fisica = NUM_LINHAS - 1 - y;
+    unsigned base = linha_fisica * NUM_COLUNAS;
     return (linha_fisica % 2 == 0) ? base + (NUM_COLUNAS - 1 - x) : base + x;
 }
\ No newline at end of file
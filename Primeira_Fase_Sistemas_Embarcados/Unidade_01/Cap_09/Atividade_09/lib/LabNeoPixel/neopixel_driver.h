@@ -11,7 +11,7 @@
 #define NEOPIXEL_DRIVER_H
 
 #include <stdint.h>
-#include "hardware/pio.h"
+#include "hal.h"
 
 #define LED_COUNT 25
 #define LED_PIN 7
@@ -28,16 +28,15 @@ typedef struct {
 } npLED_t;
 
 extern npLED_t leds[LED_COUNT];
-extern PIO np_pio;
-extern int sm;
+extern hal_pio_sm_t np_sm;
 
-void npInit(uint pin);
+void npInit(uint32_t pin);
 void npWrite(void);
 void npWriteComBrilho(float brilho);
 void npSetLED(uint8_t index, uint8_t r, uint8_t g, uint8_t b);
 void npSetAll(uint8_t r, uint8_t g, uint8_t b);
 void npClear(void);
-void liberar_maquina_pio(PIO pio, uint sm);
-uint getLEDIndex(uint x, uint y);
+void liberar_maquina_pio(hal_pio_sm_t sm);
+unsigned getLEDIndex(unsigned x, unsigned y);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+/**
+ * @file hal.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Camada fina de acesso ao hardware usada pelos drivers (I2C, GPIO, FIFO da PIO,
+ *        ADC + DMA e tempo).
+ *
+ * @details
+ * Os drivers (`ssd1306_i2c.c`, `neopixel_driver.c`, `tarefa1_temp.c`) chamam só estas
+ * funções, sem incluir cabeçalhos do pico-sdk. Há duas implementações:
+ * - `hal_pico.c`: repassa para o SDK (build da placa, CMakeLists.txt da raiz).
+ * - `hal_mock.c`: Linux. Registra cada transação, conta operações e bytes, soma um hash do
+ *   conteúdo enviado e avança um relógio simulado com o custo que a operação teria no
+ *   barramento (veja hal_mock.h). Usada por `host/bancada_host.c`:
+ * @code
+ *   cmake -S host -B build_host && cmake --build build_host && ./build_host/bancada_host
+ * @endcode
+ *
+ * Este cabeçalho não depende do SDK, para que os drivers compilem nos dois lados.
+ *
+ * Fora daqui: o driver PIO do DHT22 (Unidade_02/Cap_04/Atividade_04/dht22.c) é de outro
+ * projeto e usa bem mais que a FIFO TX daqui (carga do programa e `pio_sm_exec`, IRQ da
+ * PIO, FIFO RX e alarmes de repetição/timeout); no host só sobraria a decodificação.
+ */
+
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Controlador I2C. */
+typedef enum {
+    HAL_I2C0 = 0,
+    HAL_I2C1 = 1,
+} hal_i2c_t;
+
+/** @brief Máquina de estados da PIO (bloco e índice). */
+typedef struct {
+    uint8_t pio;
+    uint8_t sm;
+} hal_pio_sm_t;
+
+// --- Tempo ---
+
+/** @brief Microssegundos desde o boot (no mock, o relógio simulado). */
+uint64_t hal_tempo_us(void);
+
+/** @brief Espera ativa (no mock, só avança o relógio simulado). */
+void hal_espera_us(uint32_t us);
+
+// --- GPIO ---
+
+void hal_gpio_escrever(uint32_t pino, bool nivel);
+bool hal_gpio_ler(uint32_t pino);
+
+// --- I2C ---
+
+/**
+ * @brief Escrita bloqueante de `n` bytes no dispositivo `endereco`.
+ * @param sem_stop `true` mantém o barramento (repeated start na próxima transação).
+ * @return Bytes escritos ou negativo em caso de erro (NACK).
+ */
+int hal_i2c_escrever(hal_i2c_t i2c, uint8_t endereco, const uint8_t *dados, size_t n, bool sem_stop);
+
+// --- PIO ---
+
+/** @brief Carrega o programa ws2818b numa máquina de estados livre e a inicia no pino. */
+hal_pio_sm_t hal_pio_ws2818b_iniciar(uint32_t pino, float freq_hz);
+
+/** @brief Escreve uma palavra na FIFO TX, esperando se ela estiver cheia. */
+void hal_pio_fifo_escrever(hal_pio_sm_t sm, uint32_t palavra);
+
+/** @brief Desabilita e libera a máquina de estados. */
+void hal_pio_liberar(hal_pio_sm_t sm);
+
+// --- ADC e DMA ---
+
+void hal_adc_selecionar(uint32_t canal);
+uint16_t hal_adc_ler(void);
+
+/**
+ * @brief Inicia a captura contínua de `n` conversões do canal `canal_adc` para `destino`
+ *        pelo canal de DMA `canal_dma` (FIFO do ADC, 16 bits, DREQ do ADC).
+ */
+void hal_adc_dma_iniciar(int canal_dma, uint32_t canal_adc, uint16_t *destino, uint32_t n);
+
+/** @brief Espera (dormindo em `wfi`) o fim da captura e para o ADC. */
+void hal_adc_dma_aguardar(int canal_dma);
+
+#endif // HAL_H
@@ -0,0 +1,177 @@
+/**
+ * @file hal_mock.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Implementação de hal.h para Linux: registra transações e simula o tempo.
+ */
+
+#include "hal_mock.h"
+#include <string.h>
+
+#define FNV_BASE   2166136261u
+#define FNV_PRIMO  16777619u
+#define ADC_REPOUSO 876u   ///< 0,706 V no sensor interno = 27 °C.
+
+static uint64_t relogio_us;
+static uint64_t relogio_ns_resto;          ///< Frações de µs da PIO.
+static hal_mock_contadores_t cont = { .hash = FNV_BASE };
+static hal_mock_transacao_t registro[HAL_MOCK_REGISTRO_MAX];
+static hal_mock_adc_fonte_t fonte_adc;
+static uint32_t canal_adc;
+static uint32_t falhas_i2c;
+static uint32_t niveis_gpio[2];            ///< Pinos 0..63.
+static uint8_t pio_proxima_sm;
+
+static void avancar_us(uint64_t us) {
+    relogio_us += us;
+    cont.tempo_us += us;
+}
+
+static void avancar_ns(uint64_t ns) {
+    relogio_ns_resto += ns;
+    avancar_us(relogio_ns_resto / 1000u);
+    relogio_ns_resto %= 1000u;
+}
+
+static void hash_byte(uint8_t b) {
+    cont.hash = (cont.hash ^ b) * FNV_PRIMO;
+}
+
+static void registrar(uint8_t tipo, uint8_t alvo, uint16_t endereco, uint32_t n, uint32_t valor) {
+    registro[cont.transacoes % HAL_MOCK_REGISTRO_MAX] = (hal_mock_transacao_t){
+        .tempo_us = relogio_us, .tipo = tipo, .alvo = alvo,
+        .endereco = endereco, .n = n, .valor = valor,
+    };
+    cont.transacoes++;
+}
+
+static uint16_t converter(void) {
+    uint16_t v = fonte_adc ? fonte_adc(canal_adc, relogio_us) : ADC_REPOUSO;
+    avancar_us(HAL_MOCK_ADC_US);
+    return v & 0x0FFFu;
+}
+
+// --- hal.h ---
+
+uint64_t hal_tempo_us(void) {
+    return relogio_us;
+}
+
+void hal_espera_us(uint32_t us) {
+    registrar(HAL_MOCK_ESPERA, 0, 0, us, 0);
+    avancar_us(us);
+}
+
+void hal_gpio_escrever(uint32_t pino, bool nivel) {
+    registrar(HAL_MOCK_GPIO, 0, (uint16_t)pino, 1, nivel);
+    cont.gpio_escritas++;
+    if (pino < 64) {
+        if (nivel) niveis_gpio[pino / 32] |= 1u << (pino % 32);
+        else niveis_gpio[pino / 32] &= ~(1u << (pino % 32));
+    }
+}
+
+bool hal_gpio_ler(uint32_t pino) {
+    return pino < 64 && (niveis_gpio[pino / 32] >> (pino % 32)) & 1u;
+}
+
+int hal_i2c_escrever(hal_i2c_t i2c, uint8_t endereco, const uint8_t *dados, size_t n, bool sem_stop) {
+    registrar(HAL_MOCK_I2C, (uint8_t)i2c, endereco, (uint32_t)n, n ? dados[0] : 0);
+    // START + endereço + dados (9 bits cada, com ACK) + STOP.
+    uint64_t bits = 1u + 9u * (n + 1u) + (sem_stop ? 0u : 1u);
+    avancar_ns(bits * 1000000000ull / HAL_MOCK_I2C_HZ);
+    if (falhas_i2c) {
+        falhas_i2c--;
+        return -1;
+    }
+    cont.i2c_transacoes++;
+    cont.i2c_bytes += (uint32_t)n;
+    hash_byte(endereco);
+    for (size_t i = 0; i < n; i++) {
+        hash_byte(dados[i]);
+    }
+    return (int)n;
+}
+
+hal_pio_sm_t hal_pio_ws2818b_iniciar(uint32_t pino, float freq_hz) {
+    (void)freq_hz;
+    hal_pio_sm_t sm = { 0, pio_proxima_sm++ & 3u };
+    registrar(HAL_MOCK_PIO, sm.pio, sm.sm, 0, pino);
+    return sm;
+}
+
+void hal_pio_fifo_escrever(hal_pio_sm_t sm, uint32_t palavra) {
+    registrar(HAL_MOCK_PIO, sm.pio, sm.sm, 1, palavra);
+    cont.pio_palavras++;
+    for (int i = 0; i < 4; i++) {
+        hash_byte((uint8_t)(palavra >> (8 * i)));
+    }
+    avancar_ns(8u * HAL_MOCK_PIO_BIT_NS);
+}
+
+void hal_pio_liberar(hal_pio_sm_t sm) {
+    (void)sm;
+}
+
+void hal_adc_selecionar(uint32_t canal) {
+    canal_adc = canal;
+}
+
+uint16_t hal_adc_ler(void) {
+    uint16_t v = converter();
+    registrar(HAL_MOCK_ADC, 0, (uint16_t)canal_adc, 1, v);
+    cont.adc_leituras++;
+    return v;
+}
+
+void hal_adc_dma_iniciar(int canal_dma, uint32_t canal, uint16_t *destino, uint32_t n) {
+    canal_adc = canal;
+    registrar(HAL_MOCK_DMA, (uint8_t)canal_dma, (uint16_t)canal, n, 0);
+    // A captura é feita aqui mesmo; o tempo avança como se o DMA a fizesse.
+    for (uint32_t i = 0; i < n; i++) {
+        destino[i] = converter();
+    }
+    cont.dma_blocos++;
+    cont.dma_amostras += n;
+}
+
+void hal_adc_dma_aguardar(int canal_dma) {
+    (void)canal_dma;
+}
+
+// --- hal_mock.h ---
+
+void hal_mock_zerar(void) {
+    memset(&cont, 0, sizeof(cont));
+    cont.hash = FNV_BASE;
+}
+
+void hal_mock_contadores(hal_mock_contadores_t *out) {
+    *out = cont;
+}
+
+void hal_mock_adc_fonte(hal_mock_adc_fonte_t fonte) {
+    fonte_adc = fonte;
+}
+
+void hal_mock_i2c_falhar(uint32_t n) {
+    falhas_i2c = n;
+}
+
+const hal_mock_transacao_t *hal_mock_transacao(uint32_t i) {
+    uint32_t guardadas = cont.transacoes < HAL_MOCK_REGISTRO_MAX ? cont.transacoes : HAL_MOCK_REGISTRO_MAX;
+    if (i >= guardadas) {
+        return NULL;
+    }
+    return &registro[(cont.transacoes - guardadas + i) % HAL_MOCK_REGISTRO_MAX];
+}
+
+void hal_mock_despejar(FILE *saida) {
+    static const char *const nomes[] = { "?", "I2C", "PIO", "GPIO", "ADC", "DMA", "ESPERA" };
+    const hal_mock_transacao_t *t;
+    for (uint32_t i = 0; (t = hal_mock_transacao(i)) != NULL; i++) {
+        fprintf(saida, "%10llu us  %-6s alvo %u end 0x%02x  n %lu  valor 0x%08lx\n",
+                (unsigned long long)t->tempo_us, nomes[t->tipo < 7 ? t->tipo : 0], t->alvo,
+                t->endereco, (unsigned long)t->n, (unsigned long)t->valor);
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * @file hal_mock.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Inspeção e controle da implementação de hal.h para Linux (hal_mock.c).
+ *
+ * @details
+ * Relógio simulado: cada operação avança o tempo pelo custo que teria na placa.
+ * - I2C a HAL_MOCK_I2C_HZ: 9 bits por byte (mais o do endereço), START e STOP.
+ * - FIFO da PIO: o programa ws2818b desloca 8 bits por palavra a 800 kHz (10 µs).
+ * - ADC: 2 µs por conversão (500 kS/s), também nas capturas por DMA.
+ *
+ * Os contadores e o hash (FNV-1a do conteúdo enviado por I2C e PIO) servem para comparar
+ * um driver antes e depois de uma mudança: mesmo hash = mesma saída no barramento.
+ */
+
+#ifndef HAL_MOCK_H
+#define HAL_MOCK_H
+
+#include <stdio.h>
+#include "hal.h"
+
+#define HAL_MOCK_I2C_HZ         400000u   ///< Mesmo clock de setup.c.
+#define HAL_MOCK_PIO_BIT_NS     1250u     ///< Bit do WS2812 a 800 kHz.
+#define HAL_MOCK_ADC_US         2u        ///< Uma conversão do ADC.
+#define HAL_MOCK_REGISTRO_MAX   4096      ///< Transações guardadas (anel).
+
+/** @brief Tipo de transação registrada. */
+typedef enum {
+    HAL_MOCK_I2C = 1,
+    HAL_MOCK_PIO,
+    HAL_MOCK_GPIO,
+    HAL_MOCK_ADC,
+    HAL_MOCK_DMA,
+    HAL_MOCK_ESPERA,
+} hal_mock_tipo_t;
+
+/** @brief Uma transação do registro. */
+typedef struct {
+    uint64_t tempo_us;       ///< Início, no relógio simulado.
+    uint8_t tipo;            ///< hal_mock_tipo_t.
+    uint8_t alvo;            ///< Controlador I2C, bloco da PIO ou canal do DMA.
+    uint16_t endereco;       ///< Endereço I2C, máquina de estados, pino ou canal do ADC.
+    uint32_t n;              ///< Bytes, palavras ou amostras.
+    uint32_t valor;          ///< Primeira palavra/byte ou nível/leitura.
+} hal_mock_transacao_t;
+
+/** @brief Contadores acumulados desde hal_mock_zerar(). */
+typedef struct {
+    uint32_t i2c_transacoes;
+    uint32_t i2c_bytes;
+    uint32_t pio_palavras;
+    uint32_t gpio_escritas;
+    uint32_t adc_leituras;
+    uint32_t dma_blocos;
+    uint32_t dma_amostras;
+    uint32_t transacoes;     ///< Total registrado (pode passar de HAL_MOCK_REGISTRO_MAX).
+    uint64_t tempo_us;       ///< Tempo simulado gasto.
+    uint32_t hash;           ///< FNV-1a dos bytes I2C e palavras PIO, em ordem.
+} hal_mock_contadores_t;
+
+/**
+ * @brief Gera a leitura do ADC simulado.
+ * @param canal Canal selecionado (4 = sensor de temperatura).
+ * @param tempo_us Instante da conversão no relógio simulado.
+ */
+typedef uint16_t (*hal_mock_adc_fonte_t)(uint32_t canal, uint64_t tempo_us);
+
+/** @brief Zera contadores, hash e registro (o relógio continua). */
+void hal_mock_zerar(void);
+
+/** @brief Copia os contadores. */
+void hal_mock_contadores(hal_mock_contadores_t *out);
+
+/** @brief Troca a fonte do ADC (NULL: 876 contagens, ~27 °C no sensor interno). */
+void hal_mock_adc_fonte(hal_mock_adc_fonte_t fonte);
+
+/** @brief Faz as próximas `n` escritas I2C falharem (NACK). */
+void hal_mock_i2c_falhar(uint32_t n);
+
+/** @brief Transação `i` das mais recentes (0 = mais antiga guardada), ou NULL. */
+const hal_mock_transacao_t *hal_mock_transacao(uint32_t i);
+
+/** @brief Imprime o registro guardado, uma transação por linha. */
+void hal_mock_despejar(FILE *saida);
+
+#endif // HAL_MOCK_H
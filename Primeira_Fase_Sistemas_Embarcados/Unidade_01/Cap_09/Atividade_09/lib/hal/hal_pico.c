@@ -0,0 +1,87 @@
+/**
+ * @file hal_pico.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Implementação de hal.h sobre o pico-sdk (build da placa).
+ */
+
+#include "hal.h"
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "hardware/sync.h"
+#include "ws2818b.pio.h"
+
+static inline PIO pio_de(hal_pio_sm_t sm) {
+    return sm.pio ? pio1 : pio0;
+}
+
+uint64_t hal_tempo_us(void) {
+    return time_us_64();
+}
+
+void hal_espera_us(uint32_t us) {
+    busy_wait_us_32(us);
+}
+
+void hal_gpio_escrever(uint32_t pino, bool nivel) {
+    gpio_put(pino, nivel);
+}
+
+bool hal_gpio_ler(uint32_t pino) {
+    return gpio_get(pino);
+}
+
+int hal_i2c_escrever(hal_i2c_t i2c, uint8_t endereco, const uint8_t *dados, size_t n, bool sem_stop) {
+    return i2c_write_blocking(i2c == HAL_I2C1 ? i2c1 : i2c0, endereco, dados, n, sem_stop);
+}
+
+hal_pio_sm_t hal_pio_ws2818b_iniciar(uint32_t pino, float freq_hz) {
+    uint offset = pio_add_program(pio0, &ws2818b_program);
+    hal_pio_sm_t sm = { 0, 0 };   // SM 0 fixa, como antes
+    pio_sm_claim(pio0, sm.sm);
+    ws2818b_program_init(pio0, sm.sm, offset, pino, freq_hz);
+    return sm;
+}
+
+void hal_pio_fifo_escrever(hal_pio_sm_t sm, uint32_t palavra) {
+    pio_sm_put_blocking(pio_de(sm), sm.sm, palavra);
+}
+
+void hal_pio_liberar(hal_pio_sm_t sm) {
+    pio_sm_set_enabled(pio_de(sm), sm.sm, false);
+    pio_sm_unclaim(pio_de(sm), sm.sm);
+}
+
+void hal_adc_selecionar(uint32_t canal) {
+    adc_select_input(canal);
+}
+
+uint16_t hal_adc_ler(void) {
+    return adc_read();
+}
+
+void hal_adc_dma_iniciar(int canal_dma, uint32_t canal_adc, uint16_t *destino, uint32_t n) {
+    adc_select_input(canal_adc);
+    adc_fifo_drain();
+    adc_run(false);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_run(true);
+
+    dma_channel_config cfg = dma_channel_get_default_config(canal_dma);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);   // FIFO do ADC fixo
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    dma_channel_configure(canal_dma, &cfg, destino, &adc_hw->fifo, n, true);
+}
+
+void hal_adc_dma_aguardar(int canal_dma) {
+    // A interrupção de fim do canal (irq_handlers.c) acorda o wfi.
+    while (dma_channel_is_busy(canal_dma)) {
+        __wfi();
+    }
+    adc_run(false);
+}
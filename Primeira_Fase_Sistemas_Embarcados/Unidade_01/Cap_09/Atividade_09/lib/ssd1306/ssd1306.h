@@ -22,7 +22,7 @@ extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t charac
 extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, const char *string);
 extern void ssd1306_command(ssd1306_t *ssd, uint8_t command);
 extern void ssd1306_config(ssd1306_t *ssd);
-extern void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+extern void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, hal_i2c_t i2c);
 extern void ssd1306_send_data(ssd1306_t *ssd);
 extern void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap);
 extern void ssd1306_clear_display(uint8_t *ssd);
\ No newline at end of file
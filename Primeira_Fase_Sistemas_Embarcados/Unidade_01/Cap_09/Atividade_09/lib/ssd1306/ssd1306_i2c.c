@@ -7,16 +7,19 @@
  *          a geração de documentação automática. (Gerado em 25/05/2025).
  */
 
+#include <assert.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
-#include "pico/stdlib.h"
-#include "pico/binary_info.h"
-#include "hardware/i2c.h"
+#include "hal.h"
 #include "ssd1306_font.h"
 #include "ssd1306_i2c.h"
 
+#ifndef count_of
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#endif
+
 // Calcular quanto do buffer será destinado à área de renderização
 /**
  * @brief Descrição da função calculate_render_area_buffer_length.
@@ -39,7 +42,7 @@ void calculate_render_area_buffer_length(struct render_area *area) {
 
 void ssd1306_send_command(uint8_t command) {
     uint8_t buffer[2] = {0x80, command};
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, buffer, 2, false);
+    hal_i2c_escrever(HAL_I2C1, ssd1306_i2c_address, buffer, 2, false);
 }
 
 // Envia uma lista de comandos ao hardware
@@ -72,7 +75,7 @@ void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
     temp_buffer[0] = 0x40;
     memcpy(temp_buffer + 1, ssd, buffer_length);
 
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
+    hal_i2c_escrever(HAL_I2C1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
 
     free(temp_buffer);
 }
@@ -236,7 +239,7 @@ void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool se
 }
 
 // Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
-inline int ssd1306_get_font(uint8_t character)
+static inline int ssd1306_get_font(uint8_t character)
 /**
  * @brief Descrição da função ssd1306_get_font.
  *
@@ -316,7 +319,7 @@ void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
+  hal_i2c_escrever(
 	ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false );
 }
 
@@ -369,7 +372,7 @@ void ssd1306_config(ssd1306_t *ssd) {
  * @param i2c Descrição do parâmetro i2c.
  */
 
-void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+void ssd1306_init_bm(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, hal_i2c_t i2c) {
     ssd->width = width;
     ssd->height = height;
     ssd->pages = height / 8U;
@@ -396,7 +399,7 @@ void ssd1306_send_data(ssd1306_t *ssd) {
     ssd1306_command(ssd, ssd1306_set_page_address);
     ssd1306_command(ssd, 0);
     ssd1306_command(ssd, ssd->pages - 1);
-    i2c_write_blocking(
+    hal_i2c_escrever(
     ssd->i2c_port, ssd->address, ssd->ram_buffer, ssd->bufsize, false );
 }
 
@@ -8,12 +8,15 @@
  */
 
 #include <stdlib.h>
-#include "pico/stdlib.h"
-#include "hardware/i2c.h"
+#include "hal.h"
 
 #ifndef ssd1306_inc_h
 #define ssd1306_inc_h
 
+#ifndef _u
+#define _u(x) x ## u   // Mesmo do pico-sdk, para compilar também no host
+#endif
+
 #define ssd1306_height 64 // Define a altura do display (32 pixels)
 #define ssd1306_width 128 // Define a largura do display (128 pixels)
 
@@ -67,7 +70,7 @@ struct render_area {
 
 typedef struct {
   uint8_t width, height, pages, address;
-  i2c_inst_t * i2c_port;
+  hal_i2c_t i2c_port;
   bool external_vcc;
   uint8_t *ram_buffer;
   size_t bufsize;
@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+"""
+@file verifica_execucao.py
+@author Manoel Felipe Costa Furtado
+@copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+@brief Confere uma execução no Renode (renode/atividade_09.robot): decodifica a UART
+       capturada (LOG_BIN e despejo do trace) e o log de acessos ao I2C, e compara
+       com os orçamentos de tempo.
+
+Uso:
+    python3 verifica_execucao.py build_uart/Atividade_09.elf uart0.bin \\
+        --log-renode renode.log --temperatura 27
+
+Verificações (cada uma é pulada se a captura não tiver o dado):
+- LOG_BIN "ciclo (us)": cada tarefa abaixo do seu --tN-max-us e a soma abaixo do
+  período do ciclo (1 s, PERIODO_CICLO_MS): passar dele faz o timer T1 disparar com
+  o ciclo anterior ainda no laço. Padrões: t1 = janela de 0,5 s de amostragem
+  (tarefa1_temp.c) com folga; t2 = dois quadros do OLED a 400 kHz (~47 ms).
+- LOG_BIN de 1 s: latência amostra->OLED abaixo de --latencia-oled-max-us e
+  temperatura a ±--tolerancia de --temperatura, se informada.
+- Trace: do callback do timer T1 (marca, em IRQ) ao início da zona T1 no laço
+  principal, abaixo de --despacho-max-us; duração de cada IRQ abaixo de --isr-max-us.
+- I2C: o endereço do OLED (0x3C) escrito em IC_TAR e pelo menos um quadro
+  (1024 bytes em IC_DATA_CMD) por ciclo decodificado.
+
+Os tempos são do relógio virtual do Renode, que não modela ciclos de barramento,
+wait states da flash nem o cache do XIP: servem para pegar regressões grandes
+(laço a mais, espera esquecida, IRQ que não dispara), não para medir a placa.
+
+Código de saída: 0 se tudo passou, 1 se alguma verificação falhou, 2 se faltou
+dado obrigatório (nenhuma mensagem LOG_BIN decodificada).
+"""
+
+import argparse
+import io
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "tools"))
+from log_bin_decode import Decodificador, Elf   # noqa: E402
+from trace_to_chrome import ler_despejo, desenrolar, ISR_ENTRA, ISR_SAI, ZONA_INICIO, MARCA  # noqa: E402
+
+# Deve ser igual a Atividade_09.c
+ZONA_T1 = 1
+MARCA_TIMER_T1 = 1
+PERIODO_CICLO_US = 1000 * 1000
+
+# Registradores do DW_apb_i2c (RP2040 datasheet, 4.3.17)
+IC_TAR = 0x04
+IC_DATA_CMD = 0x10
+ENDERECO_OLED = 0x3C
+BYTES_QUADRO = 1024    # 128 x 64 / 8
+
+RE_CICLO = re.compile(r"ciclo \(us\): t1 (-?\d+) t2 (-?\d+) t3 (-?\d+) t4 (-?\d+)")
+RE_RESUMO = re.compile(r"(-?\d+\.\d+) °C \| Tend: .* max (\d+)")
+RE_I2C = re.compile(r"i2c1\b.*Write\w*\s+to\s+0x([0-9a-fA-F]+).*value\s+0x([0-9a-fA-F]+)")
+
+
+class Relatorio:
+    def __init__(self):
+        self.falhas = 0
+
+    def conferir(self, nome, ok, detalhe):
+        print("{:5} {:28} {}".format("OK" if ok else "FALHA", nome, detalhe))
+        if not ok:
+            self.falhas += 1
+
+    def pular(self, nome, motivo):
+        print("{:5} {:28} {}".format("-", nome, motivo))
+
+
+def decodificar_log(elf, bruto):
+    """Mensagens LOG_BIN da captura, sem o prefixo de tempo/núcleo."""
+    texto = io.StringIO()
+    Decodificador(elf, texto).processar(bytearray(bruto))
+    return [linha.split("] ", 1)[-1].split(" ", 1)[-1] for linha in texto.getvalue().splitlines()
+            if not linha.startswith("#")]
+
+
+def ler_trace(bruto):
+    """Último despejo completo do trace_recorder, ou None."""
+    linhas = bruto.decode("latin-1").splitlines()
+    try:
+        return ler_despejo(linhas)
+    except SystemExit:
+        return None
+
+
+def verificar_log(rel, msgs, args):
+    ciclos = [tuple(int(v) for v in m.groups()) for m in map(RE_CICLO.search, msgs) if m]
+    resumos = [(float(m.group(1)), int(m.group(2))) for m in map(RE_RESUMO.search, msgs) if m]
+
+    if ciclos:
+        # O primeiro ciclo inclui a inicialização do OLED e dos timers.
+        medidos = ciclos[1:] or ciclos
+        limites = (args.t1_max_us, args.t2_max_us, args.t3_max_us, args.t4_max_us)
+        for i, limite in enumerate(limites):
+            pior = max(c[i] for c in medidos)
+            rel.conferir("tarefa t{}".format(i + 1), 0 <= pior <= limite,
+                         "pior {} us em {} ciclos (máx. {})".format(pior, len(medidos), limite))
+        pior = max(sum(c) for c in medidos)
+        rel.conferir("ciclo t1+t2+t3+t4", pior <= PERIODO_CICLO_US,
+                     "pior {} us (período {})".format(pior, PERIODO_CICLO_US))
+    else:
+        rel.pular("tarefas t1..t4", "nenhuma mensagem 'ciclo (us)' (build RTOS?)")
+
+    if resumos:
+        pior = resumos[-1][1]
+        rel.conferir("latência amostra->OLED", pior <= args.latencia_oled_max_us,
+                     "máx. acumulado {} us (máx. {})".format(pior, args.latencia_oled_max_us))
+        if args.temperatura is not None:
+            temps = [r[0] for r in resumos[1:]] or [resumos[0][0]]
+            desvio = max(abs(t - args.temperatura) for t in temps)
+            rel.conferir("temperatura", desvio <= args.tolerancia,
+                         "{:.2f}..{:.2f} °C (esperado {} ± {})".format(
+                             min(temps), max(temps), args.temperatura, args.tolerancia))
+    else:
+        rel.pular("latência / temperatura", "nenhuma mensagem de 1 s")
+    return len(ciclos)
+
+
+def verificar_trace(rel, despejo, args):
+    if despejo is None:
+        rel.pular("trace", "sem despejo completo (envie 't' antes de parar)")
+        return
+
+    despachos, isr, abertas, marca_t1 = [], [], {}, {}
+    for nucleo, ts32, tipo, ident in despejo["eventos"]:
+        t = desenrolar(despejo["agora"], ts32)
+        if tipo == MARCA and ident == MARCA_TIMER_T1:
+            marca_t1[nucleo] = t
+        elif tipo == ZONA_INICIO and ident == ZONA_T1:
+            # O callback pode ter rodado no outro núcleo: vale a marca mais recente.
+            if marca_t1:
+                ini = max(marca_t1.values())
+                despachos.append(t - ini)
+                marca_t1.clear()
+        elif tipo == ISR_ENTRA:
+            abertas[(nucleo, ident)] = t
+        elif tipo == ISR_SAI and (nucleo, ident) in abertas:
+            isr.append((t - abertas.pop((nucleo, ident)), ident))
+
+    if despachos:
+        pior = max(despachos)
+        rel.conferir("despacho timer T1 -> laço", pior <= args.despacho_max_us,
+                     "pior {} us em {} ciclos (máx. {})".format(pior, len(despachos), args.despacho_max_us))
+    else:
+        rel.pular("despacho timer T1 -> laço", "nenhum par marca/zona no trace")
+
+    if isr:
+        pior, irq = max(isr)
+        rel.conferir("duração de IRQ", pior <= args.isr_max_us,
+                     "pior {} us (IRQ {}), {} execuções (máx. {})".format(pior, irq, len(isr), args.isr_max_us))
+    else:
+        rel.pular("duração de IRQ", "nenhuma IRQ no trace")
+
+
+def verificar_i2c(rel, caminho, ciclos):
+    if not caminho:
+        rel.pular("I2C", "sem --log-renode")
+        return
+    alvos, dados = set(), 0
+    with open(caminho, errors="replace") as f:
+        for linha in f:
+            m = RE_I2C.search(linha)
+            if not m:
+                continue
+            reg, valor = int(m.group(1), 16), int(m.group(2), 16)
+            if reg == IC_TAR:
+                alvos.add(valor & 0x3FF)
+            elif reg == IC_DATA_CMD:
+                dados += 1
+    rel.conferir("I2C endereço do OLED", ENDERECO_OLED in alvos,
+                 "IC_TAR: {}".format(", ".join("0x{:02x}".format(a) for a in sorted(alvos)) or "nenhum"))
+    minimo = BYTES_QUADRO * max(ciclos, 1)
+    rel.conferir("I2C quadros do OLED", dados >= minimo,
+                 "{} bytes em IC_DATA_CMD (mín. {} para {} ciclos)".format(dados, minimo, ciclos))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Verificação de uma execução no Renode")
+    ap.add_argument("elf", help="ELF do firmware emulado (mesmo build)")
+    ap.add_argument("captura", help="saída bruta da UART0 (CreateFileBackend)")
+    ap.add_argument("--log-renode", help="log do Renode com os acessos ao i2c1 (LogPeripheralAccess)")
+    ap.add_argument("--temperatura", type=float, help="temperatura esperada (°C) para a tensão do ADC")
+    ap.add_argument("--tolerancia", type=float, default=1.5, help="°C (padrão: 1,5)")
+    ap.add_argument("--t1-max-us", type=int, default=550000)
+    ap.add_argument("--t2-max-us", type=int, default=60000)
+    ap.add_argument("--t3-max-us", type=int, default=1000)
+    ap.add_argument("--t4-max-us", type=int, default=5000)
+    ap.add_argument("--latencia-oled-max-us", type=int, default=100000)
+    ap.add_argument("--despacho-max-us", type=int, default=2000)
+    ap.add_argument("--isr-max-us", type=int, default=50)
+    args = ap.parse_args()
+
+    with open(args.captura, "rb") as f:
+        bruto = f.read()
+    msgs = decodificar_log(Elf(args.elf), bruto)
+    if not msgs:
+        print("Nenhuma mensagem LOG_BIN na captura ({} bytes).".format(len(bruto)), file=sys.stderr)
+        return 2
+
+    rel = Relatorio()
+    ciclos = verificar_log(rel, msgs, args)
+    verificar_trace(rel, ler_trace(bruto), args)
+    verificar_i2c(rel, args.log_renode, ciclos)
+    return 1 if rel.falhas else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
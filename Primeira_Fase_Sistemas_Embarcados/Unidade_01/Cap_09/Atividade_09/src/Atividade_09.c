@@ -40,6 +40,34 @@
  *      callback (setando flags) e processar de fato no laço
  *      principal. Assim evitamos bloqueios longos em IRQ.
  *
+ *      TRACE
+ *      -----
+ *      Cada tarefa é gravada como uma "zona" e a IRQ do DMA e
+ *      os callbacks de timer como eventos (trace_recorder.h).
+ *      Enviar 't' pelo terminal despeja a gravação; o script
+ *      tools/trace_to_chrome.py gera o JSON para
+ *      chrome://tracing ou ui.perfetto.dev.
+ *
+ *      LOG BINÁRIO
+ *      -----------
+ *      O tempo de cada tarefa (por ciclo) e o resumo de 1 s
+ *      saem por LOG_BIN (log_binario.h): a placa grava só o
+ *      id do formato e os argumentos; o script
+ *      tools/log_bin_decode.py formata as mensagens no PC.
+ *
+ *      FALHAS
+ *      ------
+ *      HardFault, laço travado (pré-watchdog), reset por
+ *      watchdog e panic/assert gravam um registro que
+ *      sobrevive ao reboot (crash_dump.h). Enviar 'c' exporta;
+ *      tools/crash_decode.py simboliza com o ELF.
+ *
+ *      EMULAÇÃO
+ *      --------
+ *      Com -DATIVIDADE_09_STDIO_UART=ON a stdio vai para a
+ *      UART0 e o firmware roda no Renode (renode/): os testes
+ *      fixam a tensão do ADC e conferem tempos, trace e I2C.
+ *
  *      Data da revisão: 25/05/2025
  * ------------------------------------------------------------
  */
@@ -56,6 +84,9 @@
 #include "tarefa4_controla_neopixel.h"
 #include "neopixel_driver.h"
 #include "testes_cores.h"
+#include "trace_recorder.h"
+#include "log_binario.h"
+#include "crash_dump.h"
 
 // ---------- Constantes do escalonador ----------
 #define PERIODO_CICLO_MS      1000    // 1 s entre execuções
@@ -64,6 +95,10 @@
 #define OFFSET_T3_MS            30
 #define OFFSET_T4_MS            40
 
+// ---------- Identificadores do trace ----------
+enum { ZONA_T1 = 1, ZONA_T2, ZONA_T3, ZONA_T4, ZONA_T5 };
+enum { MARCA_TIMER_T1 = 1, MARCA_ALARME_T5, MARCA_ALARME_T2, MARCA_ALARME_T3, MARCA_ALARME_T4 };
+
 // ---------- Flags de execução (setadas nos timers) ----------
 static volatile bool run_t1 = false;
 static volatile bool run_t2 = false;
@@ -93,6 +128,7 @@ static struct repeating_timer timer_t4;
  * @return Valor de retorno descrevendo o significado.
  */
 static int64_t alarm_cb_t5(alarm_id_t id, void *user_data) {
+    TRACE_MARCA(MARCA_ALARME_T5);
     run_t5 = true;
     return 0;
 }
@@ -105,6 +141,7 @@ static int64_t alarm_cb_t5(alarm_id_t id, void *user_data) {
  * @return Valor de retorno descrevendo o significado.
  */
 static int64_t alarm_cb_t2(alarm_id_t id, void *user_data) {
+    TRACE_MARCA(MARCA_ALARME_T2);
     run_t2 = true;
     return 0;
 }
@@ -118,6 +155,7 @@ static int64_t alarm_cb_t2(alarm_id_t id, void *user_data) {
  */
 
 static int64_t alarm_cb_t3(alarm_id_t id, void *user_data) {
+    TRACE_MARCA(MARCA_ALARME_T3);
     run_t3 = true;
     return 0;
 }
@@ -130,6 +168,7 @@ static int64_t alarm_cb_t3(alarm_id_t id, void *user_data) {
  * @return Valor de retorno descrevendo o significado.
  */
 static int64_t alarm_cb_t4(alarm_id_t id, void *user_data) {
+    TRACE_MARCA(MARCA_ALARME_T4);
     run_t4 = true;
     return 0;
 }
@@ -143,6 +182,10 @@ absolute_time_t ini_tarefa2, fim_tarefa2;
 absolute_time_t ini_tarefa3, fim_tarefa3;
 absolute_time_t ini_tarefa4, fim_tarefa4;
 
+// Latência amostra → OLED (fim da T1 até o fim da T2), para comparar com src/rtos/
+static int64_t latencia_us = 0;
+static int64_t latencia_max_us = 0;
+
 // ------------------------------------------------------------------
 //                       Funções de Callback
 // ------------------------------------------------------------------
@@ -158,6 +201,7 @@ absolute_time_t ini_tarefa4, fim_tarefa4;
  * @return Valor de retorno descrevendo o significado.
  */
 static bool timer_cb_t1(struct repeating_timer *t) {
+    TRACE_MARCA(MARCA_TIMER_T1);
     run_t1 = true;
 
     // Agenda flags das demais tarefas na sequência desejada.
@@ -206,11 +250,26 @@ static bool timer_cb_generic(struct repeating_timer *t) {
  * @return Valor de retorno descrevendo o significado.
  */
 int main(void) {
+    crash_iniciar();  // Antes do trace_iniciar(): o trace de um reset por watchdog vai para o registro
     stdio_init_all();
     setup();  // ADC, DMA, OLED, etc.
 
-    // Watchdog opcional
-    watchdog_enable(3000, false);
+    // ---------------- Trace ----------------
+    trace_iniciar();
+    trace_nomear(TRACE_NOME_ZONA, ZONA_T1, "tarefa1_temp");
+    trace_nomear(TRACE_NOME_ZONA, ZONA_T2, "tarefa2_display");
+    trace_nomear(TRACE_NOME_ZONA, ZONA_T3, "tarefa3_tendencia");
+    trace_nomear(TRACE_NOME_ZONA, ZONA_T4, "tarefa4_neopixel");
+    trace_nomear(TRACE_NOME_ZONA, ZONA_T5, "tarefa5_alerta");
+    trace_nomear(TRACE_NOME_ISR, DMA_IRQ_0, "DMA_IRQ_0 (temp)");
+    trace_nomear(TRACE_NOME_MARCA, MARCA_TIMER_T1, "timer T1");
+    trace_nomear(TRACE_NOME_MARCA, MARCA_ALARME_T5, "alarme T5");
+    trace_nomear(TRACE_NOME_MARCA, MARCA_ALARME_T2, "alarme T2");
+    trace_nomear(TRACE_NOME_MARCA, MARCA_ALARME_T3, "alarme T3");
+    trace_nomear(TRACE_NOME_MARCA, MARCA_ALARME_T4, "alarme T4");
+
+    // Watchdog + pré-watchdog: travamento vira registro em crash_dump
+    crash_watchdog_iniciar(3000);
 
     // ---------------- Configuração dos Timers ----------------
     // Tarefa 1 – repeating_timer_callback
@@ -229,13 +288,16 @@ int main(void) {
 
         if (run_t1) {
             run_t1 = false;
+            TRACE_ZONA_INICIO(ZONA_T1);
             ini_tarefa1 = get_absolute_time();
-            media = tarefa1_obter_media_temp(&cfg_temp, DMA_TEMP_CHANNEL);          // ajustado para retornar média
+            media = tarefa1_obter_media_temp(DMA_TEMP_CHANNEL);          // ajustado para retornar média
             fim_tarefa1 = get_absolute_time();
+            TRACE_ZONA_FIM(ZONA_T1);
         }
 
         if (run_t5) {
             run_t5 = false;
+            TRACE_ZONA_INICIO(ZONA_T5);
             // Mantém sem bloqueio: usa piscar neopixel quando
             // temperatura < 1°C como no código original
             if (media < 1.0f) {
@@ -245,40 +307,67 @@ int main(void) {
                 npClear();
                 npWrite();
             }
+            TRACE_ZONA_FIM(ZONA_T5);
         }
 
         if (run_t2) {
             run_t2 = false;
+            TRACE_ZONA_INICIO(ZONA_T2);
             ini_tarefa2 = get_absolute_time();
             tarefa2_exibir_oled(media, t);
             fim_tarefa2 = get_absolute_time();
+            TRACE_ZONA_FIM(ZONA_T2);
+
+            latencia_us = absolute_time_diff_us(fim_tarefa1, fim_tarefa2);
+            if (latencia_us > latencia_max_us) latencia_max_us = latencia_us;
         }
 
         if (run_t3) {
             run_t3 = false;
+            TRACE_ZONA_INICIO(ZONA_T3);
             ini_tarefa3 = get_absolute_time();
             t = tarefa3_analisa_tendencia(media);
             fim_tarefa3 = get_absolute_time();
+            TRACE_ZONA_FIM(ZONA_T3);
         }
 
         if (run_t4) {
             run_t4 = false;
+            TRACE_ZONA_INICIO(ZONA_T4);
             ini_tarefa4 = get_absolute_time();
             tarefa4_matriz_cor_por_tendencia(t);
             fim_tarefa4 = get_absolute_time();
+            TRACE_ZONA_FIM(ZONA_T4);
+
+            LOG_BIN("ciclo (us): t1 %ld t2 %ld t3 %ld t4 %ld",
+                    (long)absolute_time_diff_us(ini_tarefa1, fim_tarefa1),
+                    (long)absolute_time_diff_us(ini_tarefa2, fim_tarefa2),
+                    (long)absolute_time_diff_us(ini_tarefa3, fim_tarefa3),
+                    (long)absolute_time_diff_us(ini_tarefa4, fim_tarefa4));
         }
 
         // Alimente watchdog a cada iteração
-        watchdog_update();
+        crash_watchdog_alimentar();
+
+        // ---------- Despejos sob demanda: 't' trace, 'c' registro de falha ----------
+        int comando = getchar_timeout_us(0);
+        if (comando == 't') {
+            trace_despejar();
+            crash_watchdog_alimentar();
+        } else if (comando == 'c') {
+            crash_exportar();
+        }
+        crash_relatar();
 
         // ---------- Diagnóstico via USB ----------
         static uint32_t last_print = 0;
         uint32_t agora = to_ms_since_boot(get_absolute_time());
         if (agora - last_print >= 1000) {
             last_print = agora;
-            printf("🌡️  %.2f °C | Tend: %s \n", 
-                   media, 
-                   tendencia_para_texto(t));
+            LOG_BIN("🌡️  %.2f °C | Tend: %s | latencia amostra->OLED (us) %ld max %ld",
+                    media, tendencia_para_texto(t),
+                    (long)latencia_us, (long)latencia_max_us);
+            log_bin_despejar();
         }
     }
 
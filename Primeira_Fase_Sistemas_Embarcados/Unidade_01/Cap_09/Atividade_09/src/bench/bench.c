@@ -0,0 +1,121 @@
+/**
+ * @file bench.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Medição em ciclos pelo SysTick e relatório CSV dos microbenchmarks.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "hardware/structs/systick.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "bench.h"
+
+#define SYSTICK_MASCARA 0x00FFFFFFu
+
+#if PICO_COPY_TO_RAM
+#define BENCH_MEMORIA "ram"
+#else
+#define BENCH_MEMORIA "flash"
+#endif
+
+static uint32_t sobrecarga;
+static uint32_t amostras[BENCH_AMOSTRAS_MAX];
+
+static void __not_in_flash_func(bench_vazio)(uint32_t i) {
+    (void)i;
+}
+
+/**
+ * @brief Uma iteração medida. Fica na RAM para que o esvaziamento do cache não cobre,
+ *        dentro da janela medida, a volta da chamada.
+ */
+static uint32_t __not_in_flash_func(medir_uma)(void (*corpo)(uint32_t), uint32_t i, bool cache_frio) {
+    uint32_t estado = save_and_disable_interrupts();
+    if (cache_frio) {
+        xip_ctrl_hw->flush = 1;
+        (void)xip_ctrl_hw->flush;   // A leitura espera o esvaziamento terminar.
+    }
+    uint32_t t0 = systick_hw->cvr;
+    corpo(i);
+    uint32_t t1 = systick_hw->cvr;
+    restore_interrupts(estado);
+    return (t0 - t1) & SYSTICK_MASCARA;   // Contador decrescente.
+}
+
+void bench_iniciar(void) {
+    systick_hw->csr = 0;
+    systick_hw->rvr = SYSTICK_MASCARA;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;   // ENABLE | CLKSOURCE = processador, sem interrupção.
+
+    uint32_t menor = UINT32_MAX;
+    for (uint32_t i = 0; i < 64; i++) {
+        uint32_t c = medir_uma(bench_vazio, i, false);
+        if (c < menor) menor = c;
+    }
+    sobrecarga = menor;
+}
+
+void bench_medir(const bench_caso_t *caso, bool cache_frio, bench_resultado_t *r) {
+    if (caso->preparar) {
+        caso->preparar();
+    }
+    for (uint32_t i = 0; i < BENCH_AQUECIMENTO; i++) {
+        caso->corpo(i);
+    }
+
+    *r = (bench_resultado_t){ .min = UINT32_MAX };
+    uint32_t guardadas = 0;
+    for (uint32_t i = 0; i < caso->iteracoes; i++) {
+        uint32_t c = medir_uma(caso->corpo, i, cache_frio);
+        c = c > sobrecarga ? c - sobrecarga : 0;
+        if (c < r->min) r->min = c;
+        if (c > r->max) r->max = c;
+        r->soma += c;
+        r->n++;
+        if (guardadas < BENCH_AMOSTRAS_MAX) {
+            amostras[guardadas++] = c;
+        }
+    }
+
+    // Mediana das primeiras BENCH_AMOSTRAS_MAX amostras (inserção: poucas e quase ordenadas).
+    for (uint32_t i = 1; i < guardadas; i++) {
+        uint32_t v = amostras[i], j = i;
+        while (j > 0 && amostras[j - 1] > v) {
+            amostras[j] = amostras[j - 1];
+            j--;
+        }
+        amostras[j] = v;
+    }
+    r->mediana = guardadas ? amostras[guardadas / 2] : 0;
+    if (!r->n) r->min = 0;
+}
+
+static void imprimir(const bench_caso_t *caso, const char *cache, const bench_resultado_t *r, float us_por_ciclo) {
+    printf("%s,%s,%lu,%lu,%lu,%.1f,%lu,%.3f\n", caso->nome, cache, (unsigned long)r->n,
+           (unsigned long)r->min, (unsigned long)r->mediana, r->n ? (double)r->soma / r->n : 0.0,
+           (unsigned long)r->max, r->mediana * us_por_ciclo);
+}
+
+void bench_executar_todos(void) {
+    uint32_t clk = clock_get_hz(clk_sys);
+    float us_por_ciclo = 1e6f / (float)clk;
+    bench_resultado_t r;
+
+    printf("BENCH_BEGIN versao=%d memoria=%s clk_hz=%lu sobrecarga=%lu\n", BENCH_VERSAO_RELATORIO,
+           BENCH_MEMORIA, (unsigned long)clk, (unsigned long)sobrecarga);
+    printf("caso,cache,n,min,mediana,media,max,us_mediana\n");
+    for (uint32_t i = 0; i < bench_total_casos; i++) {
+        const bench_caso_t *caso = &bench_casos[i];
+        bench_medir(caso, false, &r);
+        imprimir(caso, "quente", &r, us_por_ciclo);
+#if !PICO_COPY_TO_RAM
+        bench_medir(caso, true, &r);
+        imprimir(caso, "frio", &r, us_por_ciclo);
+#endif
+    }
+    printf("BENCH_END\n");
+}
@@ -0,0 +1,62 @@
+/**
+ * @file bench.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Microbenchmarks na placa: ciclos medidos pelo SysTick com interrupções mascaradas.
+ *
+ * @details
+ * Cada caso é uma função que executa uma iteração. bench_medir() roda BENCH_AQUECIMENTO
+ * iterações sem medir e depois `iteracoes` medidas uma a uma:
+ * - O SysTick conta ciclos do processador (24 bits, decrescente); cada iteração tem de
+ *   caber em 2^24 ciclos (~134 ms a 125 MHz).
+ * - As interrupções ficam mascaradas só durante a iteração, para a USB continuar viva
+ *   entre elas.
+ * - Com `cache_frio`, o cache do XIP é esvaziado antes de cada iteração: mede o código
+ *   vindo da flash, e não do cache.
+ * - A sobrecarga da medição (caso vazio) é descontada de cada amostra.
+ *
+ * O mesmo firmware é gerado duas vezes pelo CMake (opção ATIVIDADE_09_BENCH):
+ * Atividade_09_bench executa da flash (XIP) e Atividade_09_bench_ram é `copy_to_ram`.
+ * O relatório é um bloco CSV entre BENCH_BEGIN e BENCH_END, lido por
+ * `tools/bench_compare.py` para guardar e comparar linhas de base.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BENCH_AQUECIMENTO      8     ///< Iterações descartadas antes de medir.
+#define BENCH_AMOSTRAS_MAX     256   ///< Amostras guardadas para a mediana.
+#define BENCH_VERSAO_RELATORIO 1
+
+/** @brief Um microbenchmark. */
+typedef struct {
+    const char *nome;
+    void (*preparar)(void);      ///< Opcional, fora da medição.
+    void (*corpo)(uint32_t i);   ///< Uma iteração (i = índice, para variar a entrada).
+    uint32_t iteracoes;
+} bench_caso_t;
+
+/** @brief Resultado de um caso, em ciclos já sem a sobrecarga. */
+typedef struct {
+    uint32_t n;
+    uint32_t min, mediana, max;
+    uint64_t soma;
+} bench_resultado_t;
+
+/** @brief Registro de casos (bench_casos.c). */
+extern const bench_caso_t bench_casos[];
+extern const uint32_t bench_total_casos;
+
+/** @brief Liga o SysTick no clock do processador e mede a sobrecarga da medição. */
+void bench_iniciar(void);
+
+/** @brief Executa um caso e preenche `r`. */
+void bench_medir(const bench_caso_t *caso, bool cache_frio, bench_resultado_t *r);
+
+/** @brief Executa todos os casos e imprime o relatório (BENCH_BEGIN ... BENCH_END). */
+void bench_executar_todos(void);
+
+#endif // BENCH_H
@@ -0,0 +1,210 @@
+/**
+ * @file bench_casos.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Registro dos microbenchmarks: rotinas quentes do projeto, chamadas como no firmware.
+ *
+ * @details Para acrescentar um caso, escreva o corpo (uma iteração, variando a entrada
+ * com `i` para o compilador não dobrar o resultado) e uma linha na tabela `bench_casos`.
+ * Os nomes são a chave de comparação em tools/bench_compare.py: não renomeie à toa.
+ * Pares `float_<x>` / `pf_<x>` (lib/ponto_fixo contra o float equivalente) saem também
+ * numa tabela de razões.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "tarefa1_temp.h"
+#include "tarefa3_tendencia.h"
+#include "ssd1306.h"
+#include "neopixel_driver.h"
+#include "log_binario.h"
+#include "trace_recorder.h"
+#include "ponto_fixo.h"
+
+#define BLOCO_MEDIA 1000   ///< Amostras por iteração em media_bloco (o laço da tarefa 1).
+#define N_ENTRADAS  64     ///< Entradas dos pares float/pf, percorridas com i.
+
+static volatile float sumidouro_f;
+static volatile uint32_t sumidouro_u;
+static uint16_t bloco_adc[BLOCO_MEDIA];
+static uint8_t quadro[ssd1306_buffer_length];
+static float ent_f[N_ENTRADAS][2];
+static q16_t ent_q[N_ENTRADAS][2];
+static char texto_num[PF_DEC_TAM + 8];
+
+// --- Tarefa 1: conversão do ADC ---
+
+static void temp_converter(uint32_t i) {
+    sumidouro_f = convert_to_celsius((uint16_t)(850 + (i & 63)));
+}
+
+static void media_bloco_preparar(void) {
+    for (uint32_t i = 0; i < BLOCO_MEDIA; i++) {
+        bloco_adc[i] = (uint16_t)(870 + (i * 7) % 13);
+    }
+}
+
+/** @brief Laço antigo da tarefa 1: uma conversão em float por amostra. */
+static void media_bloco(uint32_t i) {
+    float soma = 0.0f;
+    for (uint32_t k = 0; k < BLOCO_MEDIA; k++) {
+        soma += convert_to_celsius(bloco_adc[k]);
+    }
+    sumidouro_f = soma / BLOCO_MEDIA + (float)(i & 1);
+}
+
+/** @brief Laço atual: soma inteira e uma conversão em Q16 da média. */
+static void media_bloco_pf(uint32_t i) {
+    uint32_t soma = i & 1;
+    for (uint32_t k = 0; k < BLOCO_MEDIA; k++) {
+        soma += bloco_adc[k];
+    }
+    sumidouro_u = (uint32_t)convert_to_celsius_q16(pf_q16_div((q16_t)soma, BLOCO_MEDIA));
+}
+
+static void temp_converter_pf(uint32_t i) {
+    sumidouro_u = (uint32_t)convert_to_celsius_q16(Q16_DE_INT(850 + (i & 63)));
+}
+
+// --- Tarefa 3 ---
+
+static void tendencia(uint32_t i) {
+    sumidouro_u = tarefa3_analisa_tendencia(25.0f + (float)(i % 7) * 0.02f);
+}
+
+// --- OLED (só o quadro em RAM; o envio I2C depende do display) ---
+
+static void oled_pixel(uint32_t i) {
+    ssd1306_set_pixel(quadro, (int)(i % ssd1306_width), (int)((i / ssd1306_width) % ssd1306_height), i & 1);
+}
+
+static void oled_quadro_pixels(uint32_t i) {
+    for (int y = 0; y < ssd1306_height; y++) {
+        for (int x = 0; x < ssd1306_width; x++) {
+            ssd1306_set_pixel(quadro, x, y, ((x + y + (int)i) & 3) == 0);
+        }
+    }
+}
+
+static void oled_texto(uint32_t i) {
+    char texto[] = "TEMP 27 C";
+    texto[6] = (char)('0' + i % 10);
+    ssd1306_draw_string(quadro, 0, 8, texto);
+}
+
+// --- NeoPixel (limitado pela PIO: 75 palavras a 800 kHz) ---
+
+static void np_preparar(void) {
+    npSetAll(10, 20, 30);
+}
+
+static void np_write(uint32_t i) {
+    (void)i;
+    npWrite();
+}
+
+static void np_write_brilho(uint32_t i) {
+    npWriteComBrilho((i & 1) ? 0.5f : 0.25f);
+}
+
+// --- libm: referência das curvas com pow() (LDR: (K / R) ^ (1 / 0,7)) ---
+
+static void libm_powf(uint32_t i) {
+    sumidouro_f = powf(1.0f + (float)(i & 255) * 0.1f, 1.0f / 0.7f);
+}
+
+// --- Ponto fixo (lib/ponto_fixo) contra float, mesmas entradas ---
+
+static void pf_preparar(void) {
+    for (uint32_t k = 0; k < N_ENTRADAS; k++) {
+        ent_f[k][0] = 0.37f + (float)k * 1.53f;      // (0, 100): log2, sqrt, dividendo
+        ent_f[k][1] = 0.51f + (float)k * 0.113f;     // (0,5, 7,7): divisor, expoente
+        ent_q[k][0] = pf_q16_de_float(ent_f[k][0]);
+        ent_q[k][1] = pf_q16_de_float(ent_f[k][1]);
+    }
+}
+
+#define A_F(i) ent_f[(i) % N_ENTRADAS][0]
+#define B_F(i) ent_f[(i) % N_ENTRADAS][1]
+#define A_Q(i) ent_q[(i) % N_ENTRADAS][0]
+#define B_Q(i) ent_q[(i) % N_ENTRADAS][1]
+
+static void float_mul(uint32_t i)   { sumidouro_f = A_F(i) * B_F(i); }
+static void pf_mul(uint32_t i)      { sumidouro_u = (uint32_t)pf_q16_mul(A_Q(i), B_Q(i)); }
+static void float_div(uint32_t i)   { sumidouro_f = A_F(i) / B_F(i); }
+static void pf_div(uint32_t i)      { sumidouro_u = (uint32_t)pf_q16_div(A_Q(i), B_Q(i)); }
+static void float_recip(uint32_t i) { sumidouro_f = 1.0f / B_F(i); }
+static void pf_recip(uint32_t i)    { sumidouro_u = (uint32_t)pf_q16_recip(B_Q(i)); }
+static void float_log2(uint32_t i)  { sumidouro_f = log2f(A_F(i)); }
+static void pf_log2(uint32_t i)     { sumidouro_u = (uint32_t)pf_q16_log2(A_Q(i)); }
+static void float_exp2(uint32_t i)  { sumidouro_f = exp2f(B_F(i)); }
+static void pf_exp2(uint32_t i)     { sumidouro_u = (uint32_t)pf_q16_exp2(B_Q(i)); }
+static void float_sqrt(uint32_t i)  { sumidouro_f = sqrtf(A_F(i)); }
+static void pf_sqrt(uint32_t i)     { sumidouro_u = (uint32_t)pf_q16_sqrt(A_Q(i)); }
+
+static void float_int_dec(uint32_t i) {
+    sumidouro_u = (uint32_t)snprintf(texto_num, sizeof(texto_num), "%ld", (long)A_Q(i));
+}
+
+static void pf_int_dec(uint32_t i) {
+    sumidouro_u = (uint32_t)pf_i32_para_dec(A_Q(i), texto_num);
+}
+
+static void float_temp_dec(uint32_t i) {
+    sumidouro_u = (uint32_t)snprintf(texto_num, sizeof(texto_num), "%.2f", A_F(i));
+}
+
+static void pf_temp_dec(uint32_t i) {
+    sumidouro_u = (uint32_t)pf_q16_para_dec(A_Q(i), 2, texto_num);
+}
+
+// --- Filas: log binário e trace (ambos gravam num anel em RAM) ---
+
+static void log_bin_preparar(void) {
+    log_bin_descartar();   // Mede o caminho de gravação, não o de anel cheio.
+}
+
+static void log_bin_2args(uint32_t i) {
+    LOG_BIN("bench %lu %.2f", (unsigned long)i, 1.5f);
+}
+
+static void trace_marca(uint32_t i) {
+    TRACE_MARCA((uint16_t)i);
+}
+
+const bench_caso_t bench_casos[] = {
+    { "convert_to_celsius",    NULL,                  temp_converter,      1000 },
+    { "media_bloco_1000",      media_bloco_preparar,  media_bloco,         32 },
+    { "media_bloco_1000_pf",   media_bloco_preparar,  media_bloco_pf,      32 },
+    { "convert_to_celsius_q16", NULL,                 temp_converter_pf,   1000 },
+    { "tendencia",             NULL,                  tendencia,           1000 },
+    { "ssd1306_set_pixel",     NULL,                  oled_pixel,          1000 },
+    { "ssd1306_quadro_8192px", NULL,                  oled_quadro_pixels,  16 },
+    { "ssd1306_draw_string",   NULL,                  oled_texto,          256 },
+    { "npWrite",               np_preparar,           np_write,            64 },
+    { "npWriteComBrilho",      np_preparar,           np_write_brilho,     64 },
+    { "powf",                  NULL,                  libm_powf,           1000 },
+    { "float_mul",             pf_preparar,           float_mul,           1000 },
+    { "pf_mul",                pf_preparar,           pf_mul,              1000 },
+    { "float_div",             pf_preparar,           float_div,           1000 },
+    { "pf_div",                pf_preparar,           pf_div,              1000 },
+    { "float_recip",           pf_preparar,           float_recip,         1000 },
+    { "pf_recip",              pf_preparar,           pf_recip,            1000 },
+    { "float_log2",            pf_preparar,           float_log2,          1000 },
+    { "pf_log2",               pf_preparar,           pf_log2,             1000 },
+    { "float_exp2",            pf_preparar,           float_exp2,          1000 },
+    { "pf_exp2",               pf_preparar,           pf_exp2,             1000 },
+    { "float_sqrt",            pf_preparar,           float_sqrt,          1000 },
+    { "pf_sqrt",               pf_preparar,           pf_sqrt,             1000 },
+    { "float_int_dec",         pf_preparar,           float_int_dec,       256 },
+    { "pf_int_dec",            pf_preparar,           pf_int_dec,          256 },
+    { "float_temp_dec",        pf_preparar,           float_temp_dec,      256 },
+    { "pf_temp_dec",           pf_preparar,           pf_temp_dec,         256 },
+    // O anel do núcleo tem 1024 palavras (4 por registro): aquecimento + 128 cabem.
+    { "LOG_BIN_2args",         log_bin_preparar,      log_bin_2args,       128 },
+    { "trace_evento",          NULL,                  trace_marca,         1000 },
+};
+
+const uint32_t bench_total_casos = sizeof(bench_casos) / sizeof(bench_casos[0]);
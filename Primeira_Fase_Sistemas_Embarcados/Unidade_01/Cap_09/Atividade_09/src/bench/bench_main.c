@@ -0,0 +1,40 @@
+/**
+ * @file bench_main.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Firmware de microbenchmarks (Atividade_09_bench e Atividade_09_bench_ram).
+ *
+ * @details Espera o terminal USB, imprime o relatório de bench.h e repete a cada 'r'.
+ * Captura e comparação com a linha de base:
+ * @code
+ *   stty -F /dev/ttyACM0 raw 115200 && cat /dev/ttyACM0 > flash.txt
+ *   python3 tools/bench_compare.py flash.txt ram.txt --salvar base.csv
+ *   python3 tools/bench_compare.py flash.txt ram.txt --base base.csv
+ * @endcode
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "bench.h"
+#include "neopixel_driver.h"
+#include "trace_recorder.h"
+
+int main(void) {
+    stdio_init_all();
+    while (!stdio_usb_connected()) {
+        sleep_ms(100);
+    }
+    sleep_ms(500);   // Dá tempo do terminal abrir a porta.
+
+    npInit(LED_PIN);
+    trace_iniciar();
+    bench_iniciar();
+
+    while (true) {
+        bench_executar_todos();
+        printf("Envie 'r' para repetir.\n");
+        while (getchar_timeout_us(1000000) != 'r') {
+        }
+    }
+}
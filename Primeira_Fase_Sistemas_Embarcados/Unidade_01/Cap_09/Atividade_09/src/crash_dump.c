@@ -0,0 +1,328 @@
+/**
+ * @file crash_dump.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Implementação da captura de falhas em RAM não inicializada.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#if LIB_PICO_STDIO_USB
+#include "pico/stdio_usb.h"
+#endif
+#include "hardware/exception.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "hardware/watchdog.h"
+#include "hardware/regs/addressmap.h"
+#include "crash_dump.h"
+#include "trace_recorder.h"
+
+// Números usados dentro do assembly (precisam ser literais).
+#define CAUSA_HARDFAULT_ASM  1
+#define CAUSA_WATCHDOG_ASM   2
+#define CRASH_XSTR(x) CRASH_STR(x)
+#define CRASH_STR(x)  #x
+_Static_assert(CAUSA_HARDFAULT_ASM == CRASH_HARDFAULT, "causa do handler");
+_Static_assert(CAUSA_WATCHDOG_ASM == CRASH_WATCHDOG, "causa do handler");
+_Static_assert(sizeof(crash_registro_t) == 664, "layout lido pelo crash_decode.py");
+
+/** @brief Registro e estado que não entram no CRC. */
+typedef struct {
+    crash_registro_t registro;
+    uint32_t exportado;          ///< Já enviado por crash_exportar().
+} crash_ram_t;
+
+static crash_ram_t __uninitialized_ram(crash_ram);
+
+/** r4-r11 salvos pelo handler antes de qualquer código C (usado pelo assembly). */
+uint32_t crash_regs_altos[8] __attribute__((used));
+
+static volatile bool capturando = false;
+static bool relatado = false;
+static int alarme_wd = -1;
+static uint32_t prazo_wd_us;
+
+void crash_excecao(uint32_t *quadro, uint32_t exc_return, uint32_t causa) __attribute__((used, noreturn));
+
+/**
+ * @brief Entrada comum dos handlers: r0 = quadro empilhado, r1 = EXC_RETURN, r2 = causa.
+ *
+ * Cortex-M0+: stmia só aceita r0-r7, então r8-r11 passam por r4-r7 (que já foram salvos
+ * e não serão restaurados: a captura termina em reboot).
+ */
+#define CRASH_CAPTURA_ASM(causa)                 \
+    "ldr   r2, =crash_regs_altos        \n"      \
+    "stmia r2!, {r4-r7}                 \n"      \
+    "mov   r4, r8                       \n"      \
+    "mov   r5, r9                       \n"      \
+    "mov   r6, r10                      \n"      \
+    "mov   r7, r11                      \n"      \
+    "stmia r2!, {r4-r7}                 \n"      \
+    "mov   r1, lr                       \n"      \
+    "movs  r0, #4                       \n"      \
+    "tst   r0, r1                       \n"      \
+    "beq   1f                           \n"      \
+    "mrs   r0, psp                      \n"      \
+    "b     2f                           \n"      \
+    "1:                                 \n"      \
+    "mrs   r0, msp                      \n"      \
+    "2:                                 \n"      \
+    "movs  r2, #" CRASH_XSTR(causa) "\n"      \
+    "ldr   r3, =crash_excecao           \n"      \
+    "bx    r3                           \n"      \
+    ".ltorg                             \n"
+
+static void __attribute__((naked)) crash_isr_hardfault(void) {
+    __asm volatile(CRASH_CAPTURA_ASM(CAUSA_HARDFAULT_ASM));
+}
+
+static void __attribute__((naked)) crash_isr_watchdog(void) {
+    __asm volatile(CRASH_CAPTURA_ASM(CAUSA_WATCHDOG_ASM));
+}
+
+__attribute__((weak)) const char *crash_nome_tarefa(void) {
+    return NULL;
+}
+
+/** @brief CRC-32 (polinômio refletido 0xEDB88320, igual ao zlib), bit a bit. */
+static uint32_t crc32(const void *dados, uint32_t n) {
+    const uint8_t *p = dados;
+    uint32_t crc = 0xFFFFFFFFu;
+    while (n--) {
+        crc ^= *p++;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static bool registro_valido(const crash_registro_t *r) {
+    return r->magic == CRASH_MAGIC && r->versao == CRASH_VERSAO &&
+           r->crc == crc32(r, offsetof(crash_registro_t, crc));
+}
+
+static bool endereco_ram(uint32_t endereco, uint32_t bytes) {
+    return endereco >= SRAM_BASE && endereco <= SRAM_END - bytes && (endereco & 3u) == 0;
+}
+
+/**
+ * @brief Zera o registro e preenche o que é comum a todas as causas.
+ * @return false se outra captura já estiver em andamento (falha dentro da captura).
+ */
+static bool registro_comecar(crash_registro_t *r, uint32_t causa) {
+    if (capturando) {
+        return false;
+    }
+    capturando = true;
+
+    memset(r, 0, sizeof(*r));
+    r->magic = CRASH_MAGIC;
+    r->versao = CRASH_VERSAO;
+    r->causa = causa;
+    r->nucleo = get_core_num();
+    r->tempo_us = time_us_32();
+
+    const char *tarefa = crash_nome_tarefa();
+    if (tarefa) {
+        strncpy(r->contexto, tarefa, CRASH_CONTEXTO_MAX - 1);
+    }
+    return true;
+}
+
+static void registro_pilha(crash_registro_t *r, uint32_t sp) {
+    r->sp = sp;
+    if (!endereco_ram(sp, 4)) {
+        return;
+    }
+    uint32_t disponivel = (SRAM_END - sp) / 4;
+    r->n_pilha = disponivel < CRASH_PILHA_PALAVRAS ? disponivel : CRASH_PILHA_PALAVRAS;
+    memcpy(r->pilha, (const void *)(uintptr_t)sp, r->n_pilha * 4);
+}
+
+/** @brief Acrescenta o trace, fecha o CRC e reinicia pela via do watchdog. */
+static void __attribute__((noreturn)) registro_concluir(crash_registro_t *r) {
+    r->n_trace = trace_copiar_recentes(r->trace, CRASH_TRACE_EVENTOS);
+    r->crc = crc32(r, offsetof(crash_registro_t, crc));
+    crash_ram.exportado = 0;
+    __dmb();
+
+    watchdog_reboot(0, 0, 0);
+    while (true) {
+        tight_loop_contents();
+    }
+}
+
+void crash_excecao(uint32_t *quadro, uint32_t exc_return, uint32_t causa) {
+    crash_registro_t *r = &crash_ram.registro;
+    if (!registro_comecar(r, causa)) {
+        watchdog_reboot(0, 0, 0);
+        while (true) tight_loop_contents();
+    }
+    r->exc_return = exc_return;
+    memcpy(&r->r[4], crash_regs_altos, sizeof(crash_regs_altos));
+
+    // Quadro de exceção: r0, r1, r2, r3, r12, lr, pc, xPSR.
+    uint32_t endereco = (uint32_t)(uintptr_t)quadro;
+    if (endereco_ram(endereco, 32)) {
+        memcpy(&r->r[0], quadro, 4 * sizeof(uint32_t));
+        r->r[12] = quadro[4];
+        r->lr = quadro[5];
+        r->pc = quadro[6];
+        r->xpsr = quadro[7];
+        // xPSR bit 9: o hardware inseriu uma palavra para alinhar a pilha em 8 bytes.
+        registro_pilha(r, endereco + 32 + ((quadro[7] & (1u << 9)) ? 4 : 0));
+    } else {
+        r->sp = endereco;
+    }
+    registro_concluir(r);
+}
+
+/** @brief Caminho de software (panic/assert/crash_falha): registradores do chamador. */
+static void __attribute__((noreturn, noinline)) falha_software(const char *texto, uint32_t retorno) {
+    save_and_disable_interrupts();
+    crash_registro_t *r = &crash_ram.registro;
+    if (!registro_comecar(r, CRASH_PANICO)) {
+        watchdog_reboot(0, 0, 0);
+        while (true) tight_loop_contents();
+    }
+
+    // A mensagem tem preferência sobre o nome da tarefa; o nome fica no fim, se couber.
+    char tarefa[CRASH_CONTEXTO_MAX];
+    strncpy(tarefa, r->contexto, sizeof(tarefa));
+    if (tarefa[0]) {
+        snprintf(r->contexto, CRASH_CONTEXTO_MAX, "%s [%s]", texto, tarefa);
+    } else {
+        snprintf(r->contexto, CRASH_CONTEXTO_MAX, "%s", texto);
+    }
+
+    uint32_t sp;
+    __asm volatile("mov %0, sp" : "=r"(sp));
+    r->pc = retorno;
+    r->lr = retorno;
+    registro_pilha(r, sp);
+    registro_concluir(r);
+}
+
+void crash_falha(const char *mensagem) {
+    falha_software(mensagem, (uint32_t)(uintptr_t)__builtin_return_address(0));
+}
+
+void crash_panico(const char *fmt, ...) {
+    char texto[CRASH_CONTEXTO_MAX];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(texto, sizeof(texto), fmt ? fmt : "panic", args);
+    va_end(args);
+    // Retorno para dentro do panic() do SDK; o chamador dele fica na cópia da pilha.
+    falha_software(texto, (uint32_t)(uintptr_t)__builtin_return_address(0));
+}
+
+void __wrap___assert_func(const char *arquivo, int linha, const char *funcao,
+                          const char *expressao) {
+    (void)funcao;
+    (void)expressao;   // Não cabe no contexto; arquivo e linha bastam para achar.
+    const char *nome = arquivo ? strrchr(arquivo, '/') : NULL;
+    nome = nome ? nome + 1 : (arquivo ? arquivo : "?");
+    char texto[CRASH_CONTEXTO_MAX];
+    snprintf(texto, sizeof(texto), "assert %s:%d", nome, linha);
+    // Retorno para a função que falhou no assert.
+    falha_software(texto, (uint32_t)(uintptr_t)__builtin_return_address(0));
+}
+
+void crash_iniciar(void) {
+    exception_set_exclusive_handler(HARDFAULT_EXCEPTION, crash_isr_hardfault);
+
+    crash_registro_t *r = &crash_ram.registro;
+    if (watchdog_enable_caused_reboot()) {
+        // O watchdog venceu sem passar pelo pré-watchdog (interrupções desabilitadas ou
+        // o próprio alarme bloqueado). Resta o trace, que sobreviveu ao reset.
+        registro_comecar(r, CRASH_WATCHDOG_RESET);
+        r->nucleo = 0xFFFFFFFFu;        // Desconhecido.
+        r->tempo_us = 0;
+        r->contexto[0] = '\0';
+        r->n_trace = trace_copiar_recentes(r->trace, CRASH_TRACE_EVENTOS);
+        r->crc = crc32(r, offsetof(crash_registro_t, crc));
+        crash_ram.exportado = 0;
+    } else if (!registro_valido(r)) {
+        memset(&crash_ram, 0, sizeof(crash_ram));
+    }
+    capturando = false;
+}
+
+void crash_watchdog_iniciar(uint32_t timeout_ms) {
+    alarme_wd = hardware_alarm_claim_unused(true);
+    prazo_wd_us = (timeout_ms - CRASH_ANTECEDENCIA_WATCHDOG_MS) * 1000u;
+
+    uint irq = TIMER_IRQ_0 + (uint)alarme_wd;
+    irq_set_exclusive_handler(irq, crash_isr_watchdog);
+    irq_set_priority(irq, PICO_HIGHEST_IRQ_PRIORITY);
+    hw_set_bits(&timer_hw->inte, 1u << alarme_wd);
+    crash_watchdog_alimentar();
+    irq_set_enabled(irq, true);
+
+    watchdog_enable(timeout_ms, false);
+}
+
+void crash_watchdog_alimentar(void) {
+    // Escrever no registrador ALARM rearma o alarme: se ninguém alimentar de novo
+    // dentro do prazo, a IRQ dispara e o handler grava onde o código estava.
+    timer_hw->alarm[alarme_wd] = time_us_32() + prazo_wd_us;
+    watchdog_update();
+}
+
+bool crash_pendente(void) {
+    return registro_valido(&crash_ram.registro);
+}
+
+static const char *nome_causa(uint32_t causa) {
+    switch (causa) {
+        case CRASH_HARDFAULT:      return "HardFault";
+        case CRASH_WATCHDOG:       return "watchdog (laço travado)";
+        case CRASH_WATCHDOG_RESET: return "reset por watchdog";
+        case CRASH_PANICO:         return "panic/assert";
+        default:                   return "?";
+    }
+}
+
+void crash_relatar(void) {
+#if LIB_PICO_STDIO_USB
+    if (relatado || !stdio_usb_connected()) {
+        return;
+    }
+#else
+    // Saída pela UART (build de emulação): não há como saber se alguém está ouvindo.
+    if (relatado) {
+        return;
+    }
+#endif
+    relatado = true;
+    const crash_registro_t *r = &crash_ram.registro;
+    if (crash_pendente() && !crash_ram.exportado) {
+        printf("CRASH pendente: %s, pc=%08lx, '%s' (envie 'c' para exportar)\n",
+               nome_causa(r->causa), (unsigned long)r->pc, r->contexto);
+    }
+}
+
+void crash_exportar(void) {
+    if (!crash_pendente()) {
+        printf("CRASH nenhum\n");
+        return;
+    }
+    const uint8_t *p = (const uint8_t *)&crash_ram.registro;
+    printf("CRASH_BEGIN %u\n", (unsigned)sizeof(crash_registro_t));
+    for (uint32_t i = 0; i < sizeof(crash_registro_t); i += 32) {
+        printf("D ");
+        for (uint32_t k = i; k < i + 32 && k < sizeof(crash_registro_t); k++) {
+            printf("%02x", p[k]);
+        }
+        printf("\n");
+    }
+    printf("CRASH_END\n");
+    crash_ram.exportado = 1;
+}
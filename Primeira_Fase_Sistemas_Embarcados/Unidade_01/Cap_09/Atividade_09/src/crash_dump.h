@@ -0,0 +1,129 @@
+/**
+ * @file crash_dump.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Registro de falhas (HardFault, watchdog, panic/assert) que sobrevive ao reboot.
+ *
+ * @details
+ * O registro fica em RAM não inicializada (`__uninitialized_ram`): o crt0 não a zera, então
+ * ele atravessa o reset por watchdog e é lido no boot seguinte. Uma queda de energia apaga
+ * a RAM, e o CRC-32 invalida o conteúdo aleatório.
+ *
+ * Caminhos de captura:
+ * - HardFault: handler em assembly salva r4-r11, pega o quadro empilhado (MSP ou PSP,
+ *   conforme o EXC_RETURN) e grava r0-r12, sp, lr, pc, xPSR e um trecho da pilha.
+ * - Pré-watchdog: um alarme de hardware com a maior prioridade é rearmado a cada
+ *   crash_watchdog_alimentar() e vence CRASH_ANTECEDENCIA_WATCHDOG_MS antes do watchdog.
+ *   Se o código travar com as interrupções habilitadas, o handler grava o ponto exato
+ *   onde ele estava (mesmo quadro do HardFault) e reinicia.
+ * - Reset pelo watchdog sem captura (travou com interrupções desabilitadas): no boot,
+ *   crash_iniciar() monta o registro só com os últimos eventos do trace, cujos anéis
+ *   também ficam em RAM não inicializada.
+ * - panic(): o CMake define PICO_PANIC_FUNCTION=crash_panico, e a mensagem vai para o
+ *   contexto.
+ * - assert()/configASSERT (que é assert() no FreeRTOSConfig.h): o __assert_func da newlib
+ *   (no SDK) não passa pelo panic, só imprime e para num bkpt. O CMake liga com
+ *   --wrap=__assert_func, e __wrap___assert_func grava "assert arquivo:linha". Só vale
+ *   em builds sem NDEBUG (o Release do SDK define NDEBUG e remove os assert()).
+ * - crash_falha() cobre as falhas detectadas pela aplicação.
+ *
+ * Todo registro leva também o núcleo, a tarefa em execução (crash_nome_tarefa(), se a
+ * aplicação a definir) e os CRASH_TRACE_EVENTOS eventos mais recentes do trace_recorder.
+ *
+ * crash_exportar() envia o registro em hexadecimal entre `CRASH_BEGIN` e `CRASH_END`; o
+ * script `tools/crash_decode.py` confere o CRC e simboliza os endereços com o ELF.
+ */
+
+#ifndef CRASH_DUMP_H
+#define CRASH_DUMP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define CRASH_MAGIC                      0x48535243u  ///< "CRSH" em little-endian.
+#define CRASH_VERSAO                     1u
+#define CRASH_PILHA_PALAVRAS             64    ///< Palavras copiadas a partir do sp da falha.
+#define CRASH_TRACE_EVENTOS              32    ///< Eventos recentes do trace (8 bytes cada).
+#define CRASH_CONTEXTO_MAX               48    ///< Tarefa ou mensagem de panic/assert.
+#define CRASH_ANTECEDENCIA_WATCHDOG_MS   250   ///< Pré-watchdog vence antes do watchdog.
+
+/** @brief Origem do registro. */
+typedef enum {
+    CRASH_NENHUM = 0,
+    CRASH_HARDFAULT,         ///< Exceção HardFault (registradores completos).
+    CRASH_WATCHDOG,          ///< Pré-watchdog: laço travado, registradores do ponto travado.
+    CRASH_WATCHDOG_RESET,    ///< Watchdog venceu sem captura: só trace e núcleo.
+    CRASH_PANICO,            ///< panic(), assert(), configASSERT ou crash_falha().
+} crash_causa_t;
+
+/**
+ * @brief Registro gravado na falha (664 bytes, layout fixo lido pelo crash_decode.py).
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t versao;
+    uint32_t causa;                             ///< crash_causa_t.
+    uint32_t nucleo;
+    uint32_t tempo_us;                          ///< time_us_32() no momento da falha.
+    uint32_t r[13];                             ///< r0 a r12.
+    uint32_t sp, lr, pc, xpsr;
+    uint32_t exc_return;                        ///< LR na entrada da exceção (0 fora dela).
+    char contexto[CRASH_CONTEXTO_MAX];          ///< Tarefa ou mensagem, terminado em '\0'.
+    uint32_t n_pilha;
+    uint32_t pilha[CRASH_PILHA_PALAVRAS];       ///< Começa em `sp`.
+    uint32_t n_trace;
+    uint8_t trace[CRASH_TRACE_EVENTOS][8];      ///< Formato do evento do trace_recorder.
+    uint32_t crc;                               ///< CRC-32 (zlib) de todos os campos acima.
+} crash_registro_t;
+
+/**
+ * @brief Instala o handler de HardFault e valida o registro do boot anterior.
+ * @note Chamar no início do main(), antes de trace_iniciar() (que zera os anéis usados
+ *       para montar o registro de um reset por watchdog).
+ */
+void crash_iniciar(void);
+
+/**
+ * @brief Liga o watchdog e o alarme de pré-watchdog.
+ * @param timeout_ms Prazo do watchdog (maior que CRASH_ANTECEDENCIA_WATCHDOG_MS).
+ */
+void crash_watchdog_iniciar(uint32_t timeout_ms);
+
+/** @brief Alimenta o watchdog e rearma o pré-watchdog (substitui watchdog_update()). */
+void crash_watchdog_alimentar(void);
+
+/** @brief Indica se há um registro válido do boot anterior. */
+bool crash_pendente(void);
+
+/**
+ * @brief Avisa pela stdio, uma vez por boot, que há registro não exportado.
+ * @note Espera o terminal USB estar conectado; pode ser chamada a cada iteração do laço.
+ */
+void crash_relatar(void);
+
+/**
+ * @brief Envia o registro pendente em texto hexadecimal (CRASH_BEGIN ... CRASH_END).
+ * @note O registro continua guardado até a próxima falha ou queda de energia.
+ */
+void crash_exportar(void);
+
+/**
+ * @brief Grava um registro CRASH_PANICO com a mensagem e reinicia a placa.
+ * @param mensagem Texto curto (truncado em CRASH_CONTEXTO_MAX - 1).
+ */
+void crash_falha(const char *mensagem) __attribute__((noreturn));
+
+/** @brief Substituto do panic() do SDK (PICO_PANIC_FUNCTION). */
+void crash_panico(const char *fmt, ...) __attribute__((noreturn));
+
+/** @brief Substituto do __assert_func da newlib (link com --wrap=__assert_func). */
+void __wrap___assert_func(const char *arquivo, int linha, const char *funcao,
+                          const char *expressao) __attribute__((noreturn));
+
+/**
+ * @brief Nome da tarefa em execução, gravado no contexto da falha.
+ * @note Definição fraca retorna NULL; a versão FreeRTOS fornece a sua.
+ */
+const char *crash_nome_tarefa(void);
+
+#endif // CRASH_DUMP_H
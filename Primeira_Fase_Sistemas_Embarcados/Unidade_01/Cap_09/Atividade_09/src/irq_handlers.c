@@ -25,8 +25,8 @@
  *  Relacionamento:
  *      - Este handler é registrado em 'setup.c' usando:
  *            irq_set_exclusive_handler(DMA_IRQ_0, dma_handler_temp);
- *      - A flag 'dma_temp_done' é usada em 'tarefa1_temp.c'
- *        para controlar o fluxo da aquisição via DMA.
+ *      - A interrupção acorda o 'wfi' de hal_adc_dma_aguardar()
+ *        ('lib/hal/hal_pico.c'), usado por 'tarefa1_temp.c'.
  *
  *  
  *  Data: 11/05/2025
@@ -34,7 +34,9 @@
  */
 
 #include "hardware/dma.h"
+#include "hardware/irq.h"
 #include "irq_handlers.h"
+#include "trace_recorder.h"
 
 // Flag global que sinaliza a conclusão da transferência DMA
 volatile bool dma_temp_done = false;
@@ -55,6 +57,8 @@ volatile bool dma_temp_done = false;
  */
 
 void dma_handler_temp() {
+    TRACE_ISR_ENTRA(DMA_IRQ_0);
     dma_hw->ints0 = 1u << 0;   // Limpa a interrupção do canal 0
     dma_temp_done = true;     // Sinaliza conclusão para o executor
+    TRACE_ISR_SAI(DMA_IRQ_0);
 }
\ No newline at end of file
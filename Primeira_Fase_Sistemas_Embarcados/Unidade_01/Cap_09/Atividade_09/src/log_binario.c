@@ -0,0 +1,114 @@
+/**
+ * @file log_binario.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Implementação do log binário em anéis de words por núcleo.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "log_binario.h"
+
+#define LOG_BIN_NUCLEOS 2
+#define LOG_BIN_MASCARA (LOG_BIN_PALAVRAS_POR_NUCLEO - 1)
+
+/**
+ * @brief Anel de um núcleo.
+ *
+ * Só esse núcleo grava (`escrita`, `perdidos`) e só log_bin_despejar() consome (`lida`):
+ * um produtor e um consumidor, então os índices bastam, sem trava entre os núcleos.
+ * Os índices crescem sem voltar a zero; a posição no vetor é o índice & LOG_BIN_MASCARA.
+ */
+typedef struct {
+    uint32_t palavras[LOG_BIN_PALAVRAS_POR_NUCLEO];
+    volatile uint32_t escrita;   ///< Fim do último registro completo.
+    volatile uint32_t lida;      ///< Início do primeiro registro ainda não enviado.
+    volatile uint32_t perdidos;  ///< Registros descartados por anel cheio (acumulado).
+} log_bin_anel_t;
+
+static log_bin_anel_t aneis[LOG_BIN_NUCLEOS];
+
+void __not_in_flash_func(log_bin_gravar)(const char *fmt, uint32_t nargs, const uint32_t *args) {
+    // Núcleo lido já com as interrupções desabilitadas: a tarefa não troca de núcleo no meio.
+    uint32_t estado = save_and_disable_interrupts();
+    log_bin_anel_t *anel = &aneis[get_core_num()];
+    uint32_t w = anel->escrita;
+
+    if (LOG_BIN_PALAVRAS_POR_NUCLEO - (w - anel->lida) < nargs + 2) {
+        anel->perdidos++;
+        restore_interrupts(estado);
+        return;
+    }
+
+    anel->palavras[w++ & LOG_BIN_MASCARA] = (uint32_t)(uintptr_t)fmt | nargs;
+    anel->palavras[w++ & LOG_BIN_MASCARA] = time_us_32();
+    for (uint32_t i = 0; i < nargs; i++) {
+        anel->palavras[w++ & LOG_BIN_MASCARA] = args[i];
+    }
+
+    // Publica o registro só depois que as palavras estão na RAM (o consumidor pode
+    // estar no outro núcleo).
+    __dmb();
+    anel->escrita = w;
+    restore_interrupts(estado);
+}
+
+#define LOG_BIN_CABECALHO 12
+
+/**
+ * @brief Quadro montado antes do envio: cabeçalho + o anel inteiro no pior caso (~4 KiB).
+ *
+ * Estático porque só log_bin_despejar() o usa e ela tem um único consumidor.
+ */
+static uint8_t quadro[LOG_BIN_CABECALHO + LOG_BIN_PALAVRAS_POR_NUCLEO * 4];
+
+void log_bin_despejar(void) {
+    for (uint32_t n = 0; n < LOG_BIN_NUCLEOS; n++) {
+        log_bin_anel_t *anel = &aneis[n];
+        uint32_t fim = anel->escrita;
+        uint32_t ini = anel->lida;
+        __dmb();   // Palavras até `fim` já visíveis.
+
+        if (fim == ini) {
+            continue;
+        }
+
+        uint32_t total = fim - ini;
+        uint32_t perdidos = anel->perdidos;
+        quadro[0] = 'B';
+        quadro[1] = 'L';
+        quadro[2] = 'O';
+        quadro[3] = 'G';
+        quadro[4] = (uint8_t)n;
+        quadro[5] = 0;
+        quadro[6] = (uint8_t)total;
+        quadro[7] = (uint8_t)(total >> 8);
+        for (int b = 0; b < 4; b++) {
+            quadro[8 + b] = (uint8_t)(perdidos >> (8 * b));
+        }
+
+        // Em até dois trechos contíguos (o anel pode dar a volta no meio).
+        uint32_t pos = ini & LOG_BIN_MASCARA;
+        uint32_t ate_volta = LOG_BIN_PALAVRAS_POR_NUCLEO - pos;
+        uint32_t parte = (total < ate_volta) ? total : ate_volta;
+        memcpy(&quadro[LOG_BIN_CABECALHO], &anel->palavras[pos], parte * 4);
+        memcpy(&quadro[LOG_BIN_CABECALHO + parte * 4], &anel->palavras[0], (total - parte) * 4);
+
+        // Copiado: o espaço volta para o produtor antes de esperar pela USB.
+        __dmb();
+        anel->lida = fim;
+
+        // Uma escrita só, sem a tradução '\n' -> "\r\n": a stdio segura a trava dela
+        // durante o quadro inteiro e nenhum printf de outra tarefa cai no meio dele.
+        stdio_put_string((const char *)quadro, (int)(LOG_BIN_CABECALHO + total * 4), false, false);
+    }
+    stdio_flush();
+}
+
+void log_bin_descartar(void) {
+    for (uint32_t n = 0; n < LOG_BIN_NUCLEOS; n++) {
+        aneis[n].lida = aneis[n].escrita;
+    }
+}
@@ -0,0 +1,118 @@
+/**
+ * @file log_binario.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Log binário com formatação adiada: a placa grava só o id do formato e os argumentos.
+ *
+ * @details
+ * `printf("%.2f", ...)` custa milhares de ciclos (formatação de float da newlib + USB) e
+ * é feito no caminho quente. Com LOG_BIN a formatação vai para o PC:
+ *
+ * - A string de formato é colocada na seção `.logfmt` do ELF, alinhada a 8 bytes. O
+ *   endereço dela é o id do formato; o firmware nunca a lê.
+ * - Cada chamada grava no anel do núcleo atual: `[endereço do formato | nº de args]`,
+ *   `time_us_32()` e um word de 32 bits por argumento (float vai como os bits do float).
+ *   São algumas instruções por argumento, com as interrupções do núcleo desabilitadas.
+ * - log_bin_despejar() envia os registros pendentes pela stdio em quadros binários e o
+ *   script `tools/log_bin_decode.py` reconstrói as mensagens lendo `.logfmt` do ELF.
+ *
+ * Quadro enviado (little-endian), um por núcleo com registros pendentes:
+ * | offset | tamanho | campo                                                  |
+ * |--------|---------|--------------------------------------------------------|
+ * | 0      | 4       | "BLOG"                                                 |
+ * | 4      | 1       | núcleo                                                 |
+ * | 5      | 1       | reservado (0)                                          |
+ * | 6      | 2       | n = palavras de registros a seguir                     |
+ * | 8      | 4       | total de registros descartados por anel cheio          |
+ * | 12     | 4 × n   | registros                                              |
+ *
+ * Regras para os argumentos (cada conversão do formato consome exatamente um word):
+ * - Inteiros de até 32 bits: `%d %i %u %x %X %o %c`, com ou sem `l`.
+ * - float/double: `%f %e %g` (double é gravado como float).
+ * - `%s` só para strings constantes (literais em flash): o PC lê o texto no ELF.
+ * - Valores de 64 bits são truncados para 32: converta antes de registrar.
+ * - No máximo LOG_BIN_MAX_ARGS argumentos.
+ *
+ * @note O texto que a aplicação ainda envia com printf (ex.: o despejo do trace) pode
+ * sair intercalado com os quadros: o decodificador ignora o que não for quadro.
+ */
+
+#ifndef LOG_BINARIO_H
+#define LOG_BINARIO_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define LOG_BIN_PALAVRAS_POR_NUCLEO 1024  ///< Potência de 2 (4 KiB por núcleo).
+#define LOG_BIN_MAX_ARGS            6     ///< Cabe nos 3 bits baixos do endereço do formato.
+
+/**
+ * @brief Grava um registro no anel do núcleo atual (executa a partir da RAM).
+ * @param fmt   String de formato em `.logfmt` (alinhada a 8 bytes).
+ * @param nargs Número de argumentos (0 a LOG_BIN_MAX_ARGS).
+ * @param args  Argumentos já convertidos para 32 bits.
+ * @note Se o anel estiver cheio o registro é descartado e contado.
+ */
+void log_bin_gravar(const char *fmt, uint32_t nargs, const uint32_t *args);
+
+/**
+ * @brief Envia pela stdio os registros pendentes de cada núcleo e libera o espaço.
+ * @note Bloqueante enquanto a USB aceita os bytes: chamar em contexto de baixa prioridade.
+ *       Cada quadro sai numa única escrita na stdio, sem printf de outra tarefa no meio.
+ *       Pode rodar em paralelo com gravações (inclusive no outro núcleo).
+ */
+void log_bin_despejar(void);
+
+/** @brief Descarta os registros pendentes sem enviá-los (ex.: entre rodadas de benchmark). */
+void log_bin_descartar(void);
+
+// --- Conversão de cada argumento para um word de 32 bits ---
+static inline uint32_t log_bin_u32(uint32_t v) { return v; }
+static inline uint32_t log_bin_ptr(const void *p) { return (uint32_t)(uintptr_t)p; }
+static inline uint32_t log_bin_f32(float v) {
+    union { float f; uint32_t u; } c = { .f = v };
+    return c.u;
+}
+static inline uint32_t log_bin_f64(double v) { return log_bin_f32((float)v); }
+
+#define LOG_BIN_PALAVRA(x) _Generic((x),            \
+        float: log_bin_f32,                         \
+        double: log_bin_f64,                        \
+        char *: log_bin_ptr,                        \
+        const char *: log_bin_ptr,                  \
+        void *: log_bin_ptr,                        \
+        const void *: log_bin_ptr,                  \
+        default: log_bin_u32)(x)
+
+// --- Contagem e conversão dos argumentos variádicos (até 6) ---
+#define LOG_BIN_NARGS(...) LOG_BIN_NARGS_(0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define LOG_BIN_NARGS_(_0, _1, _2, _3, _4, _5, _6, n, ...) n
+
+#define LOG_BIN_P0()
+#define LOG_BIN_P1(a)                LOG_BIN_PALAVRA(a)
+#define LOG_BIN_P2(a, b)             LOG_BIN_P1(a), LOG_BIN_PALAVRA(b)
+#define LOG_BIN_P3(a, b, c)          LOG_BIN_P2(a, b), LOG_BIN_PALAVRA(c)
+#define LOG_BIN_P4(a, b, c, d)       LOG_BIN_P3(a, b, c), LOG_BIN_PALAVRA(d)
+#define LOG_BIN_P5(a, b, c, d, e)    LOG_BIN_P4(a, b, c, d), LOG_BIN_PALAVRA(e)
+#define LOG_BIN_P6(a, b, c, d, e, f) LOG_BIN_P5(a, b, c, d, e), LOG_BIN_PALAVRA(f)
+#define LOG_BIN_CAT(a, b)  LOG_BIN_CAT_(a, b)
+#define LOG_BIN_CAT_(a, b) a##b
+#define LOG_BIN_MAPA(...) LOG_BIN_CAT(LOG_BIN_P, LOG_BIN_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+/**
+ * @brief Registra uma mensagem no formato do printf sem formatá-la na placa.
+ *
+ * O `sizeof(printf(...))` não executa nada: só mantém a checagem de formato do
+ * compilador (-Wformat) sobre os argumentos.
+ */
+#define LOG_BIN(fmt, ...)                                                               \
+    do {                                                                                \
+        static const char log_bin_fmt_[]                                                \
+            __attribute__((section(".logfmt"), aligned(8), used)) = fmt;                \
+        const uint32_t log_bin_args_[LOG_BIN_NARGS(__VA_ARGS__) + 1] =                  \
+            { 0, LOG_BIN_MAPA(__VA_ARGS__) };                                           \
+        (void)sizeof(printf(fmt, ##__VA_ARGS__));                                       \
+        log_bin_gravar(log_bin_fmt_, LOG_BIN_NARGS(__VA_ARGS__), &log_bin_args_[1]);    \
+    } while (0)
+
+#endif // LOG_BINARIO_H
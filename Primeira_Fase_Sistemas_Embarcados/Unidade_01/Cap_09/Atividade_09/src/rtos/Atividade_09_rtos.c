@@ -0,0 +1,350 @@
+/**
+ * @file Atividade_09_rtos.c
+ * @brief Versão FreeRTOS do TempCycleDMA: pipeline de tarefas ligadas por stream buffers.
+ * @details Mesma aplicação do executivo cíclico (`src/Atividade_09.c`), reorganizada como
+ *          um fluxo de dados. Cada etapa é uma tarefa independente e a única ligação entre
+ *          elas é o stream buffer de entrada/saída (nenhuma variável global compartilhada).
+ * @author  Manoel Furtado
+ * @date    25 maio 2025
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ */
+
+/**
+ * ------------------------------------------------------------
+ *  Arquivo: Atividade_09_rtos.c
+ *  Projeto: TempCycleDMA (versão pipeline FreeRTOS)
+ * ------------------------------------------------------------
+ *  Fluxo de dados:
+ *
+ *    DMA_IRQ_0 ──notifica──▶ aquisicao_task
+ *                              │ sb_amostras (blocos de amostras brutas + instante)
+ *                              ▼
+ *                           media_task     (janela de 0,5 s, soma inteira)
+ *                              │ sb_media
+ *                              ▼
+ *                           tendencia_task
+ *                     sb_display │       │ sb_led
+ *                              ▼         ▼
+ *                     display_task     led_task (T4 + alerta T5)
+ *
+ *  - A aquisição usa dois buffers (ping‑pong): enquanto o DMA
+ *    enche um, o outro é enviado ao stream buffer, então o ADC
+ *    não para entre blocos como no executivo cíclico.
+ *  - A média soma os valores brutos em inteiro e converte para
+ *    °C uma única vez por janela (a conversão é linear, então o
+ *    resultado é o mesmo da média das conversões individuais).
+ *  - Latência fim‑a‑fim: cada registro carrega o instante da
+ *    última amostra da janela; a display_task mede o tempo até
+ *    o valor estar no OLED e imprime mín/méd/máx. O executivo
+ *    cíclico imprime a mesma métrica para comparação.
+ *
+ *  Build: cmake -DATIVIDADE_09_FREERTOS=ON (gera Atividade_09_rtos)
+ * ------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/watchdog.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#include "setup.h"
+#include "irq_handlers.h"
+#include "tarefa2_display.h"
+#include "tarefa3_tendencia.h"
+#include "tarefa4_controla_neopixel.h"
+#include "neopixel_driver.h"
+#include "testes_cores.h"
+#include "log_binario.h"
+#include "crash_dump.h"
+#include "trace_recorder.h"
+
+// ---------- Parâmetros do pipeline ----------
+#define BLOCO_AMOSTRAS_RTOS     1000     // Amostras por transferência DMA (2 KiB)
+#define JANELA_MEDIA_US         500000   // Mesma janela de 0,5 s da Tarefa 1
+#define RELATORIO_A_CADA        10       // Janelas entre relatórios de latência
+
+// ---------- Prioridades (etapas mais próximas do sensor têm prioridade maior) ----------
+#define PRIO_AQUISICAO          (tskIDLE_PRIORITY + 4)
+#define PRIO_MEDIA              (tskIDLE_PRIORITY + 3)
+#define PRIO_TENDENCIA          (tskIDLE_PRIORITY + 2)
+#define PRIO_LED                (tskIDLE_PRIORITY + 2)
+#define PRIO_DISPLAY            (tskIDLE_PRIORITY + 1)
+
+// ---------- Registros trocados entre as etapas ----------
+typedef struct {
+    uint32_t t_ultima_us;                       // Instante em que o DMA terminou o bloco
+    uint16_t amostras[BLOCO_AMOSTRAS_RTOS];
+} bloco_amostras_t;
+
+typedef struct {
+    float media;                                // °C
+    uint32_t t_amostra_us;                      // Instante da última amostra da janela
+} registro_media_t;
+
+typedef struct {
+    float media;
+    tendencia_t tendencia;
+    uint32_t t_amostra_us;
+} registro_tendencia_t;
+
+// ---------- Stream buffers (um produtor e um consumidor cada) ----------
+static StreamBufferHandle_t sb_amostras;
+static StreamBufferHandle_t sb_media;
+static StreamBufferHandle_t sb_display;
+static StreamBufferHandle_t sb_led;
+
+static TaskHandle_t aquisicao_handle;
+
+// Dois buffers de DMA: um sendo preenchido, outro sendo enviado.
+static bloco_amostras_t blocos[2];
+
+/**
+ * @brief Converte a média dos valores brutos do ADC para °C.
+ * @details Mesma fórmula de convert_to_celsius() da Tarefa 1, aplicada uma vez por janela.
+ * @param raw_medio Média dos valores brutos de 12 bits.
+ * @return Temperatura em graus Celsius.
+ */
+static float raw_para_celsius(float raw_medio) {
+    const float conv = 3.3f / (1 << 12);
+    float voltage = raw_medio * conv;
+    return 27.0f - (voltage - 0.706f) / 0.001721f;
+}
+
+/**
+ * @brief Handler do DMA para a versão RTOS: acorda a tarefa de aquisição.
+ * @details Substitui dma_handler_temp(), que apenas seta uma flag para o laço principal.
+ */
+static void dma_handler_rtos(void) {
+    BaseType_t acordou = pdFALSE;
+    dma_hw->ints0 = 1u << DMA_TEMP_CHANNEL;
+    vTaskNotifyGiveFromISR(aquisicao_handle, &acordou);
+    portYIELD_FROM_ISR(acordou);
+}
+
+/**
+ * @brief Dispara uma transferência DMA de um bloco com o ADC em modo contínuo.
+ * @param destino Buffer de amostras a ser preenchido.
+ */
+static void iniciar_bloco_dma(uint16_t *destino) {
+    dma_channel_configure(DMA_TEMP_CHANNEL, &cfg_temp, destino, &adc_hw->fifo,
+                          BLOCO_AMOSTRAS_RTOS, true);
+}
+
+/**
+ * @brief Etapa 1: aquisição contínua por DMA (ping‑pong).
+ * @details Bloqueia na notificação do DMA (sem consumir CPU), reinicia o DMA no outro
+ * buffer imediatamente e só então copia o bloco pronto para sb_amostras.
+ * @param param Não utilizado.
+ */
+static void aquisicao_task(void *param) {
+    int atual = 0;
+
+    adc_select_input(4);           // Canal 4 → sensor interno
+    adc_fifo_drain();
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_run(true);
+    iniciar_bloco_dma(blocos[atual].amostras);
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        blocos[atual].t_ultima_us = time_us_32();
+
+        int pronto = atual;
+        atual ^= 1;
+        iniciar_bloco_dma(blocos[atual].amostras);
+
+        // Se a média ficar para trás, espera: é melhor atrasar do que perder amostras da janela.
+        xStreamBufferSend(sb_amostras, &blocos[pronto], sizeof(bloco_amostras_t), portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief Etapa 2: média da temperatura em janelas de JANELA_MEDIA_US.
+ * @param param Não utilizado.
+ */
+static void media_task(void *param) {
+    static bloco_amostras_t bloco;   // 2 KiB: fora da pilha da tarefa
+    uint32_t soma = 0;
+    uint32_t total = 0;
+    uint32_t inicio_janela = 0;
+
+    while (1) {
+        xStreamBufferReceive(sb_amostras, &bloco, sizeof(bloco), portMAX_DELAY);
+
+        if (total == 0) {
+            inicio_janela = bloco.t_ultima_us;
+        }
+        for (int i = 0; i < BLOCO_AMOSTRAS_RTOS; i++) {
+            soma += bloco.amostras[i];      // 12 bits: cabe folgado em 32 bits por janela
+        }
+        total += BLOCO_AMOSTRAS_RTOS;
+
+        if ((uint32_t)(bloco.t_ultima_us - inicio_janela) >= JANELA_MEDIA_US) {
+            registro_media_t reg = {
+                .media = raw_para_celsius((float)soma / (float)total),
+                .t_amostra_us = bloco.t_ultima_us
+            };
+            xStreamBufferSend(sb_media, &reg, sizeof(reg), portMAX_DELAY);
+            soma = 0;
+            total = 0;
+        }
+    }
+}
+
+/**
+ * @brief Etapa 3: tendência; distribui o resultado para o display e para os LEDs.
+ * @param param Não utilizado.
+ */
+static void tendencia_task(void *param) {
+    registro_media_t entrada;
+
+    while (1) {
+        xStreamBufferReceive(sb_media, &entrada, sizeof(entrada), portMAX_DELAY);
+
+        registro_tendencia_t saida = {
+            .media = entrada.media,
+            .tendencia = tarefa3_analisa_tendencia(entrada.media),
+            .t_amostra_us = entrada.t_amostra_us
+        };
+
+        // Timeout zero: se um consumidor estiver atrasado, ele perde esta atualização
+        // em vez de travar a outra saída.
+        xStreamBufferSend(sb_display, &saida, sizeof(saida), 0);
+        xStreamBufferSend(sb_led, &saida, sizeof(saida), 0);
+    }
+}
+
+/**
+ * @brief Tarefa em execução para o registro de falha (substitui a definição fraca).
+ * @return Nome da tarefa ou NULL antes do escalonador iniciar.
+ */
+const char *crash_nome_tarefa(void) {
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED) {
+        return NULL;
+    }
+    return pcTaskGetName(NULL);
+}
+
+/** @brief Heap do FreeRTOS esgotado: vira registro de falha em vez de travar. */
+void vApplicationMallocFailedHook(void) {
+    crash_falha("heap FreeRTOS esgotado");
+}
+
+/** @brief Estouro de pilha detectado pelo kernel (configCHECK_FOR_STACK_OVERFLOW 2). */
+void vApplicationStackOverflowHook(TaskHandle_t tarefa, char *nome) {
+    (void)tarefa;
+    char texto[CRASH_CONTEXTO_MAX];
+    snprintf(texto, sizeof(texto), "estouro de pilha: %s", nome);
+    crash_falha(texto);
+}
+
+/**
+ * @brief Etapa 4: OLED + medição da latência amostra → valor exibido.
+ * @details Também alimenta o watchdog: se qualquer etapa do pipeline travar,
+ * o display deixa de receber dados e o sistema é reiniciado.
+ * @param param Não utilizado.
+ */
+static void display_task(void *param) {
+    registro_tendencia_t reg;
+    uint32_t lat_min = UINT32_MAX, lat_max = 0, n = 0;
+    uint64_t lat_soma = 0;
+
+    while (1) {
+        // 'c' pelo terminal exporta o registro de falha do boot anterior.
+        if (getchar_timeout_us(0) == 'c') {
+            crash_exportar();
+        }
+        crash_relatar();
+
+        if (xStreamBufferReceive(sb_display, &reg, sizeof(reg), pdMS_TO_TICKS(1000)) != sizeof(reg)) {
+            continue;
+        }
+
+        tarefa2_exibir_oled(reg.media, reg.tendencia);
+        uint32_t latencia = time_us_32() - reg.t_amostra_us;
+        crash_watchdog_alimentar();
+
+        if (latencia < lat_min) lat_min = latencia;
+        if (latencia > lat_max) lat_max = latencia;
+        lat_soma += latencia;
+
+        if (++n == RELATORIO_A_CADA) {
+            LOG_BIN("🌡️  %.2f °C | Tend: %s | latencia amostra->OLED (us) min %lu med %lu max %lu",
+                    reg.media, tendencia_para_texto(reg.tendencia),
+                    (unsigned long)lat_min, (unsigned long)(lat_soma / n), (unsigned long)lat_max);
+            log_bin_despejar();
+            lat_min = UINT32_MAX;
+            lat_max = 0;
+            lat_soma = 0;
+            n = 0;
+        }
+    }
+}
+
+/**
+ * @brief Etapa 5: matriz NeoPixel por tendência (T4) e alerta branco abaixo de 1 °C (T5).
+ * @param param Não utilizado.
+ */
+static void led_task(void *param) {
+    registro_tendencia_t reg;
+
+    while (1) {
+        xStreamBufferReceive(sb_led, &reg, sizeof(reg), portMAX_DELAY);
+
+        if (reg.media < 1.0f) {
+            npSetAll(COR_BRANCA);
+            npWrite();
+            vTaskDelay(pdMS_TO_TICKS(1000));   // Só esta tarefa espera; o resto do pipeline segue
+            npClear();
+            npWrite();
+        }
+        tarefa4_matriz_cor_por_tendencia(reg.tendencia);
+    }
+}
+
+/**
+ * @brief Cria os stream buffers e as tarefas e inicia o escalonador.
+ * @return Nunca retorna.
+ */
+int main(void) {
+    crash_iniciar();  // Antes de trace_iniciar(): aproveita o trace de um reset por watchdog
+    trace_iniciar();  // IRQ do DMA gravada no trace; os últimos eventos entram no registro de falha
+    stdio_init_all();
+    setup();  // ADC, DMA, OLED, NeoPixel (mesma configuração do executivo cíclico)
+
+    // Troca o handler da IRQ do DMA pela versão que notifica a tarefa de aquisição.
+    irq_set_enabled(DMA_IRQ_0, false);
+    irq_remove_handler(DMA_IRQ_0, dma_handler_temp);
+    irq_set_exclusive_handler(DMA_IRQ_0, dma_handler_rtos);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    // Nível de disparo = tamanho de um registro: o consumidor só acorda com um registro inteiro.
+    sb_amostras = xStreamBufferCreate(2 * sizeof(bloco_amostras_t), sizeof(bloco_amostras_t));
+    sb_media    = xStreamBufferCreate(4 * sizeof(registro_media_t), sizeof(registro_media_t));
+    sb_display  = xStreamBufferCreate(4 * sizeof(registro_tendencia_t), sizeof(registro_tendencia_t));
+    sb_led      = xStreamBufferCreate(4 * sizeof(registro_tendencia_t), sizeof(registro_tendencia_t));
+    if (!sb_amostras || !sb_media || !sb_display || !sb_led) {
+        crash_falha("falha ao criar stream buffers");
+    }
+
+    xTaskCreate(aquisicao_task, "Aquisicao", 256, NULL, PRIO_AQUISICAO, &aquisicao_handle);
+    xTaskCreate(media_task, "Media", 256, NULL, PRIO_MEDIA, NULL);
+    xTaskCreate(tendencia_task, "Tendencia", 256, NULL, PRIO_TENDENCIA, NULL);
+    xTaskCreate(display_task, "Display", 1024, NULL, PRIO_DISPLAY, NULL);
+    xTaskCreate(led_task, "LED", 256, NULL, PRIO_LED, NULL);
+
+    // Mesmo limite do executivo cíclico; alimentado pela display_task.
+    crash_watchdog_iniciar(3000);
+
+    vTaskStartScheduler();
+
+    while (true) {
+        // Nunca deve chegar aqui.
+    }
+}
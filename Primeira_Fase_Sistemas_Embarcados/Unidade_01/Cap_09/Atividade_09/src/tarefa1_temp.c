@@ -20,16 +20,17 @@
  *
  *      A leitura é feita em blocos menores (10.000 amostras)
  *      para evitar o uso excessivo da SRAM do RP2040. Cada
- *      bloco é transferido via DMA e processado de forma
- *      incremental para obter a média da temperatura ao final
- *      do intervalo total.
+ *      bloco é transferido via DMA e somado em inteiros; a
+ *      conversão é linear, então basta converter a média dos
+ *      valores brutos uma vez, em ponto fixo (lib/ponto_fixo),
+ *      ao final do intervalo total.
  *
  *  Funcionalidades:
  *      - Converte valores brutos do ADC para graus Celsius.
  *      - Controla o tempo de aquisição com precisão usando
- *        o clock interno via 'get_absolute_time()'.
- *      - Utiliza DMA canal 0 e depende da flag 'dma_temp_done'
- *        sinalizada pelo handler definido em 'irq_handlers.c'.
+ *        o clock interno via 'hal_tempo_us()'.
+ *      - Utiliza DMA canal 0 pela camada 'hal.h'; a interrupção
+ *        de fim do canal ('irq_handlers.c') acorda a espera.
  *
  *  Relacionamento:
  *      - Chamado pelo laço principal em 'main.c' como tarefa do ciclo.
@@ -40,17 +41,16 @@
  * ------------------------------------------------------------
  */
 
-#include "pico/stdlib.h"
-#include "hardware/adc.h"
-#include "hardware/dma.h"
-#include "hardware/sync.h"
+#include "hal.h"
 #include "tarefa1_temp.h"
+#include "ponto_fixo.h"
 
 #define BLOCO_AMOSTRAS 10000
 #define DURACAO_AMOSTRAGEM_US 500000  // 0,5 segundos em microssegundos
 
+#define CANAL_ADC_TEMP 4              // Canal 4 → sensor interno
+
 static uint16_t buffer_temp[BLOCO_AMOSTRAS];
-extern volatile bool dma_temp_done;
 
 /**
  * @brief Converte valor do ADC para temperatura em °C.
@@ -66,49 +66,26 @@ extern volatile bool dma_temp_done;
  * @return Valor de retorno descrevendo o significado.
  */
 
-static float convert_to_celsius(uint16_t raw) {
+float convert_to_celsius(uint16_t raw) {
     const float conv = 3.3f / (1 << 12);  // Conversão para tensão
     float voltage = raw * conv;
     return 27.0f - (voltage - 0.706f) / 0.001721f;
 }
 
 /**
- * @brief Inicia uma transferência via DMA de um bloco do sensor de temperatura.
+ * @brief convert_to_celsius() em Q16.16, para uma leitura (ou média de leituras) em Q16.
  *
- * @param buffer Buffer de destino.
- * @param cfg Configuração do canal DMA.
- * @param dma_chan Canal DMA utilizado.
+ * @details 27 - (raw·3,3/4096 - 0,706) / 0,001721 = 437,24 - raw·0,46814: uma
+ * multiplicação e uma subtração. O erro da constante em Q16 fica abaixo de 0,01 °C na
+ * faixa do sensor, contra 0,47 °C de um passo do ADC.
  */
-/**
- * @brief Descrição da função iniciar_dma_temp.
- *
- * @details Explique aqui a lógica da função, parâmetros de entrada e o que ela retorna.
- * @param buffer Descrição do parâmetro buffer.
- * @param cfg Descrição do parâmetro cfg.
- * @param dma_chan Descrição do parâmetro dma_chan.
- * @return Valor de retorno descrevendo o significado.
- */
-
-static void iniciar_dma_temp(uint16_t *buffer, dma_channel_config *cfg, int dma_chan) {
-    adc_select_input(4);           // Canal 4 → sensor interno
-    adc_fifo_drain();
-    adc_run(false);
-    adc_fifo_setup(true, true, 1, false, false);
-    adc_run(true);
-
-    dma_channel_configure(
-        dma_chan,
-        cfg,
-        buffer, &adc_hw->fifo,
-        BLOCO_AMOSTRAS,
-        true
-    );
+q16_t convert_to_celsius_q16(q16_t raw_q16) {
+    return Q16(27.0 + 0.706 / 0.001721) - pf_q16_mul(raw_q16, Q16(3.3 / 4096.0 / 0.001721));
 }
 
 /**
  * @brief Executa a Tarefa 1 do executor cíclico: coleta de temperatura por 0,5s.
  *
- * @param cfg_temp Configuração do canal DMA.
  * @param dma_chan Número do canal DMA utilizado.
  * @return float Temperatura média calculada ao final do intervalo.
  */
@@ -116,29 +93,30 @@ static void iniciar_dma_temp(uint16_t *buffer, dma_channel_config *cfg, int dma_
  * @brief Descrição da função tarefa1_obter_media_temp.
  *
  * @details Explique aqui a lógica da função, parâmetros de entrada e o que ela retorna.
- * @param cfg_temp Descrição do parâmetro cfg_temp.
  * @param dma_chan Descrição do parâmetro dma_chan.
  * @return Valor de retorno descrevendo o significado.
  */
 
-float tarefa1_obter_media_temp(dma_channel_config* cfg_temp, int dma_chan) {
-    float soma = 0.0f;
+float tarefa1_obter_media_temp(int dma_chan) {
+    uint32_t soma = 0;             // 0,5 s a 500 kHz × 4095 < 2^31
     uint32_t total_amostras = 0;
 
-    absolute_time_t inicio = get_absolute_time();
+    uint64_t inicio = hal_tempo_us();
 
-    while (absolute_time_diff_us(inicio, get_absolute_time()) < DURACAO_AMOSTRAGEM_US) {
-        dma_temp_done = false;
-        iniciar_dma_temp(buffer_temp, cfg_temp, dma_chan);
-        while (!dma_temp_done) __wfi();  // Aguarda fim do DMA
-        adc_run(false); // Desliga o ADC
+    while (hal_tempo_us() - inicio < DURACAO_AMOSTRAGEM_US) {
+        hal_adc_dma_iniciar(dma_chan, CANAL_ADC_TEMP, buffer_temp, BLOCO_AMOSTRAS);
+        hal_adc_dma_aguardar(dma_chan);  // Aguarda fim do DMA e desliga o ADC
 
         for (int i = 0; i < BLOCO_AMOSTRAS; i++) {
-            soma += convert_to_celsius(buffer_temp[i]);
+            soma += buffer_temp[i];
         }
 
         total_amostras += BLOCO_AMOSTRAS;
     }
 
-    return soma / total_amostras;
+    // Média em Q16: parte inteira e fração saem do divisor de hardware.
+    uint32_t inteiro = soma / total_amostras;
+    q16_t media = Q16_DE_INT(inteiro) +
+                  pf_q16_div((q16_t)(soma - inteiro * total_amostras), (q16_t)total_amostras);
+    return pf_q16_para_float(convert_to_celsius_q16(media));
 }
\ No newline at end of file
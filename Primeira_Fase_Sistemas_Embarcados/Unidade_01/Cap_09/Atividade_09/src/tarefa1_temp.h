@@ -10,8 +10,15 @@
 #ifndef TAREFA1_TEMP_H
 #define TAREFA1_TEMP_H
 
-#include "hardware/dma.h"
+#include <stdint.h>
+#include "ponto_fixo.h"
 
-float tarefa1_obter_media_temp(dma_channel_config* cfg, int dma_chan);
+float tarefa1_obter_media_temp(int dma_chan);
+
+/** @brief Converte uma leitura de 12 bits do sensor interno para °C. */
+float convert_to_celsius(uint16_t raw);
+
+/** @brief Idem em Q16.16; aceita média de leituras (valor bruto com fração). */
+q16_t convert_to_celsius_q16(q16_t raw_q16);
 
 #endif
\ No newline at end of file
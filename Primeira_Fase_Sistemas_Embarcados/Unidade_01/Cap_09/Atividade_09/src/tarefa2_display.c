@@ -27,6 +27,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include "pico/stdlib.h"
 #include "ssd1306.h"
 #include "display_utils.h"
 #include "tarefa2_display.h"
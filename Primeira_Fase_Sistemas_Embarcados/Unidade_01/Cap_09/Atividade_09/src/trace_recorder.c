@@ -0,0 +1,130 @@
+/**
+ * @file trace_recorder.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Implementação do gravador de eventos em anéis por núcleo.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "trace_recorder.h"
+
+#define TRACE_NUCLEOS 2
+
+/** @brief Evento compacto: 8 bytes. */
+typedef struct {
+    uint32_t tempo_us;   ///< time_us_32() no momento do evento.
+    uint8_t tipo;        ///< trace_tipo_t.
+    uint8_t nucleo;      ///< Núcleo que gerou o evento.
+    uint16_t id;         ///< Objeto associado.
+} trace_evento_t;
+
+/** @brief Anel de um núcleo. Apenas esse núcleo escreve nele. */
+typedef struct {
+    trace_evento_t eventos[TRACE_EVENTOS_POR_NUCLEO];
+    uint32_t escritos;   ///< Total de eventos gravados (não volta a zero ao dar a volta).
+} trace_anel_t;
+
+/** @brief Entrada da tabela de nomes. */
+typedef struct {
+    uint8_t categoria;
+    uint16_t id;
+    const char *nome;
+} trace_nome_t;
+
+// Fora do .bss: o conteúdo sobrevive ao reset por watchdog e entra no crash_dump.
+// trace_iniciar() zera os anéis.
+static trace_anel_t __uninitialized_ram(aneis)[TRACE_NUCLEOS];
+static trace_nome_t nomes[TRACE_MAX_NOMES];
+static uint32_t total_nomes = 0;
+static volatile bool gravando = false;
+
+void trace_iniciar(void) {
+    memset(aneis, 0, sizeof(aneis));
+    gravando = true;
+}
+
+void __not_in_flash_func(trace_evento)(uint8_t tipo, uint16_t id) {
+    if (!gravando) {
+        return;
+    }
+
+    uint nucleo = get_core_num();
+    trace_anel_t *anel = &aneis[nucleo];
+
+    // Impede que uma interrupção do mesmo núcleo grave no meio deste evento.
+    uint32_t estado = save_and_disable_interrupts();
+    trace_evento_t *ev = &anel->eventos[anel->escritos & (TRACE_EVENTOS_POR_NUCLEO - 1)];
+    ev->tempo_us = time_us_32();
+    ev->tipo = tipo;
+    ev->nucleo = (uint8_t)nucleo;
+    ev->id = id;
+    anel->escritos++;
+    restore_interrupts(estado);
+}
+
+void trace_nomear(uint8_t categoria, uint16_t id, const char *nome) {
+    // Atualiza a entrada existente, se houver.
+    for (uint32_t i = 0; i < total_nomes; i++) {
+        if (nomes[i].categoria == categoria && nomes[i].id == id) {
+            nomes[i].nome = nome;
+            return;
+        }
+    }
+    if (total_nomes < TRACE_MAX_NOMES) {
+        nomes[total_nomes++] = (trace_nome_t){ categoria, id, nome };
+    }
+}
+
+void trace_despejar(void) {
+    gravando = false;
+    // Garante que uma escrita em andamento no outro núcleo já terminou.
+    busy_wait_us(10);
+
+    printf("TRACE_BEGIN %016llx %u\n", (unsigned long long)time_us_64(), TRACE_NUCLEOS);
+
+    for (uint32_t i = 0; i < total_nomes; i++) {
+        printf("N %u %u %s\n", nomes[i].categoria, nomes[i].id, nomes[i].nome);
+    }
+
+    for (uint32_t n = 0; n < TRACE_NUCLEOS; n++) {
+        trace_anel_t *anel = &aneis[n];
+        uint32_t total = anel->escritos;
+        uint32_t primeiro = (total > TRACE_EVENTOS_POR_NUCLEO) ? total - TRACE_EVENTOS_POR_NUCLEO : 0;
+
+        // Quantos eventos foram sobrescritos antes do despejo.
+        printf("C %lu %lu %lu\n", (unsigned long)n, (unsigned long)total, (unsigned long)primeiro);
+        for (uint32_t k = primeiro; k < total; k++) {
+            const trace_evento_t *ev = &anel->eventos[k & (TRACE_EVENTOS_POR_NUCLEO - 1)];
+            printf("E %u %08lx %u %u\n", ev->nucleo, (unsigned long)ev->tempo_us, ev->tipo, ev->id);
+        }
+    }
+
+    printf("TRACE_END\n");
+
+    // Recomeça com anéis limpos para que o próximo despejo não repita eventos.
+    trace_iniciar();
+}
+
+uint32_t trace_copiar_recentes(void *destino, uint32_t max) {
+    uint8_t *saida = destino;
+    uint32_t copiados = 0;
+    uint32_t cota = max / TRACE_NUCLEOS;
+
+    for (uint32_t n = 0; n < TRACE_NUCLEOS; n++) {
+        const trace_anel_t *anel = &aneis[n];
+        uint32_t total = anel->escritos;
+        uint32_t qtd = total;
+        if (qtd > TRACE_EVENTOS_POR_NUCLEO) qtd = TRACE_EVENTOS_POR_NUCLEO;
+        if (qtd > cota) qtd = cota;
+
+        for (uint32_t k = total - qtd; k != total; k++) {
+            memcpy(saida, &anel->eventos[k & (TRACE_EVENTOS_POR_NUCLEO - 1)], sizeof(trace_evento_t));
+            saida += sizeof(trace_evento_t);
+            copiados++;
+        }
+    }
+    return copiados;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file trace_recorder.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Gravador de eventos de escalonamento em RAM (formato compacto de 8 bytes).
+ *
+ * @details
+ * Cada núcleo tem o seu próprio anel circular, portanto não há disputa entre os núcleos:
+ * a única proteção necessária é desabilitar as interrupções do próprio núcleo durante a
+ * escrita de um evento (algumas instruções). Os eventos carregam o `time_us_32()`, que é
+ * comum aos dois núcleos, então as linhas do tempo podem ser intercaladas no PC.
+ *
+ * Fontes de eventos:
+ * - Hooks do FreeRTOS (`traceTASK_SWITCHED_IN/OUT`, `traceQUEUE_SEND/RECEIVE`), definidos
+ *   no FreeRTOSConfig.h.
+ * - Marcações manuais: TRACE_ISR_ENTRA/SAI, TRACE_ZONA_INICIO/FIM e TRACE_MARCA.
+ *
+ * trace_despejar() envia tudo pela stdio (USB CDC) em linhas de texto hexadecimal, que o
+ * script `tools/trace_to_chrome.py` converte para JSON do Chrome Trace / Perfetto
+ * (abrir em chrome://tracing ou https://ui.perfetto.dev).
+ *
+ * @note Este módulo não depende do FreeRTOS: aqui é usado pelo executivo cíclico, com
+ * zonas em torno de cada tarefaN e marcações nas interrupções (a versão FreeRTOS do
+ * Unidade_03/Cap_03 usa o mesmo arquivo com os hooks do kernel).
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <stdint.h>
+
+#define TRACE_EVENTOS_POR_NUCLEO 1024   ///< Potência de 2 (8 KiB por núcleo).
+#define TRACE_MAX_NOMES          32     ///< Entradas da tabela id -> nome.
+
+/** @brief Tipos de evento gravados. */
+typedef enum {
+    TRACE_TAREFA_ENTRA = 1,  ///< Tarefa passou a executar (id = número da tarefa).
+    TRACE_TAREFA_SAI,        ///< Tarefa deixou de executar.
+    TRACE_ISR_ENTRA,         ///< Início de rotina de interrupção (id = número da IRQ).
+    TRACE_ISR_SAI,           ///< Fim de rotina de interrupção.
+    TRACE_FILA_ENVIA,        ///< Envio para fila/semáforo (id = número da fila).
+    TRACE_FILA_RECEBE,       ///< Recepção de fila/semáforo.
+    TRACE_ZONA_INICIO,       ///< Início de trecho marcado pelo usuário.
+    TRACE_ZONA_FIM,          ///< Fim de trecho marcado pelo usuário.
+    TRACE_MARCA              ///< Evento instantâneo do usuário.
+} trace_tipo_t;
+
+/** @brief Categorias da tabela de nomes (o mesmo id pode existir em categorias diferentes). */
+typedef enum {
+    TRACE_NOME_TAREFA = 0,
+    TRACE_NOME_ISR,
+    TRACE_NOME_FILA,
+    TRACE_NOME_ZONA,
+    TRACE_NOME_MARCA
+} trace_categoria_t;
+
+/** @brief Zera os anéis e habilita a gravação. */
+void trace_iniciar(void);
+
+/**
+ * @brief Grava um evento no anel do núcleo atual (executa a partir da RAM).
+ * @param tipo Um valor de trace_tipo_t.
+ * @param id   Identificador do objeto (tarefa, IRQ, fila ou zona).
+ */
+void trace_evento(uint8_t tipo, uint16_t id);
+
+/**
+ * @brief Associa um nome legível a um id para a conversão no PC.
+ * @param categoria Um valor de trace_categoria_t.
+ * @param id        Identificador.
+ * @param nome      String com duração estática.
+ */
+void trace_nomear(uint8_t categoria, uint16_t id, const char *nome);
+
+/**
+ * @brief Pausa a gravação, envia anéis e nomes pela stdio e retoma a gravação.
+ * @note Bloqueante (alguns milhares de linhas): chamar em contexto de baixa prioridade.
+ */
+void trace_despejar(void);
+
+/**
+ * @brief Copia os eventos mais recentes de cada núcleo (até max / 2 por núcleo).
+ * @param destino Área para `max` eventos de 8 bytes: tempo_us (u32), tipo (u8),
+ *                núcleo (u8), id (u16), little-endian.
+ * @param max     Capacidade de `destino` em eventos.
+ * @return Eventos copiados.
+ * @note Os anéis não são zerados no reset, então após um reset por watchdog esta função,
+ *       chamada antes de trace_iniciar(), devolve o que aconteceu antes do travamento.
+ */
+uint32_t trace_copiar_recentes(void *destino, uint32_t max);
+
+// --- Marcações manuais ---
+#define TRACE_ISR_ENTRA(irq)     trace_evento(TRACE_ISR_ENTRA, (uint16_t)(irq))
+#define TRACE_ISR_SAI(irq)       trace_evento(TRACE_ISR_SAI, (uint16_t)(irq))
+#define TRACE_ZONA_INICIO(id)    trace_evento(TRACE_ZONA_INICIO, (uint16_t)(id))
+#define TRACE_ZONA_FIM(id)       trace_evento(TRACE_ZONA_FIM, (uint16_t)(id))
+#define TRACE_MARCA(id)          trace_evento(TRACE_MARCA, (uint16_t)(id))
+
+#endif // TRACE_RECORDER_H
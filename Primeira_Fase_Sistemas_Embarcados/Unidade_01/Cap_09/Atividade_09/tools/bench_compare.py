@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""
+@file bench_compare.py
+@author Manoel Felipe Costa Furtado
+@copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+@brief Lê os relatórios do firmware de microbenchmarks (BENCH_BEGIN ... BENCH_END),
+       guarda linhas de base e compara medianas entre versões.
+
+Uso:
+    # 1) Capturar (o relatório sai ao conectar; envie 'r' para repetir):
+    #    stty -F /dev/ttyACM0 raw 115200 && cat /dev/ttyACM0 > flash.txt
+    #    (idem com o Atividade_09_bench_ram gravado, em ram.txt)
+    # 2) Tabela, com a razão flash/RAM se as duas capturas forem dadas:
+    python3 bench_compare.py flash.txt ram.txt
+    # 3) Guardar a linha de base e, depois de uma mudança, comparar:
+    python3 bench_compare.py flash.txt ram.txt --salvar base.csv
+    python3 bench_compare.py flash.txt ram.txt --base base.csv --limite 5
+
+Com --base, o código de saída é 1 se algum caso ficou mais lento que o limite (%).
+"""
+
+import argparse
+import csv
+import sys
+
+CAMPOS = ["caso", "cache", "n", "min", "mediana", "media", "max", "us_mediana"]
+
+
+def ler_relatorios(caminho):
+    """{(memoria, caso, cache): linha} do último bloco de cada memória no arquivo."""
+    resultado, atual, memoria, cabecalho = {}, None, None, {}
+    with open(caminho, "rb") as f:
+        texto = f.read().decode("utf-8", "replace")
+    for linha in texto.splitlines():
+        linha = linha.strip()
+        if linha.startswith("BENCH_BEGIN"):
+            cabecalho = dict(c.split("=", 1) for c in linha.split()[1:] if "=" in c)
+            memoria, atual = cabecalho.get("memoria", "?"), {}
+        elif linha.startswith("BENCH_END") and atual is not None:
+            # Um novo bloco da mesma memória substitui o anterior.
+            resultado = {k: v for k, v in resultado.items() if k[0] != memoria}
+            resultado.update(atual)
+            atual = None
+        elif atual is not None and "," in linha and not linha.startswith("caso,"):
+            valores = linha.split(",")
+            if len(valores) != len(CAMPOS):
+                continue
+            d = dict(zip(CAMPOS, valores))
+            d["memoria"] = memoria
+            d["clk_hz"] = cabecalho.get("clk_hz", "")
+            atual[(memoria, d["caso"], d["cache"])] = d
+    return resultado
+
+
+def ler_base(caminho):
+    with open(caminho, newline="") as f:
+        return {(d["memoria"], d["caso"], d["cache"]): d for d in csv.DictReader(f)}
+
+
+def salvar_base(caminho, linhas):
+    campos = ["memoria"] + CAMPOS + ["clk_hz"]
+    with open(caminho, "w", newline="") as f:
+        w = csv.DictWriter(f, fieldnames=campos)
+        w.writeheader()
+        for chave in sorted(linhas):
+            w.writerow({c: linhas[chave][c] for c in campos})
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Relatórios do firmware de microbenchmarks")
+    ap.add_argument("capturas", nargs="+", help="texto capturado da serial (flash e/ou RAM)")
+    ap.add_argument("--salvar", help="grava as medianas atuais como linha de base (CSV)")
+    ap.add_argument("--base", help="linha de base para comparar")
+    ap.add_argument("--limite", type=float, default=5.0, help="variação tolerada em %% (padrão 5)")
+    args = ap.parse_args()
+
+    linhas = {}
+    for caminho in args.capturas:
+        linhas.update(ler_relatorios(caminho))
+    if not linhas:
+        print("Nenhum bloco BENCH_BEGIN/BENCH_END nas capturas.", file=sys.stderr)
+        return 1
+
+    print("{:<6} {:<24} {:<6} {:>10} {:>10} {:>10} {:>10}".format(
+        "mem", "caso", "cache", "min", "mediana", "max", "us"))
+    for chave in sorted(linhas):
+        d = linhas[chave]
+        print("{:<6} {:<24} {:<6} {:>10} {:>10} {:>10} {:>10}".format(
+            d["memoria"], d["caso"], d["cache"], d["min"], d["mediana"], d["max"], d["us_mediana"]))
+
+    # Razão flash/RAM por caso (cache quente), quando as duas memórias estão presentes.
+    pares = [(k[1], linhas[k], linhas.get(("ram", k[1], "quente")))
+             for k in sorted(linhas) if k[0] == "flash" and k[2] == "quente"]
+    pares = [(caso, f, r) for caso, f, r in pares if r and int(r["mediana"]) > 0]
+    if pares:
+        print("\nflash / RAM (mediana, cache quente; frio = cache do XIP esvaziado):")
+        for caso, f, r in pares:
+            frio = linhas.get(("flash", caso, "frio"))
+            extra = "  frio {:.2f}x".format(int(frio["mediana"]) / int(r["mediana"])) if frio else ""
+            print("  {:<24} {:.2f}x{}".format(caso, int(f["mediana"]) / int(r["mediana"]), extra))
+
+    # float / ponto fixo: casos float_<x> e pf_<x> da mesma memória e cache.
+    pf = [(k, linhas[k], linhas.get((k[0], "float_" + k[1][3:], k[2])))
+          for k in sorted(linhas) if k[1].startswith("pf_")]
+    pf = [(k, p, f) for k, p, f in pf if f and int(p["mediana"]) > 0]
+    if pf:
+        print("\nfloat / ponto fixo (mediana; > 1 = ponto fixo mais rápido):")
+        for (memoria, caso, cache), p, f in pf:
+            print("  {:<6} {:<24} {:<6} {:>8} {:>8} {:.2f}x".format(
+                memoria, caso[3:], cache, f["mediana"], p["mediana"],
+                int(f["mediana"]) / int(p["mediana"])))
+
+    if args.salvar:
+        salvar_base(args.salvar, linhas)
+        print("\nLinha de base gravada em {}".format(args.salvar))
+
+    regressoes = 0
+    if args.base:
+        base = ler_base(args.base)
+        print("\nComparação com {} (mediana, limite {:.1f} %):".format(args.base, args.limite))
+        for chave in sorted(linhas):
+            if chave not in base:
+                print("  {:<6} {:<24} {:<6} novo".format(*chave))
+                continue
+            antes, agora = int(base[chave]["mediana"]), int(linhas[chave]["mediana"])
+            delta = 100.0 * (agora - antes) / antes if antes else 0.0
+            marca = ""
+            if delta > args.limite:
+                marca, regressoes = "  REGRESSAO", regressoes + 1
+            elif delta < -args.limite:
+                marca = "  melhora"
+            print("  {:<6} {:<24} {:<6} {:>10} -> {:>10} ({:+.1f} %){}".format(
+                chave[0], chave[1], chave[2], antes, agora, delta, marca))
+        for chave in sorted(set(base) - set(linhas)):
+            print("  {:<6} {:<24} {:<6} ausente na captura".format(*chave))
+    return 1 if regressoes else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
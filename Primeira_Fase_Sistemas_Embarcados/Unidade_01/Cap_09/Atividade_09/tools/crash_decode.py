@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""
+@file crash_decode.py
+@author Manoel Felipe Costa Furtado
+@copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+@brief Decodifica o registro de falha exportado pelo crash_dump (CRASH_BEGIN ... CRASH_END)
+       e simboliza pc, lr e a cópia da pilha com a tabela de símbolos do ELF.
+
+Uso:
+    # 1) Na placa que reiniciou, envie 'c' e capture a saída:
+    #    stty -F /dev/ttyACM0 raw 115200 && cat /dev/ttyACM0 > captura.txt
+    # 2) Decodificar com o ELF do mesmo build:
+    python3 crash_decode.py build/Atividade_09.elf captura.txt
+
+Se `arm-none-eabi-addr2line` estiver no PATH (ou for indicado com --addr2line), cada
+endereço ganha também arquivo:linha. Sem ele, só função+deslocamento.
+"""
+
+import argparse
+import shutil
+import struct
+import subprocess
+import sys
+import zlib
+
+# Deve ser igual a crash_registro_t em crash_dump.h
+REGISTRO = struct.Struct("<5I13I5I48sI64II256sI")
+MAGIC, VERSAO = 0x48535243, 1
+CAUSAS = {1: "HardFault", 2: "watchdog (laço travado, capturado pelo pré-watchdog)",
+          3: "reset por watchdog (sem registradores)", 4: "panic/assert"}
+
+# Deve ser igual a trace_tipo_t em trace_recorder.h
+TIPOS_TRACE = {1: "tarefa entra", 2: "tarefa sai", 3: "ISR entra", 4: "ISR sai",
+               5: "fila envia", 6: "fila recebe", 7: "zona início", 8: "zona fim", 9: "marca"}
+
+SHT_SYMTAB = 2
+STT_FUNC = 2
+
+
+class Simbolos:
+    """Funções do .symtab de um ELF32 little-endian."""
+
+    def __init__(self, caminho, addr2line=None):
+        self.caminho = caminho
+        self.addr2line = addr2line
+        with open(caminho, "rb") as f:
+            dados = f.read()
+        if dados[:4] != b"\x7fELF" or dados[4] != 1 or dados[5] != 1:
+            raise ValueError("esperado ELF32 little-endian (build do RP2040)")
+        shoff, = struct.unpack_from("<I", dados, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", dados, 0x2E)
+        secoes = [struct.unpack_from("<IIIIIIIIII", dados, shoff + i * shentsize)
+                  for i in range(shnum)]
+
+        self.funcoes = []
+        for _, tipo, _, _, off, tam, link, _, _, entsize in secoes:
+            if tipo != SHT_SYMTAB:
+                continue
+            str_off = secoes[link][4]
+            for i in range(tam // entsize):
+                nome, valor, tamanho, info, _, shndx = struct.unpack_from("<IIIBBH", dados, off + i * entsize)
+                if info & 0xF != STT_FUNC or shndx == 0:
+                    continue
+                fim = dados.index(b"\0", str_off + nome)
+                self.funcoes.append((valor & ~1, max(tamanho, 2), dados[str_off + nome:fim].decode()))
+        self.funcoes.sort()
+
+    def funcao(self, endereco):
+        """'nome+0x12' ou None se o endereço não cair em nenhuma função."""
+        endereco &= ~1
+        for ini, tam, nome in self.funcoes:
+            if ini <= endereco < ini + tam:
+                return "{}+0x{:x}".format(nome, endereco - ini)
+        return None
+
+    def linha(self, endereco):
+        if not self.addr2line:
+            return ""
+        try:
+            saida = subprocess.run([self.addr2line, "-e", self.caminho, "0x{:08x}".format(endereco & ~1)],
+                                   capture_output=True, text=True, timeout=5).stdout.strip()
+        except (OSError, subprocess.SubprocessError):
+            return ""
+        return "" if saida.startswith("??") else "  " + saida
+
+    def descrever(self, endereco):
+        nome = self.funcao(endereco)
+        if nome is None:
+            return "0x{:08x}".format(endereco)
+        return "0x{:08x} {}{}".format(endereco, nome, self.linha(endereco))
+
+
+def extrair(texto):
+    """Bytes do último bloco CRASH_BEGIN ... CRASH_END da captura."""
+    blocos, atual = [], None
+    for linha in texto.splitlines():
+        linha = linha.strip()
+        if linha.startswith("CRASH_BEGIN"):
+            atual = bytearray()
+        elif linha.startswith("CRASH_END") and atual is not None:
+            blocos.append(bytes(atual))
+            atual = None
+        elif atual is not None and linha.startswith("D "):
+            atual += bytes.fromhex(linha[2:])
+    return blocos[-1] if blocos else None
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decodificador do registro de falha (crash_dump)")
+    ap.add_argument("elf", help="ELF do mesmo build que gerou a falha")
+    ap.add_argument("captura", help="texto capturado após enviar 'c'")
+    ap.add_argument("--addr2line", default=shutil.which("arm-none-eabi-addr2line"),
+                    help="caminho do addr2line (padrão: procura no PATH)")
+    args = ap.parse_args()
+
+    with open(args.captura, "rb") as f:
+        bruto = extrair(f.read().decode("utf-8", "replace"))
+    if bruto is None:
+        print("Nenhum bloco CRASH_BEGIN/CRASH_END na captura.", file=sys.stderr)
+        return 1
+    if len(bruto) != REGISTRO.size:
+        print("Tamanho {} != {}: versão do crash_dump diferente?".format(len(bruto), REGISTRO.size),
+              file=sys.stderr)
+        return 1
+
+    campos = REGISTRO.unpack(bruto)
+    magic, versao, causa, nucleo, tempo_us = campos[0:5]
+    r = campos[5:18]
+    sp, lr, pc, xpsr, exc_return = campos[18:23]
+    contexto = campos[23].split(b"\0")[0].decode("utf-8", "replace")
+    n_pilha, pilha = campos[24], campos[25:89]
+    n_trace, trace, crc = campos[89], campos[90], campos[91]
+
+    if magic != MAGIC or versao != VERSAO:
+        print("Registro inválido (magic/versão).", file=sys.stderr)
+        return 1
+    crc_ok = zlib.crc32(bruto[:-4]) & 0xFFFFFFFF == crc
+    sim = Simbolos(args.elf, args.addr2line)
+
+    print("Causa:    {}".format(CAUSAS.get(causa, causa)))
+    print("CRC:      {}".format("ok" if crc_ok else "INVÁLIDO (registro corrompido)"))
+    print("Núcleo:   {}".format("?" if nucleo == 0xFFFFFFFF else nucleo))
+    if tempo_us:
+        print("Instante: {:.6f} s após o boot".format(tempo_us / 1e6))
+    if contexto:
+        print("Contexto: {}".format(contexto))
+
+    if causa != 3:
+        print("\nRegistradores:")
+        print("  pc   {}".format(sim.descrever(pc)))
+        print("  lr   {}".format(sim.descrever(lr)))
+        print("  sp   0x{:08x}   xPSR 0x{:08x} (exceção ativa {})".format(sp, xpsr, xpsr & 0x3F))
+        if exc_return:
+            print("  EXC_RETURN 0x{:08x} (pilha {})".format(exc_return, "PSP" if exc_return & 4 else "MSP"))
+        for i in range(0, 13, 4):
+            print("  " + "  ".join("r{:<2} 0x{:08x}".format(k, r[k]) for k in range(i, min(i + 4, 13))))
+
+    if n_pilha:
+        print("\nPilha (prováveis endereços de retorno):")
+        for i in range(min(n_pilha, 64)):
+            w = pilha[i]
+            if w & 1 and sim.funcao(w):
+                print("  [sp+0x{:03x}] {}".format(4 * i, sim.descrever(w)))
+
+    if n_trace:
+        print("\nÚltimos eventos do trace:")
+        eventos = [struct.unpack_from("<IBBH", trace, 8 * i) for i in range(min(n_trace, 32))]
+        eventos.sort(key=lambda e: e[0])
+        ultimo = eventos[-1][0]
+        for t, tipo, nucleo_ev, ident in eventos:
+            print("  {:>10} us  c{}  {:<13} id {}".format(
+                -((ultimo - t) & 0xFFFFFFFF), nucleo_ev, TIPOS_TRACE.get(tipo, tipo), ident))
+    return 0 if crc_ok else 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+"""
+@file log_bin_decode.py
+@author Manoel Felipe Costa Furtado
+@copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+@brief Reconstrói as mensagens do log binário (LOG_BIN, src/log_binario.h) a partir
+       dos quadros capturados da USB e das strings de formato guardadas no ELF.
+
+Uso:
+    # 1) Capturar a saída da placa (binário; o texto normal é ignorado na decodificação):
+    #    stty -F /dev/ttyACM0 raw 115200 && cat /dev/ttyACM0 > captura.bin
+    # 2) Decodificar com o ELF do mesmo build:
+    python3 log_bin_decode.py build/Atividade_09.elf captura.bin
+    # ou direto da porta (Ctrl+C para sair):
+    python3 log_bin_decode.py build/Atividade_09.elf /dev/ttyACM0
+
+Cada conversão do formato consome um word de 32 bits: inteiros com ou sem `l`,
+`%f/%e/%g` como float e `%s` como ponteiro para uma string do próprio ELF.
+Só depende da biblioteca padrão (o ELF é lido com struct).
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+# Deve ser igual a log_binario.h
+MAGIC = b"BLOG"
+CAB = struct.Struct("<4sBBHI")     # magic, núcleo, reservado, n palavras, perdidos
+MAX_PALAVRAS = 1024                # LOG_BIN_PALAVRAS_POR_NUCLEO
+NUCLEOS = 2
+SECAO_FMT = ".logfmt"
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+CONVERSAO = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<largura>\*|\d+)?(?:\.(?P<prec>\*|\d+))?"
+    r"(?P<tam>hh|h|ll|l|j|z|t|L)?(?P<conv>[diouxXeEfFgGcsp%])")
+
+
+class Elf:
+    """Seções alocadas de um ELF32 little-endian: endereço -> bytes."""
+
+    def __init__(self, caminho):
+        with open(caminho, "rb") as f:
+            dados = f.read()
+        if dados[:4] != b"\x7fELF" or dados[4] != 1 or dados[5] != 1:
+            raise ValueError("esperado ELF32 little-endian (build do RP2040)")
+        shoff, = struct.unpack_from("<I", dados, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", dados, 0x2E)
+
+        secoes = []
+        for i in range(shnum):
+            secoes.append(struct.unpack_from("<IIIIII", dados, shoff + i * shentsize))
+        nomes_off = secoes[shstrndx][4]
+
+        self.regioes = []   # (inicio, fim, bytes)
+        self.fmt = None
+        for nome, tipo, flags, addr, off, tam in secoes:
+            fim_nome = dados.index(b"\0", nomes_off + nome)
+            texto = dados[nomes_off + nome:fim_nome].decode()
+            if flags & SHF_ALLOC and tipo != SHT_NOBITS and tam:
+                self.regioes.append((addr, addr + tam, dados[off:off + tam]))
+            if texto == SECAO_FMT:
+                self.fmt = (addr, addr + tam)
+        if self.fmt is None:
+            raise ValueError("seção {} não encontrada: o firmware usa LOG_BIN?".format(SECAO_FMT))
+
+    def string(self, endereco):
+        """String C no endereço dado, ou None se não estiver no ELF."""
+        for ini, fim, dados in self.regioes:
+            if ini <= endereco < fim:
+                pos = endereco - ini
+                fim_str = dados.find(b"\0", pos)
+                return dados[pos:fim_str if fim_str >= 0 else len(dados)].decode("utf-8", "replace")
+        return None
+
+    def formato(self, endereco):
+        if self.fmt[0] <= endereco < self.fmt[1]:
+            return self.string(endereco)
+        return None
+
+
+def formatar(elf, fmt, args):
+    """Aplica o formato do printf aos words, um por conversão."""
+    args = list(args)
+
+    def proximo():
+        return args.pop(0) if args else 0
+
+    def trocar(m):
+        conv = m.group("conv")
+        if conv == "%":
+            return "%"
+        largura, prec = m.group("largura") or "", m.group("prec")
+        if largura == "*":
+            largura = str(struct.unpack("<i", struct.pack("<I", proximo()))[0])
+        if prec == "*":
+            prec = str(max(0, struct.unpack("<i", struct.pack("<I", proximo()))[0]))
+        espec = "%" + m.group("flags") + largura + ("." + prec if prec is not None else "")
+        w = proximo()
+        if conv in "di":
+            return (espec + "d") % struct.unpack("<i", struct.pack("<I", w))[0]
+        if conv in "uoxX":
+            return (espec + ("d" if conv == "u" else conv)) % w
+        if conv in "eEfFgG":
+            return (espec + conv) % struct.unpack("<f", struct.pack("<I", w))[0]
+        if conv == "c":
+            return (espec + "c") % chr(w & 0xFF)
+        if conv == "s":
+            texto = elf.string(w)
+            return (espec + "s") % (texto if texto is not None else "<0x{:08x}>".format(w))
+        return "0x{:08x}".format(w)   # %p
+
+    return CONVERSAO.sub(trocar, fmt)
+
+
+class Decodificador:
+    def __init__(self, elf, saida):
+        self.elf = elf
+        self.saida = saida
+        self.perdidos = [0] * NUCLEOS
+        self.tempo_ant = [None] * NUCLEOS
+        self.voltas = [0] * NUCLEOS
+        self.descartados = 0
+
+    def tempo_s(self, nucleo, t):
+        """time_us_32() volta a zero a cada ~71 min: estende para 64 bits."""
+        ant = self.tempo_ant[nucleo]
+        if ant is not None and t < ant and ant - t > 0x80000000:
+            self.voltas[nucleo] += 1
+        self.tempo_ant[nucleo] = t
+        return ((self.voltas[nucleo] << 32) + t) / 1e6
+
+    def registros(self, palavras):
+        """Separa os registros de um quadro; None se algum não fizer sentido."""
+        regs, i = [], 0
+        while i < len(palavras):
+            fmt_addr, nargs = palavras[i] & ~7, palavras[i] & 7
+            fmt = self.elf.formato(fmt_addr)
+            if fmt is None or i + 2 + nargs > len(palavras):
+                return None
+            regs.append((fmt, palavras[i + 1], palavras[i + 2:i + 2 + nargs]))
+            i += 2 + nargs
+        return regs
+
+    def processar(self, buf):
+        """Consome os quadros completos de `buf` (bytearray). Retorna o buf restante."""
+        pos = 0
+        while True:
+            ini = buf.find(MAGIC, pos)
+            if ini < 0:
+                self.descartados += max(0, len(buf) - pos - 3)
+                return buf[max(pos, len(buf) - 3):]
+            self.descartados += ini - pos
+            if len(buf) - ini < CAB.size:
+                return buf[ini:]
+            _, nucleo, _, n, perdidos = CAB.unpack_from(buf, ini)
+            if nucleo >= NUCLEOS or n == 0 or n > MAX_PALAVRAS:
+                pos = ini + 1
+                continue
+            fim = ini + CAB.size + 4 * n
+            if len(buf) < fim:
+                return buf[ini:]
+
+            palavras = struct.unpack_from("<{}I".format(n), buf, ini + CAB.size)
+            regs = self.registros(palavras)
+            if regs is None:
+                pos = ini + 1     # Falso magic no meio do texto: ressincroniza
+                continue
+
+            if perdidos != self.perdidos[nucleo]:
+                print("# núcleo {}: {} registros perdidos (anel cheio)".format(
+                    nucleo, (perdidos - self.perdidos[nucleo]) & 0xFFFFFFFF), file=self.saida)
+                self.perdidos[nucleo] = perdidos
+            for fmt, t, args in regs:
+                texto = formatar(self.elf, fmt, args).rstrip("\n")
+                print("[{:12.6f}] c{} {}".format(self.tempo_s(nucleo, t), nucleo, texto),
+                      file=self.saida)
+            pos = fim
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decodificador do log binário (LOG_BIN)")
+    ap.add_argument("elf", help="ELF do mesmo build que gerou a captura")
+    ap.add_argument("captura", help="arquivo capturado ou porta serial (ex.: /dev/ttyACM0)")
+    ap.add_argument("-o", "--saida", help="arquivo de texto (padrão: stdout)")
+    args = ap.parse_args()
+
+    elf = Elf(args.elf)
+    saida = open(args.saida, "w", encoding="utf-8") if args.saida else sys.stdout
+    dec = Decodificador(elf, saida)
+    buf = bytearray()
+    try:
+        with open(args.captura, "rb", buffering=0) as f:
+            while True:
+                dados = f.read(4096)
+                if not dados:
+                    break
+                buf += dados
+                buf = dec.processar(buf)
+                saida.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if saida is not sys.stdout:
+            saida.close()
+    if dec.descartados:
+        print("# {} bytes fora de quadros ignorados".format(dec.descartados), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,27 +1,303 @@
+/**
+ * @file rgb_pwm_control.c
+ * @brief Motor do LED RGB: fila de comandos, gerador de quadros com gama e reprodução por DMA.
+ */
 #include "rgb_pwm_control.h"
+#include <math.h>
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+#include "pico/critical_section.h"
 
-static uint slice_r, slice_g, slice_b;
+#define PWM_CLKDIV     4.f        /**< Contador a 31,25 MHz: 16 bits dão ~477 Hz. */
+#define GAMA           2.2f       /**< Expoente da correção perceptual. */
+#define MAX_FADE_QUADROS 30000u   /**< Limite da transição (~63 s) para a interpolação em 32 bits. */
+
+/** @brief Um comando da fila: transição até `cor` e permanência nela. */
+typedef struct {
+    uint16_t cor[3];
+    uint32_t fade_quadros;
+    uint32_t hold_quadros;
+} ComandoRGB;
+
+// --- Fila de comandos (produtor: aplicação/MQTT; consumidor: IRQ do DMA) ---
+static ComandoRGB fila[RGB_PWM_FILA_TAM];
+static uint32_t fila_ini, fila_qtd;
+static critical_section_t cs;
+
+// --- Hardware: cada LED num canal de uma fatia; um canal de DMA por fatia usada ---
+static const uint pinos[3] = { LED_R, LED_G, LED_B };
+static uint led_fatia[3];          /**< Índice em `fatias[]` de cada LED. */
+static uint led_shift[3];          /**< 0 (canal A) ou 16 (canal B) dentro do registrador CC. */
+static uint fatias[3];
+static uint n_fatias;
+static int dma_ch[3];
+static uint32_t buffers[2][3][RGB_PWM_BLOCO];
+
+static uint16_t gama_lut[257];     /**< Brilho percebido (índice = bits altos) -> nível do PWM. */
+static uint32_t quadro_hz;
+
+// --- Estado do gerador de quadros (sempre acessado dentro de `cs`) ---
+static uint16_t cor_atual[3], cor_inicio[3], cor_alvo[3];
+static uint32_t quadro, fade_total, hold_rest;
+static bool em_transicao;
+static bool rodando;               /**< DMA reproduzindo blocos. */
+static bool proximo_pronto;        /**< O buffer que não está tocando tem um bloco com atividade. */
+static uint buf_tocando;
+
+/** @brief Estado do gerador no fim do bloco que está tocando (= início do pendente). */
+typedef struct {
+    uint16_t cor_atual[3], cor_inicio[3], cor_alvo[3];
+    uint32_t quadro, fade_total, hold_rest;
+    bool em_transicao;
+    uint32_t fila_ini;
+} EstadoGerador;
+
+static EstadoGerador salvo;
+static bool pendente_gerado;       /**< O buffer pendente foi gerado a partir de `salvo`. */
+static uint32_t retirados;         /**< Comandos tirados da fila desde salvar_estado(). */
+
+/** @brief Brilho percebido de 16 bits -> nível do PWM, interpolando a LUT. */
+static inline uint16_t gama(uint16_t p) {
+    uint32_t i = p >> 8, f = p & 0xFFu;
+    return (uint16_t)(gama_lut[i] + (((uint32_t)(gama_lut[i + 1] - gama_lut[i]) * f) >> 8));
+}
+
+/** @brief Guarda o estado antes de gerar o bloco pendente. */
+static void salvar_estado(void) {
+    for (int i = 0; i < 3; i++) {
+        salvo.cor_atual[i] = cor_atual[i];
+        salvo.cor_inicio[i] = cor_inicio[i];
+        salvo.cor_alvo[i] = cor_alvo[i];
+    }
+    salvo.quadro = quadro;
+    salvo.fade_total = fade_total;
+    salvo.hold_rest = hold_rest;
+    salvo.em_transicao = em_transicao;
+    salvo.fila_ini = fila_ini;
+    retirados = 0;
+    pendente_gerado = true;
+}
+
+/**
+ * @brief Desfaz a geração do bloco pendente (ainda não tocado): volta ao estado do fim
+ * do bloco que está tocando e devolve à fila os comandos que ele consumiu.
+ */
+static void restaurar_estado(void) {
+    if (!pendente_gerado) {
+        return;
+    }
+    for (int i = 0; i < 3; i++) {
+        cor_atual[i] = salvo.cor_atual[i];
+        cor_inicio[i] = salvo.cor_inicio[i];
+        cor_alvo[i] = salvo.cor_alvo[i];
+    }
+    quadro = salvo.quadro;
+    fade_total = salvo.fade_total;
+    hold_rest = salvo.hold_rest;
+    em_transicao = salvo.em_transicao;
+    fila_ini = salvo.fila_ini;
+    fila_qtd += retirados;
+    retirados = 0;
+    pendente_gerado = false;
+}
+
+static uint32_t ms_para_quadros(uint32_t ms) {
+    uint32_t q = (uint32_t)(((uint64_t)ms * quadro_hz + 500u) / 1000u);
+    return q > MAX_FADE_QUADROS ? MAX_FADE_QUADROS : q;
+}
+
+/**
+ * @brief Preenche um buffer com o próximo bloco de quadros.
+ * @return `true` se o bloco contém alguma transição/permanência (precisa ser tocado).
+ */
+static bool gerar_bloco(uint b) {
+    bool ativo = false;
+
+    for (uint k = 0; k < RGB_PWM_BLOCO; k++) {
+        if (!em_transicao && fila_qtd > 0) {
+            const ComandoRGB *c = &fila[fila_ini];
+            for (int i = 0; i < 3; i++) {
+                cor_inicio[i] = cor_atual[i];
+                cor_alvo[i] = c->cor[i];
+            }
+            fade_total = c->fade_quadros;
+            hold_rest = c->hold_quadros;
+            quadro = 0;
+            em_transicao = true;
+            fila_ini = (fila_ini + 1) % RGB_PWM_FILA_TAM;
+            fila_qtd--;
+            retirados++;
+        }
+
+        if (em_transicao) {
+            ativo = true;
+            if (quadro < fade_total) {
+                quadro++;
+                for (int i = 0; i < 3; i++) {
+                    int32_t delta = (int32_t)cor_alvo[i] - (int32_t)cor_inicio[i];
+                    cor_atual[i] = (uint16_t)(cor_inicio[i] + delta * (int32_t)quadro / (int32_t)fade_total);
+                }
+            } else {
+                for (int i = 0; i < 3; i++) cor_atual[i] = cor_alvo[i];
+                if (hold_rest > 0) hold_rest--;
+                else em_transicao = false;
+            }
+        }
+
+        uint32_t palavra[3] = { 0, 0, 0 };
+        for (int i = 0; i < 3; i++) {
+            palavra[led_fatia[i]] |= (uint32_t)gama(cor_atual[i]) << led_shift[i];
+        }
+        for (uint s = 0; s < n_fatias; s++) {
+            buffers[b][s][k] = palavra[s];
+        }
+    }
+    return ativo;
+}
+
+/** @brief Dispara os canais de DMA sobre um buffer. */
+static void iniciar_dma(uint b) {
+    for (uint s = 0; s < n_fatias; s++) {
+        dma_channel_set_read_addr(dma_ch[s], buffers[b][s], false);
+        dma_channel_set_trans_count(dma_ch[s], RGB_PWM_BLOCO, true);
+    }
+}
+
+/**
+ * @brief Fim de um bloco: troca para o buffer já preenchido e gera o seguinte.
+ * @details Todas as fatias têm o mesmo divisor e foram habilitadas juntas, então os
+ * demais canais terminam no mesmo período do PWM.
+ */
+static void rgb_dma_irq(void) {
+    if (!dma_channel_get_irq1_status(dma_ch[0])) {
+        return;
+    }
+    dma_channel_acknowledge_irq1(dma_ch[0]);
+
+    critical_section_enter_blocking(&cs);
+    for (uint s = 1; s < n_fatias; s++) {
+        while (dma_channel_is_busy(dma_ch[s])) tight_loop_contents();
+    }
+    if (proximo_pronto) {
+        buf_tocando ^= 1u;
+        iniciar_dma(buf_tocando);
+        salvar_estado();
+        proximo_pronto = gerar_bloco(buf_tocando ^ 1u);
+    } else {
+        rodando = false;   // Cor estável: o CC mantém o último quadro.
+        pendente_gerado = false;
+        retirados = 0;
+    }
+    critical_section_exit(&cs);
+}
+
+/**
+ * @brief Garante que o novo conteúdo da fila seja tocado. Chamada dentro de `cs`.
+ */
+static void acordar_motor(void) {
+    if (!rodando) {
+        buf_tocando = 0;
+        gerar_bloco(0);
+        iniciar_dma(0);
+        rodando = true;
+    } else {
+        // O buffer pendente ainda não tocou: regera a partir do fim do bloco que toca.
+        restaurar_estado();
+    }
+    salvar_estado();
+    proximo_pronto = gerar_bloco(buf_tocando ^ 1u);
+}
+
+/** @brief Coloca um comando na fila e acorda o motor. Chamada dentro de `cs`. */
+static bool enfileirar(uint16_t r_val, uint16_t g_val, uint16_t b_val, uint32_t fade_ms, uint32_t hold_ms) {
+    // As vagas liberadas pelo bloco pendente só valem quando ele tocar: uma regeração
+    // devolve esses comandos à fila.
+    if (fila_qtd + retirados >= RGB_PWM_FILA_TAM) {
+        return false;
+    }
+    ComandoRGB *c = &fila[(fila_ini + fila_qtd) % RGB_PWM_FILA_TAM];
+    c->cor[0] = r_val;
+    c->cor[1] = g_val;
+    c->cor[2] = b_val;
+    c->fade_quadros = ms_para_quadros(fade_ms);
+    c->hold_quadros = ms_para_quadros(hold_ms);
+    fila_qtd++;
+    acordar_motor();
+    return true;
+}
 
 void init_rgb_pwm() {
-    
-    gpio_set_function(LED_R, GPIO_FUNC_PWM);
-    gpio_set_function(LED_G, GPIO_FUNC_PWM);
-    gpio_set_function(LED_B, GPIO_FUNC_PWM);
+    critical_section_init(&cs);
 
-    slice_r = pwm_gpio_to_slice_num(LED_R);
-    slice_g = pwm_gpio_to_slice_num(LED_G);
-    slice_b = pwm_gpio_to_slice_num(LED_B);
+    for (int i = 0; i <= 256; i++) {
+        float v = powf((float)i / 256.0f, GAMA) * 65535.0f + 0.5f;
+        gama_lut[i] = (uint16_t)(v > 65535.0f ? 65535.0f : v);
+    }
 
-    pwm_config config = pwm_get_default_config();
-    pwm_config_set_clkdiv(&config, 4.f);
+    pwm_config config = pwm_get_default_config();   // wrap = 65535 (16 bits)
+    pwm_config_set_clkdiv(&config, PWM_CLKDIV);
+    quadro_hz = (uint32_t)(clock_get_hz(clk_sys) / (PWM_CLKDIV * 65536.0f));
 
-    pwm_init(slice_r, &config, true);
-    pwm_init(slice_g, &config, true);
-    pwm_init(slice_b, &config, true);
+    uint32_t mascara = 0;
+    n_fatias = 0;
+    for (int i = 0; i < 3; i++) {
+        gpio_set_function(pinos[i], GPIO_FUNC_PWM);
+        uint fatia = pwm_gpio_to_slice_num(pinos[i]);
+        uint s = 0;
+        while (s < n_fatias && fatias[s] != fatia) s++;
+        if (s == n_fatias) {
+            fatias[n_fatias++] = fatia;
+            pwm_init(fatia, &config, false);
+            mascara |= 1u << fatia;
+        }
+        led_fatia[i] = s;
+        led_shift[i] = pwm_gpio_to_channel(pinos[i]) == PWM_CHAN_B ? 16 : 0;
+        pwm_set_gpio_level(pinos[i], 0);
+    }
+
+    for (uint s = 0; s < n_fatias; s++) {
+        dma_ch[s] = dma_claim_unused_channel(true);
+        dma_channel_config c = dma_channel_get_default_config(dma_ch[s]);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, pwm_get_dreq(fatias[s]));
+        dma_channel_configure(dma_ch[s], &c, &pwm_hw->slice[fatias[s]].cc, buffers[0][s], RGB_PWM_BLOCO, false);
+    }
+    dma_channel_set_irq1_enabled(dma_ch[0], true);
+    irq_add_shared_handler(DMA_IRQ_1, rgb_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    // Contadores em fase: os canais de DMA de todas as fatias andam juntos.
+    pwm_set_mask_enabled(mascara);
+}
+
+bool rgb_pwm_enfileirar(uint16_t r_val, uint16_t g_val, uint16_t b_val, uint32_t fade_ms, uint32_t hold_ms) {
+    critical_section_enter_blocking(&cs);
+    bool ok = enfileirar(r_val, g_val, b_val, fade_ms, hold_ms);
+    critical_section_exit(&cs);
+    return ok;
+}
+
+bool rgb_pwm_fade_para(uint16_t r_val, uint16_t g_val, uint16_t b_val, uint32_t fade_ms) {
+    critical_section_enter_blocking(&cs);
+    // A nova transição parte da cor no fim do bloco que está tocando, não do pendente.
+    restaurar_estado();
+    fila_qtd = 0;
+    em_transicao = false;
+    bool ok = enfileirar(r_val, g_val, b_val, fade_ms, 0);
+    critical_section_exit(&cs);
+    return ok;
 }
 
 void set_rgb_pwm(uint16_t r_val, uint16_t g_val, uint16_t b_val) {
-    pwm_set_gpio_level(LED_R, r_val);
-    pwm_set_gpio_level(LED_G, g_val);
-    pwm_set_gpio_level(LED_B, b_val);
-}
\ No newline at end of file
+    rgb_pwm_fade_para(r_val, g_val, b_val, 0);
+}
+
+bool rgb_pwm_ocupado(void) {
+    critical_section_enter_blocking(&cs);
+    bool ocupado = rodando || fila_qtd > 0;
+    critical_section_exit(&cs);
+    return ocupado;
+}
@@ -1,9 +1,62 @@
+/**
+ * @file rgb_pwm_control.h
+ * @brief Motor do LED RGB: correção gama, PWM de 16 bits e transições reproduzidas por DMA.
+ *
+ * @details
+ * As cores são dadas em brilho percebido (0 a 65535 por componente). Uma LUT de gama
+ * (2,2) converte o brilho em ciclo de trabalho do PWM de 16 bits, de modo que as
+ * transições pareçam lineares ao olho.
+ *
+ * Cada comando entra numa fila e a função retorna na hora (seguro para os callbacks
+ * do MQTT). O motor gera os quadros em blocos curtos e um canal de DMA por fatia de
+ * PWM, cadenciado pelo DREQ de "wrap" da fatia, escreve um quadro no registrador CC a
+ * cada período do PWM (~477 Hz). A CPU só é chamada uma vez por bloco, na interrupção
+ * de fim do DMA; parado numa cor, o DMA desliga e não há interrupções.
+ *
+ * @code
+ *   fila de comandos ─▶ gerador de quadros (IRQ do DMA, 1x por bloco)
+ *        ─▶ buffers ping-pong ─▶ DMA (1 quadro por wrap) ─▶ pwm_hw->slice[s].cc
+ * @endcode
+ */
+
 #ifndef RGB_PWM_CONTROL_H
 #define RGB_PWM_CONTROL_H
 
 #include "src/configura_geral.h"
 
+#define RGB_PWM_FILA_TAM 16   /**< Comandos de cor aguardando na fila. */
+#define RGB_PWM_BLOCO    16   /**< Quadros por bloco de DMA (~34 ms a 477 Hz). */
+
+/**
+ * @brief Configura o PWM de 16 bits dos três pinos, os canais de DMA e a LUT de gama.
+ */
 void init_rgb_pwm();
+
+/**
+ * @brief Troca a cor imediatamente, descartando a fila e a transição em andamento.
+ * @param r_val Brilho percebido do vermelho (0 a PWM_STEP).
+ * @param g_val Brilho percebido do verde.
+ * @param b_val Brilho percebido do azul.
+ */
 void set_rgb_pwm(uint16_t r_val, uint16_t g_val, uint16_t b_val);
 
-#endif
\ No newline at end of file
+/**
+ * @brief Enfileira uma transição: vai da cor atual até (r, g, b) em `fade_ms` e mantém por `hold_ms`.
+ * @details Comandos enfileirados executam em sequência, permitindo montar efeitos
+ * (ex.: piscar numa cor e voltar) sem bloquear quem chamou.
+ * @return `false` se a fila estiver cheia.
+ */
+bool rgb_pwm_enfileirar(uint16_t r_val, uint16_t g_val, uint16_t b_val, uint32_t fade_ms, uint32_t hold_ms);
+
+/**
+ * @brief Descarta a fila e inicia uma transição da cor atual até (r, g, b).
+ * @return `false` se a fila estiver cheia (não ocorre após o descarte).
+ */
+bool rgb_pwm_fade_para(uint16_t r_val, uint16_t g_val, uint16_t b_val, uint32_t fade_ms);
+
+/**
+ * @brief Indica se ainda há transição em andamento ou comandos na fila.
+ */
+bool rgb_pwm_ocupado(void);
+
+#endif
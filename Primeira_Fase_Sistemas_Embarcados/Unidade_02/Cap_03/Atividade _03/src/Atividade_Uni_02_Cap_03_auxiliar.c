@@ -22,7 +22,7 @@
 // Includes de Bibliotecas
 // =============================================================================
 #include "fila_circular.h"      // Para o tipo de dado `MensagemWiFi`.
-#include "rgb_pwm_control.h"    // Para a função `set_rgb_pwm`.
+#include "rgb_pwm_control.h"    // Para `set_rgb_pwm` e a fila de transições do LED.
 #include "configura_geral.h"    // Para constantes como `PWM_STEP`.
 #include "oled_utils.h"         // Para funções como `exibir_e_esperar`.
 #include "ssd1306_i2c.h"        // Para funções de desenho no OLED.
@@ -97,15 +97,13 @@ void tratar_mensagem(MensagemWiFi msg) {
                 b = numero_aleatorio(0, 65535); // Gera valor para azul.
             } while (g > r && g > b && g > 32768); // A condição impede cores onde o verde é o componente mais forte e brilhante.
 
-            // 2. Define a cor aleatória gerada no LED para sinalizar visualmente o PING.
-            set_rgb_pwm(r, g, b);
+            // 2. Sequência no motor do LED: transição rápida para a cor aleatória, 1 segundo
+            //    nela e volta suave ao verde padrão (conexão OK). Os comandos vão para a fila
+            //    e o DMA executa a sequência; esta função não bloqueia.
+            rgb_pwm_fade_para(r, g, b, 150);          // Descarta o que houver na fila e vai à cor.
+            rgb_pwm_enfileirar(r, g, b, 0, 1000);     // Permanece 1 s.
+            rgb_pwm_enfileirar(0, 65535, 0, 400, 0);  // Volta ao verde sólido.
             render_on_display(buffer_oled, &area); // Atualiza o OLED junto com a mudança de cor do LED.
-
-            // 3. Mantém a cor aleatória visível por 1 segundo.
-            sleep_ms(1000);
-
-            // 4. Retorna o LED para a cor verde padrão, indicando que a conexão continua OK.
-            set_rgb_pwm(0, 65535, 0); // Verde sólido.
             // --- FIM DA MELHORIA IMPLEMENTADA ---
 
         } else { // Se o status do PING não for 0, significa falha.
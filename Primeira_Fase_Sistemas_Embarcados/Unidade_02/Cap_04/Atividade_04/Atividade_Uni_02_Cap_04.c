@@ -29,20 +29,37 @@
  * gerenciar ADC (Conversor Analógico-Digital), PWM (Modulação por Largura de Pulso) e GPIO (Entrada/Saída
  * de Propósito Geral), além do driver `dht22.c` para o sensor de temperatura.
  * A lógica principal opera em um loop infinito (`while(true)`), garantindo monitoramento contínuo.
+ * Cada sensor é amostrado no seu próprio período pelo escalonador `sensor_sched.c`
+ * (MQ-2 a 20 Hz, LDR a 10 Hz, DHT22 a 0,5 Hz); o laço aplica a lógica de controle a cada
+ * retrato novo e dorme até o próximo prazo.
+ * A cada STORE_PERIOD_MS, temperatura, umidade, gás e luz vão para o histórico comprimido
+ * na flash (`ts_store.c`), que sobrevive a reboots e quedas de energia; a cada minuto o
+ * relatório mostra a taxa de compressão e consulta a última hora de temperatura.
  */
 
 // --- Inclusão de Bibliotecas ---
 #include <stdio.h>         // Biblioteca padrão de entrada/saída para funções como printf().
-#include <math.h>          // Biblioteca matemática para funções como pow() e powf(), usadas nos cálculos dos sensores.
+#include <math.h>          // pow()/powf(): só nas versões de referência usadas no benchmark das curvas.
 #include "pico/stdlib.h"   // Biblioteca principal do SDK do Pico, inclui funções de inicialização e temporização como sleep_ms().
 #include "hardware/gpio.h" // Biblioteca para controle de pinos digitais (GPIO), usada para o LED e o Relé.
-#include "hardware/pwm.h"  // Biblioteca para gerar sinais PWM, usada para controlar o servo motor.
 #include "hardware/adc.h"  // Biblioteca para ler sinais analógicos, usada para os sensores MQ-2 e LDR.
 #include "dht22.h"         // Inclui a interface do driver customizado para o sensor de temperatura e umidade DHT22.
+#include "sensor_sched.h"  // Escalonador de sensores com taxas de amostragem independentes.
+#include "curve_tables.h"  // Curvas do MQ-2 e do LDR em ponto fixo (gerado por tools/gen_curve_tables.py).
+#include "actuator_ctrl.h" // Histerese, debounce e tempos mínimos dos atuadores.
+#include "servo_motion.h"  // Movimentos suaves do servo reproduzidos por DMA no PWM.
+#include "ts_store.h"      // Histórico comprimido das leituras na flash.
 
 // --- Definições de Pinos GPIO ---
 /** @brief Pino GPIO onde o pino de dados do sensor DHT22 está conectado. */
 #define DHT22_PIN 6
+/**
+ * @brief Pinos de todos os sensores DHT22 do ambiente (o primeiro é o principal).
+ * @details Cada sensor usa uma máquina de estados da PIO e todos são lidos no mesmo ciclo.
+ * Para monitorar mais pontos, basta acrescentar os pinos aqui (até DHT22_MAX_SENSORS).
+ */
+static const uint32_t DHT22_PINS[] = { DHT22_PIN };
+#define DHT22_NUM_SENSORS (sizeof(DHT22_PINS) / sizeof(DHT22_PINS[0]))
 /** @brief Pino GPIO conectado ao catodo do LED vermelho (o anodo deve ir para 3.3V através de um resistor). */
 #define LED_RED_PIN 10
 /** @brief Pino GPIO que envia o sinal de controle PWM para o servo motor. */
@@ -54,15 +71,67 @@
 /** @brief Pino GPIO analógico (GP28) conectado ao divisor de tensão com o sensor de luminosidade LDR. Corresponde ao canal 2 do ADC. */
 #define LDR_ADC_PIN 28
 
-// --- Constantes de Limite (Thresholds) para Ativação dos Atuadores ---
-/** @brief Limiar de temperatura em graus Celsius. Acima deste valor, o servo motor será acionado. */
-const float TEMPERATURE_THRESHOLD = 30.0f;
-/** @brief Limiar de luminosidade em Lux. Abaixo deste valor, o LED será aceso. Este valor é empírico e pode precisar de calibragem. */
-const float LUMINOSITY_THRESHOLD = 150.0f; // No código original a lógica está invertida (>), então o LED acende com LUZ ALTA.
-/** @brief Limiar de concentração de gás em PPM. Acima deste valor, o led do relé será acionado. */
-const float GAS_PPM_THRESHOLD = 6.0f; //  GÁS BAIXO.
+// --- Limiares (thresholds) e decisão dos atuadores (actuator_ctrl.h) ---
+// Cada atuador liga ao cruzar `threshold` e só desliga ao voltar `hysteresis` para o outro
+// lado; a decisão ainda passa por filtro, debounce e tempo mínimo em cada estado.
+/**
+ * @brief Servo (temperatura): acima de 30 °C vai para 180°. O DHT22 já é lento (0,5 Hz),
+ * então sem filtro nem debounce; 0,5 °C de histerese e 10 s mínimos em cada posição.
+ */
+static const actuator_ctrl_config_t SERVO_CTRL_CFG = {
+    .threshold = 30.0f, .hysteresis = 0.5f, .active_above = true,
+    .filter_alpha = 1.0f, .debounce_ms = 0, .min_on_ms = 10000, .min_off_ms = 10000,
+};
+/** @brief Velocidade máxima do servo em graus/s (pico da curva em S: 0 -> 180 em ~3,75 s). */
+#define SERVO_MAX_SPEED_DEG_S 90.0f
+/** @brief Aceleração máxima do servo em graus/s² (usada pelo perfil trapezoidal). */
+#define SERVO_MAX_ACCEL_DEG_S2 180.0f
+/**
+ * @brief Relé (gás): liga com PPM em ou abaixo de 6 (gás baixo, como no original). O MQ-2 a
+ * 20 Hz é ruidoso: filtro de ~5 amostras, 0,3 PPM de histerese, 250 ms de debounce e 3 s
+ * mínimos ligado/desligado para poupar os contatos.
+ */
+static const actuator_ctrl_config_t RELAY_CTRL_CFG = {
+    .threshold = 6.0f, .hysteresis = 0.3f, .active_above = false,
+    .filter_alpha = 0.2f, .debounce_ms = 250, .min_on_ms = 3000, .min_off_ms = 3000,
+};
+/**
+ * @brief LED (luz): acende acima de 150 Lux (no original a lógica está invertida, acende com
+ * LUZ ALTA); filtro leve, 10 % de histerese, 200 ms de debounce e 1 s mínimo.
+ */
+static const actuator_ctrl_config_t LED_CTRL_CFG = {
+    .threshold = 150.0f, .hysteresis = 15.0f, .active_above = true,
+    .filter_alpha = 0.3f, .debounce_ms = 200, .min_on_ms = 1000, .min_off_ms = 1000,
+};
+
+// --- Taxas de amostragem (cada sensor no seu próprio ritmo) ---
+/** @brief Período do MQ-2 em ms (20 Hz): vazamentos de gás precisam de resposta rápida. */
+#define MQ2_PERIOD_MS 50
+/** @brief Período do LDR em ms (10 Hz). */
+#define LDR_PERIOD_MS 100
+/** @brief Período do DHT22 em ms (0,5 Hz): o mínimo permitido pelo sensor. */
+#define DHT22_PERIOD_MS 2000
+/** @brief Latência de conversão do DHT22: pulso de início + 40 bits terminam em até 25 ms. */
+#define DHT22_LATENCY_US 30000
+/** @brief Intervalo do relatório na serial, em ms (independente das taxas dos sensores). */
+#define REPORT_PERIOD_MS 1000
+/** @brief Período de gravação no histórico, em ms (grade fixa: o delta-do-delta fica em zero). */
+#define STORE_PERIOD_MS 5000
+/** @brief Intervalo para gravar as páginas parciais (limita a perda numa queda de energia). */
+#define STORE_FLUSH_PERIOD_MS (10u * 60u * 1000u)
+/** @brief Intervalo do relatório do histórico (compressão e consulta), em ms. */
+#define HISTORY_REPORT_PERIOD_MS 60000
+/** @brief Janela da consulta de exemplo: última hora. */
+#define HISTORY_QUERY_WINDOW_MS (60u * 60u * 1000u)
+/** @brief Idade máxima (ms) de uma leitura do DHT22 para ainda ser usada no controle do servo. */
+#define DHT22_MAX_AGE_MS 10000
+
+/** @brief Mede, no boot, o custo e o erro das curvas em ponto fixo contra pow()/powf(). */
+#define CURVE_BENCHMARK_AT_BOOT 1
 
 // --- Parâmetros de Calibração para o Sensor de Gás MQ-2 ---
+// As curvas usadas em tempo de execução são geradas a partir destas constantes por
+// tools/gen_curve_tables.py (curve_tables.c); ao recalibrar, ajuste o script e gere de novo.
 /** @brief Resistência do sensor em ar limpo (R0), em Ohms. Este é o valor mais importante para calibrar a precisão do sensor. */
 const float MQ2_R0 = 8000.0f; // Valor obtido experimentalmente ou a partir do datasheet, ajustado para simulação.
 /** @brief Valor da resistência de carga (RL) presente no módulo do sensor MQ-2, em Ohms. Geralmente 5kΩ. */
@@ -84,6 +153,8 @@ const float LDR_SERIES_RESISTOR = 10000.0f; // 10kΩ
 const float ADC_VREF = 3.3f;
 /** @brief Resolução máxima do ADC de 12 bits (2^12 = 4096 valores, de 0 a 4095). */
 const float ADC_MAX_RESOLUTION = 4095.0f;
+/** @brief Fundo de escala do ADC em contagens (inteiro, para a aritmética das curvas). */
+#define ADC_MAX_COUNTS 4095u
 
 /**
  * @brief Estrutura para agrupar os resultados da leitura do sensor MQ-2.
@@ -99,9 +170,33 @@ typedef struct {
 // --- Protótipos das Funções Auxiliares ---
 // Declarar as funções aqui permite que `main` as chame antes de suas implementações completas.
 void setup_peripherals();
-void set_servo_angle(uint pin, float angle);
 float read_ldr_lux();
 Mq2Result read_mq2_ppm();
+void setup_sensor_schedule();
+void apply_controls(const sensor_snapshot_t *snap);
+void print_report(const sensor_snapshot_t *snap);
+void run_curve_benchmark();
+void setup_history();
+void store_samples(const sensor_snapshot_t *snap, uint64_t t_ms);
+void print_history_report();
+
+// --- Ids dos sensores no retrato do escalonador ---
+static int mq2_id = -1;
+static int ldr_id = -1;
+static int dht_sensor_ids[DHT22_MAX_SENSORS];  // Id no driver dht22
+static int dht_sched_ids[DHT22_MAX_SENSORS];   // Id no retrato do escalonador
+static uint32_t dht_count = 0;
+
+// --- Estado da camada de decisão dos atuadores ---
+static actuator_ctrl_t servo_ctrl, relay_ctrl, led_ctrl;
+static servo_motion_t servo;
+
+// --- Séries do histórico (a ordem de registro define o id gravado na flash) ---
+static const ts_series_config_t HIST_TEMP_CFG = { "temperatura", TS_ENC_DELTA, 10.0f };  // DHT22: 0,1 °C
+static const ts_series_config_t HIST_HUM_CFG = { "umidade", TS_ENC_DELTA, 10.0f };      // DHT22: 0,1 %
+static const ts_series_config_t HIST_GAS_CFG = { "gas_ppm", TS_ENC_XOR, 0.0f };
+static const ts_series_config_t HIST_LUX_CFG = { "luz_lux", TS_ENC_XOR, 0.0f };
+static int hist_temp = -1, hist_hum = -1, hist_gas = -1, hist_lux = -1;
 
 
 /**
@@ -124,62 +219,68 @@ int main() {
     sleep_ms(2000);
     printf("Sistema de Monitoramento Ambiental Iniciado.\n\n");
 
+#if CURVE_BENCHMARK_AT_BOOT
+    run_curve_benchmark();
+#endif
+
+    // Cada sensor passa a ser disparado e coletado no seu próprio período.
+    setup_sensor_schedule();
+    setup_history();
+
+    sensor_snapshot_t snap;
+    uint32_t applied_version = 0;
+    uint32_t last_report_ms = 0;
+    uint32_t last_history_ms = 0;
+    uint32_t last_flush_ms = 0;
+    uint64_t store_next_ms = ts_store_now_ms() + STORE_PERIOD_MS;
+
     // Laço de execução principal. O programa permanecerá aqui para sempre.
     while (true) {
-        // --- Leitura e Lógica do Sensor de Temperatura (DHT22) ---
-        float temperature, humidity;
-        // Chama a função do driver para ler os dados do sensor DHT22.
-        int dht_result = dht22_read(&temperature, &humidity);
-
-        // Verifica se a leitura foi bem-sucedida.
-        if (dht_result == DHT22_OK) {
-            printf("\nTemperatura: %.1f °C | Umidade: %.1f %%\n", temperature, humidity);
-
-            // Compara a temperatura lida com o limiar definido.
-            if (temperature > TEMPERATURE_THRESHOLD) {
-                set_servo_angle(SERVO_PIN, 180); // Move o servo para a posição de "alerta" (180 graus).
-                printf("ALERTA: Temperatura ALTA! Servo acionado.\n");
-            } else {
-                set_servo_angle(SERVO_PIN, 0); // Mantém ou retorna o servo à posição de repouso (0 graus).
-            }
-        } else {
-            // Informa sobre a falha na leitura do DHT22, incluindo o código de erro.
-            printf("Falha ao ler DHT22 (cod: %d) | ", dht_result);
+        // Dispara/coleta o que estiver no prazo e descobre quando é o próximo prazo.
+        uint64_t next_due_us = sensor_sched_run();
+
+        // Os atuadores reagem a cada retrato novo (no ritmo do sensor mais rápido).
+        sensor_sched_snapshot(&snap);
+        if (snap.version != applied_version) {
+            applied_version = snap.version;
+            apply_controls(&snap);
         }
-        // --- Fim Leitura e Lógica do Sensor de Temperatura (DHT22) ---
-
-        // --- Leitura e Lógica do Sensor de Gás (MQ-2) ---
-        Mq2Result mq2_data = read_mq2_ppm(); // Chama a função que retorna a struct com os dados do MQ-2.
-
-        printf("Gás: Leitura bruta: %4d | PPM (estimado): %.0f\n",
-               mq2_data.raw_adc, mq2_data.ppm);
-       
-        // Compara a concentração de gás com o limiar.
-        if (mq2_data.ppm <= GAS_PPM_THRESHOLD) {
-            gpio_put(RELAY_PIN, 1); // Ativa o relé (envia nível alto).
-            printf("ALERTA: Condicao de gas para ativacao do rele atingida!\n");
-        } else {
-            gpio_put(RELAY_PIN, 0); // Desativa o relé (envia nível baixo).
-        }
-        // --- Fim Leitura e Lógica do Sensor de Gás (MQ-2) ---
 
+        uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+        if (now_ms - last_report_ms >= REPORT_PERIOD_MS) {
+            last_report_ms = now_ms;
+            print_report(&snap);
+        }
 
-        // --- Leitura e Lógica do Sensor de Luminosidade (LDR) ---
-        float lux = read_ldr_lux();
-        printf("Luz: %.0f Lux\n", lux);
-        // Compara a luminosidade com o limiar. Acima de 150 Lux  acende o led
-        if (lux > LUMINOSITY_THRESHOLD) {
-            gpio_put(LED_RED_PIN, 1); // Liga o LED.
-            printf("ALERTA: Condicao de luz para ativacao do LED atingida!\n");
-        } else {
-            gpio_put(LED_RED_PIN, 0); // Desliga o LED.
+        // Histórico: grava na grade fixa de STORE_PERIOD_MS; se a flash atrasou o laço
+        // além de um período, a grade recomeça a partir de agora.
+        uint64_t store_now_ms = ts_store_now_ms();
+        if (store_now_ms >= store_next_ms) {
+            store_samples(&snap, store_next_ms);
+            store_next_ms += STORE_PERIOD_MS;
+            if (store_next_ms <= store_now_ms) {
+                store_next_ms = store_now_ms + STORE_PERIOD_MS;
+            }
+        }
+        if (now_ms - last_flush_ms >= STORE_FLUSH_PERIOD_MS) {
+            last_flush_ms = now_ms;
+            ts_store_flush();
+        }
+        if (now_ms - last_history_ms >= HISTORY_REPORT_PERIOD_MS) {
+            last_history_ms = now_ms;
+            print_history_report();
         }
-        // --- Fim Leitura e Lógica do Sensor de Luminosidade (LDR) ---
 
-        // Aguarda por 2 segundos antes de iniciar o próximo ciclo de leituras.
-        // Este delay é importante para respeitar o intervalo mínimo do sensor DHT22 e para
-        // evitar sobrecarregar o sistema com leituras excessivamente rápidas.
-        sleep_ms(2000);
+        // Dorme até o próximo prazo de algum sensor (ou do relatório, se vier antes).
+        uint64_t report_due_us = (uint64_t)(last_report_ms + REPORT_PERIOD_MS) * 1000u;
+        if (report_due_us < next_due_us) {
+            next_due_us = report_due_us;
+        }
+        uint64_t store_due_us = time_us_64() + (store_next_ms - ts_store_now_ms()) * 1000u;
+        if (store_due_us < next_due_us) {
+            next_due_us = store_due_us;
+        }
+        sleep_until(from_us_since_boot(next_due_us));
     }
 
     return 0; // Esta linha nunca será alcançada.
@@ -200,22 +301,15 @@ void setup_peripherals() {
     gpio_init(RELAY_PIN);
     gpio_set_dir(RELAY_PIN, GPIO_OUT);
 
-    // --- Inicialização do PWM para o Servo Motor ---
-    // Atribui a função de PWM ao pino do servo.
-    gpio_set_function(SERVO_PIN, GPIO_FUNC_PWM);
-    // Descobre qual "fatia" (slice) de PWM está conectada ao pino. O Pico tem 8 slices de PWM.
-    uint slice_num = pwm_gpio_to_slice_num(SERVO_PIN);
-    // Obtém uma configuração padrão de PWM.
-    pwm_config config = pwm_get_default_config();
-    
-    // Configura o clock do PWM para operar a 50Hz, que é a frequência padrão para servos.
-    // Clock do sistema (125MHz) / 62.5 (clkdiv) / 40000 (wrap) = 50 Hz.
-    // Período de 20ms.
-    pwm_config_set_clkdiv(&config, 62.5f); 
-    pwm_config_set_wrap(&config, 40000);
-    // Aplica a configuração à fatia de PWM e a inicia.
-    pwm_init(slice_num, &config, true);
-    set_servo_angle(SERVO_PIN, 0); // Define a posição inicial do servo como 0 graus.
+    // --- Servo Motor: PWM a 50 Hz e um canal de DMA para os perfis de movimento ---
+    // Posição inicial 0 graus; cada movimento depois é uma curva em S reproduzida pelo DMA.
+    servo_motion_init(&servo, SERVO_PIN, 0.0f, SERVO_MAX_SPEED_DEG_S, SERVO_MAX_ACCEL_DEG_S2,
+                      SERVO_PROFILE_SCURVE);
+
+    // --- Camada de decisão dos atuadores ---
+    actuator_ctrl_init(&servo_ctrl, &SERVO_CTRL_CFG);
+    actuator_ctrl_init(&relay_ctrl, &RELAY_CTRL_CFG);
+    actuator_ctrl_init(&led_ctrl, &LED_CTRL_CFG);
 
     // --- Inicialização do Conversor Analógico-Digital (ADC) ---
     adc_init(); // Inicializa o hardware do ADC.
@@ -223,36 +317,15 @@ void setup_peripherals() {
     adc_gpio_init(LDR_ADC_PIN); // Habilita a função de ADC no pino GP28.
 
     // --- Inicialização do driver do sensor DHT22 ---
-    dht22_init(DHT22_PIN);
-}
-
-/**
- * @brief Controla o ângulo de um servo motor padrão.
- *
- * @details Converte um ângulo desejado (de 0 a 180 graus) em um valor de duty cycle de PWM.
- * Servos padrão respondem a pulsos de largura específica dentro de um período de 20ms:
- * - Pulso de ~1ms: Posição de 0 graus.
- * - Pulso de ~1.5ms: Posição de 90 graus.
- * - Pulso de ~2ms: Posição de 180 graus.
- * A função calcula o valor de contagem (`duty`) correspondente a essa largura de pulso.
- *
- * @param[in] pin O pino GPIO onde o servo está conectado (deve ser um pino com PWM).
- * @param[in] angle O ângulo desejado para o servo, de 0.0 a 180.0 graus.
- */
-void set_servo_angle(uint pin, float angle) {
-    // Garante que o ângulo esteja dentro da faixa permitida (0-180).
-    if (angle < 0) angle = 0;
-    if (angle > 180) angle = 180;
-    
-    // Mapeia o ângulo (0-180) para o valor de duty cycle (contagem do PWM).
-    // Com nosso wrap de 40000 e clkdiv de 62.5, o período é de 20ms.
-    // 1ms (1000us) de pulso corresponde a um duty de (1000us / 20000us) * 40000 = 2000.
-    // 2ms (2000us) de pulso corresponde a um duty de (2000us / 20000us) * 40000 = 4000.
-    // A fórmula abaixo mapeia linearmente o ângulo [0, 180] para o duty [2000, 4000].
-    uint16_t duty = (uint16_t)(2000 + (angle / 180.0f) * 2000);
-    
-    // Define o nível do PWM para o pino especificado, movendo o servo.
-    pwm_set_gpio_level(pin, duty);
+    // Um sensor por máquina de estados da PIO. As leituras são disparadas pelo escalonador.
+    for (uint32_t i = 0; i < DHT22_NUM_SENSORS; i++) {
+        int id = dht22_add_sensor(DHT22_PINS[i]);
+        if (id < 0) {
+            printf("DHT22: sem PIO livre para o pino %lu\n", (unsigned long)DHT22_PINS[i]);
+            continue;
+        }
+        dht_sensor_ids[dht_count++] = id;
+    }
 }
 
 /**
@@ -275,31 +348,18 @@ float read_ldr_lux() {
     
     // Caso especial: se a leitura do ADC for máxima, a resistência do LDR é próxima de zero (luz muito intensa).
     // A fórmula abaixo daria divisão por zero. O retorno correto aqui dependeria do circuito.
-    if (raw_adc >= ADC_MAX_RESOLUTION) {
+    if (raw_adc >= ADC_MAX_COUNTS) {
         return 50000; // Retorna um valor alto para indicar luz intensa.
     }
     
-    // Converte o valor bruto do ADC (0-4095) para uma tensão (0-3.3V).
-    float adc_voltage = ADC_VREF * (raw_adc / ADC_MAX_RESOLUTION);
-    
-    // Evita divisão por zero se a tensão for 0V (escuridão total).
-    if (adc_voltage <= 0.0f) {
+    // Escuridão total: a resistência do LDR tende ao infinito.
+    if (raw_adc == 0) {
         return 0; // Retorna 0 Lux para escuridão.
     }
 
-    // Calcula a resistência do LDR usando a fórmula do divisor de tensão:
-    // V_out = V_ref * R_ldr / (R_fixo + R_ldr) => R_ldr = R_fixo * V_out / (V_ref - V_out)
-    float ldr_resistance = (LDR_SERIES_RESISTOR * adc_voltage) / (ADC_VREF - adc_voltage);
-
-    // Converte a resistência do LDR para Lux (fórmula de aproximação)
-    float lux = powf((50.0f * 1000.0f * powf(10.0f, 0.7f)) / ldr_resistance, 1.0f / 0.7f);
-    
-    // Converte a resistência do LDR para Lux usando uma fórmula empírica de aproximação.
-    // Esta fórmula (Lux = 500 * (10k / R_ldr)) é um exemplo comum, mas pode não ser precisa.
-    // A fórmula original no código era mais complexa e também uma aproximação.
-    // Usando uma versão mais simples para clareza: Lux = k / R_ldr
-    // float lux = 5e6 / ldr_resistance;
-
+    // Lux = (K / R_ldr)^(1/0,7) com R_ldr = R_fixo * raw / (4095 - raw): a curva depende só
+    // da razão (4095 - raw) / raw e é avaliada em ponto fixo no domínio log (curve_fixed.h).
+    float lux = curve_eval_f(&curve_ldr_lux, ADC_MAX_COUNTS - raw_adc, raw_adc);
     return lux;
 }
 
@@ -323,33 +383,362 @@ Mq2Result read_mq2_ppm() {
     // Lê o valor bruto e armazena diretamente no campo da struct.
     result.raw_adc = adc_read();
 
-    // Converte o valor bruto do ADC (0-4095) para uma tensão (0-3.3V).
-    float adc_voltage = result.raw_adc * ADC_VREF / ADC_MAX_RESOLUTION;
-
-    // Evita divisão por zero se a tensão for 0V (o que não deve acontecer em operação normal).
-    if (adc_voltage <= 0) {
+    // Evita divisão por zero (0 V) e Rs <= 0 (fundo de escala), como leituras inválidas.
+    if (result.raw_adc == 0 || result.raw_adc >= ADC_MAX_COUNTS) {
         result.ppm = 0;
         return result;
     }
-    
-    // Calcula a resistência do sensor (Rs) usando a fórmula do divisor de tensão.
-    // O módulo do sensor tem um circuito onde a tensão medida (V_out) está em RL.
-    // V_out = V_ref * RL / (Rs + RL) => Rs = (V_ref * RL / V_out) - RL
+
+    // PPM = A * (Rs/R0)^B com Rs = RL * (4095 - raw) / raw: avaliado em ponto fixo no
+    // domínio log (curve_fixed.h), sem pow(). Referência em double: mq2_ppm_from_raw_libm().
+    result.ppm = curve_eval_f(&curve_mq2_ppm, ADC_MAX_COUNTS - result.raw_adc, result.raw_adc);
+
+    // Retorna a struct inteira contendo tanto o valor bruto quanto o calculado.
+    return result;
+}
+
+// --- Referências em libm e benchmark das curvas ---
+
+/**
+ * @brief PPM do MQ-2 pela fórmula original em ponto flutuante (pow() em double).
+ * @param raw Leitura do ADC (1..4094).
+ */
+static float mq2_ppm_from_raw_libm(uint16_t raw) {
+    float adc_voltage = raw * ADC_VREF / ADC_MAX_RESOLUTION;
     float rs = ((ADC_VREF * MQ2_RL) / adc_voltage) - MQ2_RL;
-    
-    // Se a resistência for negativa ou zero (pode acontecer com leituras instáveis), trate como erro.
-    if (rs <= 0) {
-        result.ppm = 0;
-        return result;
+    float ratio = rs / MQ2_R0;
+    return MQ2_CURVE_A * pow(ratio, MQ2_CURVE_B);
+}
+
+/**
+ * @brief Lux do LDR pela fórmula original em ponto flutuante (powf()).
+ * @param raw Leitura do ADC (1..4094).
+ */
+static float ldr_lux_from_raw_libm(uint16_t raw) {
+    float adc_voltage = ADC_VREF * (raw / ADC_MAX_RESOLUTION);
+    float ldr_resistance = (LDR_SERIES_RESISTOR * adc_voltage) / (ADC_VREF - adc_voltage);
+    return powf((50.0f * 1000.0f * powf(10.0f, 0.7f)) / ldr_resistance, 1.0f / 0.7f);
+}
+
+/**
+ * @brief Compara as curvas em ponto fixo com as versões em libm em todas as leituras 1..4094.
+ *
+ * @details Imprime o tempo médio por conversão (µs, medido com o timer de 1 MHz sobre as
+ * 4094 leituras) e o maior erro relativo encontrado, que deve ficar abaixo do limite
+ * publicado em curve_tables.h.
+ */
+void run_curve_benchmark() {
+    const uint32_t n = ADC_MAX_COUNTS - 1;
+    volatile float sink = 0.0f;  // Impede o compilador de descartar os cálculos.
+    uint32_t t0;
+
+    t0 = time_us_32();
+    for (uint16_t raw = 1; raw < ADC_MAX_COUNTS; raw++) sink = mq2_ppm_from_raw_libm(raw);
+    uint32_t mq2_libm_us = time_us_32() - t0;
+
+    t0 = time_us_32();
+    for (uint16_t raw = 1; raw < ADC_MAX_COUNTS; raw++) sink = curve_eval_f(&curve_mq2_ppm, ADC_MAX_COUNTS - raw, raw);
+    uint32_t mq2_fixed_us = time_us_32() - t0;
+
+    t0 = time_us_32();
+    for (uint16_t raw = 1; raw < ADC_MAX_COUNTS; raw++) sink = ldr_lux_from_raw_libm(raw);
+    uint32_t ldr_libm_us = time_us_32() - t0;
+
+    t0 = time_us_32();
+    for (uint16_t raw = 1; raw < ADC_MAX_COUNTS; raw++) sink = curve_eval_f(&curve_ldr_lux, ADC_MAX_COUNTS - raw, raw);
+    uint32_t ldr_fixed_us = time_us_32() - t0;
+    (void)sink;
+
+    float mq2_err = 0.0f, ldr_err = 0.0f;
+    for (uint16_t raw = 1; raw < ADC_MAX_COUNTS; raw++) {
+        float ref = mq2_ppm_from_raw_libm(raw);
+        float err = fabsf(curve_eval_f(&curve_mq2_ppm, ADC_MAX_COUNTS - raw, raw) - ref) / ref;
+        if (err > mq2_err) mq2_err = err;
+        ref = ldr_lux_from_raw_libm(raw);
+        err = fabsf(curve_eval_f(&curve_ldr_lux, ADC_MAX_COUNTS - raw, raw) - ref) / ref;
+        if (err > ldr_err) ldr_err = err;
     }
 
-    // Calcula a razão Rs/R0, que é a base para encontrar a concentração no gráfico do datasheet.
-    float ratio = rs / MQ2_R0;
+    printf("Benchmark das curvas (%lu leituras, us por conversao):\n", (unsigned long)n);
+    printf("  MQ-2: libm %.2f | ponto fixo %.2f | erro max %.4f %% (limite %.4f %%)\n",
+           (float)mq2_libm_us / n, (float)mq2_fixed_us / n,
+           mq2_err * 100.0f, CURVE_MQ2_PPM_MAX_REL_ERR_E6 / 10000.0f);
+    printf("  LDR : libm %.2f | ponto fixo %.2f | erro max %.4f %% (limite %.4f %%)\n\n",
+           (float)ldr_libm_us / n, (float)ldr_fixed_us / n,
+           ldr_err * 100.0f, CURVE_LDR_LUX_MAX_REL_ERR_E6 / 10000.0f);
+}
 
-    // Calcula o PPM usando a fórmula da curva de potência: PPM = A * ratio^B
-    // A função pow() da biblioteca math.h é usada para a exponenciação.
-    result.ppm = MQ2_CURVE_A * pow(ratio, MQ2_CURVE_B);
+// --- Drivers dos sensores para o escalonador (sensor_sched.h) ---
 
-    // Retorna a struct inteira contendo tanto o valor bruto quanto o calculado.
-    return result;
-}
\ No newline at end of file
+/**
+ * @brief Coleta do MQ-2: uma conversão do ADC (~2 µs), feita no próprio disparo.
+ * @param[out] values values[0] = PPM estimado, values[1] = leitura bruta do ADC.
+ */
+static bool mq2_collect(void *ctx, float *values, uint32_t *sample_time_ms) {
+    Mq2Result r = read_mq2_ppm();
+    values[0] = r.ppm;
+    values[1] = (float)r.raw_adc;
+    return true;
+}
+
+/**
+ * @brief Coleta do LDR: uma conversão do ADC, feita no próprio disparo.
+ * @param[out] values values[0] = luminosidade em Lux.
+ */
+static bool ldr_collect(void *ctx, float *values, uint32_t *sample_time_ms) {
+    values[0] = read_ldr_lux();
+    return true;
+}
+
+/**
+ * @brief Disparo do DHT22: a PIO faz a transferência; o resultado fica pronto em até 25 ms.
+ * @param ctx Id do sensor no driver dht22.
+ */
+static bool dht_trigger(void *ctx) {
+    return dht22_sensor_read_async((uint32_t)(uintptr_t)ctx, NULL, NULL) == DHT22_OK;
+}
+
+/**
+ * @brief Coleta do DHT22: lê o cache do driver, preenchido pela interrupção da PIO.
+ * @param[out] values values[0] = temperatura (°C), values[1] = umidade (%).
+ * @param[out] sample_time_ms Instante real da leitura (o do cache).
+ * @return `false` se a leitura disparada falhou.
+ */
+static bool dht_collect(void *ctx, float *values, uint32_t *sample_time_ms) {
+    dht22_reading_t r;
+    dht22_sensor_get_latest((uint32_t)(uintptr_t)ctx, &r);
+    if (!r.valid || r.last_status != DHT22_OK) {
+        return false;
+    }
+    values[0] = r.temperature;
+    values[1] = r.humidity;
+    *sample_time_ms = r.timestamp_ms;
+    return true;
+}
+
+/**
+ * @brief Registra todos os sensores no escalonador, cada um com o seu período e latência.
+ */
+void setup_sensor_schedule() {
+    static const sensor_driver_t mq2_driver = {
+        .name = "MQ-2", .period_ms = MQ2_PERIOD_MS, .latency_us = 0,
+        .trigger = NULL, .collect = mq2_collect, .ctx = NULL
+    };
+    static const sensor_driver_t ldr_driver = {
+        .name = "LDR", .period_ms = LDR_PERIOD_MS, .latency_us = 0,
+        .trigger = NULL, .collect = ldr_collect, .ctx = NULL
+    };
+    static sensor_driver_t dht_drivers[DHT22_MAX_SENSORS];
+
+    mq2_id = sensor_sched_register(&mq2_driver);
+    ldr_id = sensor_sched_register(&ldr_driver);
+
+    // Todos os DHT22 com o mesmo período e fase: são disparados na mesma passada e lidos em paralelo.
+    for (uint32_t i = 0; i < dht_count; i++) {
+        dht_drivers[i] = (sensor_driver_t){
+            .name = "DHT22", .period_ms = DHT22_PERIOD_MS, .latency_us = DHT22_LATENCY_US,
+            .trigger = dht_trigger, .collect = dht_collect, .ctx = (void *)(uintptr_t)dht_sensor_ids[i]
+        };
+        dht_sched_ids[i] = sensor_sched_register(&dht_drivers[i]);
+    }
+}
+
+/**
+ * @brief Aplica a lógica de controle ao retrato mais recente.
+ * @details Cada atuador decide pela sua camada de `actuator_ctrl_t` (filtro, histerese,
+ * debounce e tempo mínimo), alimentada apenas quando o seu sensor tem amostra nova.
+ * Os alertas só são impressos na mudança de estado.
+ * @param[in] snap Retrato coerente dos sensores.
+ */
+void apply_controls(const sensor_snapshot_t *snap) {
+    static uint32_t dht_samples_seen = 0, mq2_samples_seen = 0, ldr_samples_seen = 0;
+    uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+
+    // --- Temperatura (DHT22): o servo reage ao ponto mais quente com leitura recente ---
+    bool temp_valid = false;
+    float temp_max = 0.0f;
+    uint32_t dht_samples = 0;
+    for (uint32_t i = 0; i < dht_count; i++) {
+        const sensor_sample_t *d = &snap->sensors[dht_sched_ids[i]];
+        dht_samples += d->samples;
+        if (d->valid && (now_ms - d->sample_time_ms) <= DHT22_MAX_AGE_MS) {
+            if (!temp_valid || d->values[0] > temp_max) temp_max = d->values[0];
+            temp_valid = true;
+        }
+    }
+    // Sem nenhuma leitura válida recente, o servo mantém a decisão anterior.
+    if (temp_valid && dht_samples != dht_samples_seen) {
+        dht_samples_seen = dht_samples;
+        bool was = servo_ctrl.state;
+        actuator_ctrl_update(&servo_ctrl, temp_max, now_ms);
+        if (servo_ctrl.state != was) {
+            // 180 graus = posição de "alerta". O DMA conduz o movimento; a CPU só o dispara.
+            uint32_t ms = servo_motion_move_to(&servo, servo_ctrl.state ? 180.0f : 0.0f);
+            if (servo_ctrl.state) printf("ALERTA: Temperatura ALTA! Servo acionado (%lu ms).\n", (unsigned long)ms);
+        }
+    }
+
+    // --- Gás (MQ-2): relé ---
+    if (mq2_id >= 0 && snap->sensors[mq2_id].valid && snap->sensors[mq2_id].samples != mq2_samples_seen) {
+        const sensor_sample_t *g = &snap->sensors[mq2_id];
+        mq2_samples_seen = g->samples;
+        bool was = relay_ctrl.state;
+        gpio_put(RELAY_PIN, actuator_ctrl_update(&relay_ctrl, g->values[0], g->sample_time_ms));
+        if (relay_ctrl.state && !was) printf("ALERTA: Condicao de gas para ativacao do rele atingida!\n");
+    }
+
+    // --- Luminosidade (LDR): LED. Acima de 150 Lux acende o led ---
+    if (ldr_id >= 0 && snap->sensors[ldr_id].valid && snap->sensors[ldr_id].samples != ldr_samples_seen) {
+        const sensor_sample_t *l = &snap->sensors[ldr_id];
+        ldr_samples_seen = l->samples;
+        bool was = led_ctrl.state;
+        gpio_put(LED_RED_PIN, actuator_ctrl_update(&led_ctrl, l->values[0], l->sample_time_ms));
+        if (led_ctrl.state && !was) printf("ALERTA: Condicao de luz para ativacao do LED atingida!\n");
+    }
+}
+
+/**
+ * @brief Imprime o retrato: valor, idade e contadores de cada sensor.
+ * @param[in] snap Retrato coerente dos sensores.
+ */
+void print_report(const sensor_snapshot_t *snap) {
+    uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+    printf("\n--- Retrato v%lu ---\n", (unsigned long)snap->version);
+
+    for (uint32_t i = 0; i < dht_count; i++) {
+        const sensor_sample_t *d = &snap->sensors[dht_sched_ids[i]];
+        dht22_stats_t stats = {0};
+        dht22_sensor_stats(dht_sensor_ids[i], &stats);
+        if (d->valid) {
+            printf("DHT22[%lu] Temperatura: %.1f °C | Umidade: %.1f %% (idade %lu ms)\n",
+                   (unsigned long)i, d->values[0], d->values[1], (unsigned long)(now_ms - d->sample_time_ms));
+        } else {
+            printf("DHT22[%lu] sem leitura valida ainda\n", (unsigned long)i);
+        }
+        printf("          ok %lu | timeout %lu | checksum %lu\n", (unsigned long)stats.ok,
+               (unsigned long)stats.timeouts, (unsigned long)stats.checksum_errors);
+    }
+    if (mq2_id >= 0) {
+        const sensor_sample_t *g = &snap->sensors[mq2_id];
+        printf("Gás: Leitura bruta: %4.0f | PPM (estimado): %.0f | %lu amostras\n",
+               g->values[1], g->values[0], (unsigned long)g->samples);
+    }
+    if (ldr_id >= 0) {
+        const sensor_sample_t *l = &snap->sensors[ldr_id];
+        printf("Luz: %.0f Lux | %lu amostras\n", l->values[0], (unsigned long)l->samples);
+    }
+
+    // Trocas efetivas x trocas que o limiar instantâneo teria feito.
+    printf("Trocas (efetivas/limiar simples): servo %lu/%lu | rele %lu/%lu | LED %lu/%lu\n",
+           (unsigned long)servo_ctrl.switches, (unsigned long)servo_ctrl.naive_switches,
+           (unsigned long)relay_ctrl.switches, (unsigned long)relay_ctrl.naive_switches,
+           (unsigned long)led_ctrl.switches, (unsigned long)led_ctrl.naive_switches);
+    printf("Servo: %.0f graus%s | %lu movimentos\n", servo_motion_position_deg(&servo),
+           servo_motion_busy(&servo) ? " (em movimento)" : "", (unsigned long)servo.moves);
+}
+
+// --- Histórico na flash (ts_store.h) ---
+
+/**
+ * @brief Monta o histórico e registra as séries (sempre na mesma ordem).
+ * @details Temperatura e umidade têm resolução fixa de 0,1 e usam delta quantizado; gás e
+ * luz são curvas contínuas e usam o XOR dos floats.
+ */
+void setup_history() {
+    uint64_t t0 = time_us_64();
+    ts_store_init();
+    uint32_t mount_us = (uint32_t)(time_us_64() - t0);
+
+    hist_temp = ts_store_add_series(&HIST_TEMP_CFG);
+    hist_hum = ts_store_add_series(&HIST_HUM_CFG);
+    hist_gas = ts_store_add_series(&HIST_GAS_CFG);
+    hist_lux = ts_store_add_series(&HIST_LUX_CFG);
+
+    ts_store_stats_t st;
+    ts_store_get_stats(&st);
+    printf("Historico: %lu/%lu paginas validas, %lu corrompidas ignoradas, montagem %lu us\n\n",
+           (unsigned long)st.pages_valid, (unsigned long)st.pages_total,
+           (unsigned long)st.torn_pages, (unsigned long)mount_us);
+}
+
+/**
+ * @brief Acrescenta ao histórico as leituras válidas do retrato.
+ * @param[in] snap Retrato coerente dos sensores.
+ * @param t_ms Instante na grade do histórico.
+ */
+void store_samples(const sensor_snapshot_t *snap, uint64_t t_ms) {
+    // Só o DHT22 principal vai para o histórico.
+    if (dht_count > 0 && snap->sensors[dht_sched_ids[0]].valid) {
+        ts_store_append(hist_temp, t_ms, snap->sensors[dht_sched_ids[0]].values[0]);
+        ts_store_append(hist_hum, t_ms, snap->sensors[dht_sched_ids[0]].values[1]);
+    }
+    if (mq2_id >= 0 && snap->sensors[mq2_id].valid) {
+        ts_store_append(hist_gas, t_ms, snap->sensors[mq2_id].values[0]);
+    }
+    if (ldr_id >= 0 && snap->sensors[ldr_id].valid) {
+        ts_store_append(hist_lux, t_ms, snap->sensors[ldr_id].values[0]);
+    }
+}
+
+/** @brief Acumulador da consulta de exemplo. */
+typedef struct {
+    uint32_t n;
+    float min, max, sum;
+} HistoryAgg;
+
+static bool history_agg(void *ctx, uint64_t t_ms, float value) {
+    HistoryAgg *a = ctx;
+    if (a->n == 0 || value < a->min) a->min = value;
+    if (a->n == 0 || value > a->max) a->max = value;
+    a->sum += value;
+    a->n++;
+    return true;
+}
+
+/**
+ * @brief Imprime ocupação, compressão e custo do histórico e consulta a última hora.
+ * @details A compressão compara com 12 bytes por amostra crua (instante de 64 bits +
+ * float) e só conta páginas já gravadas neste boot.
+ */
+void print_history_report() {
+    ts_store_stats_t st;
+    ts_store_get_stats(&st);
+
+    printf("\n--- Historico ---\n");
+    printf("Flash: %lu/%lu paginas validas | %lu gravadas e %lu setores apagados neste boot\n",
+           (unsigned long)st.pages_valid, (unsigned long)st.pages_total,
+           (unsigned long)st.pages_written, (unsigned long)st.sectors_erased);
+    if (st.pages_written > 0) {
+        float raw_bytes = (float)st.samples_sealed * 12.0f;
+        float stored_bytes = (float)st.pages_written * TS_STORE_PAGE_BYTES;
+        printf("Compressao: %.1fx (%.2f bytes/amostra) | gravacao %.0f us/pagina",
+               raw_bytes / stored_bytes, stored_bytes / st.samples_sealed,
+               (float)st.program_us / st.pages_written);
+        if (st.sectors_erased > 0) {
+            printf(" | apagamento %.0f us/setor", (float)st.erase_us / st.sectors_erased);
+        }
+        printf("\n");
+    }
+    if (st.flash_errors > 0) {
+        printf("Erros de flash: %lu (paginas descartadas)\n", (unsigned long)st.flash_errors);
+    }
+    if (st.samples > 0) {
+        printf("Acrescimo: %lu amostras, %.2f us/amostra (com gravacoes)\n",
+               (unsigned long)st.samples, (float)st.append_us / st.samples);
+    }
+
+    // Consulta de exemplo: estatísticas da temperatura na última hora.
+    uint64_t now = ts_store_now_ms();
+    uint64_t from = now > HISTORY_QUERY_WINDOW_MS ? now - HISTORY_QUERY_WINDOW_MS : 0;
+    HistoryAgg agg = {0};
+    ts_store_query(hist_temp, from, now, history_agg, &agg);
+    ts_store_get_stats(&st);
+    if (agg.n > 0) {
+        printf("Temperatura (1 h): min %.1f | max %.1f | media %.2f °C\n",
+               agg.min, agg.max, agg.sum / agg.n);
+    }
+    printf("Consulta: %lu amostras em %lu paginas, %lu us (%.0f amostras/s)\n",
+           (unsigned long)st.last_query_samples, (unsigned long)st.last_query_pages,
+           (unsigned long)st.last_query_us,
+           st.last_query_us ? st.last_query_samples * 1e6f / st.last_query_us : 0.0f);
+}
@@ -0,0 +1,70 @@
+/**
+ * @file actuator_ctrl.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Implementação da camada de decisão dos atuadores.
+ */
+
+#include "actuator_ctrl.h"
+
+void actuator_ctrl_init(actuator_ctrl_t *ctrl, const actuator_ctrl_config_t *cfg) {
+    *ctrl = (actuator_ctrl_t){ .cfg = cfg };
+}
+
+/**
+ * @brief Decisão com histerese a partir do estado atual.
+ */
+static bool hysteresis_decide(const actuator_ctrl_config_t *cfg, bool state, float x) {
+    if (cfg->active_above) {
+        return state ? (x >= cfg->threshold - cfg->hysteresis) : (x > cfg->threshold);
+    }
+    return state ? (x <= cfg->threshold + cfg->hysteresis) : (x <= cfg->threshold);
+}
+
+bool actuator_ctrl_update(actuator_ctrl_t *ctrl, float input, uint32_t now_ms) {
+    const actuator_ctrl_config_t *cfg = ctrl->cfg;
+
+    // Referência: o que o limiar instantâneo original faria com a amostra crua.
+    bool naive = cfg->active_above ? (input > cfg->threshold) : (input <= cfg->threshold);
+    if (naive != ctrl->naive_state) {
+        ctrl->naive_state = naive;
+        ctrl->naive_switches++;
+    }
+
+    // 1. Filtro: média móvel exponencial.
+    if (!ctrl->primed) {
+        ctrl->filtered = input;
+        ctrl->primed = true;
+        ctrl->last_change_ms = now_ms;
+    } else {
+        ctrl->filtered += cfg->filter_alpha * (input - ctrl->filtered);
+    }
+
+    // 2. Histerese.
+    bool wanted = hysteresis_decide(cfg, ctrl->state, ctrl->filtered);
+    if (wanted == ctrl->state) {
+        ctrl->pending = false;
+        return ctrl->state;
+    }
+
+    // 3. Debounce: a nova decisão precisa persistir.
+    if (!ctrl->pending) {
+        ctrl->pending = true;
+        ctrl->pending_since_ms = now_ms;
+    }
+    if (now_ms - ctrl->pending_since_ms < cfg->debounce_ms) {
+        return ctrl->state;
+    }
+
+    // 4. Tempo mínimo no estado atual.
+    uint32_t min_ms = ctrl->state ? cfg->min_on_ms : cfg->min_off_ms;
+    if (ctrl->switches > 0 && now_ms - ctrl->last_change_ms < min_ms) {
+        return ctrl->state;
+    }
+
+    ctrl->state = wanted;
+    ctrl->pending = false;
+    ctrl->last_change_ms = now_ms;
+    ctrl->switches++;
+    return ctrl->state;
+}
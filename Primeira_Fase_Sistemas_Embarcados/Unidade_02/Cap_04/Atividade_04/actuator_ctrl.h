@@ -0,0 +1,74 @@
+/**
+ * @file actuator_ctrl.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Camada de decisão dos atuadores: filtro, histerese, debounce e tempos mínimos.
+ *
+ * @details
+ * Um limiar instantâneo faz o relé "bater" e o servo tremer quando a leitura ruidosa
+ * fica perto do limiar. Cada atuador liga/desliga passa por um `actuator_ctrl_t`:
+ * @code
+ *   amostra ─▶ média móvel exponencial ─▶ histerese ─▶ debounce ─▶ tempo mínimo ─▶ estado
+ * @endcode
+ * - Histerese: ativa ao cruzar `threshold` e só libera ao voltar `hysteresis` para o
+ *   outro lado.
+ * - Debounce: a nova decisão precisa se manter por `debounce_ms` antes de valer.
+ * - Tempo mínimo: depois de uma troca, o estado fica pelo menos `min_on_ms`/`min_off_ms`.
+ *
+ * Em paralelo, o bloco conta quantas trocas o limiar instantâneo original teria feito
+ * (`naive_switches`), para comparar com as trocas reais (`switches`).
+ *
+ * A velocidade dos atuadores de posição (servo) é limitada pelo perfil de movimento
+ * em servo_motion.h.
+ *
+ * O custo por amostra é fixo: algumas comparações e uma multiplicação do filtro.
+ */
+
+#ifndef ACTUATOR_CTRL_H
+#define ACTUATOR_CTRL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Parâmetros de um atuador liga/desliga (constante). */
+typedef struct {
+    float threshold;             ///< Limiar de ativação (o mesmo do controle instantâneo).
+    float hysteresis;            ///< Largura da banda de histerese (mesma unidade da entrada).
+    bool active_above;           ///< `true`: ativa acima do limiar; `false`: ativa em ou abaixo dele.
+    float filter_alpha;          ///< Peso da nova amostra na média exponencial (1 = sem filtro).
+    uint32_t debounce_ms;        ///< Tempo que a nova decisão deve persistir.
+    uint32_t min_on_ms;          ///< Tempo mínimo ativo após ligar.
+    uint32_t min_off_ms;         ///< Tempo mínimo inativo após desligar.
+} actuator_ctrl_config_t;
+
+/** @brief Estado de um atuador liga/desliga. */
+typedef struct {
+    const actuator_ctrl_config_t *cfg;
+    float filtered;              ///< Entrada filtrada.
+    bool primed;                 ///< Filtro já recebeu a primeira amostra.
+    bool state;                  ///< Saída atual.
+    bool pending;                ///< Decisão diferente do estado em debounce.
+    uint32_t pending_since_ms;   ///< Início do debounce.
+    uint32_t last_change_ms;     ///< Instante da última troca de estado.
+    bool naive_state;            ///< Saída que o limiar instantâneo teria.
+    uint32_t switches;           ///< Trocas de estado efetivas.
+    uint32_t naive_switches;     ///< Trocas que o limiar instantâneo teria feito.
+} actuator_ctrl_t;
+
+/**
+ * @brief Inicializa um atuador liga/desliga (começa desligado).
+ * @param ctrl Estado.
+ * @param cfg Parâmetros (devem permanecer válidos).
+ */
+void actuator_ctrl_init(actuator_ctrl_t *ctrl, const actuator_ctrl_config_t *cfg);
+
+/**
+ * @brief Processa uma amostra da entrada.
+ * @param ctrl Estado.
+ * @param input Amostra.
+ * @param now_ms Instante da amostra (ms desde o boot).
+ * @return Estado da saída após a amostra.
+ */
+bool actuator_ctrl_update(actuator_ctrl_t *ctrl, float input, uint32_t now_ms);
+
+#endif // ACTUATOR_CTRL_H
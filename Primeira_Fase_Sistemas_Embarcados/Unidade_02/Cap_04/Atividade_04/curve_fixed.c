@@ -0,0 +1,78 @@
+/**
+ * @file curve_fixed.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief log2/exp2 em ponto fixo e avaliação das curvas dos sensores.
+ *
+ * @note A aritmética aqui é emulada bit a bit por tools/gen_curve_tables.py para medir o
+ *       erro publicado em curve_tables.h; qualquer mudança deve ser feita nos dois lados.
+ */
+
+#include "curve_fixed.h"
+#include "curve_tables.h"
+#include <string.h>
+
+#define FRAC_SHIFT (16 - CURVE_SEG_BITS)
+#define FRAC_MASK  ((1u << FRAC_SHIFT) - 1u)
+
+/**
+ * @brief Interpola uma tabela de 2^CURVE_SEG_BITS segmentos.
+ * @param table Tabela com 2^CURVE_SEG_BITS + 1 pontos.
+ * @param t Posição em Q16 (0 <= t < 65536).
+ */
+static inline int32_t interp(const int32_t *table, uint32_t t) {
+    uint32_t idx = t >> FRAC_SHIFT;
+    int32_t f = (int32_t)(t & FRAC_MASK);
+    int32_t a = table[idx];
+    return a + (((table[idx + 1] - a) * f + (1 << (FRAC_SHIFT - 1))) >> FRAC_SHIFT);
+}
+
+int32_t curve_log2_q16(uint32_t n) {
+    int32_t e = 31 - __builtin_clz(n);
+    // Normaliza n para 1.t em Q16 (65536 <= t < 131072).
+    uint32_t t = (e <= 16) ? (n << (16 - e)) : (n >> (e - 16));
+    return (e << 16) + interp(curve_log2_table, t - 65536u);
+}
+
+/**
+ * @brief Expoente (em Q16.16) de log2(y) para a curva.
+ */
+static inline int32_t curve_log2_y(const curve_t *c, uint32_t num, uint32_t den) {
+    int32_t d = curve_log2_q16(num) - curve_log2_q16(den);
+    return c->k0_q16 + (int32_t)(((int64_t)c->k1_q16 * d + 32768) >> 16);
+}
+
+uint32_t curve_eval_q(const curve_t *c, uint32_t num, uint32_t den, uint32_t frac_bits) {
+    int32_t e = curve_log2_y(c, num, den) + (int32_t)(frac_bits << 16);
+    int32_t i = e >> 16;
+    uint32_t m = (uint32_t)interp(curve_exp2_table, (uint32_t)e & 0xFFFFu);  // 1.x em Q16
+
+    if (i >= 16) {
+        return (i - 16 > 14) ? UINT32_MAX : (m << (i - 16));
+    }
+    if (i < -15) {
+        return 0;
+    }
+    uint32_t sh = (uint32_t)(16 - i);
+    return (m + (1u << (sh - 1))) >> sh;
+}
+
+float curve_eval_f(const curve_t *c, uint32_t num, uint32_t den) {
+    int32_t e = curve_log2_y(c, num, den);
+    int32_t i = e >> 16;
+    uint32_t m = (uint32_t)interp(curve_exp2_table, (uint32_t)e & 0xFFFFu);
+
+    if (i < -126) {
+        return 0.0f;
+    }
+    if (i > 127) {
+        i = 127;
+        m = 131071u;
+    }
+    // Mantissa de 16 bits alinhada aos 23 do IEEE-754. m == 2.0 (131072) gera vai-um para
+    // o expoente, que é exatamente 2^(i+1).
+    uint32_t bits = ((uint32_t)(i + 127) << 23) + ((m - 65536u) << 7);
+    float y;
+    memcpy(&y, &bits, sizeof(y));
+    return y;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file curve_fixed.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Avaliação de curvas de potência de sensores em ponto fixo, sem pow()/powf().
+ *
+ * @details
+ * Curvas do tipo y = A * (num/den)^B viram retas no domínio logarítmico:
+ * @code
+ *   log2(y) = k0 + k1 * (log2(num) - log2(den))     k0 = log2(A), k1 = B
+ * @endcode
+ * log2 e exp2 são calculados com aritmética inteira (CLZ + interpolação linear em
+ * tabelas de 33 pontos, Q16.16). O resultado em float é montado direto nos bits do
+ * IEEE-754 a partir do expoente inteiro e da mantissa, sem nenhuma operação em ponto
+ * flutuante por software. Custo: algumas dezenas de instruções inteiras e uma
+ * multiplicação de 64 bits, contra milhares de ciclos de pow() no Cortex-M0+.
+ *
+ * Os coeficientes e tabelas ficam em curve_tables.c, gerado por
+ * tools/gen_curve_tables.py, que também mede o erro máximo de cada curva em todas as
+ * leituras do ADC e o publica em curve_tables.h (CURVE_*_MAX_REL_ERR_E6).
+ *
+ * Limite teórico do erro: a interpolação linear de log2(1+t) em segmentos de 1/32 erra
+ * no máximo h²/(8·ln2) ≈ 1,8e-4 (em log2); a de 2^t, ln²2·h²/8 ≈ 5,9e-5 (relativo).
+ * Com duas avaliações de log2 escaladas por k1, o erro relativo fica abaixo de
+ * ln2·(2·|k1|·1,8e-4) + 5,9e-5 mais o arredondamento Q16 (~2e-5 por etapa).
+ */
+
+#ifndef CURVE_FIXED_H
+#define CURVE_FIXED_H
+
+#include <stdint.h>
+
+/** @brief Curva log2(y) = k0 + k1 * log2(num/den), coeficientes em Q16.16. */
+typedef struct {
+    int32_t k0_q16;
+    int32_t k1_q16;
+} curve_t;
+
+/**
+ * @brief log2 de um inteiro.
+ * @param n Valor (n >= 1).
+ * @return log2(n) em Q16.16.
+ */
+int32_t curve_log2_q16(uint32_t n);
+
+/**
+ * @brief Avalia a curva em ponto fixo.
+ * @param c Coeficientes.
+ * @param num Numerador da razão (>= 1).
+ * @param den Denominador da razão (>= 1).
+ * @param frac_bits Bits fracionários do resultado.
+ * @return y * 2^frac_bits, saturado em UINT32_MAX.
+ */
+uint32_t curve_eval_q(const curve_t *c, uint32_t num, uint32_t den, uint32_t frac_bits);
+
+/**
+ * @brief Avalia a curva e devolve float (montado por bits, sem aritmética em float).
+ * @param c Coeficientes.
+ * @param num Numerador da razão (>= 1).
+ * @param den Denominador da razão (>= 1).
+ * @return y.
+ */
+float curve_eval_f(const curve_t *c, uint32_t num, uint32_t den);
+
+#endif // CURVE_FIXED_H
@@ -0,0 +1,27 @@
+/**
+ * @file curve_tables.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Tabelas e coeficientes das curvas dos sensores (gerado por tools/gen_curve_tables.py; não edite).
+ */
+
+#include "curve_tables.h"
+
+const int32_t curve_log2_table[33] = {
+    0, 2909, 5732, 8473, 11136, 13727, 16248, 18704,
+    21098, 23433, 25711, 27936, 30109, 32234, 34312, 36346,
+    38336, 40286, 42196, 44068, 45904, 47705, 49472, 51207,
+    52911, 54584, 56229, 57845, 59434, 60997, 62534, 64047,
+    65536,
+};
+
+const int32_t curve_exp2_table[33] = {
+    65536, 66971, 68438, 69936, 71468, 73032, 74632, 76266,
+    77936, 79642, 81386, 83169, 84990, 86851, 88752, 90696,
+    92682, 94711, 96785, 98905, 101070, 103283, 105545, 107856,
+    110218, 112631, 115098, 117618, 120194, 122825, 125515, 128263,
+    131072,
+};
+
+const curve_t curve_mq2_ppm = { .k0_q16 = 198992, .k1_q16 = 7602 };
+const curve_t curve_ldr_lux = { .k0_q16 = 435091, .k1_q16 = 93623 };
@@ -0,0 +1,28 @@
+/**
+ * @file curve_tables.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Tabelas e coeficientes das curvas dos sensores (gerado por tools/gen_curve_tables.py; não edite).
+ *
+ * @details Erro relativo máximo medido contra double em todas as leituras 1..4094 do ADC:
+ *  - mq2_ppm: 0.0087 % (pior caso em raw = 4079)
+ *  - ldr_lux: 0.0229 % (pior caso em raw = 2079)
+ */
+
+#ifndef CURVE_TABLES_H
+#define CURVE_TABLES_H
+
+#include "curve_fixed.h"
+
+#define CURVE_SEG_BITS 5  ///< log2 do número de segmentos de interpolação.
+
+#define CURVE_MQ2_PPM_MAX_REL_ERR_E6 87  ///< Erro relativo máximo de mq2_ppm, em milionésimos.
+#define CURVE_LDR_LUX_MAX_REL_ERR_E6 230  ///< Erro relativo máximo de ldr_lux, em milionésimos.
+
+extern const int32_t curve_log2_table[33];   ///< log2(1 + i/32) em Q16.16.
+extern const int32_t curve_exp2_table[33];   ///< 2^(i/32) em Q16.16.
+
+extern const curve_t curve_mq2_ppm;  ///< log2(y) = 3.036377 + 0.116000 * log2(num/den).
+extern const curve_t curve_ldr_lux;  ///< log2(y) = 6.638968 + 1.428571 * log2(num/den).
+
+#endif // CURVE_TABLES_H
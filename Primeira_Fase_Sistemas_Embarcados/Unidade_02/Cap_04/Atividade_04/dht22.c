@@ -24,152 +24,78 @@
  * * @details Este arquivo contém a implementação detalhada das funções necessárias para
  * a comunicação com o sensor de temperatura e umidade DHT22. Ele utiliza o
  * protocolo de 1-fio (1-Wire) específico do sensor, que depende de uma
- * temporização precisa para a troca de dados. As funções aqui são de baixo nível
- * e manipulam diretamente os pinos GPIO e os temporizadores do Raspberry Pi Pico.
+ * temporização precisa para a troca de dados.
+ * * Toda a temporização do protocolo é feita por uma máquina de estados da PIO
+ * (programa em `dht22.pio`): ela gera o pulso de início, amostra a largura de cada
+ * bit e entrega os 40 bits na RX FIFO. A CPU apenas dispara a leitura e trata uma
+ * interrupção no final, então interrupções ou pausas da flash durante a transferência
+ * não corrompem mais os bits, e nenhum laço de espera ativa consome a CPU.
+ * * Cada sensor usa a sua própria máquina de estados (até 4 por PIO, com o programa
+ * carregado uma única vez em cada PIO), então vários sensores são lidos ao mesmo
+ * tempo: um ciclo de aquisição dispara todos juntos e termina em ~25 ms, em vez de
+ * ~25 ms por sensor em série.
  */
 
  // --- Inclusão de Bibliotecas ---
  #include "dht22.h"         // Inclui a interface pública do próprio driver.
- #include "pico/stdlib.h"   // Inclui funções padrão do SDK do Pico, como `sleep_us` e `time_us_32`.
+ #include "pico/stdlib.h"   // Inclui funções padrão do SDK do Pico, como `add_alarm_in_us` e `time_us_32`.
  #include "hardware/gpio.h" // Inclui funções para controle dos pinos de Entrada/Saída de Propósito Geral (GPIO).
+ #include "hardware/pio.h"  // Inclui o controle das máquinas de estado da PIO.
+ #include "hardware/irq.h"  // Inclui o registro do handler da interrupção da PIO.
+ #include "hardware/sync.h" // Inclui `save_and_disable_interrupts` e `__wfi`.
+ #include "dht22.pio.h"     // Programa PIO gerado pelo pioasm a partir de `dht22.pio`.
  
  // --- Constantes de Temporização (Timing) para o Protocolo do DHT22 ---
  // Estes valores são críticos e baseados no datasheet do sensor.
  #define DHT22_START_SIGNAL_DELAY 18000  ///< Duração do sinal de início enviado pelo microcontrolador (18ms = 18000μs).
- #define DHT22_RESPONSE_WAIT_TIMEOUT 200 ///< Tempo máximo (em μs) para aguardar uma resposta do sensor após o sinal de início.
- #define DHT22_BIT_THRESHOLD 50          ///< Limite (em μs) para diferenciar um bit '0' de um bit '1'. Pulsos mais curtos que isso são '0', mais longos são '1'.
+ #define DHT22_TRANSFER_TIMEOUT_US 25000 ///< Tempo máximo de uma leitura completa: pulso de início (18ms) + resposta (160μs) + 40 bits (no máximo ~120μs cada).
+ #define DHT22_DATA_BITS 40              ///< Quantidade de bits enviados pelo sensor (umidade, temperatura e checksum).
  #define DHT22_MIN_INTERVAL_MS 2000      ///< Intervalo mínimo recomendado entre leituras (2s = 2000ms) para evitar autoaquecimento do sensor.
  
  /**
-  * @brief Estrutura para armazenar o estado interno e a configuração do driver DHT22.
-  * @details Esta estrutura mantém as informações vitais sobre o estado do driver
-  * entre as chamadas de função, como o pino utilizado e o tempo da última leitura.
-  * É definida como `static` para ser visível apenas dentro deste arquivo.
+  * @brief Estado interno e configuração de um sensor DHT22.
+  * @details Esta estrutura mantém as informações vitais sobre cada sensor entre as
+  * chamadas de função: o pino e a máquina de estados usados, a leitura em andamento,
+  * o cache da última leitura válida e as estatísticas de erro.
   */
  typedef struct {
-     uint32_t last_read_time_ms;  ///< Armazena o timestamp (em milissegundos) da última leitura bem-sucedida.
+     uint32_t last_read_time_ms;  ///< Armazena o timestamp (em milissegundos) do início da última leitura.
      uint32_t pin;                ///< Armazena o número do pino GPIO utilizado para a comunicação.
-     bool initialized;            ///< Flag que indica se a função `dht22_init` já foi chamada.
- } dht22_state_t;
+     PIO pio;                     ///< Bloco PIO onde o programa foi carregado.
+     uint sm;                     ///< Máquina de estados usada pelo sensor.
+     uint offset;                 ///< Endereço do programa na memória de instruções da PIO.
+     volatile bool busy;          ///< Há uma leitura agendada ou em andamento.
+     alarm_id_t alarm;            ///< Alarme pendente (início adiado ou timeout), 0 se nenhum.
+     dht22_callback_t callback;   ///< Função chamada ao final da leitura em andamento.
+     void *user_data;             ///< Ponteiro repassado ao callback.
+     dht22_reading_t cache;       ///< Última leitura válida e resultado da tentativa mais recente.
+     volatile bool fresh;         ///< Leitura nova ainda não consumida por `dht22_poll()`.
+     dht22_stats_t stats;         ///< Contadores de resultado por sensor.
+ } dht22_sensor_t;
  
- // Instância global e estática da estrutura de estado do driver.
- // 'static' garante que esta variável só seja acessível dentro deste arquivo.
- static dht22_state_t dht22_state = {0, 0, false};
+ // Tabela de sensores registrados. 'static' garante que só seja acessível dentro deste arquivo.
+ // Os campos escritos em interrupção são lidos pela aplicação com as interrupções desabilitadas.
+ static dht22_sensor_t dht22_sensors[DHT22_MAX_SENSORS];
+ static uint dht22_sensor_total = 0;
  
  /**
-  * @brief Aguarda uma mudança de estado em um pino GPIO, com um tempo limite.
-  * @details Função auxiliar para esperar até que um pino atinja um estado específico (alto ou baixo).
-  * Se o estado não for alcançado dentro do timeout, a função retorna um erro.
-  * É crucial para sincronizar a comunicação com o sensor.
-  * @param[in] pin O número do pino GPIO a ser monitorado.
-  * @param[in] state O estado esperado (`true` para alto, `false` para baixo).
-  * @param[in] timeout_us O tempo máximo de espera em microssegundos.
-  * @return Retorna `0` se o estado foi alcançado a tempo, ou `-1` se ocorreu um timeout.
+  * @brief Programa carregado em cada PIO (o mesmo programa atende as 4 SMs do bloco).
   */
- static inline int wait_for_pin_state(uint32_t pin, bool state, uint32_t timeout_us) {
-     uint32_t start = time_us_32(); // Captura o tempo inicial.
-     // Continua no loop enquanto o estado do pino for diferente do desejado.
-     while (gpio_get(pin) != state) {
-         // Verifica se o tempo decorrido excedeu o timeout.
-         if ((time_us_32() - start) > timeout_us) {
-             return -1; // Timeout atingido.
-         }
-     }
-     return 0; // Estado desejado alcançado com sucesso.
- }
- 
- /**
-  * @brief Implementação da função de inicialização do driver (visível publicamente).
-  */
- int dht22_init(uint32_t pin) {
-     // Inicializa o pino GPIO especificado para que o SDK do Pico possa usá-lo.
-     gpio_init(pin);
-     // Configura o pino com um resistor de pull-up interno. A linha de dados do DHT22 precisa
-     // ser mantida em nível alto quando ociosa. O pull-up garante isso sem a necessidade
-     // de um resistor externo. O segundo e terceiro parâmetros desativam o pull-down.
-     gpio_set_pulls(pin, true, false);
-     
-     // Armazena as informações de configuração na estrutura de estado global.
-     dht22_state.pin = pin;
-     dht22_state.last_read_time_ms = 0; // Zera o tempo da última leitura.
-     dht22_state.initialized = true;    // Marca o driver como inicializado.
-     
-     return DHT22_OK;
- }
- 
- /**
-  * @brief Envia o sinal de "início de comunicação" para o sensor DHT22.
-  * @details Para iniciar uma leitura, o microcontrolador deve primeiro derrubar a linha de dados
-  * para nível baixo por um período, e depois elevá-la, sinalizando ao sensor que
-  * deseja receber dados.
-  * @param[in] pin O número do pino GPIO conectado ao sensor.
-  * @return Sempre retorna `DHT22_OK`.
-  */
- static int dht22_send_start_signal(uint32_t pin) {
-     // Configura o pino como saída para poder controlar seu nível.
-     gpio_set_dir(pin, GPIO_OUT);
-     
-     // --- Sequência de início da comunicação ---
-     gpio_put(pin, 0);                         // 1. Coloca o pino em nível baixo.
-     sleep_us(DHT22_START_SIGNAL_DELAY);       // 2. Mantém em nível baixo por 18ms.
-     gpio_put(pin, 1);                         // 3. Coloca o pino em nível alto.
-     sleep_us(30);                             // 4. Mantém em nível alto por 30μs.
-     
-     // Configura o pino de volta para entrada para poder ler a resposta do sensor.
-     gpio_set_dir(pin, GPIO_IN);
-     
-     return DHT22_OK;
- }
- 
- /**
-  * @brief Aguarda e verifica a resposta de confirmação do sensor.
-  * @details Após o sinal de início, o sensor DHT22 deve responder com uma sequência
-  * específica de níveis baixo e alto para confirmar que está pronto para enviar os dados.
-  * Esta função verifica se essa sequência ocorre dentro do tempo esperado.
-  * @param[in] pin O número do pino GPIO.
-  * @return Retorna `DHT22_OK` se a resposta for válida, ou `DHT22_ERROR_TIMEOUT` se falhar.
-  */
- static int dht22_wait_for_response(uint32_t pin) {
-     // O sensor deve responder com: baixo por ~80μs, depois alto por ~80μs.
-     // Usamos a função wait_for_pin_state para verificar cada transição.
-     if (wait_for_pin_state(pin, 0, DHT22_RESPONSE_WAIT_TIMEOUT) != 0) return DHT22_ERROR_TIMEOUT;
-     if (wait_for_pin_state(pin, 1, DHT22_RESPONSE_WAIT_TIMEOUT) != 0) return DHT22_ERROR_TIMEOUT;
-     if (wait_for_pin_state(pin, 0, DHT22_RESPONSE_WAIT_TIMEOUT) != 0) return DHT22_ERROR_TIMEOUT;
-     
-     return DHT22_OK; // Sequência de resposta recebida com sucesso.
- }
+ static struct {
+     bool loaded;                 ///< Programa já está na memória de instruções deste bloco.
+     uint offset;                 ///< Endereço onde foi carregado.
+ } dht22_pio_program[NUM_PIOS];
  
  /**
-  * @brief Lê os 40 bits de dados transmitidos pelo sensor.
-  * @details Após a resposta, o sensor envia 5 bytes (40 bits) de dados. Cada bit é
-  * codificado pela duração de um pulso em nível alto. Esta função mede a duração
-  * de cada pulso para decodificar os bits.
-  * @param[in] pin O número do pino GPIO.
-  * @param[out] data Um buffer (array de 8 bits) para armazenar os 5 bytes de dados lidos.
-  * @return Retorna `DHT22_OK` se os 40 bits forem lidos, ou `DHT22_ERROR_TIMEOUT` se houver falha.
+  * @brief Estado do modo de aquisição contínua (`dht22_start()`).
   */
- static int dht22_read_data(uint32_t pin, uint8_t *data) {
-     for (int i = 0; i < 40; i++) {
-         // Cada bit começa com um pulso baixo de ~50μs. Primeiro, esperamos a linha ir para alto.
-         if (wait_for_pin_state(pin, 1, DHT22_RESPONSE_WAIT_TIMEOUT) != 0) return DHT22_ERROR_TIMEOUT;
-         
-         // Mede a duração do pulso em nível alto para determinar se é bit 0 ou 1.
-         uint32_t pulse_start = time_us_32();
-         if (wait_for_pin_state(pin, 0, DHT22_RESPONSE_WAIT_TIMEOUT) != 0) return DHT22_ERROR_TIMEOUT;
-         uint32_t pulse_length = time_us_32() - pulse_start;
-         
-         // Se o pulso alto durou mais que o limiar (50μs), é um bit '1'. Caso contrário, é '0'.
-         // O bit '0' já está no array `data` (inicializado com zeros), então só precisamos definir o bit '1'.
-         if (pulse_length > DHT22_BIT_THRESHOLD) {
-             // Define o bit apropriado no byte correto.
-             // `i / 8` calcula o índice do byte (0 a 4).
-             // `7 - (i % 8)` calcula a posição do bit dentro do byte (da esquerda para a direita).
-             data[i / 8] |= (1 << (7 - (i % 8)));
-         }
-     }
-     
-     return DHT22_OK;
- }
+ static struct {
+     volatile bool running;            ///< Modo contínuo ativo.
+     alarm_id_t alarm;                 ///< Alarme periódico que dispara os ciclos.
+     volatile uint32_t pending;        ///< Máscara dos sensores do ciclo atual que ainda não terminaram.
+     dht22_cycle_callback_t callback;  ///< Callback da aplicação ao final de cada ciclo.
+     void *user_data;                  ///< Ponteiro repassado ao callback.
+ } dht22_auto = {0};
  
  /**
   * @brief Verifica a integridade dos dados usando o checksum.
@@ -227,47 +153,466 @@
  }
  
  /**
-  * @brief Implementação da função principal de leitura do sensor DHT22 (visível publicamente).
+  * @brief Encerra a leitura em andamento de um sensor e entrega o resultado ao callback.
+  * @details Chamada apenas em contexto de interrupção (handler da PIO ou alarme de timeout).
+  * Atualiza as estatísticas e o cache; o sensor é liberado antes do callback para que
+  * ele possa agendar a próxima leitura.
+  * @param[in] s Sensor.
+  * @param[in] status Código de resultado da leitura.
+  * @param[in] temperature Temperatura em °C (válida apenas com `DHT22_OK`).
+  * @param[in] humidity Umidade em % (válida apenas com `DHT22_OK`).
   */
- int dht22_read(float *temperature, float *humidity) {
-     int result;
-     uint8_t data[5] = {0}; // Inicializa o buffer de dados com zeros.
+ static void dht22_finish(dht22_sensor_t *s, int status, float temperature, float humidity) {
+     dht22_callback_t callback = s->callback;
+     void *user_data = s->user_data;
+     
+     switch (status) {
+         case DHT22_OK:                 s->stats.ok++; break;
+         case DHT22_ERROR_CHECKSUM:     s->stats.checksum_errors++; break;
+         case DHT22_ERROR_TIMEOUT:      s->stats.timeouts++; break;
+         case DHT22_ERROR_INVALID_DATA: s->stats.invalid_data++; break;
+         default: break;
+     }
+     
+     s->cache.last_status = status;
+     if (status == DHT22_OK) {
+         s->cache.temperature = temperature;
+         s->cache.humidity = humidity;
+         s->cache.timestamp_ms = to_ms_since_boot(get_absolute_time());
+         s->cache.valid = true;
+         s->cache.consecutive_failures = 0;
+         s->fresh = true;
+     } else {
+         s->cache.consecutive_failures++;
+     }
+     
+     s->alarm = 0;
+     s->busy = false;
+     
+     if (callback) {
+         callback(status, temperature, humidity, user_data);
+     }
+ }
+ 
+ /**
+  * @brief Devolve a máquina de estados ao início do programa, com a linha liberada.
+  * @details Usada após um timeout, quando a SM ficou parada esperando uma borda
+  * que o sensor nunca gerou.
+  * @param[in] s Sensor.
+  */
+ static void dht22_reset_sm(dht22_sensor_t *s) {
+     pio_sm_set_enabled(s->pio, s->sm, false);
+     pio_sm_clear_fifos(s->pio, s->sm);                          // Descarta bits parciais.
+     pio_sm_restart(s->pio, s->sm);                              // Zera contadores de deslocamento e estados de espera.
+     pio_sm_exec(s->pio, s->sm, pio_encode_set(pio_pindirs, 0)); // Solta a linha (pull-up).
+     pio_sm_exec(s->pio, s->sm, pio_encode_jmp(s->offset));
+     pio_interrupt_clear(s->pio, s->sm);                         // Ignora uma conclusão que tenha chegado junto.
+     pio_sm_set_enabled(s->pio, s->sm, true);
+ }
+ 
+ /**
+  * @brief Alarme de timeout: o sensor não completou a transferência a tempo.
+  */
+ static int64_t dht22_timeout_cb(alarm_id_t id, void *user_data) {
+     dht22_sensor_t *s = (dht22_sensor_t *)user_data;
+     dht22_reset_sm(s);
+     dht22_finish(s, DHT22_ERROR_TIMEOUT, 0.0f, 0.0f);
+     return 0; // Não repete.
+ }
+ 
+ /**
+  * @brief Entrega à PIO os parâmetros da leitura e arma o timeout.
+  * @details A partir daqui a PIO gera o pulso de início e recebe os bits sozinha.
+  * @param[in] s Sensor.
+  */
+ static void dht22_begin_transfer(dht22_sensor_t *s) {
+     s->last_read_time_ms = to_ms_since_boot(get_absolute_time());
+     s->alarm = add_alarm_in_us(DHT22_TRANSFER_TIMEOUT_US, dht22_timeout_cb, s, true);
+     
+     pio_sm_put(s->pio, s->sm, DHT22_START_SIGNAL_DELAY - 1); // Duração do pulso de início.
+     pio_sm_put(s->pio, s->sm, DHT22_DATA_BITS - 1);          // Bits a receber.
+ }
+ 
+ /**
+  * @brief Alarme de início adiado: o intervalo mínimo de 2 s terminou.
+  */
+ static int64_t dht22_delayed_start_cb(alarm_id_t id, void *user_data) {
+     dht22_begin_transfer((dht22_sensor_t *)user_data);
+     return 0; // Não repete.
+ }
+ 
+ /**
+  * @brief Lê o resultado de uma SM que levantou a flag de conclusão.
+  * @details Lê as duas palavras da RX FIFO, reconstrói os 5 bytes, valida o checksum
+  * e converte para temperatura e umidade.
+  * @param[in] s Sensor.
+  */
+ static void dht22_complete(dht22_sensor_t *s) {
+     if (s->alarm) {
+         cancel_alarm(s->alarm);
+     }
+     
+     if (pio_sm_get_rx_fifo_level(s->pio, s->sm) < 2) {
+         dht22_reset_sm(s);
+         dht22_finish(s, DHT22_ERROR_TIMEOUT, 0.0f, 0.0f);
+         return;
+     }
+     
+     // Palavra 0: umidade (16 bits) | temperatura (16 bits). Palavra 1: checksum nos 8 bits baixos.
+     uint32_t word0 = pio_sm_get(s->pio, s->sm);
+     uint32_t word1 = pio_sm_get(s->pio, s->sm);
+     uint8_t data[5] = {
+         (uint8_t)(word0 >> 24), (uint8_t)(word0 >> 16),
+         (uint8_t)(word0 >> 8),  (uint8_t)word0,
+         (uint8_t)word1
+     };
+     
+     float temperature = 0.0f, humidity = 0.0f;
+     int result = dht22_verify_checksum(data);
+     if (result == DHT22_OK) {
+         result = dht22_convert_data(data, &temperature, &humidity);
+     }
+     dht22_finish(s, result, temperature, humidity);
+ }
+ 
+ /**
+  * @brief Handler da interrupção da PIO: uma ou mais SMs terminaram de receber os 40 bits.
+  * @details O mesmo handler atende as duas PIOs; a interrupção é compartilhada, então só
+  * são tratadas as flags das SMs que pertencem a sensores registrados.
+  */
+ static void dht22_pio_irq_handler(void) {
+     for (uint i = 0; i < dht22_sensor_total; i++) {
+         dht22_sensor_t *s = &dht22_sensors[i];
+         if (pio_interrupt_get(s->pio, s->sm)) {
+             pio_interrupt_clear(s->pio, s->sm);
+             dht22_complete(s);
+         }
+     }
+ }
+ 
+ /**
+  * @brief Reserva uma SM para um novo sensor, reaproveitando uma PIO que já tem o programa.
+  * @param[out] pio Bloco PIO escolhido.
+  * @param[out] sm Máquina de estados reservada.
+  * @param[out] offset Endereço do programa no bloco.
+  * @return `true` se conseguiu reservar.
+  */
+ static bool dht22_claim_sm(PIO *pio, uint *sm, uint *offset) {
+     // 1. Uma SM livre numa PIO onde o programa já está carregado (não gasta instruções).
+     for (uint i = 0; i < NUM_PIOS; i++) {
+         if (!dht22_pio_program[i].loaded) continue;
+         int free_sm = pio_claim_unused_sm(pio_get_instance(i), false);
+         if (free_sm >= 0) {
+             *pio = pio_get_instance(i);
+             *sm = (uint)free_sm;
+             *offset = dht22_pio_program[i].offset;
+             return true;
+         }
+     }
+     
+     // 2. Carrega o programa numa PIO com espaço e SM livre.
+     if (!pio_claim_free_sm_and_add_program(&dht22_program, pio, sm, offset)) {
+         return false;
+     }
+     uint index = pio_get_index(*pio);
+     dht22_pio_program[index].loaded = true;
+     dht22_pio_program[index].offset = *offset;
+     
+     // Primeira SM desta PIO: registra o handler (compartilhado) na linha IRQ 0 dela.
+     uint irq = pio_get_irq_num(*pio, 0);
+     irq_add_shared_handler(irq, dht22_pio_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+     irq_set_enabled(irq, true);
+     return true;
+ }
+ 
+ /**
+  * @brief Implementação do registro de um sensor (visível publicamente).
+  */
+ int dht22_add_sensor(uint32_t pin) {
+     if (dht22_sensor_total >= DHT22_MAX_SENSORS) {
+         return DHT22_ERROR_NO_RESOURCES;
+     }
      
-     // 1. Verifica se o driver foi inicializado.
-     if (!dht22_state.initialized) {
+     PIO pio;
+     uint sm, offset;
+     if (!dht22_claim_sm(&pio, &sm, &offset)) {
+         return DHT22_ERROR_NO_RESOURCES;
+     }
+     
+     // Configura o pino (pull-up interno, linha liberada) e inicia a SM, que fica
+     // parada esperando um pedido de leitura na TX FIFO.
+     dht22_program_init(pio, sm, offset, pin);
+     
+     // A flag "irq 0 rel" da SM n é a flag n; ela é roteada para a linha IRQ 0 da PIO.
+     pio_set_irq0_source_enabled(pio, (pio_interrupt_source_t)(pis_interrupt0 + sm), true);
+     
+     // Armazena as informações de configuração na tabela de sensores.
+     dht22_sensor_t *s = &dht22_sensors[dht22_sensor_total];
+     *s = (dht22_sensor_t){0};
+     s->pin = pin;
+     s->pio = pio;
+     s->sm = sm;
+     s->offset = offset;
+     s->cache.last_status = DHT22_ERROR_NOT_INITIALIZED; // Nenhuma tentativa ainda.
+     
+     return (int)dht22_sensor_total++;
+ }
+ 
+ /**
+  * @brief Implementação da função de inicialização do driver (visível publicamente).
+  */
+ int dht22_init(uint32_t pin) {
+     int id = dht22_add_sensor(pin);
+     return (id < 0) ? id : DHT22_OK;
+ }
+ 
+ /**
+  * @brief Implementação da leitura assíncrona de um sensor (visível publicamente).
+  */
+ int dht22_sensor_read_async(uint32_t id, dht22_callback_t callback, void *user_data) {
+     if (id >= dht22_sensor_total) {
          return DHT22_ERROR_NOT_INITIALIZED;
      }
+     dht22_sensor_t *s = &dht22_sensors[id];
      
-     // 2. Garante o intervalo mínimo de 2 segundos entre as leituras.
-     uint32_t current_time = to_ms_since_boot(get_absolute_time());
-     if ((current_time - dht22_state.last_read_time_ms) < DHT22_MIN_INTERVAL_MS && dht22_state.last_read_time_ms != 0) {
-         // Se chamada muito cedo, a função bloqueia (aguarda) pelo tempo restante.
-         sleep_ms(DHT22_MIN_INTERVAL_MS - (current_time - dht22_state.last_read_time_ms));
+     // Reserva o sensor de forma atômica em relação às interrupções que o liberam.
+     uint32_t irq_state = save_and_disable_interrupts();
+     if (s->busy || dht22_auto.running) {
+         restore_interrupts(irq_state);
+         return DHT22_ERROR_BUSY;
      }
+     s->busy = true;
+     s->callback = callback;
+     s->user_data = user_data;
      
-     // --- Executa a sequência completa de comunicação ---
+     // Respeita o intervalo mínimo de 2 s sem bloquear: se for cedo demais, a
+     // transferência começa num alarme quando o intervalo terminar.
+     uint32_t elapsed = to_ms_since_boot(get_absolute_time()) - s->last_read_time_ms;
+     if (s->last_read_time_ms != 0 && elapsed < DHT22_MIN_INTERVAL_MS) {
+         s->alarm = add_alarm_in_ms(DHT22_MIN_INTERVAL_MS - elapsed, dht22_delayed_start_cb, s, true);
+     } else {
+         dht22_begin_transfer(s);
+     }
+     restore_interrupts(irq_state);
      
-     // 3. Envia o sinal de início.
-     result = dht22_send_start_signal(dht22_state.pin);
-     if (result != DHT22_OK) return result;
+     return DHT22_OK;
+ }
+ 
+ /**
+  * @brief Implementação da leitura assíncrona do sensor principal (visível publicamente).
+  */
+ int dht22_read_async(dht22_callback_t callback, void *user_data) {
+     return dht22_sensor_read_async(0, callback, user_data);
+ }
+ 
+ /**
+  * @brief Contexto da leitura bloqueante construída sobre a assíncrona.
+  */
+ typedef struct {
+     volatile bool done;
+     int status;
+     float temperature;
+     float humidity;
+ } dht22_sync_ctx_t;
+ 
+ /**
+  * @brief Callback usado por `dht22_read()` para receber o resultado.
+  */
+ static void dht22_sync_cb(int status, float temperature, float humidity, void *user_data) {
+     dht22_sync_ctx_t *ctx = (dht22_sync_ctx_t *)user_data;
+     ctx->status = status;
+     ctx->temperature = temperature;
+     ctx->humidity = humidity;
+     ctx->done = true;
+ }
+ 
+ /**
+  * @brief Implementação da função principal de leitura do sensor DHT22 (visível publicamente).
+  */
+ int dht22_read(float *temperature, float *humidity) {
+     dht22_sync_ctx_t ctx = { .done = false };
      
-     // 4. Aguarda e valida a resposta do sensor.
-     result = dht22_wait_for_response(dht22_state.pin);
+     int result = dht22_read_async(dht22_sync_cb, &ctx);
      if (result != DHT22_OK) return result;
      
-     // 5. Lê os 40 bits de dados.
-     result = dht22_read_data(dht22_state.pin, data);
-     if (result != DHT22_OK) return result;
+     // A CPU dorme entre interrupções; a PIO faz a comunicação.
+     while (!ctx.done) {
+         __wfi();
+     }
      
-     // Atualiza o timestamp da última leitura IMEDIATAMENTE após a comunicação,
-     // para garantir a temporização mais precisa possível para a próxima chamada.
-     dht22_state.last_read_time_ms = to_ms_since_boot(get_absolute_time());
+     if (ctx.status == DHT22_OK) {
+         *temperature = ctx.temperature;
+         *humidity = ctx.humidity;
+     }
+     return ctx.status;
+ }
+ 
+ /**
+  * @brief Fim da leitura de um sensor dentro de um ciclo do modo contínuo.
+  * @details Quando o último sensor do ciclo termina, entrega o retrato de todos à aplicação.
+  */
+ static void dht22_cycle_sensor_cb(int status, float temperature, float humidity, void *user_data) {
+     uint id = (uint)(uintptr_t)user_data;
+     dht22_auto.pending &= ~(1u << id);
      
-     // 6. Verifica a integridade dos dados com o checksum.
-     result = dht22_verify_checksum(data);
-     if (result != DHT22_OK) return result;
+     if (dht22_auto.pending == 0 && dht22_auto.callback) {
+         dht22_reading_t readings[DHT22_MAX_SENSORS];
+         uint32_t now = to_ms_since_boot(get_absolute_time());
+         for (uint i = 0; i < dht22_sensor_total; i++) {
+             readings[i] = dht22_sensors[i].cache;
+             readings[i].age_ms = readings[i].valid ? now - readings[i].timestamp_ms : 0;
+         }
+         dht22_auto.callback(readings, dht22_sensor_total, dht22_auto.user_data);
+     }
+ }
+ 
+ /**
+  * @brief Alarme periódico do modo contínuo: dispara todos os sensores juntos.
+  * @details Os pedidos são escritos nas TX FIFOs em sequência, com as interrupções
+  * desabilitadas, então os pulsos de início começam com poucos µs de diferença e
+  * todas as transferências terminam na mesma janela de ~25 ms. Um sensor que falhou
+  * é repetido naturalmente no ciclo seguinte, 2 s depois (o mínimo permitido).
+  * @return Reagenda o alarme para 2 s após o disparo anterior enquanto o modo estiver ativo.
+  */
+ static int64_t dht22_cycle_cb(alarm_id_t id, void *user_data) {
+     if (!dht22_auto.running) {
+         dht22_auto.alarm = 0;
+         return 0;
+     }
+     
+     uint32_t irq_state = save_and_disable_interrupts();
+     uint32_t started = 0;
+     for (uint i = 0; i < dht22_sensor_total; i++) {
+         dht22_sensor_t *s = &dht22_sensors[i];
+         if (s->busy) continue; // Leitura anterior ainda em andamento (não deve ocorrer).
+         s->busy = true;
+         s->callback = dht22_cycle_sensor_cb;
+         s->user_data = (void *)(uintptr_t)i;
+         started |= 1u << i;
+     }
+     dht22_auto.pending = started;
+     for (uint i = 0; i < dht22_sensor_total; i++) {
+         if (started & (1u << i)) {
+             dht22_begin_transfer(&dht22_sensors[i]);
+         }
+     }
+     restore_interrupts(irq_state);
      
-     // 7. Converte os dados brutos para temperatura e umidade.
-     // Esta é a última etapa, e seu resultado é retornado diretamente.
-     return dht22_convert_data(data, temperature, humidity);
- }
\ No newline at end of file
+     return -(int64_t)DHT22_MIN_INTERVAL_MS * 1000; // Negativo: relativo ao disparo anterior, sem deriva.
+ }
+ 
+ /**
+  * @brief Implementação do início da aquisição contínua (visível publicamente).
+  */
+ int dht22_start(dht22_cycle_callback_t callback, void *user_data) {
+     if (dht22_sensor_total == 0) {
+         return DHT22_ERROR_NOT_INITIALIZED;
+     }
+     if (dht22_auto.running) {
+         return DHT22_OK; // Já está rodando.
+     }
+     for (uint i = 0; i < dht22_sensor_total; i++) {
+         if (dht22_sensors[i].busy) {
+             return DHT22_ERROR_BUSY;
+         }
+     }
+     
+     dht22_auto.callback = callback;
+     dht22_auto.user_data = user_data;
+     dht22_auto.running = true;
+     
+     // Primeiro ciclo imediato; os seguintes a cada 2 s.
+     dht22_auto.alarm = add_alarm_in_ms(1, dht22_cycle_cb, NULL, true);
+     return DHT22_OK;
+ }
+ 
+ /**
+  * @brief Implementação da parada da aquisição contínua (visível publicamente).
+  * @details Leituras já disparadas ainda terminam e atualizam o cache.
+  */
+ void dht22_stop(void) {
+     dht22_auto.running = false;
+     if (dht22_auto.alarm > 0) {
+         cancel_alarm(dht22_auto.alarm);
+     }
+     dht22_auto.alarm = 0;
+ }
+ 
+ /**
+  * @brief Copia o cache de um sensor com as interrupções desabilitadas e calcula a idade.
+  * @param[in] id Índice do sensor (já validado).
+  * @param[out] reading Destino.
+  * @param[in] consume Se `true`, marca a leitura nova como consumida.
+  * @return Se havia leitura nova não consumida.
+  */
+ static bool dht22_copy_cache(uint32_t id, dht22_reading_t *reading, bool consume) {
+     dht22_sensor_t *s = &dht22_sensors[id];
+     
+     uint32_t irq_state = save_and_disable_interrupts();
+     *reading = s->cache;
+     bool fresh = s->fresh;
+     if (consume) {
+         s->fresh = false;
+     }
+     restore_interrupts(irq_state);
+     
+     reading->age_ms = reading->valid ? to_ms_since_boot(get_absolute_time()) - reading->timestamp_ms : 0;
+     return fresh;
+ }
+ 
+ /**
+  * @brief Implementação da consulta ao cache de um sensor (visível publicamente).
+  */
+ bool dht22_sensor_get_latest(uint32_t id, dht22_reading_t *reading) {
+     if (id >= dht22_sensor_total) {
+         *reading = (dht22_reading_t){ .last_status = DHT22_ERROR_NOT_INITIALIZED };
+         return false;
+     }
+     dht22_copy_cache(id, reading, false);
+     return reading->valid;
+ }
+ 
+ /**
+  * @brief Implementação da consulta de leitura nova de um sensor (visível publicamente).
+  */
+ bool dht22_sensor_poll(uint32_t id, dht22_reading_t *reading) {
+     if (id >= dht22_sensor_total) {
+         *reading = (dht22_reading_t){ .last_status = DHT22_ERROR_NOT_INITIALIZED };
+         return false;
+     }
+     return dht22_copy_cache(id, reading, true);
+ }
+ 
+ /**
+  * @brief Implementação da consulta ao cache do sensor principal (visível publicamente).
+  */
+ bool dht22_get_latest(dht22_reading_t *reading) {
+     return dht22_sensor_get_latest(0, reading);
+ }
+ 
+ /**
+  * @brief Implementação da consulta de leitura nova do sensor principal (visível publicamente).
+  */
+ bool dht22_poll(dht22_reading_t *reading) {
+     return dht22_sensor_poll(0, reading);
+ }
+ 
+ /**
+  * @brief Implementação da consulta às estatísticas de um sensor (visível publicamente).
+  */
+ bool dht22_sensor_stats(uint32_t id, dht22_stats_t *stats) {
+     if (id >= dht22_sensor_total) {
+         return false;
+     }
+     uint32_t irq_state = save_and_disable_interrupts();
+     *stats = dht22_sensors[id].stats;
+     restore_interrupts(irq_state);
+     return true;
+ }
+ 
+ /**
+  * @brief Implementação da consulta ao número de sensores registrados (visível publicamente).
+  */
+ uint32_t dht22_sensor_count(void) {
+     return dht22_sensor_total;
+ }
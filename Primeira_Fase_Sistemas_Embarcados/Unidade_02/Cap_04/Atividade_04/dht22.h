@@ -37,6 +37,7 @@
  #define DHT22_H
  
  #include <stdint.h>
+ #include <stdbool.h>
  
  /**
   * @brief Códigos de retorno para as operações do driver DHT22.
@@ -49,16 +50,37 @@
  #define DHT22_ERROR_TIMEOUT -2            ///< Timeout durante a comunicação. O sensor não respondeu no tempo esperado, o que pode indicar um problema de conexão ou falha do sensor.
  #define DHT22_ERROR_INVALID_DATA -3       ///< Os dados recebidos estão fora dos limites físicos esperados (ex: umidade > 100%). Isso pode indicar uma leitura incorreta ou falha do sensor.
  #define DHT22_ERROR_NOT_INITIALIZED -4    ///< Tentativa de uso do driver sem antes chamar a função de inicialização `dht22_init()`.
+ #define DHT22_ERROR_BUSY -5               ///< Já existe uma leitura agendada ou em andamento; aguarde o callback dela.
+ #define DHT22_ERROR_NO_RESOURCES -6       ///< Não há máquina de estados/memória de instruções livre nas PIOs, ou a tabela de sensores está cheia.
+ 
+ /** @brief Número máximo de sensores simultâneos (4 SMs em cada uma das 2 PIOs). */
+ #define DHT22_MAX_SENSORS 8
+ 
+ /**
+  * @brief Função chamada ao final de uma leitura assíncrona.
+  * @details É executada em contexto de interrupção (handler da PIO ou do alarme de timeout):
+  * deve ser curta e não pode bloquear. `temperature` e `humidity` só são válidos se
+  * `status == DHT22_OK`.
+  * @param[in] status Um dos códigos `DHT22_OK` / `DHT22_ERROR_*`.
+  * @param[in] temperature Temperatura em graus Celsius.
+  * @param[in] humidity Umidade relativa em percentual.
+  * @param[in] user_data Ponteiro fornecido em `dht22_read_async()`.
+  */
+ typedef void (*dht22_callback_t)(int status, float temperature, float humidity, void *user_data);
  
  /**
   * @brief Inicializa o driver do sensor DHT22.
   * * @details Esta função deve ser chamada obrigatoriamente antes de qualquer tentativa de leitura do sensor.
   * Ela realiza as seguintes configurações essenciais:
-  * - Configura o pino GPIO especificado como uma entrada.
+  * - Carrega o programa `dht22.pio` em uma PIO com máquina de estados livre e entrega o pino a ela.
   * - Ativa o resistor de pull-up interno no pino GPIO, que é necessário para manter a linha de dados em nível alto quando o sensor não está transmitindo.
+  * - Registra o handler (compartilhado) da interrupção da PIO que sinaliza o fim de cada leitura.
   * - Inicializa a estrutura de estado interno do driver.
+  * * Equivale a `dht22_add_sensor(pin)` para o primeiro sensor (id 0), que é o usado por
+  * `dht22_read()`, `dht22_read_async()`, `dht22_get_latest()` e `dht22_poll()`.
   * * @param[in] pin O número do pino GPIO do Raspberry Pi Pico onde o pino de dados do sensor DHT22 está conectado.
-  * * @return Retorna `DHT22_OK` se a inicialização for bem-sucedida.
+  * * @return Retorna `DHT22_OK` se a inicialização for bem-sucedida, ou `DHT22_ERROR_NO_RESOURCES`
+  * se não houver máquina de estados ou memória de instruções livre nas PIOs.
   * * @note O pino de dados do sensor DHT22 deve estar conectado ao pino GPIO especificado. Além disso,
   * o sensor requer alimentação (VCC, tipicamente 3.3V a 5.5V) e uma conexão com o terra (GND) para funcionar.
   */
@@ -77,6 +99,8 @@
   * conforme recomendado pelo fabricante do sensor para garantir a estabilidade das medições.
   * Se esta função for chamada antes de 2 segundos terem passado desde a última leitura,
   * ela aguardará internamente o tempo necessário.
+  * * É uma versão bloqueante de `dht22_read_async()`: a comunicação é feita pela PIO e a CPU
+  * fica em WFI (dormindo) até a interrupção de conclusão, sem laços de espera ativa.
   * * @param[out] temperature Ponteiro para uma variável do tipo `float` onde o valor da temperatura em graus Celsius será armazenado.
   * A faixa de medição é de -40°C a 80°C.
   * @param[out] humidity    Ponteiro para uma variável do tipo `float` onde o valor da umidade relativa em percentual será armazenado.
@@ -113,4 +137,133 @@
   */
  int dht22_read(float *temperature, float *humidity);
  
- #endif // DHT22_H
\ No newline at end of file
+ /**
+  * @brief Dispara uma leitura sem bloquear; o resultado chega pelo callback.
+  * @details A PIO gera o pulso de início, amostra os 40 bits e levanta uma interrupção;
+  * o driver valida o checksum e converte os valores antes de chamar `callback`.
+  * Se o intervalo mínimo de 2 s desde a leitura anterior ainda não passou, a
+  * transferência é agendada para o fim do intervalo (a função retorna imediatamente).
+  * Se o sensor não completar a transferência em 25 ms, o callback recebe `DHT22_ERROR_TIMEOUT`.
+  * @param[in] callback Função chamada ao final (contexto de interrupção). Pode ser `NULL`.
+  * @param[in] user_data Ponteiro repassado ao callback.
+  * @return `DHT22_OK` se a leitura foi disparada/agendada, `DHT22_ERROR_BUSY` se já houver
+  * uma em andamento, ou `DHT22_ERROR_NOT_INITIALIZED`.
+  */
+ int dht22_read_async(dht22_callback_t callback, void *user_data);
+ 
+ /**
+  * @brief Registra mais um sensor, cada um com a sua máquina de estados.
+  * @details O programa PIO é carregado uma única vez por bloco PIO e compartilhado pelas
+  * SMs dele, então até 4 sensores cabem em uma PIO (8 nas duas, se a outra estiver livre).
+  * O primeiro sensor registrado (por aqui ou por `dht22_init()`) recebe o id 0.
+  * @param[in] pin Pino GPIO da linha de dados do sensor.
+  * @return O id do sensor (>= 0) ou `DHT22_ERROR_NO_RESOURCES`.
+  */
+ int dht22_add_sensor(uint32_t pin);
+ 
+ /**
+  * @brief Número de sensores registrados.
+  */
+ uint32_t dht22_sensor_count(void);
+ 
+ /**
+  * @brief Versão de `dht22_read_async()` para um sensor específico.
+  * @details O intervalo mínimo de 2 s é controlado por sensor. Sensores diferentes podem
+  * ter leituras em andamento ao mesmo tempo.
+  * @param[in] id Id retornado por `dht22_add_sensor()`.
+  * @param[in] callback Função chamada ao final (contexto de interrupção). Pode ser `NULL`.
+  * @param[in] user_data Ponteiro repassado ao callback.
+  * @return `DHT22_OK`, `DHT22_ERROR_BUSY` ou `DHT22_ERROR_NOT_INITIALIZED` (id inválido).
+  */
+ int dht22_sensor_read_async(uint32_t id, dht22_callback_t callback, void *user_data);
+ 
+ /**
+  * @brief Última leitura válida guardada pelo driver (uma por sensor).
+  * @details Preenchida por `dht22_get_latest()` / `dht22_poll()` e variantes `dht22_sensor_*`.
+  * Os valores de temperatura e umidade são sempre os da última leitura com `DHT22_OK`;
+  * falhas posteriores não os apagam, apenas atualizam `last_status` e `consecutive_failures`.
+  */
+ typedef struct {
+     float temperature;             ///< Temperatura em °C da última leitura válida.
+     float humidity;                ///< Umidade em % da última leitura válida.
+     uint32_t timestamp_ms;         ///< Instante (ms desde o boot) da última leitura válida.
+     uint32_t age_ms;               ///< Idade da leitura no momento da consulta.
+     bool valid;                    ///< `false` até a primeira leitura válida.
+     int last_status;               ///< Resultado da tentativa mais recente (`DHT22_OK` ou erro).
+     uint32_t consecutive_failures; ///< Tentativas com erro desde a última leitura válida.
+ } dht22_reading_t;
+ 
+ /**
+  * @brief Contadores de resultado de um sensor, acumulados desde o registro.
+  */
+ typedef struct {
+     uint32_t ok;                   ///< Leituras válidas.
+     uint32_t timeouts;             ///< Sensor não respondeu ou não completou os 40 bits.
+     uint32_t checksum_errors;      ///< Bits corrompidos na linha.
+     uint32_t invalid_data;         ///< Valores fora da faixa do sensor.
+ } dht22_stats_t;
+ 
+ /**
+  * @brief Função chamada ao final de cada ciclo do modo contínuo.
+  * @details Executada em contexto de interrupção, quando o último sensor do ciclo termina.
+  * @param[in] readings Cache de cada sensor (índice = id), com `age_ms` já calculado.
+  * @param[in] count Número de sensores.
+  * @param[in] user_data Ponteiro fornecido em `dht22_start()`.
+  */
+ typedef void (*dht22_cycle_callback_t)(const dht22_reading_t *readings, uint32_t count, void *user_data);
+ 
+ /**
+  * @brief Inicia a aquisição contínua em segundo plano de todos os sensores registrados.
+  * @details A cada 2 s (o mínimo permitido) um alarme dispara todos os sensores ao mesmo
+  * tempo, e o ciclo inteiro termina em ~25 ms, qualquer que seja o número de sensores.
+  * Tudo ocorre em alarmes e na interrupção da PIO. Uma falha (timeout, checksum) é
+  * repetida automaticamente no ciclo seguinte, mantendo a última leitura válida em cache.
+  * Enquanto o modo contínuo estiver ativo, as leituras avulsas (`dht22_read()`,
+  * `dht22_read_async()`, `dht22_sensor_read_async()`) retornam `DHT22_ERROR_BUSY`.
+  * @param[in] callback Chamado ao final de cada ciclo com o cache de todos os sensores. Pode ser `NULL`.
+  * @param[in] user_data Ponteiro repassado ao callback.
+  * @return `DHT22_OK`, `DHT22_ERROR_BUSY` se houver leitura avulsa em andamento, ou
+  * `DHT22_ERROR_NOT_INITIALIZED` se nenhum sensor foi registrado.
+  */
+ int dht22_start(dht22_cycle_callback_t callback, void *user_data);
+ 
+ /**
+  * @brief Encerra a aquisição contínua. Leituras em andamento ainda terminam e atualizam o cache.
+  */
+ void dht22_stop(void);
+ 
+ /**
+  * @brief Copia a última leitura válida de um sensor, sem esperar.
+  * @param[in] id Id do sensor.
+  * @param[out] reading Destino; `age_ms` é calculado no momento da chamada.
+  * @return `true` se já existe alguma leitura válida.
+  */
+ bool dht22_sensor_get_latest(uint32_t id, dht22_reading_t *reading);
+ 
+ /**
+  * @brief Consulta não bloqueante de leitura nova de um sensor.
+  * @param[in] id Id do sensor.
+  * @param[out] reading Destino (preenchido mesmo quando não há leitura nova).
+  * @return `true` somente se chegou uma leitura válida desde a última consulta deste sensor.
+  */
+ bool dht22_sensor_poll(uint32_t id, dht22_reading_t *reading);
+ 
+ /**
+  * @brief Copia as estatísticas de erro de um sensor.
+  * @param[in] id Id do sensor.
+  * @param[out] stats Destino.
+  * @return `false` se o id for inválido.
+  */
+ bool dht22_sensor_stats(uint32_t id, dht22_stats_t *stats);
+ 
+ /**
+  * @brief `dht22_sensor_get_latest()` para o sensor principal (id 0).
+  */
+ bool dht22_get_latest(dht22_reading_t *reading);
+ 
+ /**
+  * @brief `dht22_sensor_poll()` para o sensor principal (id 0).
+  */
+ bool dht22_poll(dht22_reading_t *reading);
+ 
+ #endif // DHT22_H
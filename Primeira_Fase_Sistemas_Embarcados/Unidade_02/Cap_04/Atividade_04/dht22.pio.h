@@ -0,0 +1,79 @@
+// -------------------------------------------------- //
+// This file is autogenerated by pioasm; do not edit! //
+// -------------------------------------------------- //
+
+#pragma once
+
+#if !PICO_NO_HARDWARE
+#include "hardware/pio.h"
+#endif
+
+// ----- //
+// dht22 //
+// ----- //
+
+#define dht22_wrap_target 0
+#define dht22_wrap 18
+#define dht22_pio_version 0
+
+static const uint16_t dht22_program_instructions[] = {
+            //     .wrap_target
+    0x80a0, //  0: pull   block
+    0x6020, //  1: out    x, 32
+    0x80a0, //  2: pull   block
+    0xe081, //  3: set    pindirs, 1
+    0x0044, //  4: jmp    x--, 4
+    0xe080, //  5: set    pindirs, 0
+    0x6040, //  6: out    y, 32
+    0x20a0, //  7: wait   1 pin, 0
+    0x2020, //  8: wait   0 pin, 0
+    0x20a0, //  9: wait   1 pin, 0
+    0x2020, // 10: wait   0 pin, 0
+    0x20a0, // 11: wait   1 pin, 0
+    0xbf42, // 12: nop                           [31]
+    0xa742, // 13: nop                           [7]
+    0x4001, // 14: in     pins, 1
+    0x2020, // 15: wait   0 pin, 0
+    0x008b, // 16: jmp    y--, 11
+    0x8020, // 17: push   block
+    0xc010, // 18: irq    nowait 0 rel
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program dht22_program = {
+    .instructions = dht22_program_instructions,
+    .length = 19,
+    .origin = -1,
+    .pio_version = dht22_pio_version,
+#if PICO_PIO_VERSION > 0
+    .used_gpio_ranges = 0x0
+#endif
+};
+
+static inline pio_sm_config dht22_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + dht22_wrap_target, offset + dht22_wrap);
+    return c;
+}
+
+#include "hardware/clocks.h"
+static inline void dht22_program_init(PIO pio, uint sm, uint offset, uint pin) {
+    pio_sm_config c = dht22_program_get_default_config(offset);
+    // Linha de dados: entrada com pull-up; a saída só é habilitada para gerar o pulso de início.
+    pio_gpio_init(pio, pin);
+    gpio_pull_up(pin);
+    pio_sm_set_pins_with_mask(pio, sm, 0, 1u << pin);
+    pio_sm_set_pindirs_with_mask(pio, sm, 0, 1u << pin);
+    sm_config_set_set_pins(&c, pin, 1);
+    sm_config_set_in_pins(&c, pin);
+    // Bits chegam do mais significativo para o menos; autopush a cada 32 bits.
+    sm_config_set_in_shift(&c, false, true, 32);
+    sm_config_set_out_shift(&c, true, false, 32);
+    // 1 ciclo = 1 us.
+    sm_config_set_clkdiv(&c, (float)clock_get_hz(clk_sys) / 1000000.0f);
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file sensor_sched.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Implementação do escalonador de sensores com taxas independentes.
+ */
+
+#include "sensor_sched.h"
+#include "pico/stdlib.h"
+
+/** @brief Estado de execução de um sensor registrado. */
+typedef struct {
+    const sensor_driver_t *driver;
+    uint64_t next_trigger_us;    ///< Próximo disparo (grade fixa: não acumula atraso).
+    uint64_t collect_at_us;      ///< Quando coletar a medição pendente.
+    bool pending;                ///< Disparado e aguardando a latência de conversão.
+} sensor_slot_t;
+
+static sensor_slot_t slots[SENSOR_SCHED_MAX_SENSORS];
+static sensor_snapshot_t snapshot;
+
+int sensor_sched_register(const sensor_driver_t *driver) {
+    if (snapshot.count >= SENSOR_SCHED_MAX_SENSORS) {
+        return -1;
+    }
+    uint32_t id = snapshot.count;
+    slots[id] = (sensor_slot_t){ .driver = driver, .next_trigger_us = time_us_64() };
+    snapshot.sensors[id] = (sensor_sample_t){0};
+    snapshot.count++;
+    return (int)id;
+}
+
+/**
+ * @brief Coleta a medição de um sensor e publica no retrato.
+ * @param id Índice do sensor.
+ */
+static void collect(uint32_t id) {
+    const sensor_driver_t *drv = slots[id].driver;
+    sensor_sample_t *sample = &snapshot.sensors[id];
+
+    float values[SENSOR_SCHED_MAX_VALUES] = {0};
+    uint32_t sample_time_ms = to_ms_since_boot(get_absolute_time());
+
+    if (drv->collect(drv->ctx, values, &sample_time_ms)) {
+        for (int i = 0; i < SENSOR_SCHED_MAX_VALUES; i++) {
+            sample->values[i] = values[i];
+        }
+        sample->sample_time_ms = sample_time_ms;
+        sample->samples++;
+        sample->valid = true;
+        snapshot.version++;
+        snapshot.publish_time_ms = to_ms_since_boot(get_absolute_time());
+    } else {
+        sample->failures++;
+    }
+}
+
+uint64_t sensor_sched_run(void) {
+    uint64_t now = time_us_64();
+    uint64_t next = UINT64_MAX;
+
+    for (uint32_t id = 0; id < snapshot.count; id++) {
+        sensor_slot_t *slot = &slots[id];
+        const sensor_driver_t *drv = slot->driver;
+
+        // 1. Coleta pendente cuja latência de conversão já passou.
+        if (slot->pending && now >= slot->collect_at_us) {
+            slot->pending = false;
+            collect(id);
+        }
+
+        // 2. Novo disparo no prazo. Se o laço atrasou mais de um período, pula os disparos
+        //    perdidos em vez de executá-los em rajada.
+        if (!slot->pending && now >= slot->next_trigger_us) {
+            uint64_t period_us = (uint64_t)drv->period_ms * 1000u;
+            slot->next_trigger_us += period_us;
+            if (slot->next_trigger_us <= now) {
+                slot->next_trigger_us = now + period_us;
+            }
+
+            if (drv->trigger && !drv->trigger(drv->ctx)) {
+                snapshot.sensors[id].failures++;
+            } else if (drv->trigger == NULL || drv->latency_us == 0) {
+                collect(id);
+            } else {
+                slot->pending = true;
+                slot->collect_at_us = now + drv->latency_us;
+            }
+        }
+
+        // 3. Próximo instante em que este sensor precisa de atenção.
+        uint64_t due = slot->pending ? slot->collect_at_us : slot->next_trigger_us;
+        if (due < next) {
+            next = due;
+        }
+    }
+
+    return next;
+}
+
+void sensor_sched_snapshot(sensor_snapshot_t *out) {
+    // Retrato só é escrito por sensor_sched_run(), no mesmo contexto da aplicação.
+    *out = snapshot;
+}
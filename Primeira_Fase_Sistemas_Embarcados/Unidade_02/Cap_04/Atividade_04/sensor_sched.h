@@ -0,0 +1,92 @@
+/**
+ * @file sensor_sched.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Escalonador de sensores com taxas independentes e retrato (snapshot) com data e hora.
+ *
+ * @details
+ * Cada sensor é descrito por um `sensor_driver_t` que declara o seu período de amostragem
+ * e a latência de conversão (tempo entre disparar a medição e o resultado estar pronto).
+ * O escalonador, chamado do laço principal, dispara e coleta cada sensor no seu próprio
+ * ritmo, sem que um sensor lento (DHT22, 0,5 Hz) segure os rápidos (MQ-2, 20 Hz).
+ *
+ * Cada coleta bem-sucedida atualiza a entrada do sensor no retrato e incrementa a
+ * versão do retrato. A aplicação copia o retrato inteiro com `sensor_sched_snapshot()`
+ * e sempre vê um conjunto coerente de valores, cada um com o instante da sua amostra.
+ *
+ * Fluxo de um sensor:
+ * @code
+ *   t = próximo disparo ──trigger()──▶ espera latency_us ──collect()──▶ retrato
+ *                    └──────────────── period_ms ────────────────┘
+ * @endcode
+ * Sensores com `trigger == NULL` ou `latency_us == 0` são coletados no mesmo instante
+ * do disparo (ex.: uma conversão única do ADC, ~2 µs).
+ */
+
+#ifndef SENSOR_SCHED_H
+#define SENSOR_SCHED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SENSOR_SCHED_MAX_SENSORS 8   ///< Sensores registrados ao mesmo tempo.
+#define SENSOR_SCHED_MAX_VALUES  2   ///< Valores produzidos por sensor (ex.: temperatura e umidade).
+
+/** @brief Descrição de um sensor para o escalonador (constante, fornecida pelo driver). */
+typedef struct {
+    const char *name;            ///< Nome para diagnóstico.
+    uint32_t period_ms;          ///< Intervalo entre disparos.
+    uint32_t latency_us;         ///< Tempo entre o disparo e o resultado estar pronto.
+    /**
+     * @brief Inicia uma medição (opcional).
+     * @return `false` se não foi possível disparar agora (tenta no próximo período).
+     */
+    bool (*trigger)(void *ctx);
+    /**
+     * @brief Lê o resultado da medição disparada.
+     * @param values Destino com SENSOR_SCHED_MAX_VALUES posições.
+     * @param sample_time_ms Instante da amostra (ms desde o boot); já vem preenchido com o
+     *        instante da coleta e pode ser corrigido pelo driver (ex.: leitura em cache).
+     * @return `false` se a medição falhou (o retrato mantém o último valor bom).
+     */
+    bool (*collect)(void *ctx, float *values, uint32_t *sample_time_ms);
+    void *ctx;                   ///< Ponteiro repassado a trigger/collect.
+} sensor_driver_t;
+
+/** @brief Último valor bom de um sensor dentro do retrato. */
+typedef struct {
+    float values[SENSOR_SCHED_MAX_VALUES]; ///< Valores convertidos.
+    uint32_t sample_time_ms;     ///< Instante da amostra.
+    uint32_t samples;            ///< Coletas bem-sucedidas.
+    uint32_t failures;           ///< Coletas com falha (ou disparos recusados).
+    bool valid;                  ///< `false` até a primeira coleta bem-sucedida.
+} sensor_sample_t;
+
+/** @brief Retrato coerente de todos os sensores. */
+typedef struct {
+    sensor_sample_t sensors[SENSOR_SCHED_MAX_SENSORS]; ///< Índice = id retornado no registro.
+    uint32_t count;              ///< Sensores registrados.
+    uint32_t version;            ///< Incrementada a cada coleta bem-sucedida.
+    uint32_t publish_time_ms;    ///< Instante da última atualização.
+} sensor_snapshot_t;
+
+/**
+ * @brief Registra um sensor. O primeiro disparo ocorre na próxima chamada de `sensor_sched_run()`.
+ * @param driver Descrição do sensor (deve permanecer válida).
+ * @return Id do sensor (índice no retrato) ou -1 se a tabela estiver cheia.
+ */
+int sensor_sched_register(const sensor_driver_t *driver);
+
+/**
+ * @brief Dispara e coleta os sensores cujo prazo já chegou. Não bloqueia.
+ * @return Instante absoluto (µs desde o boot) do próximo prazo, para a aplicação dormir até lá.
+ */
+uint64_t sensor_sched_run(void);
+
+/**
+ * @brief Copia o retrato atual.
+ * @param out Destino.
+ */
+void sensor_sched_snapshot(sensor_snapshot_t *out);
+
+#endif // SENSOR_SCHED_H
@@ -0,0 +1,155 @@
+/**
+ * @file servo_motion.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Geração dos perfis de movimento e reprodução por DMA no registrador CC do PWM.
+ */
+
+#include "servo_motion.h"
+#include <math.h>
+#include "pico/stdlib.h"
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+
+#define PWM_COUNTER_HZ 2000000u                            ///< 1 contagem = 0,5 us.
+#define PWM_WRAP (PWM_COUNTER_HZ / 1000u * SERVO_MOTION_PERIOD_MS - 1u)
+
+/** @brief Converte ângulo (0-180) no nível do PWM (contagens de 0,5 us). */
+static uint16_t angle_to_level(float deg) {
+    if (deg < 0.0f) deg = 0.0f;
+    if (deg > 180.0f) deg = 180.0f;
+    float us = SERVO_MOTION_MIN_US + deg * (SERVO_MOTION_MAX_US - SERVO_MOTION_MIN_US) / 180.0f;
+    return (uint16_t)(us * (PWM_COUNTER_HZ / 1000000u) + 0.5f);
+}
+
+/** @brief Converte o nível do PWM em ângulo. */
+static float level_to_angle(uint16_t level) {
+    float us = (float)level / (PWM_COUNTER_HZ / 1000000u);
+    return (us - SERVO_MOTION_MIN_US) * 180.0f / (SERVO_MOTION_MAX_US - SERVO_MOTION_MIN_US);
+}
+
+/** @brief Nível atual do canal do servo no registrador CC. */
+static uint16_t current_level(const servo_motion_t *servo) {
+    uint32_t cc = pwm_hw->slice[servo->slice].cc;
+    return (uint16_t)(servo->channel == PWM_CHAN_A ? cc : cc >> 16);
+}
+
+/**
+ * @brief Duração de um movimento de `dist` graus, em segundos.
+ */
+static float profile_duration(const servo_motion_t *servo, float dist) {
+    float v = servo->max_speed_deg_s;
+    if (servo->profile == SERVO_PROFILE_SCURVE) {
+        // Jerk mínimo: pico de velocidade = 1,875 * dist / T.
+        return 1.875f * dist / v;
+    }
+    float a = servo->max_accel_deg_s2;
+    float ta = v / a;
+    if (dist < v * ta) {
+        return 2.0f * sqrtf(dist / a);     // Triângulo: nunca atinge v.
+    }
+    return 2.0f * ta + (dist - v * ta) / v;
+}
+
+/**
+ * @brief Fração do percurso (0 a 1) percorrida no instante t de um movimento de duração T.
+ */
+static float profile_fraction(const servo_motion_t *servo, float dist, float t, float T) {
+    if (servo->profile == SERVO_PROFILE_SCURVE) {
+        float s = t / T;
+        return s * s * s * (10.0f + s * (-15.0f + 6.0f * s));
+    }
+    // Trapézio simétrico ajustado à duração efetiva (arredondada para passos inteiros ou
+    // comprimida pelo limite do buffer). No triângulo a rampa ocupa metade do tempo.
+    float ta = fminf(servo->max_speed_deg_s / servo->max_accel_deg_s2, T / 2.0f);
+    float vc = dist / (T - ta);                   // Velocidade de cruzeiro efetiva.
+    float ae = vc / ta;
+    float pos;
+    if (t < ta) {
+        pos = 0.5f * ae * t * t;
+    } else if (t < T - ta) {
+        pos = 0.5f * ae * ta * ta + vc * (t - ta);
+    } else {
+        float r = T - t;
+        pos = dist - 0.5f * ae * r * r;
+    }
+    return pos / dist;
+}
+
+void servo_motion_init(servo_motion_t *servo, uint32_t pin, float initial_deg, float max_speed_deg_s,
+                       float max_accel_deg_s2, servo_profile_t profile) {
+    servo->pin = pin;
+    servo->slice = pwm_gpio_to_slice_num(pin);
+    servo->channel = pwm_gpio_to_channel(pin);
+    servo->profile = profile;
+    servo->max_speed_deg_s = max_speed_deg_s;
+    servo->max_accel_deg_s2 = max_accel_deg_s2;
+    servo->target_deg = initial_deg;
+    servo->moves = 0;
+
+    // PWM a 50 Hz com contador de 2 MHz: resolução de 0,5 us na largura do pulso.
+    gpio_set_function(pin, GPIO_FUNC_PWM);
+    pwm_config config = pwm_get_default_config();
+    pwm_config_set_clkdiv(&config, (float)clock_get_hz(clk_sys) / PWM_COUNTER_HZ);
+    pwm_config_set_wrap(&config, PWM_WRAP);
+    pwm_init(servo->slice, &config, false);
+    pwm_set_chan_level(servo->slice, servo->channel, angle_to_level(initial_deg));
+    pwm_set_enabled(servo->slice, true);
+
+    // Canal de DMA: 32 bits por transferência, um valor a cada wrap do contador.
+    servo->dma_chan = dma_claim_unused_channel(true);
+}
+
+uint32_t servo_motion_move_to(servo_motion_t *servo, float angle_deg) {
+    // Interrompe o movimento anterior onde estiver; o novo parte da posição real.
+    dma_channel_abort(servo->dma_chan);
+
+    uint16_t start_level = current_level(servo);
+    float start = level_to_angle(start_level);
+    float dist = angle_deg - start;
+    float abs_dist = fabsf(dist);
+    servo->target_deg = angle_deg;
+
+    if (angle_to_level(angle_deg) == start_level) {
+        return 0;
+    }
+
+    // Número de passos (um por período do PWM), limitado ao tamanho do buffer.
+    float T = profile_duration(servo, abs_dist);
+    uint32_t n = (uint32_t)ceilf(T * 1000.0f / SERVO_MOTION_PERIOD_MS);
+    if (n < 1) n = 1;
+    if (n > SERVO_MOTION_MAX_STEPS) n = SERVO_MOTION_MAX_STEPS;
+    T = (float)(n * SERVO_MOTION_PERIOD_MS) / 1000.0f;
+
+    // O outro canal da fatia é preservado na metade que não pertence a este servo.
+    uint32_t cc = pwm_hw->slice[servo->slice].cc;
+    uint32_t keep = (servo->channel == PWM_CHAN_A) ? (cc & 0xFFFF0000u) : (cc & 0x0000FFFFu);
+    uint32_t shift = (servo->channel == PWM_CHAN_A) ? 0 : 16;
+
+    for (uint32_t k = 0; k < n; k++) {
+        float t = T * (float)(k + 1) / (float)n;
+        float deg = start + dist * profile_fraction(servo, abs_dist, t, T);
+        servo->steps[k] = keep | ((uint32_t)angle_to_level(deg) << shift);
+    }
+    servo->steps[n - 1] = keep | ((uint32_t)angle_to_level(angle_deg) << shift);
+
+    dma_channel_config c = dma_channel_get_default_config(servo->dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pwm_get_dreq(servo->slice));
+    dma_channel_configure(servo->dma_chan, &c, &pwm_hw->slice[servo->slice].cc, servo->steps, n, true);
+
+    servo->moves++;
+    return n * SERVO_MOTION_PERIOD_MS;
+}
+
+bool servo_motion_busy(const servo_motion_t *servo) {
+    return dma_channel_is_busy(servo->dma_chan);
+}
+
+float servo_motion_position_deg(const servo_motion_t *servo) {
+    return level_to_angle(current_level(servo));
+}
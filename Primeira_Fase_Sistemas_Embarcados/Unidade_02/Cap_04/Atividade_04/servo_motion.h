@@ -0,0 +1,95 @@
+/**
+ * @file servo_motion.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Perfis de movimento suaves para servos, reproduzidos por DMA no PWM sem uso de CPU.
+ *
+ * @details
+ * Saltar direto para a largura de pulso final causa pico de corrente e tranco mecânico.
+ * `servo_motion_move_to()` calcula uma vez todo o movimento (trapezoidal ou curva em S)
+ * e grava, em um buffer, o valor do registrador de comparação do PWM para cada período
+ * de 20 ms. Um canal de DMA, cadenciado pelo DREQ de "wrap" da fatia do PWM, copia um
+ * valor por período para o registrador CC: o movimento inteiro acontece sem CPU, e cada
+ * servo tem o seu canal, então vários se movem ao mesmo tempo.
+ *
+ * @code
+ *   buffer[0..n-1] ──DMA (1 palavra por wrap do PWM, 50 Hz)──▶ pwm_hw->slice[s].cc
+ * @endcode
+ *
+ * Perfis (velocidade x tempo):
+ * - SERVO_PROFILE_TRAPEZOID: acelera em `max_accel`, cruza em `max_speed`, desacelera
+ *   (vira triângulo em movimentos curtos).
+ * - SERVO_PROFILE_SCURVE: curva de jerk mínimo (10t³ − 15t⁴ + 6t⁵), sem degraus de
+ *   aceleração; a duração é escolhida para o pico de velocidade ser `max_speed`.
+ *
+ * @note O registrador CC guarda os dois canais (A e B) da fatia e o DMA escreve 32 bits;
+ *       o buffer preserva o nível do outro canal lido no início do movimento. Por isso,
+ *       cada servo deve estar numa fatia própria, ou o outro canal não pode mudar
+ *       enquanto o servo se move.
+ */
+
+#ifndef SERVO_MOTION_H
+#define SERVO_MOTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SERVO_MOTION_PERIOD_MS 20      ///< Período do PWM (50 Hz) = um passo do perfil.
+#define SERVO_MOTION_MAX_STEPS 256     ///< Passos por movimento (5,12 s); movimentos mais longos são acelerados.
+#define SERVO_MOTION_MIN_US    1000    ///< Pulso em 0 grau.
+#define SERVO_MOTION_MAX_US    2000    ///< Pulso em 180 graus.
+
+/** @brief Forma do perfil de velocidade. */
+typedef enum {
+    SERVO_PROFILE_TRAPEZOID,
+    SERVO_PROFILE_SCURVE,
+} servo_profile_t;
+
+/** @brief Um servo com o seu canal de DMA e buffer de passos. */
+typedef struct {
+    uint32_t pin;
+    uint32_t slice;
+    uint32_t channel;                      ///< PWM_CHAN_A ou PWM_CHAN_B.
+    int dma_chan;
+    servo_profile_t profile;
+    float max_speed_deg_s;                 ///< Velocidade máxima (graus/s).
+    float max_accel_deg_s2;                ///< Aceleração máxima (graus/s², só no trapezoidal).
+    float target_deg;                      ///< Destino do último movimento.
+    uint32_t moves;                        ///< Movimentos iniciados.
+    uint32_t steps[SERVO_MOTION_MAX_STEPS]; ///< Valores do registrador CC, um por período.
+} servo_motion_t;
+
+/**
+ * @brief Configura o PWM do pino a 50 Hz, reserva um canal de DMA e posiciona o servo.
+ * @param servo Estado (deve permanecer válido enquanto houver movimento).
+ * @param pin Pino com função PWM.
+ * @param initial_deg Posição inicial (aplicada imediatamente, sem perfil).
+ * @param max_speed_deg_s Velocidade máxima.
+ * @param max_accel_deg_s2 Aceleração máxima (trapezoidal).
+ * @param profile Forma do perfil.
+ */
+void servo_motion_init(servo_motion_t *servo, uint32_t pin, float initial_deg, float max_speed_deg_s,
+                       float max_accel_deg_s2, servo_profile_t profile);
+
+/**
+ * @brief Inicia um movimento suave até `angle_deg` a partir da posição atual.
+ * @details Um movimento em andamento é interrompido na posição em que está e o novo
+ * parte dali. A função só calcula o buffer e dispara o DMA; retorna imediatamente.
+ * @param servo Estado.
+ * @param angle_deg Destino (0 a 180 graus).
+ * @return Duração do movimento em ms (0 se já estava no destino).
+ */
+uint32_t servo_motion_move_to(servo_motion_t *servo, float angle_deg);
+
+/**
+ * @brief Indica se o DMA ainda está reproduzindo um movimento.
+ */
+bool servo_motion_busy(const servo_motion_t *servo);
+
+/**
+ * @brief Posição atual, lida do registrador de comparação do PWM.
+ * @return Ângulo em graus.
+ */
+float servo_motion_position_deg(const servo_motion_t *servo);
+
+#endif // SERVO_MOTION_H
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+"""
+@file gen_curve_tables.py
+@author Manoel Felipe Costa Furtado
+@copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+@brief Gera as tabelas de ponto fixo usadas por curve_fixed.c para converter as
+       leituras do MQ-2 (PPM) e do LDR (Lux) sem pow()/powf().
+
+As duas curvas dos sensores são leis de potência sobre uma razão de resistências,
+e a razão depende só do valor bruto do ADC:
+
+    MQ-2: PPM = A * (Rs/R0)^B,          Rs  = RL * (4095 - raw) / raw
+    LDR : Lux = (K / R_ldr)^(1/0,7),    R_ldr = Rserie * raw / (4095 - raw)
+
+No domínio logarítmico as duas ficam na mesma forma linear:
+
+    log2(y) = k0 + k1 * (log2(num) - log2(den))
+
+O script calcula k0 e k1 (Q16.16) a partir das constantes do datasheet, gera as
+tabelas de log2/exp2 interpoladas e, emulando bit a bit a aritmética inteira de
+curve_fixed.c, varre todas as 4094 leituras válidas do ADC para medir o erro máximo
+contra o cálculo em double. O erro medido é gravado no cabeçalho como limite
+documentado (CURVE_*_MAX_REL_ERR_E6, em milionésimos).
+
+Uso (na pasta do projeto, sempre que mudar a calibração em Atividade_Uni_02_Cap_04.c):
+    python3 tools/gen_curve_tables.py -o .
+"""
+
+import argparse
+import math
+import os
+
+ADC_MAX = 4095
+
+# Constantes de calibração: devem acompanhar as de Atividade_Uni_02_Cap_04.c.
+MQ2_R0 = 8000.0
+MQ2_RL = 5000.0
+MQ2_CURVE_A = 8.664
+MQ2_CURVE_B = 0.116
+LDR_SERIES_RESISTOR = 10000.0
+LDR_K = 50.0 * 1000.0 * 10.0 ** 0.7
+LDR_GAMMA = 0.7
+
+# Segmentos de interpolação (potência de 2; o índice sai direto dos bits da fração).
+SEG_BITS = 5
+SEGMENTS = 1 << SEG_BITS
+FRAC_SHIFT = 16 - SEG_BITS
+
+
+def q16(x):
+    return int(round(x * 65536.0))
+
+
+LOG2_TABLE = [q16(math.log2(1.0 + i / SEGMENTS)) for i in range(SEGMENTS + 1)]
+EXP2_TABLE = [q16(2.0 ** (i / SEGMENTS)) for i in range(SEGMENTS + 1)]
+
+
+def interp(table, t):
+    """Mesma interpolação de curve_fixed.c (t em Q16, 0 <= t < 65536)."""
+    idx = t >> FRAC_SHIFT
+    f = t & ((1 << FRAC_SHIFT) - 1)
+    return table[idx] + (((table[idx + 1] - table[idx]) * f + (1 << (FRAC_SHIFT - 1))) >> FRAC_SHIFT)
+
+
+def fx_log2(n):
+    """Emula curve_log2_q16(): log2 de um inteiro n >= 1, em Q16.16."""
+    e = n.bit_length() - 1
+    t = (n << (16 - e)) if e <= 16 else (n >> (e - 16))
+    return (e << 16) + interp(LOG2_TABLE, t - 65536)
+
+
+def fx_eval(k0, k1, num, den):
+    """Emula curve_eval_f(): devolve o valor exato do float montado pelo C."""
+    d = fx_log2(num) - fx_log2(den)
+    e = k0 + ((k1 * d + 32768) >> 16)
+    i = e >> 16
+    m = interp(EXP2_TABLE, e & 0xFFFF)
+    return m / 65536.0 * 2.0 ** i
+
+
+def curve_mq2():
+    k1 = MQ2_CURVE_B
+    k0 = math.log2(MQ2_CURVE_A) + MQ2_CURVE_B * math.log2(MQ2_RL / MQ2_R0)
+
+    def exact(raw):
+        rs = MQ2_RL * (ADC_MAX - raw) / raw
+        return MQ2_CURVE_A * (rs / MQ2_R0) ** MQ2_CURVE_B
+
+    # num/den = (4095 - raw) / raw
+    return "mq2_ppm", k0, k1, exact, lambda raw: (ADC_MAX - raw, raw)
+
+
+def curve_ldr():
+    k1 = 1.0 / LDR_GAMMA
+    k0 = k1 * math.log2(LDR_K / LDR_SERIES_RESISTOR)
+
+    def exact(raw):
+        r = LDR_SERIES_RESISTOR * raw / (ADC_MAX - raw)
+        return (LDR_K / r) ** (1.0 / LDR_GAMMA)
+
+    return "ldr_lux", k0, k1, exact, lambda raw: (ADC_MAX - raw, raw)
+
+
+def max_error(k0q, k1q, exact, args):
+    worst, worst_raw = 0.0, 0
+    for raw in range(1, ADC_MAX):
+        ref = exact(raw)
+        err = abs(fx_eval(k0q, k1q, *args(raw)) - ref) / ref
+        if err > worst:
+            worst, worst_raw = err, raw
+    return worst, worst_raw
+
+
+def c_array(values):
+    lines = []
+    for i in range(0, len(values), 8):
+        lines.append("    " + ", ".join("%d" % v for v in values[i:i + 8]) + ",")
+    return "\n".join(lines)
+
+
+HEADER = """\
+/**
+ * @file curve_tables.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Tabelas e coeficientes das curvas dos sensores (gerado por tools/gen_curve_tables.py; não edite).
+ *
+ * @details Erro relativo máximo medido contra double em todas as leituras 1..4094 do ADC:
+{bounds_doc}
+ */
+
+#ifndef CURVE_TABLES_H
+#define CURVE_TABLES_H
+
+#include "curve_fixed.h"
+
+#define CURVE_SEG_BITS {seg_bits}  ///< log2 do número de segmentos de interpolação.
+
+{bounds_def}
+
+extern const int32_t curve_log2_table[{n}];   ///< log2(1 + i/{segs}) em Q16.16.
+extern const int32_t curve_exp2_table[{n}];   ///< 2^(i/{segs}) em Q16.16.
+
+{externs}
+
+#endif // CURVE_TABLES_H
+"""
+
+SOURCE = """\
+/**
+ * @file curve_tables.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Tabelas e coeficientes das curvas dos sensores (gerado por tools/gen_curve_tables.py; não edite).
+ */
+
+#include "curve_tables.h"
+
+const int32_t curve_log2_table[{n}] = {{
+{log2}
+}};
+
+const int32_t curve_exp2_table[{n}] = {{
+{exp2}
+}};
+
+{curves}
+"""
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("-o", "--outdir", default=".", help="pasta do projeto (destino de curve_tables.h/.c)")
+    args = parser.parse_args()
+
+    bounds_doc, bounds_def, externs, curves = [], [], [], []
+    for name, k0, k1, exact, nd in (curve_mq2(), curve_ldr()):
+        k0q, k1q = q16(k0), q16(k1)
+        err, raw = max_error(k0q, k1q, exact, nd)
+        macro = "CURVE_%s_MAX_REL_ERR_E6" % name.upper()
+        bound = int(math.ceil(err * 1e6))
+        bounds_doc.append(" *  - %s: %.4f %% (pior caso em raw = %d)" % (name, err * 100.0, raw))
+        bounds_def.append("#define %s %d  ///< Erro relativo máximo de %s, em milionésimos." % (macro, bound, name))
+        externs.append("extern const curve_t curve_%s;  ///< log2(y) = %.6f + %.6f * log2(num/den)." % (name, k0, k1))
+        curves.append("const curve_t curve_%s = { .k0_q16 = %d, .k1_q16 = %d };" % (name, k0q, k1q))
+        print("%-8s k0=%d k1=%d erro máx=%.4f %% (raw=%d)" % (name, k0q, k1q, err * 100.0, raw))
+
+    fmt = dict(n=SEGMENTS + 1, segs=SEGMENTS, seg_bits=SEG_BITS)
+    with open(os.path.join(args.outdir, "curve_tables.h"), "w", encoding="utf-8") as f:
+        f.write(HEADER.format(bounds_doc="\n".join(bounds_doc), bounds_def="\n".join(bounds_def),
+                              externs="\n".join(externs), **fmt))
+    with open(os.path.join(args.outdir, "curve_tables.c"), "w", encoding="utf-8") as f:
+        f.write(SOURCE.format(log2=c_array(LOG2_TABLE), exp2=c_array(EXP2_TABLE),
+                              curves="\n".join(curves), **fmt))
+
+
+if __name__ == "__main__":
+    main()
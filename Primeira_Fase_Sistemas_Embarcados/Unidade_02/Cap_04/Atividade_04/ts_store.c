@@ -0,0 +1,516 @@
+/**
+ * @file ts_store.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Implementação do histórico comprimido (codificação Gorilla em páginas de flash).
+ */
+
+#include "ts_store.h"
+#include <math.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+
+#define TS_MAGIC             0x5354u   ///< "TS" em little-endian.
+#define TS_REGION_OFFSET     (PICO_FLASH_SIZE_BYTES - TS_STORE_REGION_BYTES)
+#define TS_PAGES             (TS_STORE_REGION_BYTES / TS_STORE_PAGE_BYTES)
+#define TS_SECTORS           (TS_STORE_REGION_BYTES / TS_STORE_SECTOR_BYTES)
+#define TS_PAGES_PER_SECTOR  (TS_STORE_SECTOR_BYTES / TS_STORE_PAGE_BYTES)
+#define TS_REBOOT_GAP_MS     1000u     ///< Separação mínima entre boots no tempo do histórico.
+#define TS_FLASH_TIMEOUT_MS  100u
+
+/** @brief Cabeçalho da página (32 bytes, sem preenchimento). */
+typedef struct {
+    uint16_t magic;
+    uint8_t series;              ///< Id da série.
+    uint8_t encoding;            ///< ts_encoding_t.
+    uint16_t count;              ///< Amostras na página (a primeira está no cabeçalho).
+    uint16_t bits;               ///< Bits usados na carga.
+    uint32_t seq;                ///< Ordem global de gravação.
+    uint32_t t_span_ms;          ///< t_last - t_first.
+    uint64_t t_first_ms;
+    uint32_t v_first;            ///< Primeiro valor: bits do float ou inteiro quantizado.
+    uint32_t crc;                ///< CRC-32 da página com este campo zerado.
+} ts_page_header_t;
+
+#define TS_PAYLOAD_BYTES (TS_STORE_PAGE_BYTES - sizeof(ts_page_header_t))
+#define TS_PAYLOAD_BITS  (TS_PAYLOAD_BYTES * 8u)
+
+typedef struct {
+    ts_page_header_t h;
+    uint8_t payload[TS_PAYLOAD_BYTES];
+} ts_page_t;
+
+_Static_assert(sizeof(ts_page_header_t) == 32, "cabeçalho da página");
+_Static_assert(sizeof(ts_page_t) == TS_STORE_PAGE_BYTES, "página = página de flash");
+_Static_assert(TS_STORE_REGION_BYTES % TS_STORE_SECTOR_BYTES == 0, "região em setores inteiros");
+
+/** @brief Série registrada: página em montagem na RAM e estado do codificador. */
+typedef struct {
+    const ts_series_config_t *cfg;
+    ts_page_t page;              ///< h.count == 0: nenhuma amostra pendente.
+    uint32_t bitpos;
+    uint64_t t_prev;
+    int32_t delta_prev;          ///< Último delta de tempo (para o delta-do-delta).
+    uint32_t v_prev;
+    uint8_t lead, trail;         ///< Janela XOR anterior (lead = 0xFF: nenhuma).
+} ts_series_t;
+
+/** @brief Resumo de um setor para pular setores inteiros nas consultas. */
+typedef struct {
+    uint64_t t_min, t_max;
+    uint16_t pages;              ///< Páginas válidas no setor.
+} ts_sector_index_t;
+
+static ts_series_t series[TS_STORE_MAX_SERIES];
+static uint32_t series_count;
+static ts_sector_index_t sectors[TS_SECTORS];
+static uint8_t page_valid[TS_PAGES / 8];   ///< Bitmap: página com CRC correto.
+static uint32_t head;                       ///< Próxima página a gravar.
+static bool head_sector_erased;             ///< O setor de `head` pode ser gravado.
+static uint32_t next_seq;
+static uint64_t time_base_ms;
+static ts_store_stats_t stats;
+
+// ---------------------------------------------------------------------------
+// Flash
+// ---------------------------------------------------------------------------
+
+static const ts_page_t *flash_page(uint32_t page) {
+    return (const ts_page_t *)(uintptr_t)(XIP_BASE + TS_REGION_OFFSET + page * TS_STORE_PAGE_BYTES);
+}
+
+typedef struct {
+    uint32_t offset;
+    const uint8_t *data;
+} flash_op_t;
+
+static void do_erase(void *param) {
+    const flash_op_t *op = param;
+    flash_range_erase(op->offset, TS_STORE_SECTOR_BYTES);
+}
+
+static void do_program(void *param) {
+    const flash_op_t *op = param;
+    flash_range_program(op->offset, op->data, TS_STORE_PAGE_BYTES);
+}
+
+static uint32_t crc32(const void *data, uint32_t n) {
+    const uint8_t *p = data;
+    uint32_t crc = 0xFFFFFFFFu;
+    while (n--) {
+        crc ^= *p++;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t page_crc(const ts_page_t *pg) {
+    ts_page_t copy = *pg;
+    copy.h.crc = 0;
+    return crc32(&copy, sizeof(copy));
+}
+
+static bool page_erased(uint32_t page) {
+    const uint32_t *w = (const uint32_t *)flash_page(page);
+    for (uint32_t i = 0; i < TS_STORE_PAGE_BYTES / 4; i++) {
+        if (w[i] != 0xFFFFFFFFu) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void index_add(uint32_t page, const ts_page_header_t *h) {
+    ts_sector_index_t *s = &sectors[page / TS_PAGES_PER_SECTOR];
+    uint64_t t_last = h->t_first_ms + h->t_span_ms;
+    if (h->t_first_ms < s->t_min) s->t_min = h->t_first_ms;
+    if (t_last > s->t_max) s->t_max = t_last;
+    s->pages++;
+    page_valid[page / 8] |= (uint8_t)(1u << (page % 8));
+    stats.pages_valid++;
+}
+
+/**
+ * @brief Apaga o setor que contém `page` (o dos dados mais antigos do anel).
+ * @return false se o apagamento não foi feito: o setor não pode ser gravado.
+ */
+static bool erase_sector(uint32_t page) {
+    uint32_t sector = page / TS_PAGES_PER_SECTOR;
+    flash_op_t op = { TS_REGION_OFFSET + sector * TS_STORE_SECTOR_BYTES, NULL };
+    uint64_t t0 = time_us_64();
+    bool ok = flash_safe_execute(do_erase, &op, TS_FLASH_TIMEOUT_MS) == PICO_OK;
+    stats.erase_us += time_us_64() - t0;
+    if (ok) {
+        stats.sectors_erased++;
+    } else {
+        stats.flash_errors++;
+    }
+
+    // Mesmo sem sucesso o índice sai: um apagamento parcial deixa o conteúdo indefinido.
+    stats.pages_valid -= sectors[sector].pages;
+    sectors[sector] = (ts_sector_index_t){ .t_min = UINT64_MAX, .t_max = 0, .pages = 0 };
+    memset(&page_valid[sector * TS_PAGES_PER_SECTOR / 8], 0, TS_PAGES_PER_SECTOR / 8);
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Bits
+// ---------------------------------------------------------------------------
+
+/** @brief Escreve os `n` bits menos significativos de `value` (MSB primeiro). */
+static bool put_bits(ts_series_t *s, uint32_t value, uint32_t n) {
+    if (s->bitpos + n > TS_PAYLOAD_BITS) {
+        return false;
+    }
+    while (n--) {
+        if ((value >> n) & 1u) {
+            s->page.payload[s->bitpos >> 3] |= (uint8_t)(0x80u >> (s->bitpos & 7u));
+        }
+        s->bitpos++;
+    }
+    return true;
+}
+
+/**
+ * @brief Inteiro com sinal em baldes: 0 → '0'; 7 bits → '10'; 9 → '110'; 12 → '1110';
+ *        senão '1111' + 32 bits.
+ */
+static bool put_bucket(ts_series_t *s, int32_t v) {
+    if (v == 0) return put_bits(s, 0x0, 1);
+    if (v >= -64 && v <= 63) return put_bits(s, 0x2, 2) && put_bits(s, (uint32_t)v & 0x7Fu, 7);
+    if (v >= -256 && v <= 255) return put_bits(s, 0x6, 3) && put_bits(s, (uint32_t)v & 0x1FFu, 9);
+    if (v >= -2048 && v <= 2047) return put_bits(s, 0xE, 4) && put_bits(s, (uint32_t)v & 0xFFFu, 12);
+    return put_bits(s, 0xF, 4) && put_bits(s, (uint32_t)v, 32);
+}
+
+typedef struct {
+    const uint8_t *buf;
+    uint32_t pos;
+} ts_reader_t;
+
+static uint32_t get_bits(ts_reader_t *r, uint32_t n) {
+    uint32_t v = 0;
+    while (n--) {
+        v = (v << 1) | ((r->buf[r->pos >> 3] >> (7u - (r->pos & 7u))) & 1u);
+        r->pos++;
+    }
+    return v;
+}
+
+static int32_t sign_extend(uint32_t v, uint32_t bits) {
+    uint32_t m = 1u << (bits - 1);
+    return (int32_t)((v ^ m) - m);
+}
+
+static int32_t get_bucket(ts_reader_t *r) {
+    if (!get_bits(r, 1)) return 0;
+    if (!get_bits(r, 1)) return sign_extend(get_bits(r, 7), 7);
+    if (!get_bits(r, 1)) return sign_extend(get_bits(r, 9), 9);
+    if (!get_bits(r, 1)) return sign_extend(get_bits(r, 12), 12);
+    return (int32_t)get_bits(r, 32);
+}
+
+// ---------------------------------------------------------------------------
+// Codificação
+// ---------------------------------------------------------------------------
+
+static uint32_t float_bits(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+static float bits_float(uint32_t u) {
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+/** @brief Valor como gravado: bits do float ou inteiro quantizado. */
+static uint32_t encode_value(const ts_series_config_t *cfg, float value) {
+    if (cfg->encoding == TS_ENC_XOR) {
+        return float_bits(value);
+    }
+    float q = roundf(value * cfg->scale);
+    if (q > 2147483520.0f) q = 2147483520.0f;
+    if (q < -2147483648.0f) q = -2147483648.0f;
+    return (uint32_t)(int32_t)q;
+}
+
+static float decode_value(uint8_t encoding, float scale, uint32_t v) {
+    return encoding == TS_ENC_XOR ? bits_float(v) : (float)(int32_t)v / scale;
+}
+
+static bool put_xor(ts_series_t *s, uint32_t v) {
+    uint32_t x = v ^ s->v_prev;
+    if (x == 0) {
+        return put_bits(s, 0x0, 1);
+    }
+    uint32_t lead = (uint32_t)__builtin_clz(x);
+    uint32_t trail = (uint32_t)__builtin_ctz(x);
+    if (s->lead != 0xFF && lead >= s->lead && trail >= s->trail) {
+        // Cabe na janela anterior: só os bits dela.
+        return put_bits(s, 0x2, 2) && put_bits(s, x >> s->trail, 32u - s->lead - s->trail);
+    }
+    uint32_t sig = 32u - lead - trail;
+    s->lead = (uint8_t)lead;
+    s->trail = (uint8_t)trail;
+    return put_bits(s, 0x3, 2) && put_bits(s, lead, 5) && put_bits(s, sig - 1u, 5) &&
+           put_bits(s, x >> trail, sig);
+}
+
+static void page_start(ts_series_t *s, uint32_t id, uint64_t t, uint32_t v) {
+    memset(&s->page, 0, sizeof(s->page));
+    s->page.h.series = (uint8_t)id;
+    s->page.h.encoding = (uint8_t)s->cfg->encoding;
+    s->page.h.count = 1;
+    s->page.h.t_first_ms = t;
+    s->page.h.v_first = v;
+    s->bitpos = 0;
+    s->t_prev = t;
+    s->delta_prev = 0;
+    s->v_prev = v;
+    s->lead = 0xFF;
+}
+
+/** @brief Tenta acrescentar à página atual; em caso de falta de espaço desfaz tudo. */
+static bool page_append(ts_series_t *s, uint64_t t, uint32_t v) {
+    ts_series_t saved = *s;   // Só o estado importa; a carga além de bitpos é ignorada.
+    uint64_t delta64 = t - s->t_prev;
+    int64_t dod = (int64_t)delta64 - s->delta_prev;
+    bool ok = delta64 <= INT32_MAX && dod >= INT32_MIN && dod <= INT32_MAX &&
+              s->page.h.count < UINT16_MAX && put_bucket(s, (int32_t)dod);
+
+    if (ok) {
+        if (s->cfg->encoding == TS_ENC_XOR) {
+            ok = put_xor(s, v);
+        } else {
+            int64_t dv = (int64_t)(int32_t)v - (int32_t)s->v_prev;
+            ok = dv >= INT32_MIN && dv <= INT32_MAX && put_bucket(s, (int32_t)dv);
+        }
+    }
+    if (!ok) {
+        s->bitpos = saved.bitpos;
+        s->lead = saved.lead;
+        s->trail = saved.trail;
+        return false;
+    }
+    s->delta_prev = (int32_t)delta64;
+    s->t_prev = t;
+    s->v_prev = v;
+    s->page.h.count++;
+    s->page.h.t_span_ms = (uint32_t)(t - s->page.h.t_first_ms);
+    return true;
+}
+
+/** @brief Fecha a página da série e grava na cabeça do anel. */
+static void page_seal(ts_series_t *s) {
+    ts_page_t *pg = &s->page;
+    pg->h.magic = TS_MAGIC;
+    pg->h.bits = (uint16_t)s->bitpos;
+    pg->h.seq = next_seq++;
+    pg->h.crc = 0;
+    pg->h.crc = crc32(pg, sizeof(*pg));
+
+    // Entrando num setor: ele guarda os dados mais antigos (ou sobras de uma queda).
+    // Se o apagamento falhou, tenta de novo na próxima página do mesmo setor.
+    if (head % TS_PAGES_PER_SECTOR == 0 || !head_sector_erased) {
+        head_sector_erased = erase_sector(head);
+    }
+
+    // Sem apagamento, gravar por cima daria bits indefinidos: a página é perdida.
+    if (head_sector_erased) {
+        flash_op_t op = { TS_REGION_OFFSET + head * TS_STORE_PAGE_BYTES, (const uint8_t *)pg };
+        uint64_t t0 = time_us_64();
+        if (flash_safe_execute(do_program, &op, TS_FLASH_TIMEOUT_MS) == PICO_OK) {
+            index_add(head, &pg->h);
+            stats.pages_written++;
+            stats.samples_sealed += pg->h.count;
+        } else {
+            stats.flash_errors++;
+        }
+        stats.program_us += time_us_64() - t0;
+    }
+
+    head = (head + 1) % TS_PAGES;
+    pg->h.count = 0;
+}
+
+// ---------------------------------------------------------------------------
+// API
+// ---------------------------------------------------------------------------
+
+void ts_store_init(void) {
+    memset(page_valid, 0, sizeof(page_valid));
+    for (uint32_t i = 0; i < TS_SECTORS; i++) {
+        sectors[i] = (ts_sector_index_t){ .t_min = UINT64_MAX, .t_max = 0, .pages = 0 };
+    }
+    stats = (ts_store_stats_t){ .pages_total = TS_PAGES };
+
+    bool any = false;
+    uint32_t last_page = 0, last_seq = 0;
+    uint64_t t_max = 0;
+
+    for (uint32_t p = 0; p < TS_PAGES; p++) {
+        const ts_page_t *pg = flash_page(p);
+        if (pg->h.magic == 0xFFFFu && page_erased(p)) {
+            continue;
+        }
+        if (pg->h.magic != TS_MAGIC || pg->h.count == 0 || page_crc(pg) != pg->h.crc) {
+            stats.torn_pages++;   // Gravação ou apagamento interrompido.
+            continue;
+        }
+        index_add(p, &pg->h);
+        uint64_t t_last = pg->h.t_first_ms + pg->h.t_span_ms;
+        if (t_last > t_max) t_max = t_last;
+        if (!any || (int32_t)(pg->h.seq - last_seq) > 0) {
+            last_seq = pg->h.seq;
+            last_page = p;
+            any = true;
+        }
+    }
+
+    next_seq = any ? last_seq + 1 : 0;
+    head = any ? (last_page + 1) % TS_PAGES : 0;
+    // A página depois da última válida tem de estar apagada; se não estiver, recomeça no
+    // próximo setor, que é apagado antes da primeira gravação.
+    if (head % TS_PAGES_PER_SECTOR != 0 && !page_erased(head)) {
+        head = (head / TS_PAGES_PER_SECTOR + 1) * TS_PAGES_PER_SECTOR % TS_PAGES;
+    }
+    head_sector_erased = true;   // Ou a página de `head` está apagada, ou o setor será apagado.
+    time_base_ms = any ? t_max + TS_REBOOT_GAP_MS : 0;
+}
+
+int ts_store_add_series(const ts_series_config_t *cfg) {
+    if (series_count >= TS_STORE_MAX_SERIES) {
+        return -1;
+    }
+    series[series_count] = (ts_series_t){ .cfg = cfg };
+    return (int)series_count++;
+}
+
+bool ts_store_append(int id, uint64_t t_ms, float value) {
+    if (id < 0 || (uint32_t)id >= series_count) {
+        return false;
+    }
+    ts_series_t *s = &series[id];
+    if (s->page.h.count && t_ms < s->t_prev) {
+        return false;
+    }
+
+    uint64_t t0 = time_us_64();
+    uint32_t v = encode_value(s->cfg, value);
+    if (!s->page.h.count || !page_append(s, t_ms, v)) {
+        if (s->page.h.count) {
+            page_seal(s);   // Página cheia: a amostra abre a próxima.
+        }
+        page_start(s, (uint32_t)id, t_ms, v);
+    }
+    stats.samples++;
+    stats.append_us += time_us_64() - t0;
+    return true;
+}
+
+void ts_store_flush(void) {
+    for (uint32_t i = 0; i < series_count; i++) {
+        if (series[i].page.h.count) {
+            page_seal(&series[i]);
+        }
+    }
+}
+
+/**
+ * @brief Entrega as amostras da página dentro de [from, to].
+ * @return `false` se a consulta deve parar (passou de `to` ou o callback pediu).
+ */
+static bool page_decode(const ts_page_t *pg, uint32_t bits, float scale, uint64_t from, uint64_t to,
+                        ts_query_cb_t cb, void *ctx, uint32_t *delivered) {
+    ts_reader_t r = { pg->payload, 0 };
+    uint64_t t = pg->h.t_first_ms;
+    int32_t delta = 0;
+    uint32_t v = pg->h.v_first;
+    uint32_t lead = 0, trail = 0;
+
+    for (uint32_t i = 0; i < pg->h.count && r.pos <= bits; i++) {
+        if (i > 0) {
+            delta += get_bucket(&r);
+            t += (uint32_t)delta;
+            if (pg->h.encoding == TS_ENC_XOR) {
+                if (get_bits(&r, 1)) {
+                    if (get_bits(&r, 1)) {
+                        lead = get_bits(&r, 5);
+                        uint32_t sig = get_bits(&r, 5) + 1u;
+                        trail = 32u - lead - sig;
+                    }
+                    v ^= get_bits(&r, 32u - lead - trail) << trail;
+                }
+            } else {
+                v = (uint32_t)((int32_t)v + get_bucket(&r));
+            }
+        }
+        if (t > to) {
+            return false;
+        }
+        if (t >= from) {
+            (*delivered)++;
+            if (!cb(ctx, t, decode_value(pg->h.encoding, scale, v))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+uint32_t ts_store_query(int id, uint64_t t_from, uint64_t t_to, ts_query_cb_t cb, void *ctx) {
+    if (id < 0 || (uint32_t)id >= series_count) {
+        return 0;
+    }
+    uint64_t t0 = time_us_64();
+    float scale = series[id].cfg->scale;
+    uint32_t delivered = 0, pages = 0;
+    bool go = true;
+
+    // Da cabeça (mais antiga) até a página anterior a ela: ordem de gravação.
+    for (uint32_t k = 0; k < TS_PAGES && go;) {
+        uint32_t p = (head + k) % TS_PAGES;
+        if (k == 0 || p % TS_PAGES_PER_SECTOR == 0) {
+            const ts_sector_index_t *s = &sectors[p / TS_PAGES_PER_SECTOR];
+            if (!s->pages || s->t_max < t_from || s->t_min > t_to) {
+                k += TS_PAGES_PER_SECTOR - p % TS_PAGES_PER_SECTOR;   // Pula o setor.
+                continue;
+            }
+        }
+        const ts_page_t *pg = flash_page(p);
+        bool valid = page_valid[p / 8] & (1u << (p % 8));
+        if (valid && pg->h.series == (uint32_t)id && pg->h.t_first_ms <= t_to &&
+            pg->h.t_first_ms + pg->h.t_span_ms >= t_from) {
+            pages++;
+            go = page_decode(pg, pg->h.bits, scale, t_from, t_to, cb, ctx, &delivered);
+        }
+        k++;
+    }
+
+    // Amostras ainda na RAM.
+    const ts_series_t *s = &series[id];
+    if (go && s->page.h.count) {
+        pages++;
+        page_decode(&s->page, s->bitpos, scale, t_from, t_to, cb, ctx, &delivered);
+    }
+
+    stats.last_query_samples = delivered;
+    stats.last_query_pages = pages;
+    stats.last_query_us = (uint32_t)(time_us_64() - t0);
+    return delivered;
+}
+
+uint64_t ts_store_now_ms(void) {
+    return time_base_ms + to_ms_since_boot(get_absolute_time());
+}
+
+void ts_store_get_stats(ts_store_stats_t *out) {
+    *out = stats;
+}
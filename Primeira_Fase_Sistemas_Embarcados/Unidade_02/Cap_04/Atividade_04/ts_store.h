@@ -0,0 +1,127 @@
+/**
+ * @file ts_store.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Histórico de séries temporais comprimido, só de acréscimo, na flash.
+ *
+ * @details
+ * Guardar cada amostra como timestamp de 64 bits + float custa 12 bytes; com a compressão
+ * no estilo Gorilla, uma série regular cabe em 1 a 2 bytes por amostra:
+ * - Instantes: delta-do-delta. Numa grade fixa (ex.: a cada 5 s) o delta-do-delta é zero
+ *   e custa 1 bit; variações pequenas custam 9, 12 ou 16 bits.
+ * - Valores, por série:
+ *   - `TS_ENC_XOR`: XOR dos bits do float com o anterior; só os bits significativos
+ *     vão para a flash, reaproveitando a janela (zeros à esquerda/direita) anterior.
+ *   - `TS_ENC_DELTA`: o valor é quantizado (`round(v * scale)`) e grava-se a diferença
+ *     para o anterior, com os mesmos baldes de tamanho dos instantes. Ideal para
+ *     sensores com resolução fixa (DHT22: 0,1 °C e 0,1 %).
+ *
+ * Cada bloco é uma página de flash (256 bytes) de uma única série, autocontida: o
+ * cabeçalho traz a primeira amostra crua, o intervalo de tempo [t_first, t_last], o
+ * número de amostras, um número de sequência global e o CRC-32 da página. Os
+ * cabeçalhos são o índice das consultas por intervalo: páginas (e setores inteiros,
+ * por um resumo em RAM) fora do intervalo são puladas sem decodificar.
+ *
+ * Organização da região (TS_STORE_REGION_BYTES no fim da flash):
+ * @code
+ *   setor 0        setor 1        ...   setor N-1
+ *   [p0 p1 .. p15] [p0 p1 .. p15]       [p0 .. p15]      <- páginas em ordem de escrita
+ *                       ^ cabeça: próxima página livre; ao entrar num setor, ele é apagado
+ * @endcode
+ * - Desgaste: a escrita é um anel; o setor apagado é sempre o que tem os dados mais
+ *   antigos, então todos os setores são apagados o mesmo número de vezes.
+ * - Queda de energia: uma página só vale com CRC correto. Página ou setor gravado pela
+ *   metade é ignorado na montagem, e a cabeça segue depois da última página válida
+ *   (ou para o próximo setor, se a página seguinte não estiver apagada). Perdem-se no
+ *   máximo as amostras ainda na RAM (uma página por série); ts_store_flush() grava as
+ *   páginas parciais quando a aplicação quiser reduzir essa janela.
+ *
+ * Relógio: sem RTC, os instantes são "tempo do histórico" em ms, que continua depois
+ * do maior instante gravado a cada boot (o tempo desligado não é contado).
+ */
+
+#ifndef TS_STORE_H
+#define TS_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TS_STORE_PAGE_BYTES    256u                  ///< Bloco = página de gravação da flash.
+#define TS_STORE_SECTOR_BYTES  4096u                 ///< Unidade de apagamento.
+#define TS_STORE_REGION_BYTES  (512u * 1024u)        ///< Últimos 512 KiB da flash.
+#define TS_STORE_MAX_SERIES    8                     ///< Séries registradas.
+
+/** @brief Codificação dos valores de uma série. */
+typedef enum {
+    TS_ENC_XOR = 1,      ///< XOR dos bits do float (Gorilla).
+    TS_ENC_DELTA = 2,    ///< Inteiro quantizado por `scale`, delta com baldes.
+} ts_encoding_t;
+
+/** @brief Descrição de uma série (constante, fornecida pela aplicação). */
+typedef struct {
+    const char *name;            ///< Nome para diagnóstico.
+    ts_encoding_t encoding;
+    float scale;                 ///< TS_ENC_DELTA: passos por unidade (10 = resolução 0,1).
+} ts_series_config_t;
+
+/** @brief Contadores de ocupação e desempenho. */
+typedef struct {
+    uint32_t samples;            ///< Amostras aceitas desde o boot.
+    uint32_t samples_sealed;     ///< Amostras em páginas já gravadas desde o boot.
+    uint32_t pages_written;      ///< Páginas gravadas desde o boot.
+    uint32_t sectors_erased;     ///< Setores apagados desde o boot.
+    uint32_t pages_valid;        ///< Páginas válidas na flash (histórico inteiro).
+    uint32_t pages_total;        ///< Páginas da região.
+    uint32_t torn_pages;         ///< Páginas com CRC inválido ignoradas na montagem.
+    uint32_t flash_errors;       ///< Apagamentos/gravações recusados por flash_safe_execute().
+    uint64_t append_us;          ///< Tempo total em ts_store_append() (inclui gravações).
+    uint64_t program_us;         ///< Tempo total gravando páginas.
+    uint64_t erase_us;           ///< Tempo total apagando setores.
+    uint32_t last_query_samples; ///< Amostras decodificadas na última consulta.
+    uint32_t last_query_pages;   ///< Páginas decodificadas na última consulta.
+    uint32_t last_query_us;      ///< Duração da última consulta.
+} ts_store_stats_t;
+
+/**
+ * @brief Chamada para cada amostra no intervalo de uma consulta, em ordem cronológica.
+ * @return `false` para interromper a consulta.
+ */
+typedef bool (*ts_query_cb_t)(void *ctx, uint64_t t_ms, float value);
+
+/**
+ * @brief Monta o histórico: varre os cabeçalhos, acha a cabeça e recupera de gravações
+ *        interrompidas. Chamar uma vez, antes de registrar as séries.
+ */
+void ts_store_init(void);
+
+/**
+ * @brief Registra uma série. A ordem de registro deve ser a mesma em todo boot: o id
+ *        gravado nas páginas é o índice.
+ * @return Id da série ou -1 se a tabela estiver cheia.
+ */
+int ts_store_add_series(const ts_series_config_t *cfg);
+
+/**
+ * @brief Acrescenta uma amostra. Grava a página da série quando ela enche.
+ * @param t_ms Instante no tempo do histórico (não pode voltar para trás na série).
+ * @return `false` se a amostra foi recusada (série inválida ou instante anterior).
+ */
+bool ts_store_append(int series, uint64_t t_ms, float value);
+
+/** @brief Grava as páginas parciais de todas as séries (cada uma ocupa uma página inteira). */
+void ts_store_flush(void);
+
+/**
+ * @brief Percorre as amostras de uma série com instante em [t_from, t_to], incluindo as
+ *        que ainda estão na RAM.
+ * @return Amostras entregues ao callback.
+ */
+uint32_t ts_store_query(int series, uint64_t t_from, uint64_t t_to, ts_query_cb_t cb, void *ctx);
+
+/** @brief Tempo do histórico agora (ms). */
+uint64_t ts_store_now_ms(void);
+
+/** @brief Copia os contadores. */
+void ts_store_get_stats(ts_store_stats_t *out);
+
+#endif // TS_STORE_H
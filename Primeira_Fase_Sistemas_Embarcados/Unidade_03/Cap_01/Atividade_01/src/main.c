@@ -33,6 +33,9 @@
  *
  * ✅ Recursos utilizados:
  * - Sistema operacional de tempo real FreeRTOS.
+ * - Tickless idle (tickless_idle.c): enquanto as três tarefas estão bloqueadas, o tick de
+ *   1 kHz é suspenso e a CPU dorme em WFI até o alarme do timer de hardware. A cada ciclo
+ *   completo a tarefa amarela imprime os despertares por segundo e o erro de temporização.
  * - Funções de temporização do FreeRTOS (vTaskDelay).
  * - GPIOs digitais para controle do LED RGB.
  * - Comunicação serial (USB/UART) para exibir o estado atual do semáforo.
@@ -59,6 +62,7 @@
 #include "FreeRTOS.h"       ///< Inclui o header principal do FreeRTOS, com as definições do Kernel.
 #include "task.h"           ///< Inclui as funções de gerenciamento de tarefas do FreeRTOS (ex: xTaskCreate, vTaskDelay).
 #include "semphr.h"         ///< Inclui as funções de gerenciamento de semáforos do FreeRTOS (ex: xSemaphoreCreateBinary, xSemaphoreTake).
+#include "tickless_idle.h"  ///< Inclui o modo de baixo consumo (supressão do tick e WFI).
 #include <stdio.h>          ///< Inclui a biblioteca padrão de entrada e saída do C, usada aqui para a função printf().
 
 //================================================================================================
@@ -190,12 +194,37 @@ void tarefa_verde(void *params) {
  * @param params Ponteiro para parâmetros da tarefa (não utilizado neste projeto).
  * @note Esta tarefa simula a cor amarela ligando os LEDs vermelho e verde simultaneamente.
  * Ao final, ela sinaliza a tarefa_vermelho, fechando o ciclo.
+ * Também mede a duração real de cada ciclo completo (esperado: 5 s + 5 s + 3 s = 13 s)
+ * e imprime as estatísticas do tickless idle do ciclo anterior.
  */
 void tarefa_amarelo(void *params) {
+    const int64_t ciclo_esperado_us = 13000000;   /// Soma dos tempos de vermelho, verde e amarelo.
+    uint64_t inicio_ciclo_anterior = 0;
+    tickless_stats_t anterior;
+    tickless_idle_estatisticas(&anterior);
+
     while (true) {
         /// Bloqueia a tarefa até que a tarefa_verde chame xSemaphoreGive(semaforo_sinal_amarelo).
         xSemaphoreTake(semaforo_sinal_amarelo, portMAX_DELAY);
 
+        /// --- Relatório do ciclo anterior (precisão e despertares) ---
+        uint64_t agora_us = time_us_64();
+        if (inicio_ciclo_anterior != 0) {
+            int64_t ciclo_us = (int64_t)(agora_us - inicio_ciclo_anterior);
+            tickless_stats_t atual;
+            tickless_idle_estatisticas(&atual);
+            uint32_t despertares = atual.despertares - anterior.despertares;
+            uint64_t dormindo_us = atual.tempo_dormindo_us - anterior.tempo_dormindo_us;
+
+            printf("Ciclo: %lld us (erro %lld us) | despertares/s: %lu | dormindo: %llu%% | atraso max alarme: %lu us\n\n",
+                   ciclo_us, ciclo_us - ciclo_esperado_us,
+                   (unsigned long)((uint64_t)despertares * 1000000u / (uint64_t)ciclo_us),
+                   dormindo_us * 100u / (uint64_t)ciclo_us,
+                   (unsigned long)atual.atraso_max_us);
+            anterior = atual;
+        }
+        inicio_ciclo_anterior = agora_us;
+
         absolute_time_t start = get_absolute_time();
         printf("Semaforo: AMARELO\n");
         gpio_put(LED_RED_PIN, 1);   /// Ativa o vermelho para a cor amarela.
@@ -240,6 +269,9 @@ int main() {
     printf("Configurando hardware (GPIOs)...\n");
     inicializar_hardware_semaforo();
 
+    /// Reserva o alarme de hardware usado para acordar a CPU quando o tick está suspenso.
+    tickless_idle_iniciar();
+
     /// Cria os semáforos binários. Eles são criados no estado "vazio" (ou "tomado"),
     /// ou seja, uma chamada a xSemaphoreTake bloquearia imediatamente.
     semaforo_sinal_vermelho = xSemaphoreCreateBinary();
@@ -0,0 +1,51 @@
+/**
+ * @file tickless_idle.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Modo "tickless idle" do FreeRTOS para o RP2040 usando um alarme do timer de hardware.
+ *
+ * @details
+ * Com `configUSE_TICKLESS_IDLE = 1`, quando todas as tarefas estão bloqueadas o kernel
+ * chama vPortSuppressTicksAndSleep(). A implementação deste módulo substitui a versão
+ * padrão (fraca) do port:
+ * 1. Para o SysTick (a interrupção de 1 kHz deixa de acordar a CPU).
+ * 2. Programa um alarme do timer de 1 MHz para o instante do próximo desbloqueio.
+ * 3. Executa WFI até o alarme ou outra interrupção qualquer.
+ * 4. Mede o tempo realmente dormido e corrige a contagem de ticks com vTaskStepTick().
+ *
+ * Como o timer do RP2040 tem 64 bits, não há o limite de ~134 ms do SysTick de 24 bits:
+ * uma tarefa bloqueada por 5 s gera um único despertar.
+ *
+ * @note Suportado apenas com `configNUMBER_OF_CORES = 1`. Com SMP o outro núcleo
+ * continua dependendo do tick, então a configuração do Cap_03 mantém o tick ligado.
+ * @note Com `pico_enable_stdio_usb`, a pilha USB do SDK continua com sua própria
+ * tarefa de fundo periódica, que também acorda a CPU; para medir o mínimo de
+ * despertares, use a saída pela UART.
+ */
+
+#ifndef TICKLESS_IDLE_H
+#define TICKLESS_IDLE_H
+
+#include <stdint.h>
+
+/** @brief Estatísticas acumuladas desde o boot. */
+typedef struct {
+    uint32_t despertares;       ///< Saídas do WFI (cada uma é um despertar da CPU ociosa).
+    uint32_t abortados;         ///< Entradas canceladas (tarefa ficou pronta antes de dormir).
+    uint64_t tempo_dormindo_us; ///< Tempo total em WFI.
+    uint32_t atraso_max_us;     ///< Maior atraso entre o alvo do alarme e o despertar real.
+} tickless_stats_t;
+
+/**
+ * @brief Reserva o alarme de hardware usado para acordar a CPU.
+ * @note Chamar em main(), antes de vTaskStartScheduler().
+ */
+void tickless_idle_iniciar(void);
+
+/**
+ * @brief Copia as estatísticas atuais.
+ * @param saida Estrutura de destino.
+ */
+void tickless_idle_estatisticas(tickless_stats_t *saida);
+
+#endif // TICKLESS_IDLE_H
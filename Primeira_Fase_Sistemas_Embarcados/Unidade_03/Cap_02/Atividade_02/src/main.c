@@ -25,6 +25,11 @@
  * - joystick_monitor_task: Lê o joystick em alta frequência, imprime os valores e aciona
  *   um alarme caso os limites de tensão sejam excedidos.
  *
+ * Baixo consumo: com `configUSE_TICKLESS_IDLE = 1` (ver tickless_idle.c), sempre que todas as
+ * tarefas estão bloqueadas o tick de 1 kHz é suspenso e a CPU dorme em WFI até o próximo
+ * desbloqueio. A alive_task imprime, a cada segundo, os despertares da CPU ociosa e o
+ * erro do seu próprio período de 1 s.
+ *
  * Este exemplo é um excelente ponto de partida para entender conceitos-chave de sistemas de
  * tempo real, como gerenciamento de tarefas, prioridades, sincronização (suspend/resume)
  * e políticas de escalonamento.
@@ -39,6 +44,7 @@
 #include "hardware/adc.h"        ///< Biblioteca para controle do Conversor Analógico-Digital (ADC).
 #include "FreeRTOS.h"            ///< Header principal do FreeRTOS, define os tipos e funções do kernel.
 #include "task.h"                ///< Header da API de gerenciamento de tarefas do FreeRTOS (criar, deletar, suspender, etc.).
+#include "tickless_idle.h"       ///< Supressão do tick e WFI quando todas as tarefas estão bloqueadas.
 
 //================================================================================
 // Definições de Hardware e Constantes
@@ -212,11 +218,29 @@ void self_test_task(void *pvParameters) {
  * "heartbeat", um sinal visual de que o processador e o escalonador do FreeRTOS
  * estão funcionando corretamente.
  *
+ * A cada ciclo também imprime quantas vezes a CPU ociosa acordou e o erro do
+ * período medido com o timer de hardware (esperado: 1.000.000 us).
+ *
  * @param pvParameters Ponteiro para parâmetros da tarefa (não utilizado).
  */
 void alive_task(void *pvParameters) {
+    tickless_stats_t anterior;
+    tickless_idle_estatisticas(&anterior);
+    uint64_t inicio_anterior = time_us_64();
+
     // Loop infinito é o padrão para tarefas persistentes no FreeRTOS.
     while (1) {
+        // Relatório de baixo consumo do último ciclo.
+        uint64_t agora = time_us_64();
+        tickless_stats_t atual;
+        tickless_idle_estatisticas(&atual);
+        printf("Tickless -> periodo: %llu us | despertares: %lu | atraso max alarme: %lu us\n",
+               agora - inicio_anterior,
+               (unsigned long)(atual.despertares - anterior.despertares),
+               (unsigned long)atual.atraso_max_us);
+        anterior = atual;
+        inicio_anterior = agora;
+
         gpio_put(LED_ALIVE_PIN, 1); // Liga o LED vermelho.
 
         // Pausa a tarefa por 500 milissegundos.
@@ -352,6 +376,9 @@ int main() {
     printf("Iniciando Sistema FreeRTOS na BitDogLab\n");
     printf("======================================\n\n");
 
+    // Reserva o alarme de hardware que acorda a CPU quando o tick está suspenso.
+    tickless_idle_iniciar();
+
     /// Bloco de criação e configuração das tarefas, implementando a lógica de escalonamento.
     
     // 1. Cria as tarefas de operação normal, mas seus handles são salvos para
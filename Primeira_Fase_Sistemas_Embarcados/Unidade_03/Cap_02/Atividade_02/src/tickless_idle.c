@@ -0,0 +1,139 @@
+/**
+ * @file tickless_idle.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Implementação do vPortSuppressTicksAndSleep() com alarme do timer de hardware.
+ */
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/timer.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "hardware/structs/scb.h"
+#include "hardware/structs/systick.h"
+#include "hardware/regs/m0plus.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "tickless_idle.h"
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+#if ( configNUMBER_OF_CORES > 1 )
+#error "tickless_idle.c suporta apenas configNUMBER_OF_CORES = 1"
+#endif
+
+#define US_POR_TICK (1000000u / configTICK_RATE_HZ)   ///< 1000 us com tick de 1 kHz.
+
+static int alarme = -1;             ///< Alarme de hardware reservado (-1 = não iniciado).
+static tickless_stats_t stats;      ///< Acessado apenas com interrupções desabilitadas.
+
+/** @brief Callback vazio: o alarme serve apenas para tirar a CPU do WFI. */
+static void alarme_cb(uint alarm_num) {
+    (void)alarm_num;
+}
+
+void tickless_idle_iniciar(void) {
+    alarme = hardware_alarm_claim_unused(true);
+    hardware_alarm_set_callback((uint)alarme, alarme_cb);
+}
+
+void tickless_idle_estatisticas(tickless_stats_t *saida) {
+    taskENTER_CRITICAL();
+    *saida = stats;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Chamado pela tarefa Idle quando nenhuma tarefa ficará pronta pelos próximos
+ * xExpectedIdleTime ticks. Substitui a versão fraca do port RP2040.
+ * @param xExpectedIdleTime Ticks até a próxima tarefa desbloquear por tempo.
+ */
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime) {
+    if (alarme < 0) {
+        return; // tickless_idle_iniciar() não foi chamada: mantém o tick normal.
+    }
+
+    const uint32_t ciclos_por_us = clock_get_hz(clk_sys) / 1000000u;
+    const uint32_t ciclos_por_tick = clock_get_hz(clk_sys) / configTICK_RATE_HZ;
+
+    portDISABLE_INTERRUPTS();
+
+    // Para o SysTick. O valor corrente (CVR) diz quanto falta para o fim do tick atual.
+    systick_hw->csr &= ~M0PLUS_SYST_CSR_ENABLE_BITS;
+
+    // Se um tick ficou pendente, ou uma tarefa ficou pronta por interrupção,
+    // volta sem dormir: o SysTick continua de onde parou.
+    if ((scb_hw->icsr & M0PLUS_ICSR_PENDSTSET_BITS) ||
+        eTaskConfirmSleepModeStatus() == eAbortSleep) {
+        systick_hw->csr |= M0PLUS_SYST_CSR_ENABLE_BITS;
+        stats.abortados++;
+        portENABLE_INTERRUPTS();
+        return;
+    }
+
+    uint64_t inicio = time_us_64();
+    uint32_t restante_us = systick_hw->cvr / ciclos_por_us;
+    uint64_t alvo = inicio + restante_us + (uint64_t)(xExpectedIdleTime - 1u) * US_POR_TICK;
+
+    // Retorna true se o alvo já passou; nesse caso não há por que dormir.
+    if (!hardware_alarm_set_target((uint)alarme, from_us_since_boot(alvo))) {
+        // Com PRIMASK ativo, uma interrupção pendente ainda tira o núcleo do WFI;
+        // ela só é atendida quando as interrupções forem reabilitadas abaixo.
+        __dsb();
+        __wfi();
+        stats.despertares++;
+    }
+    uint64_t agora = time_us_64();
+    hardware_alarm_cancel((uint)alarme);
+
+    // --- Correção da contagem de ticks ---
+    uint64_t decorrido = agora - inicio;
+    TickType_t ticks_completos;
+    uint32_t ciclos_ate_proximo;
+
+    if (decorrido < restante_us) {
+        // Acordou antes mesmo de terminar o tick em que entrou.
+        ticks_completos = 0;
+        ciclos_ate_proximo = (uint32_t)(restante_us - decorrido) * ciclos_por_us;
+    } else {
+        uint64_t apos = decorrido - restante_us;
+        ticks_completos = (TickType_t)(1u + apos / US_POR_TICK);
+        ciclos_ate_proximo = (uint32_t)(US_POR_TICK - (apos % US_POR_TICK)) * ciclos_por_us;
+
+        if (ticks_completos >= xExpectedIdleTime) {
+            // O tick que desbloqueia a tarefa fica a cargo da própria interrupção do
+            // SysTick (para o kernel processar o desbloqueio), que dispara em seguida.
+            ticks_completos = xExpectedIdleTime - 1u;
+            ciclos_ate_proximo = ciclos_por_us;
+        }
+        if (agora >= alvo && (uint32_t)(agora - alvo) > stats.atraso_max_us) {
+            stats.atraso_max_us = (uint32_t)(agora - alvo);
+        }
+    }
+    if (ciclos_ate_proximo < ciclos_por_us) {
+        ciclos_ate_proximo = ciclos_por_us;
+    }
+    stats.tempo_dormindo_us += decorrido;
+
+    // Reinicia o SysTick com o período parcial; depois da recarga volta ao período normal.
+    // O tempo gasto em vTaskStepTick() garante que o valor parcial já foi carregado.
+    systick_hw->rvr = ciclos_ate_proximo - 1u;
+    systick_hw->cvr = 0;
+    systick_hw->csr |= M0PLUS_SYST_CSR_ENABLE_BITS;
+    vTaskStepTick(ticks_completos);
+    systick_hw->rvr = ciclos_por_tick - 1u;
+
+    portENABLE_INTERRUPTS();
+}
+
+#else // configUSE_TICKLESS_IDLE == 0
+
+void tickless_idle_iniciar(void) {
+}
+
+void tickless_idle_estatisticas(tickless_stats_t *saida) {
+    memset(saida, 0, sizeof(*saida));
+}
+
+#endif
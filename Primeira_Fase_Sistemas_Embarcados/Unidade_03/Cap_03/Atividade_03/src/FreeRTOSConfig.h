@@ -146,4 +146,23 @@ to exclude the API function. */
 
 /* A header file that defines trace macro can be included here. */
 
+/* Contagem de trocas de contexto por núcleo (ver main.c, timer de métricas) e
+ * gravação de eventos para o trace (ver trace_recorder.h). O id de tarefa gravado é
+ * o uxTaskNumber, definido pela aplicação com vTaskSetTaskNumber(); o de fila é o
+ * uxQueueNumber, definido com vQueueSetQueueNumber(). Ambos exigem configUSE_TRACE_FACILITY. */
+#ifndef __ASSEMBLER__
+#include <stdint.h>
+#include "trace_recorder.h"
+extern volatile uint32_t trocas_de_contexto[];
+#endif
+#define traceTASK_SWITCHED_IN()                                                   \
+    do {                                                                          \
+        trocas_de_contexto[ portGET_CORE_ID() ]++;                                \
+        trace_evento( TRACE_TAREFA_ENTRA, ( uint16_t ) pxCurrentTCB->uxTaskNumber ); \
+    } while( 0 )
+#define traceTASK_SWITCHED_OUT()                trace_evento( TRACE_TAREFA_SAI, ( uint16_t ) pxCurrentTCB->uxTaskNumber )
+#define traceQUEUE_SEND( pxQueue )              trace_evento( TRACE_FILA_ENVIA, ( uint16_t ) ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )     trace_evento( TRACE_FILA_ENVIA, ( uint16_t ) ( pxQueue )->uxQueueNumber )
+#define traceQUEUE_RECEIVE( pxQueue )           trace_evento( TRACE_FILA_RECEBE, ( uint16_t ) ( pxQueue )->uxQueueNumber )
+
 #endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
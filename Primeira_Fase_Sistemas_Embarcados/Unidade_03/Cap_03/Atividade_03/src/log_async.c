@@ -0,0 +1,176 @@
+/**
+ * @file log_async.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Implementação do registro (log) assíncrono baseado em fila do FreeRTOS.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "log_async.h"
+
+/** @brief Registro armazenado na fila (28 bytes). */
+typedef struct {
+    const char *fmt;        ///< Formato estático, ou NULL quando o registro é texto pronto.
+    uint32_t tempo_us;      ///< Instante da chamada (time_us_32).
+    uint8_t core;           ///< Núcleo que gerou o registro.
+    uint8_t nargs;          ///< Quantidade de argumentos válidos.
+    union {
+        uint32_t args[LOG_ASYNC_MAX_ARGS];
+        char texto[LOG_ASYNC_TAM_TEXTO];
+    } dados;
+} log_registro_t;
+
+static QueueHandle_t log_fila = NULL;
+static SemaphoreHandle_t log_saida = NULL;   ///< Posse da USB: log_task ou um despejo.
+static log_async_stats_t log_stats = {0};
+
+/**
+ * @brief Incrementa um contador de estatística de forma segura entre núcleos.
+ * @details Com SMP, dois núcleos podem chamar o log ao mesmo tempo; a seção crítica
+ * do port RP2040 usa um spinlock de hardware, então o custo é de poucos ciclos.
+ */
+static void log_incrementa(uint32_t *contador) {
+    if (portCHECK_IF_IN_ISR()) {
+        UBaseType_t estado = taskENTER_CRITICAL_FROM_ISR();
+        (*contador)++;
+        taskEXIT_CRITICAL_FROM_ISR(estado);
+    } else {
+        taskENTER_CRITICAL();
+        (*contador)++;
+        taskEXIT_CRITICAL();
+    }
+}
+
+/** @brief Tenta colocar o registro na fila sem bloquear e atualiza as estatísticas. */
+static void log_publica(const log_registro_t *reg) {
+    BaseType_t ok;
+
+    if (log_fila == NULL) {
+        return;
+    }
+
+    if (portCHECK_IF_IN_ISR()) {
+        // A log_task tem prioridade mínima: não há motivo para pedir troca de contexto.
+        ok = xQueueSendFromISR(log_fila, reg, NULL);
+    } else {
+        ok = xQueueSend(log_fila, reg, 0);
+    }
+
+    log_incrementa(ok == pdTRUE ? &log_stats.enviados : &log_stats.descartados);
+}
+
+void log_async_enviar(const char *fmt, const uint32_t *args, uint32_t nargs) {
+    log_registro_t reg;
+
+    if (nargs > LOG_ASYNC_MAX_ARGS) {
+        nargs = LOG_ASYNC_MAX_ARGS;
+    }
+
+    reg.fmt = fmt;
+    reg.tempo_us = time_us_32();
+    reg.core = (uint8_t)get_core_num();
+    reg.nargs = (uint8_t)nargs;
+    for (uint32_t i = 0; i < LOG_ASYNC_MAX_ARGS; i++) {
+        reg.dados.args[i] = (i < nargs) ? args[i] : 0u;
+    }
+
+    log_publica(&reg);
+}
+
+void log_async_texto(const char *texto) {
+    log_registro_t reg;
+
+    reg.fmt = NULL;
+    reg.tempo_us = time_us_32();
+    reg.core = (uint8_t)get_core_num();
+    reg.nargs = 0;
+    strncpy(reg.dados.texto, texto, LOG_ASYNC_TAM_TEXTO - 1);
+    reg.dados.texto[LOG_ASYNC_TAM_TEXTO - 1] = '\0';
+
+    log_publica(&reg);
+}
+
+void log_async_pausar(void) {
+    xSemaphoreTake(log_saida, portMAX_DELAY);
+}
+
+void log_async_retomar(void) {
+    xSemaphoreGive(log_saida);
+}
+
+void log_async_estatisticas(log_async_stats_t *saida) {
+    taskENTER_CRITICAL();
+    *saida = log_stats;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief Tarefa de escrita: única responsável pelo printf/USB CDC.
+ * @details Roda na prioridade mínima, portanto só consome CPU quando nenhuma
+ * tarefa de aplicação está pronta. Sempre que novos descartes acontecem,
+ * emite um aviso com o total acumulado.
+ * @param param Não utilizado.
+ */
+static void log_task(void *param) {
+    log_registro_t reg;
+    uint32_t descartes_reportados = 0;
+
+    while (1) {
+        if (xQueueReceive(log_fila, &reg, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        // +1 porque o registro atual acabou de sair da fila.
+        uint32_t ocupacao = (uint32_t)uxQueueMessagesWaiting(log_fila) + 1;
+        if (ocupacao > log_stats.pico_fila) {
+            log_stats.pico_fila = ocupacao;
+        }
+
+        // Um registro por vez com a saída: um despejo (log_async_pausar) nunca é intercalado.
+        xSemaphoreTake(log_saida, portMAX_DELAY);
+        printf("[%10lu us][C%u] ", (unsigned long)reg.tempo_us, reg.core);
+        if (reg.fmt == NULL) {
+            printf("%s\n", reg.dados.texto);
+        } else {
+            // Argumentos além dos usados pelo formato são simplesmente ignorados pelo printf.
+            printf(reg.fmt, reg.dados.args[0], reg.dados.args[1],
+                   reg.dados.args[2], reg.dados.args[3]);
+        }
+
+        uint32_t descartados = log_stats.descartados;
+        if (descartados != descartes_reportados) {
+            printf("[LOG] fila cheia: %lu registros descartados no total\n",
+                   (unsigned long)descartados);
+            descartes_reportados = descartados;
+        }
+        xSemaphoreGive(log_saida);
+    }
+}
+
+bool log_async_iniciar(void) {
+    log_fila = xQueueCreate(LOG_ASYNC_TAM_FILA, sizeof(log_registro_t));
+    log_saida = xSemaphoreCreateMutex();
+    if (log_fila == NULL || log_saida == NULL) {
+        if (log_fila != NULL) vQueueDelete(log_fila);
+        if (log_saida != NULL) vSemaphoreDelete(log_saida);
+        log_fila = NULL;
+        log_saida = NULL;
+        return false;
+    }
+
+    if (xTaskCreate(log_task, "LogTask", LOG_ASYNC_PILHA, NULL, tskIDLE_PRIORITY, NULL) != pdPASS) {
+        vQueueDelete(log_fila);
+        vSemaphoreDelete(log_saida);
+        log_fila = NULL;
+        log_saida = NULL;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file log_async.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Interface do registro (log) assíncrono para tarefas FreeRTOS.
+ *
+ * @details
+ * As tarefas não chamam mais `printf` diretamente. Em vez disso, elas enfileiram
+ * um registro compacto (ponteiro para a string de formato + até 4 argumentos inteiros,
+ * ou um texto curto já formatado) numa fila do FreeRTOS com timeout zero.
+ * Uma tarefa de baixa prioridade (`log_task`) retira os registros, faz a formatação
+ * e a escrita na USB CDC. Assim, nenhuma tarefa de aplicação fica bloqueada pelo
+ * tempo de transmissão da USB nem disputa um mutex com tarefas de menor prioridade.
+ *
+ * Se a fila estiver cheia, o registro é descartado e o descarte é contabilizado.
+ *
+ * Saídas longas que não cabem na fila (o despejo do trace) escrevem direto, entre
+ * log_async_pausar() e log_async_retomar(): nesse intervalo a log_task não escreve,
+ * e os registros esperam na fila (ou são descartados, se ela encher).
+ *
+ * @note A string de formato precisa ter duração estática (literal), pois apenas o
+ * ponteiro é copiado. Somente argumentos inteiros (`%d`, `%u`, `%x`, `%c`) são
+ * suportados; valores `float` devem ser convertidos antes ou enviados com log_async_texto().
+ */
+
+#ifndef LOG_ASYNC_H
+#define LOG_ASYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// --- Parâmetros de configuração ---
+#define LOG_ASYNC_TAM_FILA      32   ///< Número máximo de registros pendentes.
+#define LOG_ASYNC_MAX_ARGS      4    ///< Argumentos inteiros por registro.
+#define LOG_ASYNC_TAM_TEXTO     16   ///< Bytes do texto pré-formatado (inclui o '\0').
+#define LOG_ASYNC_PILHA         512  ///< Pilha da log_task, em palavras.
+
+/** @brief Estatísticas acumuladas do registro assíncrono. */
+typedef struct {
+    uint32_t enviados;      ///< Registros aceitos pela fila.
+    uint32_t descartados;   ///< Registros perdidos por fila cheia (overflow).
+    uint32_t pico_fila;     ///< Maior ocupação da fila observada pela log_task.
+} log_async_stats_t;
+
+/**
+ * @brief Cria a fila de registros e a tarefa de escrita (prioridade mínima).
+ * @return true se a fila e a tarefa foram criadas, false em caso de falta de memória.
+ */
+bool log_async_iniciar(void);
+
+/**
+ * @brief Enfileira um registro com string de formato e argumentos inteiros.
+ * @details Nunca bloqueia. Pode ser chamada de tarefas ou de interrupções.
+ * @param fmt   String de formato com duração estática.
+ * @param args  Vetor de argumentos (pode ser NULL se nargs == 0).
+ * @param nargs Quantidade de argumentos (o excedente a LOG_ASYNC_MAX_ARGS é ignorado).
+ */
+void log_async_enviar(const char *fmt, const uint32_t *args, uint32_t nargs);
+
+/**
+ * @brief Enfileira um texto curto já formatado (truncado em LOG_ASYNC_TAM_TEXTO - 1).
+ * @param texto Texto a ser copiado para o registro.
+ */
+void log_async_texto(const char *texto);
+
+/**
+ * @brief Toma a saída USB só para o chamador: espera a log_task terminar o registro
+ *        em andamento e a impede de escrever até log_async_retomar().
+ * @details Só para tarefas (usa um mutex). O chamador pode usar printf diretamente.
+ */
+void log_async_pausar(void);
+
+/** @brief Devolve a saída à log_task. */
+void log_async_retomar(void);
+
+/**
+ * @brief Copia as estatísticas atuais (enviados, descartados e pico de ocupação).
+ * @param saida Estrutura de destino.
+ */
+void log_async_estatisticas(log_async_stats_t *saida);
+
+/**
+ * @brief Macro de conveniência: LOG_ASYNC("X=%d Y=%d\n", x, y);
+ * @details Monta o vetor de argumentos na pilha do chamador e conta os elementos
+ * em tempo de compilação (o primeiro elemento é apenas um marcador).
+ */
+#define LOG_ASYNC(fmt, ...)                                                        \
+    do {                                                                           \
+        const uint32_t _log_args[] = { 0u, ##__VA_ARGS__ };                        \
+        log_async_enviar((fmt), &_log_args[1],                                     \
+                         (uint32_t)(sizeof(_log_args) / sizeof(_log_args[0])) - 1u); \
+    } while (0)
+
+#endif // LOG_ASYNC_H
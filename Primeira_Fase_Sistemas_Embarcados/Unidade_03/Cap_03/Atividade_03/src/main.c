@@ -2,7 +2,7 @@
  * @file main.c
  * @author Manoel Felipe Costa Furtado
  * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
- * @version 1.0
+ * @version 1.1
  * @date 2025-07-06
  * @brief Sistema multitarefa com FreeRTOS e SMP no Pico W para leitura de joystick e controle de buzzer.
  *
@@ -18,8 +18,25 @@
  * - `processing_task`: Processa os eventos da fila.
  * - `buzzer_task`: Controla o buzzer.
  * * **Mecanismos de Sincronização:**
- * - **Fila (Queue):** Uma fila unificada (`event_queue`) é usada para enviar eventos das tarefas de entrada (Núcleo 0) para a tarefa de processamento (Núcleo 1).
- * - **Mutex:** O acesso ao terminal serial (printf) é protegido por um mutex para evitar mensagens corrompidas, já que tarefas em diferentes núcleos poderiam tentar escrever ao mesmo tempo.
+ * - **Filas + Queue Set:** Cada produtor tem sua própria fila. O joystick usa uma fila de 1 posição
+ *   sobrescrita (`xQueueOverwrite`), que guarda apenas a amostra mais recente; o botão usa uma fila
+ *   de 10 posições. As duas pertencem a um *queue set*: a `processing_task` acorda uma vez e esvazia
+ *   todos os eventos pendentes (recepção em lote), botões primeiro. Assim, amostras de joystick em
+ *   alta taxa não ocupam o espaço dos eventos de botão.
+ *   Com `PROCESSAMENTO_EM_LOTE` em 0, o código volta ao modelo antigo (fila única, um evento por
+ *   `xQueueReceive`), permitindo comparar as duas abordagens.
+ * - **Trace:** Trocas de tarefa e operações de fila são gravadas em RAM pelos hooks do
+ *   FreeRTOS (trace_recorder.h). Enviar 't' pelo terminal despeja a gravação (com a
+ *   saída do log pausada, para não intercalar as linhas); o script
+ *   `tools/trace_to_chrome.py` gera o JSON para chrome://tracing ou ui.perfetto.dev.
+ * - **Métrica:** Um timer de software imprime, a cada segundo, as trocas de contexto por núcleo
+ *   (contadas pelo hook `traceTASK_SWITCHED_IN` no FreeRTOSConfig.h) e os despertares da
+ *   `processing_task`.
+ * - **Log assíncrono:** As tarefas não chamam `printf` diretamente. Elas enfileiram registros
+ *   compactos (formato + argumentos) com timeout zero, e uma tarefa de prioridade mínima
+ *   (`log_task`, ver log_async.h) formata e escreve na USB. Isso substitui o antigo mutex
+ *   da USB, que causava inversão de prioridade e jitter quando uma tarefa esperava a
+ *   transmissão CDC de outra. Registros perdidos por fila cheia são contados.
  * - **Semáforo Contador:** Gerencia o acesso ao buzzer, permitindo enfileirar até 2 solicitações de som.
  *
  * @note Para compilar este projeto, as seguintes configurações devem estar ativas no arquivo FreeRTOSConfig.h:
@@ -39,6 +56,9 @@
 #include "task.h"         // Funções de criação e controle de tarefas
 #include "queue.h"        // Funções de criação e manipulação de filas
 #include "semphr.h"       // Biblioteca para semáforos e mutexes
+#include "timers.h"       // Timers de software (relatório de métricas)
+#include "log_async.h"    // Registro (log) assíncrono, sem bloqueio nas tarefas
+#include "trace_recorder.h" // Gravação de eventos para o trace (Chrome/Perfetto)
 
 // --- Definições de pinos GPIO ---
 #define VRY_PIN 26          // ADC0 para o eixo Y do joystick
@@ -47,6 +67,17 @@
 #define BUZZER_PIN 21       // Pino digital para o buzzer passivo
 #define ERROR_LED_PIN 13    // Pino para o LED de sinalização de erro crítico
 
+// --- Configuração do processamento de eventos ---
+#define PROCESSAMENTO_EM_LOTE 1     // 1 = filas separadas + queue set + lote | 0 = fila única (modelo antigo)
+#define JOYSTICK_PERIOD_MS    100   // Período de amostragem do joystick
+#define BUTTON_QUEUE_LEN      10    // Eventos de botão que podem ficar pendentes
+#define METRICS_PERIOD_MS     1000  // Período do relatório de trocas de contexto
+
+// --- Identificadores usados no trace (0 = tarefas do sistema: Idle, Timer, Log) ---
+enum { TRACE_ID_JOYSTICK = 1, TRACE_ID_BUTTON, TRACE_ID_PROCESSING, TRACE_ID_BUZZER, TRACE_ID_DUMP };
+enum { TRACE_FILA_JOYSTICK = 1, TRACE_FILA_BUTTON, TRACE_FILA_EVENTOS, TRACE_FILA_BUZZER };
+enum { TRACE_ZONA_LOTE = 1 };
+
 // --- Definições para a fila de eventos ---
 
 /** @brief Enumeração para identificar o tipo de evento na fila. */
@@ -63,19 +94,52 @@ typedef struct {
 
 
 // --- Handles globais para objetos FreeRTOS ---
+#if PROCESSAMENTO_EM_LOTE
+QueueHandle_t joystick_queue;   // 1 posição, sempre com a amostra mais recente
+QueueHandle_t button_queue;     // BUTTON_QUEUE_LEN posições
+QueueSetHandle_t event_set;     // Conjunto com as duas filas acima
+#else
 QueueHandle_t event_queue;
-SemaphoreHandle_t usb_mutex;
+#endif
 SemaphoreHandle_t buzzer_sem;
+TimerHandle_t metrics_timer;
+
+// --- Métricas ---
+// Incrementado pelo hook traceTASK_SWITCHED_IN (ver FreeRTOSConfig.h), um contador por núcleo.
+volatile uint32_t trocas_de_contexto[configNUMBER_OF_CORES];
+// Quantas vezes a processing_task saiu do bloqueio e quantos eventos ela tratou.
+volatile uint32_t processing_wakeups;
+volatile uint32_t processing_events;
 
 // --- Handles para as tarefas (necessários para definir a afinidade de núcleo) ---
 TaskHandle_t joystick_task_handle;
 TaskHandle_t button_task_handle;
 TaskHandle_t processing_task_handle;
 TaskHandle_t buzzer_task_handle;
+TaskHandle_t trace_dump_task_handle;
 
 // --- Protótipo da função de tratamento de erro ---
 void critical_error_handler();
 
+/**
+ * @brief Publica um evento de entrada sem bloquear o produtor.
+ * @details No modo em lote, o joystick sobrescreve a única posição da sua fila
+ * (só a amostra mais recente interessa) e o botão vai para a fila própria.
+ * No modo antigo, ambos disputam a fila única.
+ * @param event Evento a ser publicado.
+ */
+static void publish_event(const queue_event_t *event) {
+#if PROCESSAMENTO_EM_LOTE
+    if (event->type == JOYSTICK_EVENT) {
+        xQueueOverwrite(joystick_queue, event);
+    } else {
+        xQueueSend(button_queue, event, 0);
+    }
+#else
+    xQueueSend(event_queue, event, 0);
+#endif
+}
+
 /**
  * @brief Tarefa 1: Lê os eixos X e Y do joystick. (Fixada no Núcleo 0)
  * @details A cada 100ms, esta tarefa lê os valores analógicos dos eixos do joystick,
@@ -94,21 +158,17 @@ void joystick_task(void *param) {
         adc_select_input(0); // Canal ADC para VRy
         uint16_t vry = adc_read();
 
-        // --- Impressão de Debug (Protegida por Mutex) ---
-        // Pega o mutex antes de usar o printf para evitar conflito com o Core 1
-        if (xSemaphoreTake(usb_mutex, pdMS_TO_TICKS(100))) {
-            printf("CORE 0: Joystick leu X=%d, Y=%d\n", vrx, vry);
-            // Devolve o mutex assim que terminar
-            xSemaphoreGive(usb_mutex);
-        }
+        // --- Impressão de Debug (Log assíncrono) ---
+        // Apenas enfileira o registro; a escrita na USB acontece na log_task.
+        LOG_ASYNC("CORE 0: Joystick leu X=%d, Y=%d\n", vrx, vry);
 
         queue_event_t event = {
             .type = JOYSTICK_EVENT,
             .data = {vrx, vry}
         };
 
-        xQueueSend(event_queue, &event, 0);
-        vTaskDelay(pdMS_TO_TICKS(100));
+        publish_event(&event);
+        vTaskDelay(pdMS_TO_TICKS(JOYSTICK_PERIOD_MS));
     }
 }
 
@@ -137,17 +197,14 @@ void button_task(void *param) {
             if (!gpio_get(JOYSTICK_SW_PIN)) {
               
                 // --- AÇÃO: Pressionamento confirmado ---
-                // --- Impressão de Debug (Protegida por Mutex) ---
-                if (xSemaphoreTake(usb_mutex, pdMS_TO_TICKS(100))) {
-                    printf("CORE 0: Botao detectado!\n");
-                    xSemaphoreGive(usb_mutex);
-                }
+                // --- Impressão de Debug (Log assíncrono) ---
+                LOG_ASYNC("CORE 0: Botao detectado!\n");
            
                 queue_event_t event = {
                     .type = BUTTON_EVENT,
                     .data = {0, 0} // Dados não são usados para este evento
                 };
-                xQueueSend(event_queue, &event, 0);
+                publish_event(&event);
 
                 // 4. AGUARDA SOLTAR: Loop que espera o botão ser fisicamente solto.
                 // Isso é crucial para garantir que apenas UM evento seja enviado por
@@ -155,10 +212,7 @@ void button_task(void *param) {
                 while(!gpio_get(JOYSTICK_SW_PIN)) {
                     vTaskDelay(pdMS_TO_TICKS(50)); // Espera em blocos de 50ms para não sobrecarregar a CPU
                 }
-                if (xSemaphoreTake(usb_mutex, pdMS_TO_TICKS(100))) {
-                    printf("CORE 0: Botao Solto!\n");
-                    xSemaphoreGive(usb_mutex);
-                }
+                LOG_ASYNC("CORE 0: Botao Solto!\n");
 
             }
         }
@@ -190,57 +244,150 @@ void buzzer_task(void *param) {
 }
 
 /**
- * @brief Tarefa 3: Processa os dados recebidos da fila. (Fixada no Núcleo 1)
- * @details Esta tarefa aguarda por eventos na fila. Ao receber um evento,
- * ela o processa: imprime no terminal serial (protegido por mutex) e,
- * se for um evento de botão ou um movimento significativo do joystick,
- * libera o semáforo para acionar o buzzer.
- * @param param Ponteiro para parâmetros da tarefa (não utilizado).
+ * @brief Trata um único evento: registra no log e decide se o buzzer deve tocar.
+ * @param event Evento recebido.
+ * @return 1 se o buzzer deve ser acionado, 0 caso contrário.
  */
-void processing_task(void *param) {
-    queue_event_t received_event;
+static int handle_event(const queue_event_t *event) {
     // Define uma "zona morta" para o joystick para evitar acionamentos por ruído
     // Valores típicos para um ADC de 12-bit (0-4095) com centro em ~2048
     const int dead_zone_low = 1000;
     const int dead_zone_high = 3000;
+    int trigger_buzzer = 0;
+
+    // O log é assíncrono: a tarefa nunca espera pela USB, mesmo que a
+    // tarefa de log (prioridade mínima) esteja no meio de uma transmissão.
+    switch (event->type) {
+        case JOYSTICK_EVENT:
+            // A impressão da leitura foi movida para a tarefa no Core 0
+            // Esta tarefa agora apenas imprime o evento que processa
+            LOG_ASYNC("CORE 1: Joystick - X: %d, Y: %d\n", event->data[0], event->data[1]);
+            if (event->data[0] < dead_zone_low || event->data[0] > dead_zone_high ||
+                event->data[1] < dead_zone_low || event->data[1] > dead_zone_high) {
+                trigger_buzzer = 1;
+            }
+            break;
+        case BUTTON_EVENT:
+            LOG_ASYNC("CORE 1: Processando evento de BOTAO.\n");
+            trigger_buzzer = 1;
+            break;
+    }
+    processing_events++;
+    return trigger_buzzer;
+}
+
+/**
+ * @brief Tarefa 3: Processa os eventos das filas. (Fixada no Núcleo 1)
+ * @details No modo em lote, a tarefa bloqueia no queue set e, a cada despertar,
+ * trata todos os eventos pendentes de uma só vez. Cada leitura segue um handle
+ * devolvido pelo conjunto, como o FreeRTOS exige; os botões são tratados na hora e
+ * a amostra mais recente do joystick fica para o fim do lote. O buzzer é liberado
+ * no máximo uma vez por lote.
+ * No modo antigo, trata um evento por xQueueReceive (uma troca de contexto por evento).
+ * @param param Ponteiro para parâmetros da tarefa (não utilizado).
+ */
+void processing_task(void *param) {
+    queue_event_t received_event;
+#if PROCESSAMENTO_EM_LOTE
+    queue_event_t joystick_event;
+    QueueSetMemberHandle_t membro;
+#endif
 
     while (1) {
+        int trigger_buzzer = 0;
+
+#if PROCESSAMENTO_EM_LOTE
+        // Bloqueia até que qualquer uma das filas do conjunto tenha dados.
+        membro = xQueueSelectFromSet(event_set, portMAX_DELAY);
+        if (membro == NULL) {
+            continue;
+        }
+        processing_wakeups++;
+        TRACE_ZONA_INICIO(TRACE_ZONA_LOTE);
+
+        // Um xQueueReceive por handle do conjunto: ler as filas por fora deixaria
+        // handles sem item (despertares falsos) e encheria o conjunto em rajadas.
+        bool tem_joystick = false;
+        do {
+            if (xQueueReceive(membro, &received_event, 0) != pdTRUE) {
+                continue;
+            }
+            if (membro == button_queue) {
+                // Botões na hora: eventos raros e que não podem ser perdidos.
+                trigger_buzzer |= handle_event(&received_event);
+            } else {
+                // Joystick: só a amostra mais recente do lote, tratada no fim.
+                joystick_event = received_event;
+                tem_joystick = true;
+            }
+        } while ((membro = xQueueSelectFromSet(event_set, 0)) != NULL);
+
+        if (tem_joystick) {
+            trigger_buzzer |= handle_event(&joystick_event);
+        }
+        TRACE_ZONA_FIM(TRACE_ZONA_LOTE);
+#else
         // Bloqueia a tarefa até que um item seja recebido da fila.
         // portMAX_DELAY significa esperar para sempre, se necessário.
-        if (xQueueReceive(event_queue, &received_event, portMAX_DELAY) == pdTRUE) {
-            
-            int trigger_buzzer = 0;
-
-            // Tenta obter o mutex para usar a porta serial. Espera até 100ms.
-            // Essencial em um sistema SMP para evitar que duas tarefas em núcleos diferentes
-            // escrevam na serial ao mesmo tempo, corrompendo a saída.
-            if (xSemaphoreTake(usb_mutex, pdMS_TO_TICKS(100))) {
-                switch (received_event.type) {
-                    case JOYSTICK_EVENT:
-                        // A impressão da leitura foi movida para a tarefa no Core 0
-                        // Esta tarefa agora apenas imprime o evento que processa
-                        printf("CORE 1: Joystick - X: %d, Y: %d\n", received_event.data[0], received_event.data[1]);
-                        if (received_event.data[0] < dead_zone_low || received_event.data[0] > dead_zone_high ||
-                            received_event.data[1] < dead_zone_low || received_event.data[1] > dead_zone_high) {
-                            trigger_buzzer = 1;
-                        }
-                        break;
-                    case BUTTON_EVENT:
-                        printf("CORE 1: Processando evento de BOTAO.\n");
-                        trigger_buzzer = 1;
-                        break;
-                }
-                // Libera o mutex assim que terminar de usar a serial.
-                xSemaphoreGive(usb_mutex);
-            }
+        if (xQueueReceive(event_queue, &received_event, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        processing_wakeups++;
+        TRACE_ZONA_INICIO(TRACE_ZONA_LOTE);
+        trigger_buzzer = handle_event(&received_event);
+        TRACE_ZONA_FIM(TRACE_ZONA_LOTE);
+#endif
+
+        if (trigger_buzzer) {
+            // Libera ("dá") o semáforo para a buzzer_task tocar o som.
+            // Se o semáforo já estiver no seu valor máximo (2), esta chamada não fará nada
+            // e não bloqueará a tarefa.
+            xSemaphoreGive(buzzer_sem);
+        }
+    }
+}
 
-            if (trigger_buzzer) {
-                // Libera ("dá") o semáforo para a buzzer_task tocar o som.
-                // Se o semáforo já estiver no seu valor máximo (2), esta chamada não fará nada
-                // e não bloqueará a tarefa.
-                xSemaphoreGive(buzzer_sem);
-            }
+/**
+ * @brief Callback do timer de métricas: imprime taxas do último período.
+ * @details Executa no contexto da tarefa de timers do FreeRTOS; como o log é
+ * assíncrono, não bloqueia. As taxas são "por segundo" quando METRICS_PERIOD_MS = 1000.
+ * @param timer Handle do timer (não utilizado).
+ */
+static void metrics_timer_cb(TimerHandle_t timer) {
+    static uint32_t last_switches[configNUMBER_OF_CORES];
+    static uint32_t last_wakeups;
+    static uint32_t last_events;
+
+    uint32_t sw0 = trocas_de_contexto[0];
+    uint32_t sw1 = trocas_de_contexto[1];
+    uint32_t wakeups = processing_wakeups;
+    uint32_t events = processing_events;
+
+    LOG_ASYNC("METRICAS: trocas/s C0=%u C1=%u | despertares=%u eventos=%u\n",
+              sw0 - last_switches[0], sw1 - last_switches[1],
+              wakeups - last_wakeups, events - last_events);
+
+    last_switches[0] = sw0;
+    last_switches[1] = sw1;
+    last_wakeups = wakeups;
+    last_events = events;
+}
+
+/**
+ * @brief Tarefa 5: Despeja o trace quando o usuário envia 't' pelo terminal.
+ * @details Roda na prioridade mínima (o despejo leva centenas de milissegundos
+ * de escrita na USB) e consulta a entrada serial a cada 200ms sem bloquear.
+ * O despejo não cabe na fila do log: ele escreve direto, com a log_task pausada.
+ * @param param Ponteiro para parâmetros da tarefa (não utilizado).
+ */
+void trace_dump_task(void *param) {
+    while (1) {
+        if (getchar_timeout_us(0) == 't') {
+            log_async_pausar();
+            trace_despejar();
+            log_async_retomar();
         }
+        vTaskDelay(pdMS_TO_TICKS(200));
     }
 }
 
@@ -269,7 +416,7 @@ void critical_error_handler() {
  * @brief Função principal, ponto de entrada do programa.
  * @details Orquestra toda a inicialização do sistema:
  * 1. Inicializa a E/S padrão.
- * 2. Cria os objetos de sincronização do FreeRTOS (fila, mutex, semáforo), com verificação de erro.
+ * 2. Cria os objetos do FreeRTOS (fila, log assíncrono, semáforo), com verificação de erro.
  * 3. Cria as 4 tarefas de aplicação, com verificação de erro.
  * 4. Define a afinidade de núcleo para cada tarefa (SMP).
  * 5. Inicia o escalonador do FreeRTOS.
@@ -284,7 +431,28 @@ int main() {
     printf("Iniciando sistema com FreeRTOS e SMP...\n");
     printf("Tarefas de entrada no Core 0 | Tarefas de processamento no Core 1\n");
 
+    // Habilita a gravação de eventos antes de criar qualquer objeto do FreeRTOS.
+    trace_iniciar();
+
     // --- Criação dos Objetos FreeRTOS ---
+#if PROCESSAMENTO_EM_LOTE
+    // Filas separadas por produtor, reunidas num queue set.
+    // O tamanho do conjunto deve ser a soma dos tamanhos das filas membro.
+    printf("Criando filas de eventos e queue set...");
+    joystick_queue = xQueueCreate(1, sizeof(queue_event_t));
+    button_queue = xQueueCreate(BUTTON_QUEUE_LEN, sizeof(queue_event_t));
+    event_set = xQueueCreateSet(1 + BUTTON_QUEUE_LEN);
+    if (joystick_queue == NULL || button_queue == NULL || event_set == NULL ||
+        xQueueAddToSet(joystick_queue, event_set) != pdPASS ||
+        xQueueAddToSet(button_queue, event_set) != pdPASS) {
+        printf("ERRO CRITICO: Falha ao criar as filas de eventos.\n");
+        critical_error_handler();
+    }
+    vQueueSetQueueNumber(joystick_queue, TRACE_FILA_JOYSTICK);
+    vQueueSetQueueNumber(button_queue, TRACE_FILA_BUTTON);
+    trace_nomear(TRACE_NOME_FILA, TRACE_FILA_JOYSTICK, "joystick_queue");
+    trace_nomear(TRACE_NOME_FILA, TRACE_FILA_BUTTON, "button_queue");
+#else
     // Cria uma fila para até 10 eventos. Cada evento tem o tamanho da struct queue_event_t.
     printf("Criando fila de eventos...");
     event_queue = xQueueCreate(10, sizeof(queue_event_t));
@@ -292,12 +460,15 @@ int main() {
         printf("ERRO CRITICO: Falha ao criar a fila de eventos.\n");
         critical_error_handler();
     }
-
-    // Cria um mutex para proteger o acesso concorrente à USB/printf.
-    printf("Criando mutex da USB...");
-    usb_mutex = xSemaphoreCreateMutex();
-    if (usb_mutex == NULL) {
-        printf("ERRO CRITICO: Falha ao criar o mutex da USB.\n");
+    vQueueSetQueueNumber(event_queue, TRACE_FILA_EVENTOS);
+    trace_nomear(TRACE_NOME_FILA, TRACE_FILA_EVENTOS, "event_queue");
+#endif
+
+    // Cria a fila de registros e a tarefa de log (prioridade mínima) que
+    // centraliza todo o acesso à USB/printf depois que o escalonador inicia.
+    printf("Criando log assincrono...");
+    if (!log_async_iniciar()) {
+        printf("ERRO CRITICO: Falha ao criar o log assincrono.\n");
         critical_error_handler();
     }
 
@@ -310,6 +481,8 @@ int main() {
         printf("ERRO CRITICO: Falha ao criar o semaforo do buzzer.\n");
         critical_error_handler();
     }
+    vQueueSetQueueNumber(buzzer_sem, TRACE_FILA_BUZZER);
+    trace_nomear(TRACE_NOME_FILA, TRACE_FILA_BUZZER, "buzzer_sem");
 
     // --- Criação das Tarefas ---
     // (Função, Nome, Tam. Pilha, Parâmetro, Prioridade, Handle para a tarefa)
@@ -334,8 +507,34 @@ int main() {
         printf("ERRO CRITICO: Falha ao criar a buzzer_task.\n");
         critical_error_handler();
     }
+
+    if (xTaskCreate(trace_dump_task, "TraceDumpTask", 512, NULL, tskIDLE_PRIORITY, &trace_dump_task_handle) != pdPASS) {
+        printf("ERRO CRITICO: Falha ao criar a trace_dump_task.\n");
+        critical_error_handler();
+    }
     printf("Todas as tarefas foram criadas com sucesso.\n");
 
+    // Números das tarefas para o trace (gravados pelos hooks traceTASK_SWITCHED_IN/OUT).
+    vTaskSetTaskNumber(joystick_task_handle, TRACE_ID_JOYSTICK);
+    vTaskSetTaskNumber(button_task_handle, TRACE_ID_BUTTON);
+    vTaskSetTaskNumber(processing_task_handle, TRACE_ID_PROCESSING);
+    vTaskSetTaskNumber(buzzer_task_handle, TRACE_ID_BUZZER);
+    vTaskSetTaskNumber(trace_dump_task_handle, TRACE_ID_DUMP);
+    trace_nomear(TRACE_NOME_TAREFA, 0, "Idle/Timer/Log");
+    trace_nomear(TRACE_NOME_TAREFA, TRACE_ID_JOYSTICK, "JoystickTask");
+    trace_nomear(TRACE_NOME_TAREFA, TRACE_ID_BUTTON, "ButtonTask");
+    trace_nomear(TRACE_NOME_TAREFA, TRACE_ID_PROCESSING, "ProcessingTask");
+    trace_nomear(TRACE_NOME_TAREFA, TRACE_ID_BUZZER, "BuzzerTask");
+    trace_nomear(TRACE_NOME_TAREFA, TRACE_ID_DUMP, "TraceDumpTask");
+    trace_nomear(TRACE_NOME_ZONA, TRACE_ZONA_LOTE, "lote de eventos");
+
+    // Timer periódico que reporta trocas de contexto por segundo (antes/depois do lote).
+    metrics_timer = xTimerCreate("Metrics", pdMS_TO_TICKS(METRICS_PERIOD_MS), pdTRUE, NULL, metrics_timer_cb);
+    if (metrics_timer == NULL || xTimerStart(metrics_timer, 0) != pdPASS) {
+        printf("ERRO CRITICO: Falha ao criar o timer de metricas.\n");
+        critical_error_handler();
+    }
+
     // --- Configuração da Afinidade de Núcleo (SMP) ---
     // Fixa as tarefas de leitura de sensores para rodar exclusivamente no Núcleo 0.
     // A máscara (1 << 0) representa o Core 0.
@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+"""
+@file trace_to_chrome.py
+@author Manoel Felipe Costa Furtado
+@copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+@brief Converte o despejo do trace_recorder (texto entre TRACE_BEGIN e TRACE_END)
+       para o formato JSON do Chrome Trace, que abre em chrome://tracing ou
+       https://ui.perfetto.dev.
+
+Uso:
+    # 1) Capturar (envie 't' pelo terminal serial para disparar o despejo):
+    #    stty -F /dev/ttyACM0 raw 115200 && cat /dev/ttyACM0 > captura.txt
+    # 2) Converter:
+    python3 trace_to_chrome.py captura.txt -o trace.json
+
+Linhas que não pertencem ao despejo (printf normal da aplicação) são ignoradas.
+"""
+
+import argparse
+import json
+import sys
+
+# Deve ser igual a trace_tipo_t em trace_recorder.h
+TAREFA_ENTRA, TAREFA_SAI, ISR_ENTRA, ISR_SAI, FILA_ENVIA, FILA_RECEBE, \
+    ZONA_INICIO, ZONA_FIM, MARCA = range(1, 10)
+
+# Deve ser igual a trace_categoria_t em trace_recorder.h
+CAT_TAREFA, CAT_ISR, CAT_FILA, CAT_ZONA, CAT_MARCA = range(5)
+PREFIXO = {CAT_TAREFA: "tarefa", CAT_ISR: "IRQ", CAT_FILA: "fila",
+           CAT_ZONA: "zona", CAT_MARCA: "marca"}
+
+TID_ZONAS = 10  # Zonas do usuário ficam numa trilha própria por núcleo (10 + núcleo).
+
+
+def ler_despejo(linhas):
+    """Retorna (agora_us, nomes, eventos, perdidos) do último despejo completo."""
+    despejo = None
+    atual = None
+    for linha in linhas:
+        campos = linha.strip().split(" ", 3)
+        if not campos or not campos[0]:
+            continue
+        try:
+            if campos[0] == "TRACE_BEGIN":
+                atual = {"agora": int(campos[1], 16), "nomes": {}, "eventos": [], "perdidos": {}}
+            elif atual is None:
+                continue
+            elif campos[0] == "N":
+                atual["nomes"][(int(campos[1]), int(campos[2]))] = campos[3]
+            elif campos[0] == "C":
+                atual["perdidos"][int(campos[1])] = int(campos[3])
+            elif campos[0] == "E":
+                nucleo, ts32, tipo, ident = campos[1], campos[2], *campos[3].split(" ")
+                atual["eventos"].append((int(nucleo), int(ts32, 16), int(tipo), int(ident)))
+            elif campos[0] == "TRACE_END":
+                despejo, atual = atual, None
+        except (IndexError, ValueError):
+            # Linha truncada ou intercalada com outro printf: descarta só ela.
+            continue
+    if despejo is None:
+        sys.exit("Nenhum despejo completo (TRACE_BEGIN ... TRACE_END) encontrado.")
+    return despejo
+
+
+def desenrolar(agora64, ts32):
+    """Reconstrói o tempo de 64 bits: o evento é o instante mais recente <= agora com os mesmos 32 bits baixos."""
+    return agora64 - ((agora64 - ts32) & 0xFFFFFFFF)
+
+
+def nome(nomes, categoria, ident):
+    return nomes.get((categoria, ident), f"{PREFIXO[categoria]} {ident}")
+
+
+def converter(despejo):
+    nomes = despejo["nomes"]
+    eventos = sorted(
+        ((desenrolar(despejo["agora"], ts), nucleo, tipo, ident)
+         for nucleo, ts, tipo, ident in despejo["eventos"]),
+        key=lambda e: e[0])
+    if not eventos:
+        return {"traceEvents": []}
+
+    base = eventos[0][0]
+    saida = []
+    abertos = {}  # tid -> pilha de nomes abertos (para descartar 'E' sem 'B')
+    nucleos = sorted({e[1] for e in eventos})
+
+    for n in nucleos:
+        saida.append({"ph": "M", "pid": 0, "tid": n, "name": "thread_name",
+                      "args": {"name": f"Nucleo {n}"}})
+        saida.append({"ph": "M", "pid": 0, "tid": TID_ZONAS + n, "name": "thread_name",
+                      "args": {"name": f"Nucleo {n} - zonas"}})
+
+    def inicio(tid, ts, texto, categoria):
+        abertos.setdefault(tid, []).append(texto)
+        saida.append({"ph": "B", "pid": 0, "tid": tid, "ts": ts, "name": texto, "cat": categoria})
+
+    def fim(tid, ts):
+        pilha = abertos.get(tid)
+        if pilha:  # o anel pode ter começado no meio de um trecho
+            pilha.pop()
+            saida.append({"ph": "E", "pid": 0, "tid": tid, "ts": ts})
+
+    for t64, nucleo, tipo, ident in eventos:
+        ts = t64 - base
+        if tipo == TAREFA_ENTRA:
+            inicio(nucleo, ts, nome(nomes, CAT_TAREFA, ident), "tarefa")
+        elif tipo == TAREFA_SAI:
+            fim(nucleo, ts)
+        elif tipo == ISR_ENTRA:
+            inicio(nucleo, ts, nome(nomes, CAT_ISR, ident), "isr")
+        elif tipo == ISR_SAI:
+            fim(nucleo, ts)
+        elif tipo in (FILA_ENVIA, FILA_RECEBE):
+            acao = "envia" if tipo == FILA_ENVIA else "recebe"
+            saida.append({"ph": "i", "s": "t", "pid": 0, "tid": nucleo, "ts": ts,
+                          "name": f"{nome(nomes, CAT_FILA, ident)} {acao}", "cat": "fila"})
+        elif tipo == ZONA_INICIO:
+            inicio(TID_ZONAS + nucleo, ts, nome(nomes, CAT_ZONA, ident), "zona")
+        elif tipo == ZONA_FIM:
+            fim(TID_ZONAS + nucleo, ts)
+        elif tipo == MARCA:
+            saida.append({"ph": "i", "s": "t", "pid": 0, "tid": nucleo, "ts": ts,
+                          "name": nome(nomes, CAT_MARCA, ident), "cat": "marca"})
+
+    # Fecha o que ficou aberto no fim da captura.
+    fim_ts = eventos[-1][0] - base
+    for tid, pilha in abertos.items():
+        for _ in pilha:
+            saida.append({"ph": "E", "pid": 0, "tid": tid, "ts": fim_ts})
+
+    return {"traceEvents": saida, "displayTimeUnit": "ms",
+            "otherData": {"eventos_perdidos_por_nucleo": despejo["perdidos"]}}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("entrada", help="arquivo capturado da serial ('-' para stdin)")
+    parser.add_argument("-o", "--saida", default="trace.json", help="arquivo JSON de saída")
+    args = parser.parse_args()
+
+    with (sys.stdin if args.entrada == "-" else open(args.entrada, errors="replace")) as f:
+        despejo = ler_despejo(f)
+
+    trace = converter(despejo)
+    with open(args.saida, "w") as f:
+        json.dump(trace, f)
+
+    print(f"{len(despejo['eventos'])} eventos convertidos -> {args.saida}; "
+          f"perdidos por sobrescrita: {despejo['perdidos']}")
+
+
+if __name__ == "__main__":
+    main()
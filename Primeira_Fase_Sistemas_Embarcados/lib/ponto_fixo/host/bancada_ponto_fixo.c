@@ -0,0 +1,203 @@
+/**
+ * @file bancada_ponto_fixo.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Bancada no Linux de ponto_fixo.c: erro contra a libm e custo contra o float.
+ *
+ * @details
+ * Para cada função, varre a faixa útil, compara com o equivalente em double e imprime o
+ * erro máximo em LSB (2^-16). Em seguida mede ns por chamada da versão em ponto fixo e
+ * da versão em float sobre as mesmas entradas.
+ *
+ * No PC o float é feito pela FPU e ganha quase sempre; o número que importa é o do
+ * RP2040, medido pelos casos pf_* de Unidade_01/Cap_09/Atividade_09/src/bench.
+ * Aqui valem a exatidão e a comparação relativa entre as funções.
+ *
+ * O código de saída é 1 se algum erro passar do limite declarado em ponto_fixo.h.
+ *
+ * @code
+ *   cmake -S host -B build_host && cmake --build build_host && ./build_host/bancada_ponto_fixo
+ * @endcode
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ponto_fixo.h"
+
+#define N_ENTRADAS 4096u
+#define REPETICOES 2000u
+
+static int falhas;
+static volatile int32_t sumidouro_i;
+static volatile float sumidouro_f;
+
+static double agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double q16_para_double(q16_t v) {
+    return v / 65536.0;
+}
+
+static void relatar_erro(const char *nome, double erro_lsb, double limite_lsb) {
+    int ok = erro_lsb <= limite_lsb;
+    printf("  %-8s erro máx %7.2f LSB (limite %4.1f) %s\n", nome, erro_lsb, limite_lsb,
+           ok ? "" : "<-- FALHOU");
+    if (!ok) {
+        falhas++;
+    }
+}
+
+// --- Exatidão ---
+
+static void conferir_exatidao(void) {
+    double e;
+    printf("exatidão (1 LSB = 2^-16 = %.2e)\n", 1.0 / 65536.0);
+
+    // Multiplicação e divisão: resultado arredondado / truncado dentro da faixa.
+    srand(7);
+    double e_mul = 0, e_div = 0, e_rec = 0;
+    for (uint32_t k = 0; k < 2000000u; k++) {
+        q16_t a = (q16_t)(((uint32_t)rand() << 1) ^ (uint32_t)rand()) >> (rand() % 16);
+        q16_t b = (q16_t)(((uint32_t)rand() << 1) ^ (uint32_t)rand()) >> (rand() % 24);
+        double ex = q16_para_double(a) * q16_para_double(b);
+        if (fabs(ex) < 32767.0) {
+            e = fabs(q16_para_double(pf_q16_mul(a, b)) - ex) * 65536.0;
+            if (e > e_mul) e_mul = e;
+        }
+        if (b != 0) {
+            ex = q16_para_double(a) / q16_para_double(b);
+            if (fabs(ex) < 32767.0) {
+                e = fabs(q16_para_double(pf_q16_div(a, b)) - ex) * 65536.0;
+                if (e > e_div) e_div = e;
+            }
+            ex = 1.0 / q16_para_double(b);
+            if (fabs(ex) < 32767.0) {
+                e = fabs(q16_para_double(pf_q16_recip(b)) - ex) * 65536.0;
+                if (e > e_rec) e_rec = e;
+            }
+        }
+    }
+    relatar_erro("mul", e_mul, 0.5);
+    relatar_erro("div", e_div, 1.0);
+    relatar_erro("recip", e_rec, 1.0);
+
+    // Saturação: nada de dar a volta.
+    if (pf_q16_somar(Q16_MAX, Q16_UM) != Q16_MAX || pf_q16_subtrair(Q16_MIN, Q16_UM) != Q16_MIN ||
+        pf_q16_mul(Q16(200.0), Q16(-200.0)) != Q16_MIN || pf_q16_div(Q16(1000.0), 1) != Q16_MAX ||
+        pf_q15_mul(Q15_MIN, Q15_MIN) != Q15_MAX || pf_q15_somar(Q15(0.75), Q15(0.5)) != Q15_MAX) {
+        printf("  saturação <-- FALHOU\n");
+        falhas++;
+    } else {
+        printf("  saturação ok\n");
+    }
+
+    // log2 em toda a faixa positiva (amostrada), sqrt e exp2 na faixa representável.
+    double e_log = 0, e_sqrt = 0, e_exp = 0;
+    for (uint32_t x = 1; x < 0x7FFFFFF0u; x += 1u + (x >> 12)) {
+        e = fabs(q16_para_double(pf_q16_log2((q16_t)x)) - log2(q16_para_double((q16_t)x))) * 65536.0;
+        if (e > e_log) e_log = e;
+        e = fabs(q16_para_double(pf_q16_sqrt((q16_t)x)) - sqrt(q16_para_double((q16_t)x))) * 65536.0;
+        if (e > e_sqrt) e_sqrt = e;
+    }
+    double e_exp_rel = 0;
+    for (int32_t y = Q16(-16.0); y < Q16(14.99); y += 37) {
+        double ex = exp2(q16_para_double(y));
+        double ob = q16_para_double(pf_q16_exp2(y));
+        e = fabs(ob - ex) * 65536.0;
+        if (ex < 1.0 && e > e_exp) e_exp = e;
+        if (ex >= 1.0 && fabs(ob - ex) / ex > e_exp_rel) e_exp_rel = fabs(ob - ex) / ex;
+    }
+    relatar_erro("log2", e_log, 4.0);
+    relatar_erro("sqrt", e_sqrt, 0.5);
+    relatar_erro("exp2<1", e_exp, 2.0);
+    // Acima de 1 o erro cresce com o resultado: o que fica constante é o relativo.
+    printf("  exp2>=1  erro relativo máx %.2e\n", e_exp_rel);
+    if (e_exp_rel > 4e-5) falhas++;
+
+    // Texto: idêntico ao printf.
+    char a[32], b[32];
+    int ruins = 0;
+    for (uint32_t k = 0; k < 200000u; k++) {
+        int32_t v = (int32_t)(((uint32_t)rand() << 1) ^ (uint32_t)rand()) >> (rand() % 31);
+        pf_i32_para_dec(v, a);
+        snprintf(b, sizeof(b), "%ld", (long)v);
+        ruins += strcmp(a, b) != 0;
+        unsigned casas = (unsigned)(k % 5u);
+        pf_q16_para_dec(v, casas, a);
+        snprintf(b, sizeof(b), "%.*f", (int)casas, q16_para_double(v));
+        // Única diferença declarada: zero negativo sai sem sinal.
+        if (strcmp(b, "-0") == 0 || strncmp(b, "-0.", 3) == 0) {
+            if (strspn(b + 1, "0.") == strlen(b + 1)) memmove(b, b + 1, strlen(b));
+        }
+        ruins += strcmp(a, b) != 0;
+    }
+    pf_i32_para_dec(INT32_MIN, a);
+    ruins += strcmp(a, "-2147483648") != 0;
+    // Empates exatos: para o par, como o printf.
+    static const struct { q16_t v; unsigned casas; const char *esperado; } empates[] = {
+        { Q16(0.25), 1, "0.2" }, { Q16(0.75), 1, "0.8" }, { Q16(2.5), 0, "2" },
+        { Q16(3.5), 0, "4" }, { Q16(-0.125), 2, "-0.12" }, { Q16(0.5), 0, "0" },
+    };
+    for (unsigned k = 0; k < sizeof(empates) / sizeof(empates[0]); k++) {
+        pf_q16_para_dec(empates[k].v, empates[k].casas, a);
+        ruins += strcmp(a, empates[k].esperado) != 0;
+    }
+    printf("  texto    %d diferenças contra o printf %s\n", ruins, ruins ? "<-- FALHOU" : "");
+    falhas += ruins != 0;
+}
+
+// --- Custo ---
+
+static q16_t in_a[N_ENTRADAS], in_b[N_ENTRADAS];
+static float fl_a[N_ENTRADAS], fl_b[N_ENTRADAS];
+
+#define MEDIR(expr_i, expr_f, nome)                                                   \
+    do {                                                                              \
+        double t0 = agora_ns();                                                       \
+        for (uint32_t r = 0; r < REPETICOES; r++)                                     \
+            for (uint32_t i = 0; i < N_ENTRADAS; i++) sumidouro_i += (expr_i);        \
+        double t1 = agora_ns();                                                       \
+        for (uint32_t r = 0; r < REPETICOES; r++)                                     \
+            for (uint32_t i = 0; i < N_ENTRADAS; i++) sumidouro_f += (expr_f);        \
+        double t2 = agora_ns();                                                       \
+        double n = (double)REPETICOES * N_ENTRADAS;                                   \
+        printf("  %-10s %8.2f %8.2f %7.2fx\n", nome, (t1 - t0) / n, (t2 - t1) / n,   \
+               (t2 - t1) / (t1 - t0));                                                \
+    } while (0)
+
+static void medir_custo(void) {
+    srand(11);
+    for (uint32_t i = 0; i < N_ENTRADAS; i++) {
+        in_a[i] = (q16_t)(rand() % Q16(100.0)) + 1;       // (0, 100]
+        in_b[i] = (q16_t)(rand() % Q16(10.0)) + Q16(0.5);  // [0,5, 10,5)
+        fl_a[i] = (float)q16_para_double(in_a[i]);
+        fl_b[i] = (float)q16_para_double(in_b[i]);
+    }
+    char buf[PF_DEC_TAM + 8];
+
+    printf("\ncusto no host (ns/chamada)\n  %-10s %8s %8s %8s\n", "função", "pf", "float",
+           "float/pf");
+    MEDIR(pf_q16_mul(in_a[i], in_b[i]), fl_a[i] * fl_b[i], "mul");
+    MEDIR(pf_q16_div(in_a[i], in_b[i]), fl_a[i] / fl_b[i], "div");
+    MEDIR(pf_q16_recip(in_b[i]), 1.0f / fl_b[i], "recip");
+    MEDIR(pf_q16_log2(in_a[i]), log2f(fl_a[i]), "log2");
+    MEDIR(pf_q16_exp2(in_b[i]), exp2f(fl_b[i]), "exp2");
+    MEDIR(pf_q16_sqrt(in_a[i]), sqrtf(fl_a[i]), "sqrt");
+    MEDIR(pf_i32_para_dec(in_a[i], buf), (float)snprintf(buf, sizeof(buf), "%ld", (long)in_a[i]),
+          "int->dec");
+    MEDIR(pf_q16_para_dec(in_a[i], 2, buf), (float)snprintf(buf, sizeof(buf), "%.2f", fl_a[i]),
+          "q16->dec");
+}
+
+int main(void) {
+    conferir_exatidao();
+    medir_custo();
+    printf("\n%s\n", falhas ? "FALHOU" : "ok");
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file ponto_fixo.c
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Funções de ponto_fixo.h que não cabem inline: divisão, log2/exp2/sqrt e texto.
+ */
+
+#include "ponto_fixo.h"
+#include <string.h>
+
+// Divisor de hardware na placa; no PC (bancada) o operador comum.
+#ifndef PF_DIVISOR_RP2040
+#if defined(PICO_RP2040) && PICO_RP2040
+#define PF_DIVISOR_RP2040 1
+#else
+#define PF_DIVISOR_RP2040 0
+#endif
+#endif
+
+#if PF_DIVISOR_RP2040
+#include "pico/divider.h"
+
+/** Quociente e resto numa operação do divisor do SIO (seguro em IRQ pelo pico_divider). */
+static inline uint32_t dividir(uint32_t a, uint32_t b, uint32_t *resto) {
+    return divmod_u32u32_rem(a, b, resto);
+}
+#else
+static inline uint32_t dividir(uint32_t a, uint32_t b, uint32_t *resto) {
+    *resto = a % b;
+    return a / b;
+}
+#endif
+
+/** log2(1 + i/64) em Q16, i = 0..64. */
+static const uint16_t tab_log2[65] = {
+    0, 1466, 2909, 4331, 5732, 7112, 8473, 9814,
+    11136, 12440, 13727, 14996, 16248, 17484, 18704, 19909,
+    21098, 22272, 23433, 24579, 25711, 26830, 27936, 29029,
+    30109, 31178, 32234, 33279, 34312, 35334, 36346, 37346,
+    38336, 39316, 40286, 41246, 42196, 43137, 44068, 44990,
+    45904, 46809, 47705, 48593, 49472, 50344, 51207, 52063,
+    52911, 53751, 54584, 55410, 56229, 57040, 57845, 58643,
+    59434, 60219, 60997, 61769, 62534, 63294, 64047, 64794,
+    65535,   // 65536 não cabe em 16 bits; o erro de 1 LSB fica dentro do da interpolação.
+};
+
+/** 2^(i/64) em Q16, i = 0..64. */
+static const uint32_t tab_exp2[65] = {
+    65536, 66250, 66971, 67700, 68438, 69183, 69936, 70698,
+    71468, 72246, 73032, 73828, 74632, 75444, 76266, 77096,
+    77936, 78785, 79642, 80510, 81386, 82273, 83169, 84074,
+    84990, 85915, 86851, 87796, 88752, 89719, 90696, 91684,
+    92682, 93691, 94711, 95743, 96785, 97839, 98905, 99982,
+    101070, 102171, 103283, 104408, 105545, 106694, 107856, 109031,
+    110218, 111418, 112631, 113858, 115098, 116351, 117618, 118899,
+    120194, 121502, 122825, 124163, 125515, 126882, 128263, 129660,
+    131072,
+};
+
+static const char pares[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint16_t pot10[5] = { 1, 10, 100, 1000, 10000 };
+
+static inline uint32_t modulo(int32_t v) {
+    return v < 0 ? 0u - (uint32_t)v : (uint32_t)v;
+}
+
+static inline q16_t com_sinal(uint32_t u, int negativo) {
+    if (u > (uint32_t)Q16_MAX) {
+        return negativo ? Q16_MIN : Q16_MAX;
+    }
+    return negativo ? -(q16_t)u : (q16_t)u;
+}
+
+q16_t pf_q16_div(q16_t a, q16_t b) {
+    int negativo = (a < 0) != (b < 0);
+    if (b == 0) {
+        return a < 0 ? Q16_MIN : Q16_MAX;
+    }
+    uint32_t ua = modulo(a), ub = modulo(b), resto;
+
+    uint32_t q = dividir(ua, ub, &resto);
+    if (q >= 0x8000u) {
+        return negativo ? Q16_MIN : Q16_MAX;
+    }
+
+    // 16 bits de fração por divisão longa: resto < ub, então resto << clz(ub) não transborda.
+    // |b| < 1,0 sai numa divisão; |b| < 256, em duas.
+    unsigned folga = (unsigned)__builtin_clz(ub);
+    uint32_t frac = 0;
+    if (folga == 0) {
+        frac = (uint32_t)(((uint64_t)resto << 16) / ub);   // Só b = Q16_MIN.
+    } else {
+        for (unsigned faltam = 16; faltam > 0;) {
+            unsigned k = folga < faltam ? folga : faltam;
+            frac = (frac << k) | dividir(resto << k, ub, &resto);
+            faltam -= k;
+        }
+    }
+    return com_sinal((q << 16) | frac, negativo);
+}
+
+q16_t pf_q16_recip(q16_t b) {
+    if (b == 0) {
+        return Q16_MAX;
+    }
+    uint32_t ub = modulo(b), resto;
+    if (ub == 1u) {
+        return b < 0 ? Q16_MIN : Q16_MAX;
+    }
+    // 2^32 / ub com uma divisão de 32 bits: 2^32 - 1 = q·ub + resto.
+    uint32_t q = dividir(0xFFFFFFFFu, ub, &resto);
+    if (resto == ub - 1u) {
+        q++;
+    }
+    return com_sinal(q, b < 0);
+}
+
+q16_t pf_q16_log2(q16_t x) {
+    if (x <= 0) {
+        return Q16_MIN;
+    }
+    int msb = 31 - __builtin_clz((uint32_t)x);
+    uint32_t m = ((uint32_t)x << (31 - msb)) - 0x80000000u;   // Fração da mantissa, 31 bits.
+    uint32_t i = m >> 25;                                     // 6 bits: posição na tabela.
+    uint32_t t = (m >> 9) & 0xFFFFu;                          // 16 bits: entre i e i+1.
+    int32_t y0 = tab_log2[i];
+    int32_t y = y0 + (int32_t)(((uint32_t)(tab_log2[i + 1] - y0) * t + 0x8000u) >> 16);
+    return (msb - 16) * Q16_UM + y;
+}
+
+q16_t pf_q16_exp2(q16_t y) {
+    int32_t inteiro = y >> 16;
+    uint32_t f = (uint32_t)y & 0xFFFFu;
+    uint32_t i = f >> 10;
+    uint32_t t = (f & 0x3FFu) << 6;
+    uint32_t m = tab_exp2[i] + (((tab_exp2[i + 1] - tab_exp2[i]) * t + 0x8000u) >> 16);   // [1, 2)
+
+    if (inteiro >= 15) {
+        return Q16_MAX;
+    }
+    if (inteiro >= 0) {
+        return (q16_t)(m << inteiro);
+    }
+    if (inteiro < -17) {
+        return 0;
+    }
+    unsigned d = (unsigned)-inteiro;
+    return (q16_t)((m + (1u << (d - 1u))) >> d);
+}
+
+q16_t pf_q16_sqrt(q16_t x) {
+    if (x <= 0) {
+        return 0;
+    }
+    // √(x·2^16): entrada de 48 bits (x seguido de 16 zeros), raiz de 24 bits, dois bits
+    // por passo. O resto fica abaixo de 2·raiz + 1 < 2^25, então tudo cabe em 32 bits.
+    uint32_t v = (uint32_t)x, resto = 0, raiz = 0;
+    int pula = __builtin_clz(v) / 2;            // Pares de zeros no topo: não geram bits.
+    int passos = 24 - pula;
+    v <<= 2 * pula;
+
+    for (int k = 0; k < passos; k++) {
+        resto = (resto << 2) | (v >> 30);
+        v <<= 2;
+        raiz <<= 1;
+        uint32_t teste = (raiz << 1) | 1u;
+        if (resto >= teste) {
+            resto -= teste;
+            raiz |= 1u;
+        }
+    }
+    return (q16_t)(resto > raiz ? raiz + 1u : raiz);
+}
+
+int pf_u32_para_dec(uint32_t v, char *buf) {
+    char tmp[10];
+    int n = sizeof(tmp);
+    uint32_t resto;
+
+    while (v >= 100u) {
+        v = dividir(v, 100u, &resto);
+        n -= 2;
+        memcpy(&tmp[n], &pares[2u * resto], 2);
+    }
+    if (v >= 10u) {
+        n -= 2;
+        memcpy(&tmp[n], &pares[2u * v], 2);
+    } else {
+        tmp[--n] = (char)('0' + v);
+    }
+    int len = (int)sizeof(tmp) - n;
+    memcpy(buf, &tmp[n], (size_t)len);
+    buf[len] = '\0';
+    return len;
+}
+
+int pf_i32_para_dec(int32_t v, char *buf) {
+    if (v < 0) {
+        *buf = '-';
+        return 1 + pf_u32_para_dec(modulo(v), buf + 1);
+    }
+    return pf_u32_para_dec((uint32_t)v, buf);
+}
+
+int pf_q16_para_dec(q16_t v, unsigned casas, char *buf) {
+    if (casas > 4u) {
+        casas = 4u;
+    }
+    uint32_t u = modulo(v);
+    uint32_t escala = pot10[casas];
+    // |v| · 10^casas em ponto fixo: parte inteira < 2^15 · 10^4 e fração de 16 bits.
+    uint32_t f = (u & 0xFFFFu) * escala;
+    uint32_t n = (u >> 16) * escala + (f >> 16);
+    uint32_t resto = f & 0xFFFFu;
+    // Empate exato vai para o par, como o printf (Q16 é exato em binário).
+    if (resto > 0x8000u || (resto == 0x8000u && (n & 1u))) {
+        n++;
+    }
+    uint32_t frac;
+    uint32_t inteiro = dividir(n, escala, &frac);
+
+    char *p = buf;
+    if (v < 0 && (inteiro | frac)) {
+        *p++ = '-';
+    }
+    p += pf_u32_para_dec(inteiro, p);
+    if (casas) {
+        *p++ = '.';
+        for (unsigned k = casas; k > 0; k--) {
+            uint32_t d;
+            frac = dividir(frac, 10u, &d);
+            p[k - 1u] = (char)('0' + d);
+        }
+        p += casas;
+        *p = '\0';
+    }
+    return (int)(p - buf);
+}
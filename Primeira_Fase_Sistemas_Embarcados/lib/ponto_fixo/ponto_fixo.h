@@ -0,0 +1,152 @@
+/**
+ * @file ponto_fixo.h
+ * @author Manoel Felipe Costa Furtado
+ * @copyright 2025 Manoel Furtado (MIT License) (veja LICENSE.md)
+ * @brief Aritmética em ponto fixo (Q15 e Q16.16) para o Cortex-M0+ do RP2040, que não tem FPU.
+ *
+ * @details
+ * Biblioteca comum aos projetos da Primeira Fase. Para usar num projeto CMake:
+ * @code
+ *   set(PONTO_FIXO_PATH ${CMAKE_CURRENT_LIST_DIR}/../../../lib/ponto_fixo CACHE PATH "Biblioteca ponto_fixo")
+ *   include(${PONTO_FIXO_PATH}/ponto_fixo_import.cmake)
+ *   target_link_libraries(meu_alvo ponto_fixo)
+ * @endcode
+ *
+ * - q15_t: [-1, 1), passo 2^-15. Para ganhos, brilho e amostras normalizadas.
+ * - q16_t: Q16.16, [-32768, 32768), passo 2^-16 (~15 µ). Para grandezas físicas.
+ * - Soma, subtração e multiplicação saturam em vez de dar a volta.
+ * - Divisão e recíproco usam o divisor de hardware do RP2040 (SIO, 8 ciclos) pelo
+ *   pico_divider; fora da placa (bancada no PC), o operador `/` comum.
+ * - log2/exp2: tabela de 65 pontos com interpolação linear. Erro medido em
+ *   host/bancada_ponto_fixo.c: log2 até 3,5 LSB; exp2 até 2 LSB abaixo de 1 e 3e-5
+ *   relativo acima. sqrt: dígito a dígito, arredondada (0,5 LSB).
+ * - Conversão para texto sem printf: dois dígitos por divisão, tabela "00".."99".
+ *
+ * Float só entra em Q16()/Q15() (constantes, resolvidas pelo compilador) e em
+ * pf_q16_de_float()/pf_q16_para_float(), para as bordas com código que ainda usa float.
+ */
+
+#ifndef PONTO_FIXO_H
+#define PONTO_FIXO_H
+
+#include <stdint.h>
+
+typedef int16_t q15_t;   ///< Q1.15.
+typedef int32_t q16_t;   ///< Q16.16.
+
+#define Q15_MAX   INT16_MAX
+#define Q15_MIN   INT16_MIN
+#define Q16_MAX   INT32_MAX
+#define Q16_MIN   INT32_MIN
+#define Q16_UM    ((q16_t)0x10000)
+
+/** @brief Constante Q16.16 a partir de um literal (arredondada; use só com constantes). */
+#define Q16(x)    ((q16_t)((x) * 65536.0 + ((x) >= 0 ? 0.5 : -0.5)))
+/** @brief Constante Q15 a partir de um literal em [-1, 1) (1.0 satura em Q15_MAX). */
+#define Q15(x)    ((q15_t)((x) >= 1.0 ? Q15_MAX : (x) * 32768.0 + ((x) >= 0 ? 0.5 : -0.5)))
+/** @brief Inteiro para Q16.16 (sem saturação: |n| < 32768). */
+#define Q16_DE_INT(n) ((q16_t)((uint32_t)(int32_t)(n) << 16))
+
+#define PF_DEC_TAM 12    ///< Buffer para qualquer pf_*_para_dec(), com o '\0'.
+
+// --- Saturação ---
+
+static inline q16_t pf_sat_q16(int64_t v) {
+    return v > Q16_MAX ? Q16_MAX : v < Q16_MIN ? Q16_MIN : (q16_t)v;
+}
+
+static inline q15_t pf_sat_q15(int32_t v) {
+    return v > Q15_MAX ? Q15_MAX : v < Q15_MIN ? Q15_MIN : (q15_t)v;
+}
+
+// --- Q15 ---
+
+static inline q15_t pf_q15_somar(q15_t a, q15_t b) {
+    return pf_sat_q15((int32_t)a + b);
+}
+
+static inline q15_t pf_q15_subtrair(q15_t a, q15_t b) {
+    return pf_sat_q15((int32_t)a - b);
+}
+
+/** @brief a·b arredondado; só -1·-1 satura. */
+static inline q15_t pf_q15_mul(q15_t a, q15_t b) {
+    return pf_sat_q15(((int32_t)a * b + (1 << 14)) >> 15);
+}
+
+static inline q16_t pf_q16_de_q15(q15_t a) {
+    return (q16_t)a * 2;
+}
+
+static inline q15_t pf_q15_de_q16(q16_t a) {
+    return pf_sat_q15((a >> 1) + (a & 1));
+}
+
+// --- Q16.16 ---
+
+static inline q16_t pf_q16_somar(q16_t a, q16_t b) {
+    int32_t s = (int32_t)((uint32_t)a + (uint32_t)b);
+    if (((a ^ s) & (b ^ s)) < 0) {       // Operandos de mesmo sinal e resultado de outro.
+        return a < 0 ? Q16_MIN : Q16_MAX;
+    }
+    return s;
+}
+
+static inline q16_t pf_q16_subtrair(q16_t a, q16_t b) {
+    int32_t s = (int32_t)((uint32_t)a - (uint32_t)b);
+    if (((a ^ b) & (a ^ s)) < 0) {
+        return a < 0 ? Q16_MIN : Q16_MAX;
+    }
+    return s;
+}
+
+/** @brief a·b arredondado, com saturação. */
+static inline q16_t pf_q16_mul(q16_t a, q16_t b) {
+    return pf_sat_q16(((int64_t)a * b + 0x8000) >> 16);
+}
+
+/** @brief Parte inteira (arredonda para baixo). */
+static inline int32_t pf_q16_para_int(q16_t a) {
+    return a >> 16;
+}
+
+static inline q16_t pf_q16_de_float(float f) {
+    return pf_sat_q16((int64_t)(f * 65536.0f + (f >= 0.0f ? 0.5f : -0.5f)));
+}
+
+static inline float pf_q16_para_float(q16_t a) {
+    return (float)a * (1.0f / 65536.0f);
+}
+
+/** @brief a/b truncado para zero; b = 0 ou quociente fora da faixa saturam. */
+q16_t pf_q16_div(q16_t a, q16_t b);
+
+/** @brief 1/b truncado (uma divisão de hardware); b = 0 e |b| = 2^-16 saturam. */
+q16_t pf_q16_recip(q16_t b);
+
+/** @brief log2(x); x <= 0 devolve Q16_MIN. */
+q16_t pf_q16_log2(q16_t x);
+
+/** @brief 2^y; satura em Q16_MAX a partir de y = 15 e vai a 0 abaixo de -16. */
+q16_t pf_q16_exp2(q16_t y);
+
+/** @brief √x arredondada; x <= 0 devolve 0. */
+q16_t pf_q16_sqrt(q16_t x);
+
+// --- Texto ---
+
+/** @brief Escreve `v` em decimal com '\0'; devolve o número de caracteres. */
+int pf_u32_para_dec(uint32_t v, char *buf);
+
+/** @brief Idem, com sinal. */
+int pf_i32_para_dec(int32_t v, char *buf);
+
+/**
+ * @brief Escreve `v` com `casas` decimais (0..4), como "%.*f": arredonda para o mais
+ *        próximo e, nos empates exatos (0,25 com 1 casa), para o dígito par. Diferença:
+ *        um negativo que arredonda para zero sai sem sinal ("0.0", e não "-0.0").
+ * @return Número de caracteres (sem o '\0').
+ */
+int pf_q16_para_dec(q16_t v, unsigned casas, char *buf);
+
+#endif // PONTO_FIXO_H
@@ -0,0 +1,21 @@
+##
+# ponto_fixo_import.cmake - Biblioteca de ponto fixo (Q15/Q16.16) da Primeira Fase
+# Descrição: define a biblioteca INTERFACE ponto_fixo. Os fontes são compilados em cada
+#            alvo que a liga, com as opções dele. Na placa, liga pico_divider, que
+#            fornece o divisor de hardware usado em pf_q16_div/pf_q16_recip.
+#
+#   set(PONTO_FIXO_PATH <caminho>/lib/ponto_fixo CACHE PATH "Biblioteca ponto_fixo")
+#   include(${PONTO_FIXO_PATH}/ponto_fixo_import.cmake)
+#   target_link_libraries(meu_alvo ponto_fixo)
+##
+
+if(NOT TARGET ponto_fixo)
+    add_library(ponto_fixo INTERFACE)
+
+    target_sources(ponto_fixo INTERFACE ${CMAKE_CURRENT_LIST_DIR}/ponto_fixo.c)
+    target_include_directories(ponto_fixo INTERFACE ${CMAKE_CURRENT_LIST_DIR})
+
+    if(TARGET pico_divider)
+        target_link_libraries(ponto_fixo INTERFACE pico_divider)
+    endif()
+endif()